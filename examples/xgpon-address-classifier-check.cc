@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jerome A Arokkiam
+ * Co-Authors in earlier versions of the code: Xiuchao Wu, Pedro Alvarez
+ */
+
+/**********************************************************************
+* This program checks the downstream prefix routes of the OLT (XgponOltConnManagerFlexible::AddDsPrefixRoute), which are
+* kept in the path-compressed trie of XgponAddressClassifier, against a brute-force longest-prefix match over the same routes.
+*
+* A fixed set of routes is added first so that every path of the insertion is taken: the default route (the root), one route
+* below an existing one, one route that splits an edge into a branching node, one route that ends on that branching node,
+* and routes that replace the connection of an existing prefix. Then several rounds add random routes (a few of them
+* replacing earlier ones) into a new connection manager. After each set of routes, addresses inside and around the routes
+* are classified and compared with the brute-force match. The program returns 1 at the first mismatch.
+**************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include "ns3/xgpon-olt-conn-manager-flexible.h"
+#include "ns3/xgpon-connection-sender.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("xgpon-address-classifier-check");
+
+
+//one prefix route as seen by the brute-force match
+class PrefixRoute
+{
+public:
+  uint32_t m_prefix;
+  uint8_t m_len;
+  Ptr<XgponConnectionSender> m_conn;
+};
+
+
+static uint32_t
+GetMask (uint8_t len)
+{
+  if(len == 0) return 0;
+  return 0xFFFFFFFF << (32 - len);
+}
+
+//add the route to the connection manager and to the list of routes (replacing the route of the same prefix)
+static void
+AddRoute (const Ptr<XgponOltConnManagerFlexible>& connManager, std::vector<PrefixRoute>& routes, uint32_t addr, uint8_t len, uint16_t port)
+{
+  Ptr<XgponConnectionSender> conn = CreateObject<XgponConnectionSender> ( );
+  conn->SetXgemPort (port);
+  connManager->AddDsPrefixRoute (Ipv4Address (addr), len, conn);
+
+  uint32_t prefix = addr & GetMask (len);
+  for(uint32_t i=0; i<routes.size(); i++)
+  {
+    if(routes[i].m_prefix == prefix && routes[i].m_len == len)
+    {
+      routes[i].m_conn = conn;
+      return;
+    }
+  }
+
+  PrefixRoute route;
+  route.m_prefix = prefix;
+  route.m_len = len;
+  route.m_conn = conn;
+  routes.push_back (route);
+}
+
+static Ptr<XgponConnectionSender>
+MatchBruteForce (const std::vector<PrefixRoute>& routes, uint32_t addr)
+{
+  Ptr<XgponConnectionSender> best = 0;
+  int bestLen = -1;
+  for(uint32_t i=0; i<routes.size(); i++)
+  {
+    if((addr & GetMask (routes[i].m_len)) == routes[i].m_prefix && (int) routes[i].m_len > bestLen)
+    {
+      bestLen = routes[i].m_len;
+      best = routes[i].m_conn;
+    }
+  }
+  return best;
+}
+
+//classify one address through the connection manager and compare with the brute-force match
+static bool
+CheckAddress (const Ptr<XgponOltConnManagerFlexible>& connManager, const std::vector<PrefixRoute>& routes, uint32_t addr)
+{
+  const Ptr<XgponConnectionSender>& found = connManager->FindDsConnByAddress (Ipv4Address (addr));
+  Ptr<XgponConnectionSender> expected = MatchBruteForce (routes, addr);
+  if(found == expected) return true;
+
+  std::cout << "Address " << Ipv4Address (addr) << ": xgem-port " << (found == 0 ? 0 : found->GetXgemPort ( ))
+            << " found, " << (expected == 0 ? 0 : expected->GetXgemPort ( )) << " expected (0: no route)" << std::endl;
+  return false;
+}
+
+//the addresses checked for one route: its first and last addresses, the addresses just outside, and random ones inside.
+static bool
+CheckRoutes (const Ptr<XgponOltConnManagerFlexible>& connManager, const std::vector<PrefixRoute>& routes,
+             const Ptr<UniformRandomVariable>& rng, uint32_t nRandom)
+{
+  if(connManager->GetNumberOfDsPrefixRoutes ( ) != routes.size ())
+  {
+    std::cout << connManager->GetNumberOfDsPrefixRoutes ( ) << " prefix routes, " << routes.size () << " expected" << std::endl;
+    return false;
+  }
+
+  for(uint32_t i=0; i<routes.size(); i++)
+  {
+    uint32_t first = routes[i].m_prefix;
+    uint32_t last = first | ~GetMask (routes[i].m_len);
+    if(!CheckAddress (connManager, routes, first) || !CheckAddress (connManager, routes, last)) return false;
+    if(!CheckAddress (connManager, routes, first - 1) || !CheckAddress (connManager, routes, last + 1)) return false;
+    for(uint32_t k=0; k<nRandom; k++)
+    {
+      if(!CheckAddress (connManager, routes, first | (rng->GetInteger (0, 0xFFFFFFFF) & ~GetMask (routes[i].m_len)))) return false;
+    }
+  }
+  for(uint32_t k=0; k<nRandom; k++)
+  {
+    if(!CheckAddress (connManager, routes, rng->GetInteger (0, 0xFFFFFFFF))) return false;
+  }
+  return true;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nRounds = 50;
+  uint32_t maxRoutes = 100;         //the largest number of random routes in one round
+  uint32_t nRandom = 20;            //random addresses per route and per set of routes
+
+  CommandLine cmd;
+  cmd.AddValue ("rounds", "Number of rounds with random routes", nRounds);
+  cmd.AddValue ("routes", "Largest number of random routes in one round", maxRoutes);
+  cmd.AddValue ("addresses", "Number of random addresses checked per route", nRandom);
+  cmd.Parse (argc, argv);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ( );
+
+  //the fixed routes: every path of AddPrefixRoute, checked after each step.
+  Ptr<XgponOltConnManagerFlexible> connManager = CreateObject<XgponOltConnManagerFlexible> ( );
+  std::vector<PrefixRoute> routes;
+  uint16_t port = 1;
+  bool passed = CheckRoutes (connManager, routes, rng, nRandom);
+
+  AddRoute (connManager, routes, Ipv4Address ("10.0.0.0").Get (), 8, port++);        //new leaf below the root
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  AddRoute (connManager, routes, Ipv4Address ("10.1.0.0").Get (), 16, port++);      //new leaf below 10/8
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  AddRoute (connManager, routes, Ipv4Address ("10.2.0.0").Get (), 16, port++);      //split 10.1/16 from 10/8 at 10.0/14
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  AddRoute (connManager, routes, Ipv4Address ("10.0.0.0").Get (), 14, port++);      //route on the branching node 10.0/14
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  AddRoute (connManager, routes, Ipv4Address ("10.1.0.0").Get (), 16, port++);      //replace the connection of 10.1/16
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  AddRoute (connManager, routes, Ipv4Address ("10.1.128.0").Get (), 17, port++);    //leaves below 10.1/16 and 10.1.128/17
+  AddRoute (connManager, routes, Ipv4Address ("10.1.192.0").Get (), 18, port++);
+  AddRoute (connManager, routes, Ipv4Address ("10.1.64.0").Get (), 18, port++);
+  AddRoute (connManager, routes, Ipv4Address ("10.1.0.0").Get (), 15, port++);      //split of the edge to 10.1/16 that ends on the new route 10.0/15
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  AddRoute (connManager, routes, Ipv4Address ("10.1.2.3").Get (), 32, port++);      //host-length prefix
+  AddRoute (connManager, routes, Ipv4Address ("0.0.0.0").Get (), 0, port++);        //default route on the root
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  AddRoute (connManager, routes, Ipv4Address ("0.0.0.0").Get (), 0, port++);        //replace the default route
+  AddRoute (connManager, routes, Ipv4Address ("10.0.0.0").Get (), 14, port++);      //replace the route on the branching node
+  passed = passed && CheckRoutes (connManager, routes, rng, nRandom);
+  std::cout << "Fixed routes: " << (passed ? "PASSED" : "FAILED") << std::endl;
+
+  //random routes; the prefixes are drawn from a few /4 blocks and some share their first bits, so that many splits happen.
+  for(uint32_t r=0; passed && r<nRounds; r++)
+  {
+    connManager = CreateObject<XgponOltConnManagerFlexible> ( );
+    routes.clear ();
+    port = 1;
+
+    uint32_t nRoutes = rng->GetInteger (1, maxRoutes);
+    for(uint32_t i=0; i<nRoutes; i++)
+    {
+      uint32_t addr = (rng->GetInteger (0, 3) << 28) | (rng->GetInteger (0, 0xFFFFFFFF) & 0x0FFFFFFF);
+      if(rng->GetInteger (0, 1) == 1) addr &= 0xFF0F0000;
+      uint8_t len = rng->GetInteger (0, 32);
+      if(i > 0 && rng->GetInteger (0, 9) == 0)
+      {
+        //one more connection for an existing prefix
+        const PrefixRoute& old = routes[rng->GetInteger (0, routes.size () - 1)];
+        addr = old.m_prefix;
+        len = old.m_len;
+      }
+      AddRoute (connManager, routes, addr, len, port++);
+    }
+    passed = CheckRoutes (connManager, routes, rng, nRandom);
+    if(!passed) std::cout << "Round " << r << " with " << nRoutes << " random routes: FAILED" << std::endl;
+  }
+  if(passed) std::cout << "Random routes (" << nRounds << " rounds): PASSED" << std::endl;
+
+  Simulator::Destroy ();
+
+  return passed ? 0 : 1;
+}
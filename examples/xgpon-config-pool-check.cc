@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jerome A Arokkiam
+ * Co-Authors in earlier versions of the code: Xiuchao Wu, Pedro Alvarez
+ */
+
+/**********************************************************************
+* This program checks the configuration objects that XgponConfigPool shares between the links and the T-CONTs.
+*
+* Burst profiles: one ONU is switched to another burst profile (XgponHelper::SetBurstProfileForOnu). Both sides of its
+* link must use the new profile, and the other ONUs must keep the profile object and the values that they had before.
+*
+* QoS parameters: the ONUs are provisioned in two groups, and one default attribute of XgponQosParameters is changed
+* (Config::SetDefault) in between. The T-CONTs of the second group must see the new value, while those of the first group
+* keep the old one.
+*
+* The program returns 1 if any of these checks fails.
+**************************************************************/
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include "ns3/xgpon-helper.h"
+#include "ns3/xgpon-config-db.h"
+#include "ns3/xgpon-service-profile.h"
+#include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-olt-net-device.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("xgpon-config-pool-check");
+
+static const uint8_t NEW_PROFILE_INDEX = 1;
+static const uint8_t NEW_PREAMBLE_LEN = 12;            // unit: byte
+static const uint8_t NEW_DELIMITER_LEN = 8;            // unit: byte
+static const uint32_t FIRST_ASSURED_BW = 1000;
+static const uint32_t SECOND_ASSURED_BW = 2000;
+
+
+//the burst profile in use at both sides of the link of one ONU
+struct LinkProfiles
+{
+  Ptr<XgponBurstProfile> m_onuSide;
+  Ptr<XgponBurstProfile> m_oltSide;
+  uint8_t m_onuIndex;
+  uint8_t m_oltIndex;
+  uint8_t m_preambleLen;
+  uint8_t m_delimiterLen;
+  bool m_fec;
+};
+
+static LinkProfiles
+GetLinkProfiles (const Ptr<XgponOnuNetDevice>& onuDevice, const Ptr<XgponOltNetDevice>& oltDevice)
+{
+  const Ptr<XgponLinkInfo>& onuLinkInfo = onuDevice->GetPloamEngine ( )->GetLinkInfo ( );
+  const Ptr<XgponLinkInfo>& oltLinkInfo = oltDevice->GetPloamEngine ( )->GetLinkInfo (onuDevice->GetOnuId ( ));
+
+  LinkProfiles profiles;
+  profiles.m_onuSide = onuLinkInfo->GetCurrentProfile ( );
+  profiles.m_oltSide = oltLinkInfo->GetCurrentProfile ( );
+  profiles.m_onuIndex = onuLinkInfo->GetCurrentProfileIndex ( );
+  profiles.m_oltIndex = oltLinkInfo->GetCurrentProfileIndex ( );
+  profiles.m_preambleLen = profiles.m_onuSide->GetPreambleLen ( );
+  profiles.m_delimiterLen = profiles.m_onuSide->GetDelimiterLen ( );
+  profiles.m_fec = profiles.m_onuSide->GetFec ( );
+  return profiles;
+}
+
+static bool
+HasAssuredBw (const Ptr<XgponOnuNetDevice>& onuDevice, uint32_t assuredBw)
+{
+  std::vector< Ptr<XgponTcontOnu> > tconts;
+  onuDevice->GetConnManager ( )->GetAllTconts (tconts);
+  if(tconts.empty ( )) return false;
+
+  for(uint32_t i=0; i<tconts.size(); i++)
+  {
+    if(tconts[i]->GetQosParameters ( )->GetAssuredBw ( ) != assuredBw) return false;
+  }
+  return true;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nOnus = 4;
+
+  CommandLine cmd;
+  cmd.AddValue ("onus", "Number of ONUs (the first one switches its burst profile)", nOnus);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (nOnus < 2, "At least two ONUs are needed");
+
+  XgponHelper xgponHelper;
+  XgponConfigDb& xgponConfigDb = xgponHelper.GetConfigDb ( );
+  xgponConfigDb.SetOltNetmaskLen (8);
+  xgponConfigDb.SetOnuNetmaskLen (24);
+  xgponConfigDb.SetIpAddressFirstByteForXgpon (10);
+  xgponConfigDb.SetIpAddressFirstByteForOnus (173);
+  xgponConfigDb.SetAllocateIds4Speed (true);
+  xgponHelper.InitializeObjectFactories ( );
+
+  NodeContainer xgponNodes;
+  xgponNodes.Create (nOnus + 1);   //0: olt; i (>0): onu
+  NetDeviceContainer xgponDevices = xgponHelper.Install (xgponNodes);
+
+  InternetStackHelper stack;
+  stack.Install (xgponNodes);
+
+  Ipv4AddressHelper addressHelper;
+  addressHelper.SetBase (xgponHelper.GetXgponIpAddressBase ( ).c_str(), xgponHelper.GetOltAddressNetmask ( ).c_str());
+  Ipv4InterfaceContainer xgponInterfaces = addressHelper.Assign (xgponDevices);
+  for(uint32_t i=0; i<(nOnus+1); i++)
+  {
+    Ptr<XgponNetDevice> tmpDevice = DynamicCast<XgponNetDevice, NetDevice> (xgponDevices.Get(i));
+    tmpDevice->SetAddress (xgponInterfaces.GetAddress(i));
+  }
+
+  Ptr<XgponOltNetDevice> oltDevice = DynamicCast<XgponOltNetDevice, NetDevice> (xgponDevices.Get(0));
+  std::vector< Ptr<XgponOnuNetDevice> > onuDevices;
+  for(uint32_t i=1; i<=nOnus; i++)
+  {
+    onuDevices.push_back (DynamicCast<XgponOnuNetDevice, NetDevice> (xgponDevices.Get(i)));
+  }
+
+  //the QoS parameters come from the pool (no QoS parameters in the service profile); the default attribute is changed
+  //between the two groups of ONUs.
+  XgponServiceProfile serviceProfile;
+  serviceProfile.AddTcont (XgponQosParameters::XGPON_TCONT_TYPE_2, 1);
+  serviceProfile.SetNDsConns (1);
+
+  uint32_t nFirstGroup = nOnus / 2;
+  NetDeviceContainer firstGroup, secondGroup;     //the OLT comes first in both
+  firstGroup.Add (xgponDevices.Get(0));
+  secondGroup.Add (xgponDevices.Get(0));
+  for(uint32_t i=1; i<=nOnus; i++)
+  {
+    if(i <= nFirstGroup) firstGroup.Add (xgponDevices.Get(i));
+    else secondGroup.Add (xgponDevices.Get(i));
+  }
+
+  Config::SetDefault ("ns3::XgponQosParameters::AssuredBandwidth", UintegerValue (FIRST_ASSURED_BW));
+  xgponHelper.ProvisionOnus (firstGroup, serviceProfile);
+  Config::SetDefault ("ns3::XgponQosParameters::AssuredBandwidth", UintegerValue (SECOND_ASSURED_BW));
+  xgponHelper.ProvisionOnus (secondGroup, serviceProfile);
+
+  bool passed = true;
+  for(uint32_t i=0; i<nOnus; i++)
+  {
+    uint32_t expected = (i < nFirstGroup) ? FIRST_ASSURED_BW : SECOND_ASSURED_BW;
+    if(!HasAssuredBw (onuDevices[i], expected))
+    {
+      std::cout << "ONU " << (i + 1) << ": T-CONTs without the expected assured bandwidth " << expected << std::endl;
+      passed = false;
+    }
+  }
+
+
+  //switch the first ONU to another burst profile
+  std::vector<LinkProfiles> before;
+  for(uint32_t i=0; i<nOnus; i++) before.push_back (GetLinkProfiles (onuDevices[i], oltDevice));
+
+  NS_ABORT_MSG_IF ((before[0].m_preambleLen == NEW_PREAMBLE_LEN && before[0].m_delimiterLen == NEW_DELIMITER_LEN && before[0].m_fec),
+                   "The new burst profile must differ from the default one");
+  xgponHelper.SetBurstProfileForOnu (onuDevices[0], oltDevice, NEW_PROFILE_INDEX, NEW_PREAMBLE_LEN, NEW_DELIMITER_LEN, true);
+
+  LinkProfiles switched = GetLinkProfiles (onuDevices[0], oltDevice);
+  if(switched.m_onuSide != switched.m_oltSide || switched.m_onuIndex != NEW_PROFILE_INDEX || switched.m_oltIndex != NEW_PROFILE_INDEX
+     || switched.m_preambleLen != NEW_PREAMBLE_LEN || switched.m_delimiterLen != NEW_DELIMITER_LEN || !switched.m_fec)
+  {
+    std::cout << "ONU 1: the link does not use the new burst profile at both sides" << std::endl;
+    passed = false;
+  }
+
+  for(uint32_t i=1; i<nOnus; i++)
+  {
+    LinkProfiles now = GetLinkProfiles (onuDevices[i], oltDevice);
+    if(now.m_onuSide != before[i].m_onuSide || now.m_oltSide != before[i].m_oltSide
+       || now.m_onuIndex != before[i].m_onuIndex || now.m_oltIndex != before[i].m_oltIndex
+       || now.m_preambleLen != before[i].m_preambleLen || now.m_delimiterLen != before[i].m_delimiterLen || now.m_fec != before[i].m_fec)
+    {
+      std::cout << "ONU " << (i + 1) << ": the burst profile changed with the one of ONU 1" << std::endl;
+      passed = false;
+    }
+  }
+
+  std::cout << "Burst profiles in the pool: " << (uint32_t) before[1].m_preambleLen << "/" << (uint32_t) before[1].m_delimiterLen
+            << " bytes (" << (nOnus - 1) << " ONUs), " << (uint32_t) switched.m_preambleLen << "/" << (uint32_t) switched.m_delimiterLen
+            << " bytes (ONU 1)" << std::endl;
+  std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+
+  Simulator::Destroy ();
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jerome A Arokkiam
+ * Co-Authors in earlier versions of the code: Xiuchao Wu, Pedro Alvarez
+ */
+
+/**********************************************************************
+* This program measures the cost of one upstream DBA mechanism, without applications, IP stacks or ONU engines.
+* The OLT DBA engine is driven frame by frame by XgponDbaHarness, either with a synthetic load or with a trace of
+* status reports (one CSV line per report: time in ns, alloc-id, buffer occupancy in bytes).
+* Every BWmap is checked for validity; the wall-clock time per BWmap and the failed checks are printed at the end.
+*
+* Example: ./waf --run "xgpon-dba-benchmark --dba=XgiantDeficit --onus=64 --tconts-per-onu=4 --frames=80000"
+**************************************************************/
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+
+#include "ns3/xgpon-helper.h"
+#include "ns3/xgpon-config-db.h"
+#include "ns3/xgpon-dba-harness.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("xgpon-dba-benchmark");
+
+static const double XGPON_UPSTREAM_CAPACITY = 2.24; // unit: Gbps
+
+int 
+main (int argc, char *argv[])
+{
+  std::string upstream_dba = "RoundRobin"; //DBA to be benchmarked (values: RoundRobin, Giant, Ebu, Xgiant, XgiantDeficit, XgiantProp)
+  uint32_t nOnus = 16;
+  uint32_t tconts_per_onu = 4;            //the T-CONT types cycle through T1...T4
+  uint32_t frames = 8000;                 //one BWmap per 125us downstream frame; 8000 frames = 1 second
+  double load = 0.8;                      //offered load of the synthetic traffic, as a fraction of the upstream capacity
+  std::string trace = "";                 //if set, the status reports are replayed from this file instead of the synthetic traffic
+
+  CommandLine cmd;
+  cmd.AddValue ("dba", "DBA to be benchmarked (values: RoundRobin, Giant, Ebu, Xgiant, XgiantDeficit, XgiantProp)", upstream_dba);
+  cmd.AddValue ("onus", "Number of ONUs", nOnus);
+  cmd.AddValue ("tconts-per-onu", "Number of T-CONTs per ONU (types T1...T4 in turn)", tconts_per_onu);
+  cmd.AddValue ("frames", "Number of BWmaps to be generated", frames);
+  cmd.AddValue ("load", "Offered load of the synthetic traffic as a fraction of the upstream capacity", load);
+  cmd.AddValue ("trace", "Trace of status reports (time-ns,alloc-id,buffer-bytes) to replay; empty for synthetic traffic", trace);
+  cmd.Parse (argc, argv);
+
+  std::string xgponDba = "ns3::XgponOltDbaEngine";
+  xgponDba.append(upstream_dba);
+
+  XgponDbaHarness harness;
+  XgponHelper& xgponHelper = harness.GetHelper ( );
+  XgponConfigDb& xgponConfigDb = xgponHelper.GetConfigDb ( );
+
+  xgponConfigDb.SetOltNetmaskLen (8);
+  xgponConfigDb.SetOnuNetmaskLen (24);
+  xgponConfigDb.SetIpAddressFirstByteForXgpon (10);
+  xgponConfigDb.SetIpAddressFirstByteForOnus (173);
+  xgponConfigDb.SetAllocateIds4Speed (true);
+  xgponConfigDb.SetOltDbaEngineTypeIdStr (xgponDba); 
+
+  //the same aggregate QoS parameters as xgpon-dba-udp-example, shared evenly by the ONUs.
+  double max_bandwidth = XGPON_UPSTREAM_CAPACITY;
+  uint32_t siValue = 1;
+  xgponHelper.SetQosParametersAttribute ("FixedBandwidth", UintegerValue (0));
+  xgponHelper.SetQosParametersAttribute ("AssuredBandwidth", UintegerValue ((uint64_t)(0.7*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("NonAssuredBandwidth", UintegerValue ((uint64_t)(0.8*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("BestEffortBandwidth", UintegerValue ((uint64_t)(0.67*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("MaxServiceInterval", UintegerValue (siValue));
+  xgponHelper.SetQosParametersAttribute ("MinServiceInterval", UintegerValue (2*siValue));
+
+  harness.Setup (nOnus, tconts_per_onu);
+
+  if(!trace.empty())
+  {
+    if(!harness.LoadReportTrace (trace))
+    {
+      std::cerr << "Cannot read the report trace " << trace << std::endl;
+      return 1;
+    }
+  }
+  else harness.SetSyntheticLoad (load);
+
+  std::cout << "dba," << upstream_dba << ",onus," << nOnus << ",tconts-per-onu," << tconts_per_onu << ",frames," << frames << std::endl;
+  harness.Run (frames);
+  harness.PrintSummary (std::cout);
+
+  Simulator::Destroy ();
+
+  return (harness.GetResult().m_violations == 0) ? 0 : 2;
+}
@@ -61,6 +61,12 @@
 #include "ns3/xgpon-channel.h"
 #include "ns3/xgpon-onu-net-device.h"
 #include "ns3/xgpon-olt-net-device.h"
+#include "ns3/xgpon-statistics-sampler.h"
+#include "ns3/xgpon-statistics-writer.h"
+#include "ns3/xgpon-memory-census.h"
+#include "ns3/xgpon-bwmap-recorder.h"
+#include "ns3/xgpon-latency-monitor.h"
+#include "ns3/xgpon-golden-trace.h"
 
 #include "ns3/xgpon-module.h"
 
@@ -76,9 +82,6 @@
 //global parameters
 static const uint16_t nOnus = 5; //number of ONUs to be used in the XGPON
 static const uint32_t timeIntervalToPrint = 100000000; //1,000,000,000 nanoseconds per second; so this prints the traces every 100ms
-static uint64_t time2printOnu[nOnus] = {timeIntervalToPrint};
-static uint64_t time2printOlt = timeIntervalToPrint; 
-static uint16_t incrementingOnuId = 0;
 static uint64_t totalOnuReceivedBytes = 0;
 static const double XGPON_UPSTREAM_CAPACITY = 2.24; // unit: Gbps
 static const double XGPON_DOWNSTREAM_CAPACITY = 9.9; // unit: Gbps
@@ -88,43 +91,34 @@ using namespace ns3;
 NS_LOG_COMPONENT_DEFINE ("xgpon-dba-udp-test");
 
 
-//trace at the OLT for upstream (counters are updated at the receiver)
+//statistics reported by XgponStatisticsSampler every timeIntervalToPrint (counters are updated at the receiver)
+//the OLT reports the upstream traffic per ONU and T-CONT type; each ONU reports its own downstream traffic.
 void
-DeviceStatisticsTrace (const XgponNetDeviceStatistics& stat)
+StatisticsSampleTrace (const XgponStatisticsSample& sample)
 {
-  if(stat.m_currentTime > time2printOlt)
+  if(sample.m_isOlt)
   {
     uint64_t totalRxFromXgponBytes = 0;
-    //std::cout << "stat.m_currentTime: " << stat.m_currentTime << std::endl;
-    for(uint16_t i = 0; i < nOnus; i++){ 
-      totalRxFromXgponBytes += stat.m_usOltBytes[i];
+    for(uint16_t i = 0; i < nOnus && i < sample.m_perOnu.size(); i++){ 
+      const XgponPerOnuRate& onu = sample.m_perOnu[i];
+      totalRxFromXgponBytes += onu.m_usBytes;
       //RoundRobin DBA only increases the counters for T4. QoS aware DBAs (all others except RoundRobin) generate traffic in all TCONTS; but since the traffic is generated for T2 - T4 in this example by default, only three types of counters can be seen incremented in the upstream when using the QoS-aware DBAs.
-      std::cout << (stat.m_currentTime / 1000000L) << ",ms," 
-          << "From ONU," << i << ",total-Upstream," << stat.m_usOltBytes[i] << "," 
-          << "alloc," << i+1024 << ",T1," << stat.m_usT1oltBytes[i] << "," 
-          << "alloc," << i+2048 << ",T2," << stat.m_usT2oltBytes[i] << "," 
-          << "alloc," << i+3072 << ",T3," << stat.m_usT3oltBytes[i] << "," 
-          << "alloc," << i+4096 << ",T4," << stat.m_usT4oltBytes[i] << "," << std::endl;
+      std::cout << (sample.m_time / 1000000L) << ",ms," 
+          << "From ONU," << i << ",Upstream-Mbps," << onu.m_usRate / 1e6 << "," 
+          << "alloc," << i+1024 << ",T1," << onu.m_usTcontRate[0] / 1e6 << "," 
+          << "alloc," << i+2048 << ",T2," << onu.m_usTcontRate[1] / 1e6 << "," 
+          << "alloc," << i+3072 << ",T3," << onu.m_usTcontRate[2] / 1e6 << "," 
+          << "alloc," << i+4096 << ",T4," << onu.m_usTcontRate[3] / 1e6 << "," << std::endl;
     }   
-    std::cout << "\tTotal-ONU-Upstream," << totalRxFromXgponBytes << ",(Bytes)" << std::endl;
-    time2printOlt += 100000000;
+    std::cout << "\tTotal-ONU-Upstream," << totalRxFromXgponBytes << ",(Bytes in the last interval)" << std::endl;
   }
-}
-
-//trace at the ONUs for the downstream (counters are updated at the receiver)
-void
-DeviceStatisticsTraceOnu (const XgponNetDeviceStatistics& stat)
-{
-  if(stat.m_currentTime > time2printOnu[incrementingOnuId])
+  else
   {
-    totalOnuReceivedBytes += stat.m_dsOnuBytes; 
-    std::cout << (stat.m_currentTime / 1000000L) << ",ms,ONU," << incrementingOnuId << ",total-downstream-thisOnu," << stat.m_dsOnuBytes << ",Bytes" << std::endl;
-    time2printOnu[incrementingOnuId] += 100000000;
-    incrementingOnuId++;
-    if(incrementingOnuId == nOnus){
-      std::cout << (stat.m_currentTime / 1000000L) << ",ms,total-downstream-allOnus," << totalOnuReceivedBytes << std::endl;
+    totalOnuReceivedBytes += sample.m_rxBytes; 
+    std::cout << (sample.m_time / 1000000L) << ",ms,ONU," << sample.m_onuId << ",downstream-Mbps-thisOnu," << sample.m_rxRate / 1e6 << std::endl;
+    if(sample.m_deviceIndex == nOnus - 1){  //the last ONU of this round
+      std::cout << (sample.m_time / 1000000L) << ",ms,total-downstream-allOnus," << totalOnuReceivedBytes << ",(Bytes in the last interval)" << std::endl;
       totalOnuReceivedBytes = 0;
-      incrementingOnuId = 0;
     }
   }
 }
@@ -138,6 +132,15 @@ main (int argc, char *argv[])
   std::string traffic_direction = "upstream"; //traffic direction: downstream/upstream; default is upstream
   std::string upstream_dba = "RoundRobin"; //DBA to be used for upstream bandwidth allocation
   std::string per_app_rate = "100Mbps"; //Datarate of an application traffic source
+  std::string stats_prefix = ""; //if set, the sampled statistics are also written into binary files with this prefix
+  bool batch_us_bursts = false; //if set, the upstream bursts of one BWmap are assembled in batches by the OLT
+  bool idle_fast_forward = false; //if set, the downstream frames are not delivered to idle ONUs
+  std::string bwmap_trace = ""; //if set, every BWmap produced by the OLT is recorded into this binary file
+  bool latency_report = false; //if set, the upstream latency is decomposed per T-CONT and printed at the end
+  bool memory_census = false; //if set, the number of live objects and pool hits of each pooled class are printed at the end
+  std::string golden_trace = ""; //if set, one digest per downstream frame is recorded into (or compared with) this file
+  bool golden_compare = false; //if set, this run is compared with the golden trace instead of recording it
+  double feeder_km = 0; //if positive, the ONUs are connected to one splitter at this distance (unit: km) instead of all at the logic one way delay
   //uint16_t dtqSize=800; //queue size for the net devices used in this example. Per AllocID Queues needs to be set at xgpon-queue.cc
   
   /*  
@@ -154,6 +157,15 @@ main (int argc, char *argv[])
   cmd.AddValue ("traffic-direction", "The direction of the traffic flow in XGPON (values: downstream, upstream)", traffic_direction);
   cmd.AddValue ("upstreamDBA", "DBA to be used for XGPON upstream; a simple RoundRobin is used for downstream (values: RoundRobin, Giant, Ebu, Xgiant, XgiantDeficit, XgiantProp)", upstream_dba);
   cmd.AddValue("app-rate", "Datarate of an application traffice source (values: 10Mbps, 1Gbps, 254kbps, etc)", per_app_rate);
+  cmd.AddValue("stats-prefix", "Prefix of the binary statistics files (<prefix>-stats.bin, etc.); empty for no file output", stats_prefix);
+  cmd.AddValue("batch-us-bursts", "Assemble the upstream bursts of one BWmap in batches instead of one event per burst (values: 0, 1)", batch_us_bursts);
+  cmd.AddValue("idle-fast-forward", "Do not deliver the downstream frames to idle ONUs (values: 0, 1)", idle_fast_forward);
+  cmd.AddValue("bwmap-trace", "Name of the binary BWmap timeline file (one record per bandwidth allocation); empty for no recording", bwmap_trace);
+  cmd.AddValue("latency-report", "Decompose the upstream latency per T-CONT (queueing, report-to-grant, grant-to-transmit, propagation) and print it at the end (values: 0, 1)", latency_report);
+  cmd.AddValue("memory-census", "Print the memory census of the pooled objects at the end of the simulation (values: 0, 1)", memory_census);
+  cmd.AddValue("golden-trace", "Name of the golden trace file (one digest of BWmap, DBRus and delivered bytes per frame); empty for none", golden_trace);
+  cmd.AddValue("golden-compare", "Compare this run with the golden trace and report the first divergence, instead of recording it (values: 0, 1)", golden_compare);
+  cmd.AddValue("feeder-km", "Length of the feeder fibre to the splitter (unit: km; 0 for all ONUs at the logic one way delay). Drop fibres are 0 or 1 km", feeder_km);
   cmd.Parse (argc, argv);
 
   std::string xgponDba = "ns3::XgponOltDbaEngine";
@@ -198,6 +210,9 @@ main (int argc, char *argv[])
   }
   
   //////////////////////////////////////////////////////////////////////////CONFIGURATIONS FOR XGPON HELPER
+  Config::SetDefault ("ns3::XgponChannel::BatchUpstreamBursts", BooleanValue (batch_us_bursts));
+  Config::SetDefault ("ns3::XgponChannel::IdleFastForward", BooleanValue (idle_fast_forward));
+
   XgponHelper xgponHelper;
   XgponConfigDb& xgponConfigDb = xgponHelper.GetConfigDb ( );
 
@@ -209,6 +224,12 @@ main (int argc, char *argv[])
   xgponConfigDb.SetIpAddressFirstByteForOnus (173);
   xgponConfigDb.SetAllocateIds4Speed (true);
   xgponConfigDb.SetOltDbaEngineTypeIdStr (xgponDba); 
+  if(feeder_km > 0)
+  {
+    //one splitter; the ONUs are spread over two drop lengths, thus two delivery events per downstream frame.
+    uint32_t splitter = xgponConfigDb.AddOdnSplitter (0, feeder_km * 1000);
+    for(uint32_t i=0; i<nOnus; i++) { xgponConfigDb.AttachOnuToOdnSplitter (i, splitter, (i % 2) * 1000); }
+  }
   
   //Set TypeId String and other configuration related information through XgponConfigDb before the following call.
   xgponHelper.InitializeObjectFactories ( );
@@ -270,6 +291,7 @@ main (int argc, char *argv[])
   NodeContainer p2pUserNodes[nOnus], p2pMetroNodes, p2pCoreNodes[nOnus];
   Ipv4InterfaceContainer p2pLastmileInterfaces[nOnus], p2pMetroInterfaces, p2pCoreInterfaces[nOnus];
   std::vector<uint16_t > allocIdList;
+  std::vector< Ptr<XgponQueue> > usQueues;   //the upstream queues of the ONUs, whose per-packet delays are written with --stats-prefix
 
 
   PointToPointHelper pointToPoint;
@@ -372,9 +394,13 @@ main (int argc, char *argv[])
 	Config::SetDefault ("ns3::XgponQueue::MaxBytes", UintegerValue(min_queue_size*1000)); //set the queue size. min_queue_size (unit: KBytes), MaxBytes (unit: Bytes)
 
   Ptr<XgponOltNetDevice> oltDevice = DynamicCast<XgponOltNetDevice, NetDevice> (xgponDevices.Get(0));
+
+  //the sampler reads the device counters at its own cadence instead of the per-frame DeviceStatistics trace
+  Ptr<XgponStatisticsSampler> statSampler = CreateObject<XgponStatisticsSampler> ( );
+  statSampler->SetAttribute ("Interval", UintegerValue (timeIntervalToPrint));
   if(traffic_direction == "upstream"){
-    std::cout << "Connecting OLT to upstream statistics " << std::endl;
-    oltDevice->TraceConnectWithoutContext ("DeviceStatistics", MakeCallback(&DeviceStatisticsTrace));
+    std::cout << "Sampling OLT upstream statistics " << std::endl;
+    statSampler->AddDevice (oltDevice);
   }
   //add xgem ports for user nodes connected to ONUs
   //each onu-olt pair would have a single downstream port and multiple upstream ports depending on the no. of tconts (by default 4 tconts, hence 4 upstream ports)
@@ -385,8 +411,8 @@ main (int argc, char *argv[])
     Address addr = p2pLastmileInterfaces[i].GetAddress(1);
     Ptr<XgponOnuNetDevice> onuDevice = DynamicCast<XgponOnuNetDevice, NetDevice> (xgponDevices.Get(i+1));
       if(traffic_direction == "downstream"){
-        std::cout << "Connecting ONU " << i << " to device downstream statistics " << std::endl;
-        onuDevice->TraceConnectWithoutContext ("DeviceStatistics", MakeCallback(&DeviceStatisticsTraceOnu));
+        std::cout << "Sampling ONU " << i << " downstream statistics " << std::endl;
+        statSampler->AddDevice (onuDevice);
       }
     uint16_t downPortId = xgponHelper.AddOneDownstreamConnectionForOnu (onuDevice, oltDevice, addr);
     xgponHelper.SetQosParametersAttribute ("FixedBandwidth", UintegerValue (fixedBw[i]) );
@@ -411,6 +437,7 @@ main (int argc, char *argv[])
       << "\tTCONT-"   << tcontType << std::endl;
       
       allocIdList.push_back(allocId);
+      usQueues.push_back (((onuDevice->GetConnManager ( ))->FindUsConnByXgemPort (upPortId))->GetXgponQueue ( ));
     }
   }
 
@@ -463,8 +490,58 @@ std::cout << std::endl;
   //pointToPoint.EnablePcap("p2p-metro-pcap", p2pMetroNodes);
   //pointToPoint.EnablePcap("p2p-server-pcap", serverNodes);
 
+  statSampler->TraceConnectWithoutContext ("Sample", MakeCallback(&StatisticsSampleTrace));
+  statSampler->Start ( );
+
+  Ptr<XgponStatisticsWriter> statWriter = 0;
+  if(!stats_prefix.empty())
+  {
+    statWriter = CreateObject<XgponStatisticsWriter> ( );
+    statWriter->SetAttribute ("FilePrefix", StringValue (stats_prefix));
+    statWriter->SetAttribute ("CsvExport", BooleanValue (true));
+    statWriter->Open ( );
+    statWriter->AttachSampler (statSampler);
+    //only the upstream queues of the ONUs report queue delays (the downstream queues at the OLT have no alloc-id)
+    for(uint32_t i=0; i<usQueues.size(); i++) { statWriter->AttachQueue (usQueues[i]); }
+  }
+
+  Ptr<XgponBwmapRecorder> bwmapRecorder = 0;
+  if(!bwmap_trace.empty())
+  {
+    bwmapRecorder = CreateObject<XgponBwmapRecorder> ( );
+    bwmapRecorder->SetAttribute ("FileName", StringValue (bwmap_trace));
+    (oltDevice->GetDbaEngine ( ))->SetBwmapRecorder (bwmapRecorder);
+  }
+
+  Ptr<XgponLatencyMonitor> latencyMonitor = 0;
+  if(latency_report)
+  {
+    latencyMonitor = CreateObject<XgponLatencyMonitor> ( );
+    oltDevice->SetLatencyMonitor (latencyMonitor);
+  }
+
+  Ptr<XgponGoldenTrace> goldenTrace = 0;
+  if(!golden_trace.empty())
+  {
+    goldenTrace = CreateObject<XgponGoldenTrace> ( );
+    goldenTrace->SetAttribute ("FileName", StringValue (golden_trace));
+    goldenTrace->SetAttribute ("Compare", BooleanValue (golden_compare));
+    if(!goldenTrace->Open ( ))
+    {
+      std::cerr << "Cannot open the golden trace " << golden_trace << std::endl;
+      return 1;
+    }
+    for(int i=0; i<(nOnus+1); i++) { goldenTrace->AddDevice (DynamicCast<XgponNetDevice, NetDevice> (xgponDevices.Get(i))); }
+    (oltDevice->GetDbaEngine ( ))->SetGoldenTrace (goldenTrace);
+  }
+
   Simulator::Stop(Seconds(APP_STOP + 0.2));
   Simulator::Run ();
+  if(statWriter != 0) { statWriter->Close ( ); }
+  if(bwmapRecorder != 0) { bwmapRecorder->Close ( ); }
+  if(latencyMonitor != 0) { latencyMonitor->PrintSummary (std::cout); }
+  if(memory_census) { XgponMemoryCensus::PrintSummary (std::cout); }
+  if(goldenTrace != 0) { goldenTrace->Close ( ); goldenTrace->PrintResult (std::cout); }
   Simulator::Destroy ();
   return 0;
 
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jerome A Arokkiam
+ * Co-Authors in earlier versions of the code: Xiuchao Wu, Pedro Alvarez
+ */
+
+/**********************************************************************
+* This program checks that two configurations of XG-PON that must behave identically produce the same golden trace
+* (one digest of the BWmap, the DBRus and the delivered bytes per downstream frame; see XgponGoldenTrace).
+* The reference configuration (dynamic engines, one event per upstream burst, no dormancy) is run and recorded first;
+* the same scenario is then run with the variant and compared with it frame by frame. It returns 1 at the first divergence.
+*
+*   --variant=static-engines     the OLT and ONUs composed with their engines at compile time (XgponConfigDb::SetStaticEngines)
+*   --variant=idle-fast-forward  the idle ONUs dormant and, while all of them are, no downstream frame produced by the OLT
+*                                (XgponChannel::IdleFastForward). The ONUs are then in the same phase of their on/off periods,
+*                                so that the whole PON is idle most of the time, and the frames in which nothing but polling
+*                                happens are left out of both traces (XgponGoldenTrace::SkipIdleFrames).
+*   --variant=idle-fast-forward-fixed  the same as idle-fast-forward, but the T1 T-CONTs have fixed bandwidth (and traffic).
+*                                Their grants do not depend on the status reports, so the OLT must keep producing every frame;
+*                                the traces are compared with all frames.
+*   --variant=batch-us-bursts    the upstream bursts of one BWmap assembled in batches (XgponChannel::BatchUpstreamBursts)
+*   --variant=repeat             the reference configuration again
+*
+* With --baseline=<file>, the reference configuration is compared with one trace recorded earlier (by --record-baseline=<file>)
+* instead, so that a change of the behaviour of one DBA is detected across commits.
+*
+* The traffic is bursty on purpose: every ONU sends (upstream, one source per T-CONT) and receives (downstream) UDP in short
+* on-periods separated by longer idle periods, so that the ONUs and the OLT alternate between busy and idle. Every ONU has one
+* T-CONT of each type (the GIANT engines serve T1 to T4 of one ONU in turn); T1 only has bandwidth and traffic with fixed bandwidth.
+**************************************************************/
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+
+#include "ns3/xgpon-helper.h"
+#include "ns3/xgpon-config-db.h"
+#include "ns3/xgpon-service-profile.h"
+#include "ns3/xgpon-channel.h"
+#include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-olt-net-device.h"
+#include "ns3/xgpon-golden-trace.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("xgpon-golden-trace-check");
+
+static const double XGPON_UPSTREAM_CAPACITY = 2.24;    // unit: Gbps
+static const double XGPON_DOWNSTREAM_CAPACITY = 9.9;   // unit: Gbps
+static const uint16_t SINK_BASE_PORT = 9000;           // the upstream sink of T-CONT type p listens at SINK_BASE_PORT + p
+static const double FIXED_SHARE = 0.1;                 // the share of the upstream capacity given to T1 with fixed bandwidth
+static const uint16_t DS_SINK_PORT = 9100;
+static const double ON_TIME = 0.002;                   // unit: second
+static const double OFF_TIME = 0.008;                  // unit: second
+
+
+static void
+AddOnOffSource (Ptr<Node> node, const InetSocketAddress& dest, double rate, double start, double stop)
+{
+  std::ostringstream onTime, offTime;
+  onTime << "ns3::ConstantRandomVariable[Constant=" << ON_TIME << "]";
+  offTime << "ns3::ConstantRandomVariable[Constant=" << OFF_TIME << "]";
+
+  OnOffHelper onOff ("ns3::UdpSocketFactory", dest);
+  onOff.SetAttribute ("OnTime", StringValue (onTime.str ()));
+  onOff.SetAttribute ("OffTime", StringValue (offTime.str ()));
+  onOff.SetAttribute ("DataRate", DataRateValue (DataRate ((uint64_t) rate)));
+  onOff.SetAttribute ("PacketSize", UintegerValue (1447));
+  onOff.SetAttribute ("MaxBytes", UintegerValue (0));
+  ApplicationContainer app = onOff.Install (node);
+  app.Start (Seconds (start));
+  app.Stop (Seconds (stop));
+}
+
+
+/**
+ * \brief run the scenario once with one configuration. The golden trace is recorded into traceFile, or compared with it.
+ * \param idleGaps whether the ONUs are busy at the same time (and, without fixed bandwidth, the idle frames are left out of the trace)
+ * \param fixedBw whether the T1 T-CONTs have fixed bandwidth and traffic
+ * \return false if the trace cannot be opened or the run diverges from the trace.
+ */
+static bool
+RunScenario (uint32_t nOnus, const std::string& dba, double simTime, const std::string& variant, bool idleGaps, bool fixedBw,
+             const std::string& traceFile, bool compare)
+{
+  //every configuration is set explicitly, since the defaults of the previous run are still in place.
+  Config::SetDefault ("ns3::XgponChannel::BatchUpstreamBursts", BooleanValue (variant == "batch-us-bursts"));
+  Config::SetDefault ("ns3::XgponChannel::IdleFastForward", BooleanValue (variant == "idle-fast-forward" || variant == "idle-fast-forward-fixed"));
+
+  std::string xgponDba = "ns3::XgponOltDbaEngine";
+  xgponDba.append(dba);
+
+  XgponHelper xgponHelper;
+  XgponConfigDb& xgponConfigDb = xgponHelper.GetConfigDb ( );
+  xgponConfigDb.SetOltNetmaskLen (8);
+  xgponConfigDb.SetOnuNetmaskLen (24);
+  xgponConfigDb.SetIpAddressFirstByteForXgpon (10);
+  xgponConfigDb.SetIpAddressFirstByteForOnus (173);
+  xgponConfigDb.SetAllocateIds4Speed (true);
+  xgponConfigDb.SetOltDbaEngineTypeIdStr (xgponDba);
+  xgponConfigDb.SetStaticEngines (variant == "static-engines");
+  xgponHelper.InitializeObjectFactories ( );
+
+  NodeContainer xgponNodes;
+  xgponNodes.Create (nOnus + 1);   //0: olt; i (>0): onu
+  NetDeviceContainer xgponDevices = xgponHelper.Install (xgponNodes);
+
+  InternetStackHelper stack;
+  stack.Install (xgponNodes);
+
+  Ipv4AddressHelper addressHelper;
+  addressHelper.SetBase (xgponHelper.GetXgponIpAddressBase ( ).c_str(), xgponHelper.GetOltAddressNetmask ( ).c_str());
+  Ipv4InterfaceContainer xgponInterfaces = addressHelper.Assign (xgponDevices);
+  for(uint32_t i=0; i<(nOnus+1); i++)
+  {
+    Ptr<XgponNetDevice> tmpDevice = DynamicCast<XgponNetDevice, NetDevice> (xgponDevices.Get(i));
+    tmpDevice->SetAddress (xgponInterfaces.GetAddress(i));
+  }
+
+  double max_bandwidth = XGPON_UPSTREAM_CAPACITY;
+  xgponHelper.SetQosParametersAttribute ("FixedBandwidth", UintegerValue (fixedBw ? (uint64_t)(FIXED_SHARE*max_bandwidth*1e9) / nOnus : 0));
+  xgponHelper.SetQosParametersAttribute ("AssuredBandwidth", UintegerValue ((uint64_t)(0.7*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("NonAssuredBandwidth", UintegerValue ((uint64_t)(0.8*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("BestEffortBandwidth", UintegerValue ((uint64_t)(0.67*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("MaxServiceInterval", UintegerValue (1));
+  xgponHelper.SetQosParametersAttribute ("MinServiceInterval", UintegerValue (2));
+
+  //every ONU: T1, T2, T3 and T4 with one upstream xgem-port each; one downstream xgem-port.
+  XgponServiceProfile serviceProfile;
+  for(uint8_t tcont=1; tcont<=4; tcont++)
+  {
+    serviceProfile.AddTcont (static_cast<XgponQosParameters::XgponTcontType>(tcont), 1);
+  }
+  serviceProfile.SetNDsConns (1);
+  xgponHelper.ProvisionOnus (xgponDevices, serviceProfile);
+
+  uint8_t firstSource = fixedBw ? 1 : 2;
+  for(uint8_t p=firstSource; p<=4; p++)
+  {
+    PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), SINK_BASE_PORT + p));
+    sink.Install (xgponNodes.Get(0)).Start (Seconds (0.000001));
+  }
+
+  //during the on-periods, the upstream load is 0.6 and the downstream load 0.3; the ONUs start one after the other,
+  //unless the whole PON should be idle in the off-periods.
+  double usRate = 0.6 * XGPON_UPSTREAM_CAPACITY * 1e9 / (nOnus * (5 - firstSource));
+  double dsRate = 0.3 * XGPON_DOWNSTREAM_CAPACITY * 1e9 / nOnus;
+  for(uint32_t i=0; i<nOnus; i++)
+  {
+    double start = idleGaps ? 0.005 : 0.005 + (ON_TIME + OFF_TIME) * i / nOnus;
+    for(uint8_t p=firstSource; p<=4; p++)
+    {
+      InetSocketAddress dest = InetSocketAddress (xgponInterfaces.GetAddress(0), SINK_BASE_PORT + p);
+      dest.SetTos (p);   //TOS n selects the n-th T-CONT added to this ONU
+      AddOnOffSource (xgponNodes.Get(i+1), dest, usRate, start, simTime);
+    }
+
+    PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), DS_SINK_PORT));
+    sink.Install (xgponNodes.Get(i+1)).Start (Seconds (0.000001));
+    AddOnOffSource (xgponNodes.Get(0), InetSocketAddress (xgponInterfaces.GetAddress(i+1), DS_SINK_PORT), dsRate, start, simTime);
+  }
+
+  Ptr<XgponOltNetDevice> oltDevice = DynamicCast<XgponOltNetDevice, NetDevice> (xgponDevices.Get(0));
+  Ptr<XgponGoldenTrace> goldenTrace = CreateObject<XgponGoldenTrace> ( );
+  goldenTrace->SetAttribute ("FileName", StringValue (traceFile));
+  goldenTrace->SetAttribute ("Compare", BooleanValue (compare));
+  goldenTrace->SetAttribute ("SkipIdleFrames", BooleanValue (idleGaps && !fixedBw));
+  if(!goldenTrace->Open ( ))
+  {
+    std::cerr << "Cannot open the golden trace " << traceFile << std::endl;
+    Simulator::Destroy ();
+    return false;
+  }
+  for(uint32_t i=0; i<(nOnus+1); i++) { goldenTrace->AddDevice (DynamicCast<XgponNetDevice, NetDevice> (xgponDevices.Get(i))); }
+  (oltDevice->GetDbaEngine ( ))->SetGoldenTrace (goldenTrace);
+
+  Simulator::Stop (Seconds (simTime + 0.01));
+  Simulator::Run ();
+
+  goldenTrace->Close ( );
+  bool diverged = goldenTrace->HasDiverged ( );
+  if(compare)
+  {
+    std::cout << dba << ", " << variant << ": ";
+    goldenTrace->PrintResult (std::cout);
+  }
+  Simulator::Destroy ();
+
+  return !diverged;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nOnus = 4;
+  std::string upstream_dba = "XgiantDeficit";
+  double sim_time = 0.05;                 //simulated time with traffic. unit: second
+  std::string variant = "repeat";
+  std::string baseline = "";              //if set, the reference configuration is compared with this trace
+  std::string record_baseline = "";       //if set, the reference configuration is recorded into this trace
+
+  CommandLine cmd;
+  cmd.AddValue ("onus", "Number of ONUs", nOnus);
+  cmd.AddValue ("dba", "DBA to be used for XGPON upstream (values: RoundRobin, Giant, Ebu, Xgiant, XgiantDeficit, XgiantProp)", upstream_dba);
+  cmd.AddValue ("sim-time", "Simulated time with traffic (unit: second)", sim_time);
+  cmd.AddValue ("variant", "The configuration compared with the reference one (values: static-engines, idle-fast-forward, idle-fast-forward-fixed, batch-us-bursts, repeat)", variant);
+  cmd.AddValue ("baseline", "Compare the reference configuration with this golden trace instead of running one variant", baseline);
+  cmd.AddValue ("record-baseline", "Record the golden trace of the reference configuration into this file and exit", record_baseline);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (variant != "static-engines" && variant != "idle-fast-forward" && variant != "idle-fast-forward-fixed"
+                   && variant != "batch-us-bursts" && variant != "repeat", "Unknown variant " << variant);
+
+  if(!record_baseline.empty())
+  {
+    return RunScenario (nOnus, upstream_dba, sim_time, "reference", false, false, record_baseline, false) ? 0 : 1;
+  }
+  if(!baseline.empty())
+  {
+    return RunScenario (nOnus, upstream_dba, sim_time, "reference", false, false, baseline, true) ? 0 : 1;
+  }
+
+  //one file per DBA and variant, since test.py may run several checks at the same time.
+  std::string traceFile = "xgpon-golden-trace-check-" + upstream_dba + "-" + variant + ".bin";
+  bool fixedBw = (variant == "idle-fast-forward-fixed");
+  bool idleGaps = (variant == "idle-fast-forward") || fixedBw;
+  bool identical = RunScenario (nOnus, upstream_dba, sim_time, "reference", idleGaps, fixedBw, traceFile, false)
+                   && RunScenario (nOnus, upstream_dba, sim_time, variant, idleGaps, fixedBw, traceFile, true);
+  std::remove (traceFile.c_str ());
+
+  return identical ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jerome A Arokkiam
+ * Co-Authors in earlier versions of the code: Xiuchao Wu, Pedro Alvarez
+ */
+
+/**********************************************************************
+* This program checks the delivery of one downstream multicast group (XgponHelper::AddOneMulticastDownstreamConnection).
+* All ONUs but the last one join the group, whose traffic is carried by one xgem-port shared by the members. The OLT sends
+* one UDP stream to the group address after an idle period; the program returns 1 unless every member receives the whole
+* stream and the last ONU receives nothing.
+*
+* With --idle-fast-forward=1 (XgponChannel::IdleFastForward), all ONUs are dormant and the OLT produces no downstream frame
+* when the stream starts. The frames that only carry the multicast group must then wake the members alone: the program
+* also returns 1 if the last ONU is found awake while the stream is sent.
+**************************************************************/
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+
+#include "ns3/xgpon-helper.h"
+#include "ns3/xgpon-config-db.h"
+#include "ns3/xgpon-service-profile.h"
+#include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-olt-net-device.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("xgpon-multicast-check");
+
+static const char* GROUP_ADDRESS = "225.1.2.3";
+static const uint16_t GROUP_PORT = 9200;
+static const uint32_t PACKET_SIZE = 1000;              // unit: byte
+static const uint32_t TOTAL_BYTES = 200 * PACKET_SIZE;
+static const double STREAM_START = 0.02;               // unit: second; the PON is idle before
+static const double STREAM_STOP = 0.05;                // unit: second
+static const double SAMPLE_INTERVAL = 0.001;           // unit: second
+
+static uint32_t g_awakeSamples = 0;                    //times that the ONU outside the group is found awake
+
+
+static void
+SampleDormancy (Ptr<XgponOnuNetDevice> onuDevice)
+{
+  if(!onuDevice->IsDormant ( )) g_awakeSamples++;
+
+  double next = Simulator::Now ( ).GetSeconds ( ) + SAMPLE_INTERVAL;
+  if(next < STREAM_STOP) Simulator::Schedule (Seconds (SAMPLE_INTERVAL), &SampleDormancy, onuDevice);
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nOnus = 3;
+  bool idleFastForward = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("onus", "Number of ONUs (all but the last one join the group)", nOnus);
+  cmd.AddValue ("idle-fast-forward", "Whether idle ONUs are dormant and the OLT skips the frames while all of them are", idleFastForward);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (nOnus < 2, "At least one member and one other ONU are needed");
+
+  Config::SetDefault ("ns3::XgponChannel::IdleFastForward", BooleanValue (idleFastForward));
+
+  XgponHelper xgponHelper;
+  XgponConfigDb& xgponConfigDb = xgponHelper.GetConfigDb ( );
+  xgponConfigDb.SetOltNetmaskLen (8);
+  xgponConfigDb.SetOnuNetmaskLen (24);
+  xgponConfigDb.SetIpAddressFirstByteForXgpon (10);
+  xgponConfigDb.SetIpAddressFirstByteForOnus (173);
+  xgponConfigDb.SetAllocateIds4Speed (true);
+  xgponHelper.InitializeObjectFactories ( );
+
+  NodeContainer xgponNodes;
+  xgponNodes.Create (nOnus + 1);   //0: olt; i (>0): onu
+  NetDeviceContainer xgponDevices = xgponHelper.Install (xgponNodes);
+
+  InternetStackHelper stack;
+  stack.Install (xgponNodes);
+
+  Ipv4AddressHelper addressHelper;
+  addressHelper.SetBase (xgponHelper.GetXgponIpAddressBase ( ).c_str(), xgponHelper.GetOltAddressNetmask ( ).c_str());
+  Ipv4InterfaceContainer xgponInterfaces = addressHelper.Assign (xgponDevices);
+  for(uint32_t i=0; i<(nOnus+1); i++)
+  {
+    Ptr<XgponNetDevice> tmpDevice = DynamicCast<XgponNetDevice, NetDevice> (xgponDevices.Get(i));
+    tmpDevice->SetAddress (xgponInterfaces.GetAddress(i));
+  }
+
+  //one T4 T-CONT per ONU, so that every ONU is polled while it is dormant; no unicast traffic is sent.
+  XgponServiceProfile serviceProfile;
+  serviceProfile.AddTcont (XgponQosParameters::XGPON_TCONT_TYPE_4, 1);
+  serviceProfile.SetNDsConns (1);
+  xgponHelper.ProvisionOnus (xgponDevices, serviceProfile);
+
+  //the group must be added after the ONUs.
+  Ipv4Address groupAddr (GROUP_ADDRESS);
+  Ptr<XgponOltNetDevice> oltDevice = DynamicCast<XgponOltNetDevice, NetDevice> (xgponDevices.Get(0));
+  uint16_t groupPort = xgponHelper.AddOneMulticastDownstreamConnection (oltDevice, groupAddr);
+  for(uint32_t i=1; i<nOnus; i++)
+  {
+    Ptr<XgponOnuNetDevice> onuDevice = DynamicCast<XgponOnuNetDevice, NetDevice> (xgponDevices.Get(i));
+    xgponHelper.AddOnuToMulticastGroup (onuDevice, oltDevice, groupPort, groupAddr);
+  }
+
+  //the multicast datagrams of the OLT leave through the XG-PON interface.
+  Ipv4StaticRoutingHelper multicastRouting;
+  multicastRouting.SetDefaultMulticastRoute (xgponNodes.Get(0), oltDevice);
+
+  std::vector< Ptr<PacketSink> > sinks;
+  for(uint32_t i=1; i<=nOnus; i++)
+  {
+    PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), GROUP_PORT));
+    ApplicationContainer app = sink.Install (xgponNodes.Get(i));
+    app.Start (Seconds (0.000001));
+    sinks.push_back (DynamicCast<PacketSink, Application> (app.Get (0)));
+  }
+
+  OnOffHelper onOff ("ns3::UdpSocketFactory", InetSocketAddress (groupAddr, GROUP_PORT));
+  onOff.SetAttribute ("OnTime", StringValue ("ns3::ConstantRandomVariable[Constant=1]"));
+  onOff.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0]"));
+  onOff.SetAttribute ("DataRate", DataRateValue (DataRate ("100Mbps")));
+  onOff.SetAttribute ("PacketSize", UintegerValue (PACKET_SIZE));
+  onOff.SetAttribute ("MaxBytes", UintegerValue (TOTAL_BYTES));
+  ApplicationContainer source = onOff.Install (xgponNodes.Get(0));
+  source.Start (Seconds (STREAM_START));
+  source.Stop (Seconds (STREAM_STOP));
+
+  Ptr<XgponOnuNetDevice> otherOnu = DynamicCast<XgponOnuNetDevice, NetDevice> (xgponDevices.Get(nOnus));
+  if(idleFastForward) Simulator::Schedule (Seconds (STREAM_START + SAMPLE_INTERVAL), &SampleDormancy, otherOnu);
+
+  Simulator::Stop (Seconds (STREAM_STOP + 0.01));
+  Simulator::Run ();
+
+  bool delivered = true;
+  for(uint32_t i=0; i<nOnus; i++)
+  {
+    uint64_t expected = (i < nOnus - 1) ? TOTAL_BYTES : 0;
+    uint64_t received = sinks[i]->GetTotalRx ();
+    std::cout << "ONU " << (i + 1) << ": " << received << " bytes received, " << expected << " expected" << std::endl;
+    if(received != expected) delivered = false;
+  }
+  if(idleFastForward)
+  {
+    std::cout << "ONU outside the group found awake " << g_awakeSamples << " times while the group was served" << std::endl;
+  }
+
+  Simulator::Destroy ();
+
+  return (delivered && g_awakeSamples == 0) ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jerome A Arokkiam
+ * Co-Authors in earlier versions of the code: Xiuchao Wu, Pedro Alvarez
+ */
+
+/**********************************************************************
+* This program measures how fast the whole simulator runs for one configuration of XG-PON, so that the scaling of
+* the simulator can be compared across commits. It is normally run by xgpon-scaling-benchmark.py, which sweeps the
+* number of ONUs, the T-CONTs per ONU, the DBA mechanism, the offered load and the packet size.
+*
+* To keep the topology (and the cost outside XG-PON) small, the UDP sources run on the ONU nodes and the sinks on the
+* OLT node; one source per T-CONT, which is selected through the TOS field. Only upstream traffic is generated.
+*
+* One CSV row is printed at the end (use --header to print the column names first):
+*   onus,tconts-per-onu,dba,load,packet-size,sim-seconds,events,wall-seconds,events-per-second,
+*   wall-seconds-per-sim-second,peak-rss-kb,rx-mbps
+**************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sys/resource.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+
+#include "ns3/xgpon-helper.h"
+#include "ns3/xgpon-config-db.h"
+#include "ns3/xgpon-service-profile.h"
+#include "ns3/xgpon-channel.h"
+#include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-olt-net-device.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("xgpon-scaling-benchmark");
+
+static const double XGPON_UPSTREAM_CAPACITY = 2.24; // unit: Gbps
+static const uint16_t SINK_BASE_PORT = 9000;        // the sink of T-CONT type p listens at SINK_BASE_PORT + p
+
+int 
+main (int argc, char *argv[])
+{
+  uint32_t nOnus = 8;
+  uint32_t tconts_per_onu = 3;            //the last ones of T1...T4, i.e., T2...T4 when 3
+  std::string upstream_dba = "XgiantDeficit";
+  double load = 0.8;                      //offered load as a fraction of the upstream capacity
+  uint32_t packet_size = 1447;            //UDP payload. unit: byte
+  double sim_time = 1.0;                  //simulated time with traffic. unit: second
+  bool batch_us_bursts = false;
+  bool idle_fast_forward = false;
+  bool header = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("onus", "Number of ONUs", nOnus);
+  cmd.AddValue ("tconts-per-onu", "Number of T-CONTs (one UDP source each) per ONU (values: 1...4)", tconts_per_onu);
+  cmd.AddValue ("dba", "DBA to be used for XGPON upstream (values: RoundRobin, Giant, Ebu, Xgiant, XgiantDeficit, XgiantProp)", upstream_dba);
+  cmd.AddValue ("load", "Offered load as a fraction of the upstream capacity", load);
+  cmd.AddValue ("packet-size", "UDP payload size (unit: byte)", packet_size);
+  cmd.AddValue ("sim-time", "Simulated time with traffic (unit: second)", sim_time);
+  cmd.AddValue ("batch-us-bursts", "Assemble the upstream bursts of one BWmap in batches (values: 0, 1)", batch_us_bursts);
+  cmd.AddValue ("idle-fast-forward", "Do not deliver the downstream frames to idle ONUs (values: 0, 1)", idle_fast_forward);
+  cmd.AddValue ("header", "Print the column names before the result row (values: 0, 1)", header);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (tconts_per_onu < 1 || tconts_per_onu > 4, "tconts-per-onu must be between 1 and 4");
+
+  std::string xgponDba = "ns3::XgponOltDbaEngine";
+  xgponDba.append(upstream_dba);
+
+  //the same aggregate QoS parameters as xgpon-dba-udp-example, shared evenly by the ONUs.
+  double max_bandwidth = XGPON_UPSTREAM_CAPACITY;
+  uint32_t siValue = 1;
+
+  Config::SetDefault ("ns3::XgponChannel::BatchUpstreamBursts", BooleanValue (batch_us_bursts));
+  Config::SetDefault ("ns3::XgponChannel::IdleFastForward", BooleanValue (idle_fast_forward));
+  //at most 5ms of queueing at the ONU for its share of the capacity
+  uint64_t queueBytes = (uint64_t) (max_bandwidth * 1e9 / 8 * 0.005 / nOnus);
+  Config::SetDefault ("ns3::XgponQueue::MaxBytes", UintegerValue (std::max (queueBytes, (uint64_t) 10 * packet_size)));
+
+  XgponHelper xgponHelper;
+  XgponConfigDb& xgponConfigDb = xgponHelper.GetConfigDb ( );
+  xgponConfigDb.SetOltNetmaskLen (8);
+  xgponConfigDb.SetOnuNetmaskLen (24);
+  xgponConfigDb.SetIpAddressFirstByteForXgpon (10);
+  xgponConfigDb.SetIpAddressFirstByteForOnus (173);
+  xgponConfigDb.SetAllocateIds4Speed (true);
+  xgponConfigDb.SetOltDbaEngineTypeIdStr (xgponDba); 
+  xgponHelper.InitializeObjectFactories ( );
+
+  NodeContainer xgponNodes;
+  xgponNodes.Create (nOnus + 1);   //0: olt; i (>0): onu
+  NetDeviceContainer xgponDevices = xgponHelper.Install (xgponNodes);
+
+  InternetStackHelper stack;
+  stack.Install (xgponNodes);
+
+  Ipv4AddressHelper addressHelper;
+  addressHelper.SetBase (xgponHelper.GetXgponIpAddressBase ( ).c_str(), xgponHelper.GetOltAddressNetmask ( ).c_str());
+  Ipv4InterfaceContainer xgponInterfaces = addressHelper.Assign (xgponDevices);
+  for(uint32_t i=0; i<(nOnus+1); i++)
+  {
+    Ptr<XgponNetDevice> tmpDevice = DynamicCast<XgponNetDevice, NetDevice> (xgponDevices.Get(i));
+    tmpDevice->SetAddress (xgponInterfaces.GetAddress(i));
+  }
+
+  //the T-CONT types in use: T1 (fixed bandwidth, not configured here) is the first one to be left out.
+  uint8_t firstType = 5 - tconts_per_onu;
+
+  xgponHelper.SetQosParametersAttribute ("FixedBandwidth", UintegerValue (0));
+  xgponHelper.SetQosParametersAttribute ("AssuredBandwidth", UintegerValue ((uint64_t)(0.7*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("NonAssuredBandwidth", UintegerValue ((uint64_t)(0.8*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("BestEffortBandwidth", UintegerValue ((uint64_t)(0.67*max_bandwidth*1e9) / nOnus));
+  xgponHelper.SetQosParametersAttribute ("MaxServiceInterval", UintegerValue (siValue));
+  xgponHelper.SetQosParametersAttribute ("MinServiceInterval", UintegerValue (2*siValue));
+
+  //every ONU gets one T-CONT (with one upstream xgem-port at the address of the ONU) per type in use
+  XgponServiceProfile serviceProfile;
+  for(uint8_t tcont=firstType; tcont<=4; tcont++)
+  {
+    serviceProfile.AddTcont (static_cast<XgponQosParameters::XgponTcontType>(tcont), 1);
+  }
+  xgponHelper.ProvisionOnus (xgponDevices, serviceProfile);
+
+  //one sink per T-CONT type at the OLT node; one source per ONU and T-CONT type in use.
+  ApplicationContainer sinkApps;
+  for(uint8_t p=firstType; p<=4; p++)
+  {
+    PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), SINK_BASE_PORT + p));
+    sinkApps.Add (sink.Install (xgponNodes.Get(0)));
+  }
+  sinkApps.Start (Seconds (0.000001));
+  sinkApps.Stop (Seconds (sim_time + 0.1));
+
+  //the ONU picks the upstream connection from the TOS field: TOS n selects the n-th T-CONT added to this ONU.
+  double perAppRate = load * max_bandwidth * 1e9 / (nOnus * tconts_per_onu);  //unit: bps
+  for(uint32_t i=0; i<nOnus; i++)
+  {
+    for(uint8_t p=firstType; p<=4; p++)
+    {
+      InetSocketAddress dest = InetSocketAddress (xgponInterfaces.GetAddress(0), SINK_BASE_PORT + p);
+      dest.SetTos (p - firstType + 1);
+
+      OnOffHelper onOff ("ns3::UdpSocketFactory", dest);
+      onOff.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0]"));
+      onOff.SetAttribute ("OnTime", StringValue ("ns3::ConstantRandomVariable[Constant=1]"));
+      onOff.SetAttribute ("DataRate", DataRateValue (DataRate ((uint64_t) perAppRate)));
+      onOff.SetAttribute ("PacketSize", UintegerValue (packet_size));
+      onOff.SetAttribute ("MaxBytes", UintegerValue (0));
+      ApplicationContainer sourceApp = onOff.Install (xgponNodes.Get(i+1));
+      sourceApp.Start (Seconds (0.005));
+      sourceApp.Stop (Seconds (sim_time));
+    }
+  }
+
+  Simulator::Stop (Seconds (sim_time + 0.2));
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Simulator::Run ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  double wallSeconds = std::chrono::duration<double> (end - start).count();
+  double simSeconds = Simulator::Now().GetSeconds();
+  uint64_t events = Simulator::GetEventCount ();
+
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);   //ru_maxrss is in kilobytes on Linux
+
+  uint64_t rxBytes = 0;
+  for(uint32_t i=0; i<sinkApps.GetN(); i++)
+  {
+    rxBytes += DynamicCast<PacketSink> (sinkApps.Get(i))->GetTotalRx ();
+  }
+
+  if(header)
+  {
+    std::cout << "onus,tconts-per-onu,dba,load,packet-size,sim-seconds,events,wall-seconds,events-per-second,"
+              << "wall-seconds-per-sim-second,peak-rss-kb,rx-mbps" << std::endl;
+  }
+  std::cout << nOnus << "," << tconts_per_onu << "," << upstream_dba << "," << load << "," << packet_size << ","
+            << simSeconds << "," << events << "," << wallSeconds << "," << (wallSeconds > 0 ? events / wallSeconds : 0) << ","
+            << (simSeconds > 0 ? wallSeconds / simSeconds : 0) << "," << usage.ru_maxrss << ","
+            << (rxBytes * 8 / (sim_time * 1e6)) << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
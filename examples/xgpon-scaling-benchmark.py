@@ -0,0 +1,88 @@
+#! /usr/bin/env python3
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+
+# Sweeps the configurations of xgpon-scaling-benchmark and collects its result rows into one CSV table.
+# Run it from the top directory of ns-3 after the module (with examples) has been built, e.g.,
+#
+#     ./src/xgpon/examples/xgpon-scaling-benchmark.py --onus 8,64,512 --dbas XgiantDeficit --output scaling.csv
+#
+# The table has one row per run: onus, tconts-per-onu, dba, load, packet-size, sim-seconds, events, wall-seconds,
+# events-per-second, wall-seconds-per-sim-second, peak-rss-kb and rx-mbps, followed by the git commit of the module,
+# so that the tables produced at different commits can be compared.
+
+import argparse
+import itertools
+import os
+import subprocess
+import sys
+
+ALL_DBAS = 'RoundRobin,Giant,Xgiant,XgiantDeficit,XgiantProp,Ebu'
+ALL_ONUS = '8,16,32,64,128,256,512,1024'
+
+
+def parse_list(text, convert):
+    return [convert(x) for x in text.split(',') if x]
+
+
+def module_commit():
+    here = os.path.dirname(os.path.abspath(__file__))
+    try:
+        return subprocess.check_output(['git', 'rev-parse', '--short', 'HEAD'], cwd=here,
+                                       stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def run_one(args, onus, tconts, dba, load, size):
+    program = ('xgpon-scaling-benchmark --onus=%d --tconts-per-onu=%d --dba=%s --load=%s --packet-size=%d '
+               '--sim-time=%s --batch-us-bursts=%d --idle-fast-forward=%d --header=1'
+               % (onus, tconts, dba, load, size, args.sim_time, args.batch_us_bursts, args.idle_fast_forward))
+    command = [args.waf, '--run-no-build', program]
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    if result.returncode != 0:
+        sys.stderr.write('failed: %s\n%s\n' % (program, result.stderr))
+        return None, None
+
+    # the last two lines of the program output are the column names and the result row.
+    lines = [l for l in result.stdout.splitlines() if l.strip()]
+    return lines[-2], lines[-1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Sweep xgpon-scaling-benchmark and write one CSV table.')
+    parser.add_argument('--waf', default='./waf', help='the waf script of ns-3')
+    parser.add_argument('--onus', default=ALL_ONUS, help='comma separated numbers of ONUs')
+    parser.add_argument('--tconts', default='3', help='comma separated numbers of T-CONTs per ONU (1...4)')
+    parser.add_argument('--dbas', default=ALL_DBAS, help='comma separated DBA mechanisms')
+    parser.add_argument('--loads', default='0.8', help='comma separated offered loads (fraction of the upstream capacity)')
+    parser.add_argument('--packet-sizes', default='1447', help='comma separated UDP payload sizes (byte)')
+    parser.add_argument('--sim-time', default='1.0', help='simulated time with traffic (second)')
+    parser.add_argument('--batch-us-bursts', type=int, default=0)
+    parser.add_argument('--idle-fast-forward', type=int, default=0)
+    parser.add_argument('--output', default='-', help='the CSV file to write; - for stdout')
+    args = parser.parse_args()
+
+    subprocess.check_call([args.waf, 'build'], stdout=subprocess.DEVNULL)
+
+    out = sys.stdout if args.output == '-' else open(args.output, 'w')
+    commit = module_commit()
+    header_written = False
+
+    sweep = itertools.product(parse_list(args.onus, int), parse_list(args.tconts, int), parse_list(args.dbas, str),
+                              parse_list(args.loads, str), parse_list(args.packet_sizes, int))
+    for onus, tconts, dba, load, size in sweep:
+        header, row = run_one(args, onus, tconts, dba, load, size)
+        if row is None:
+            continue
+        if not header_written:
+            out.write(header + ',commit\n')
+            header_written = True
+        out.write(row + ',' + commit + '\n')
+        out.flush()
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Jerome A Arokkiam
+ * Co-Authors in earlier versions of the code: Xiuchao Wu, Pedro Alvarez
+ */
+
+/**********************************************************************
+* This program checks the upstream classification rules of one ONU (XgponHelper::AddUsClassificationRuleForOnu).
+*
+* The ONU has one T-CONT of each type. One rule sends the TCP/UDP packets to one destination port through the T4 T-CONT,
+* and another one sends the packets with DSCP 46 through the T1 T-CONT. IPv4 packets of several flows are given to the ONU
+* (XgponOnuNetDevice::Send) and the queue of each upstream connection is checked after every packet: the matching rule
+* must win, and the packets that match no rule must still be mapped through their TOS. The ports are read from the bytes
+* after the IPv4 header, so the ICMP packets and the later fragments whose bytes look like the rule port must not match.
+*
+* Every flow is sent several times, so that its later packets are classified through the flow cache. Then one more rule
+* (the source port of one unmatched flow, through the T3 T-CONT) is added, which must clear the cache: that flow must move
+* to the new rule while the other flows keep their connections.
+*
+* No simulation is run; the packets stay in the queues. The program returns 1 if any packet takes the wrong connection.
+**************************************************************/
+
+#include <iostream>
+#include <cstring>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include "ns3/xgpon-helper.h"
+#include "ns3/xgpon-config-db.h"
+#include "ns3/xgpon-service-profile.h"
+#include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-us-classifier.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("xgpon-us-classifier-check");
+
+static const uint16_t RULE_PORT = 5001;                //destination port of the port rule (T4)
+static const uint8_t RULE_DSCP = 46;                   //DSCP of the DSCP rule (T1)
+static const uint16_t LATER_RULE_PORT = 7001;          //source port of the rule added at the end (T3)
+static const uint32_t PAYLOAD_SIZE = 100;              // unit: byte; the first 4 bytes hold the TCP/UDP ports
+
+
+//one flow given to the ONU and the T-CONT type whose connection should carry it
+class TestFlow
+{
+public:
+  const char* m_name;
+  uint8_t m_protocol;
+  uint8_t m_tos;
+  uint16_t m_srcPort;
+  uint16_t m_dstPort;
+  bool m_laterFragment;
+  uint8_t m_tcont;                      //before the last rule is added
+  uint8_t m_tcontWithLaterRule;         //after the last rule is added
+};
+
+static const TestFlow FLOWS[] = {
+  { "UDP to the rule port, TOS 2",                         17, 2,    6000, RULE_PORT, false, 4, 4 },
+  { "TCP to the rule port, TOS 3",                         6,  3,    6001, RULE_PORT, false, 4, 4 },
+  { "UDP with DSCP 46",                                    17, 0xB8, 6002, 5002,      false, 1, 1 },
+  { "UDP with DSCP 46 and ECN bits",                       17, 0xBA, 6003, 5002,      false, 1, 1 },
+  { "UDP with DSCP 46 to the rule port (first rule wins)", 17, 0xB8, 6004, RULE_PORT, false, 4, 4 },
+  { "UDP matching no rule, TOS 2",                         17, 2,    6005, 5002,      false, 2, 2 },
+  { "UDP matching no rule, TOS 3",                         17, 3,    6006, 5002,      false, 3, 3 },
+  { "UDP from the port of the later rule, TOS 2",          17, 2,    LATER_RULE_PORT, 5002, false, 2, 3 },
+  { "ICMP with the rule port in its payload, TOS 2",       1,  2,    6007, RULE_PORT, false, 2, 2 },
+  { "later fragment of UDP to the rule port, TOS 3",       17, 3,    6008, RULE_PORT, true,  3, 3 },
+};
+static const uint32_t N_FLOWS = sizeof (FLOWS) / sizeof (FLOWS[0]);
+
+
+static Ptr<Packet>
+CreateFlowPacket (const TestFlow& flow, const Ipv4Address& src, const Ipv4Address& dst)
+{
+  uint8_t payload[PAYLOAD_SIZE];
+  memset (payload, 0, PAYLOAD_SIZE);
+  payload[0] = flow.m_srcPort >> 8;
+  payload[1] = flow.m_srcPort & 0xFF;
+  payload[2] = flow.m_dstPort >> 8;
+  payload[3] = flow.m_dstPort & 0xFF;
+  Ptr<Packet> packet = Create<Packet> (payload, PAYLOAD_SIZE);
+
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (src);
+  ipHeader.SetDestination (dst);
+  ipHeader.SetProtocol (flow.m_protocol);
+  ipHeader.SetTos (flow.m_tos);
+  ipHeader.SetTtl (64);
+  ipHeader.SetPayloadSize (PAYLOAD_SIZE);
+  if(flow.m_laterFragment) ipHeader.SetFragmentOffset (PAYLOAD_SIZE / 8 * 8);
+  packet->AddHeader (ipHeader);
+  return packet;
+}
+
+//send one packet of the flow and check that only the queue of the expected connection grows.
+//conns: index == T-CONT type (0 is not used)
+static bool
+SendAndCheck (const Ptr<XgponOnuNetDevice>& onuDevice, const std::vector< Ptr<XgponConnectionSender> >& conns,
+              const TestFlow& flow, uint8_t expectedTcont, const Ipv4Address& src, const Ipv4Address& dst)
+{
+  std::vector<uint32_t> before (conns.size (), 0);
+  for(uint32_t i=1; i<conns.size(); i++) before[i] = conns[i]->GetQueueStatus ( );
+
+  if(!onuDevice->Send (CreateFlowPacket (flow, src, dst), dst, 0x0800))
+  {
+    std::cout << flow.m_name << ": the packet is not accepted by the ONU" << std::endl;
+    return false;
+  }
+
+  bool passed = true;
+  for(uint32_t i=1; i<conns.size(); i++)
+  {
+    bool grown = conns[i]->GetQueueStatus ( ) > before[i];
+    if(grown != (i == expectedTcont))
+    {
+      std::cout << flow.m_name << ": " << (grown ? "carried" : "not carried") << " by the T" << i << " T-CONT, T"
+                << (uint32_t) expectedTcont << " expected" << std::endl;
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nRounds = 3;            //packets of each flow before and after the last rule is added
+
+  CommandLine cmd;
+  cmd.AddValue ("rounds", "Number of packets of each flow before and after the last rule is added", nRounds);
+  cmd.Parse (argc, argv);
+
+  XgponHelper xgponHelper;
+  XgponConfigDb& xgponConfigDb = xgponHelper.GetConfigDb ( );
+  xgponConfigDb.SetOltNetmaskLen (8);
+  xgponConfigDb.SetOnuNetmaskLen (24);
+  xgponConfigDb.SetIpAddressFirstByteForXgpon (10);
+  xgponConfigDb.SetIpAddressFirstByteForOnus (173);
+  xgponConfigDb.SetAllocateIds4Speed (true);
+  xgponHelper.InitializeObjectFactories ( );
+
+  NodeContainer xgponNodes;
+  xgponNodes.Create (2);   //0: olt; 1: onu
+  NetDeviceContainer xgponDevices = xgponHelper.Install (xgponNodes);
+
+  InternetStackHelper stack;
+  stack.Install (xgponNodes);
+
+  Ipv4AddressHelper addressHelper;
+  addressHelper.SetBase (xgponHelper.GetXgponIpAddressBase ( ).c_str(), xgponHelper.GetOltAddressNetmask ( ).c_str());
+  Ipv4InterfaceContainer xgponInterfaces = addressHelper.Assign (xgponDevices);
+  for(uint32_t i=0; i<2; i++)
+  {
+    Ptr<XgponNetDevice> tmpDevice = DynamicCast<XgponNetDevice, NetDevice> (xgponDevices.Get(i));
+    tmpDevice->SetAddress (xgponInterfaces.GetAddress(i));
+  }
+
+  XgponServiceProfile serviceProfile;
+  for(uint8_t tcont=1; tcont<=4; tcont++)
+  {
+    serviceProfile.AddTcont (static_cast<XgponQosParameters::XgponTcontType>(tcont), 1);
+  }
+  serviceProfile.SetNDsConns (1);
+  xgponHelper.ProvisionOnus (xgponDevices, serviceProfile);
+
+  Ptr<XgponOnuNetDevice> onuDevice = DynamicCast<XgponOnuNetDevice, NetDevice> (xgponDevices.Get(1));
+  std::vector< Ptr<XgponConnectionSender> > conns (5);
+  for(uint8_t tcont=1; tcont<=4; tcont++)
+  {
+    conns[tcont] = onuDevice->GetConnManager ( )->FindUsConnByTcontType (tcont);
+    NS_ABORT_MSG_IF ((conns[tcont] == 0), "The ONU has no upstream connection for one T-CONT type");
+  }
+
+  XgponUsClassifier::Rule portRule;
+  portRule.MatchDestinationPort (RULE_PORT);
+  xgponHelper.AddUsClassificationRuleForOnu (onuDevice, portRule, conns[4]->GetXgemPort ( ));
+  XgponUsClassifier::Rule dscpRule;
+  dscpRule.MatchDscp (RULE_DSCP);
+  xgponHelper.AddUsClassificationRuleForOnu (onuDevice, dscpRule, conns[1]->GetXgemPort ( ));
+
+  Ipv4Address src = xgponInterfaces.GetAddress(1);
+  Ipv4Address dst = xgponInterfaces.GetAddress(0);
+
+  bool passed = true;
+  for(uint32_t r=0; r<nRounds; r++)
+  {
+    for(uint32_t i=0; i<N_FLOWS; i++) passed = SendAndCheck (onuDevice, conns, FLOWS[i], FLOWS[i].m_tcont, src, dst) && passed;
+  }
+  std::cout << "Two rules: " << (passed ? "PASSED" : "FAILED") << std::endl;
+
+  //the flows classified so far are in the cache; the new rule must take over the flow from its source port.
+  XgponUsClassifier::Rule laterRule;
+  laterRule.MatchSourcePort (LATER_RULE_PORT);
+  xgponHelper.AddUsClassificationRuleForOnu (onuDevice, laterRule, conns[3]->GetXgemPort ( ));
+
+  bool passedWithLaterRule = true;
+  for(uint32_t r=0; r<nRounds; r++)
+  {
+    for(uint32_t i=0; i<N_FLOWS; i++)
+    {
+      passedWithLaterRule = SendAndCheck (onuDevice, conns, FLOWS[i], FLOWS[i].m_tcontWithLaterRule, src, dst) && passedWithLaterRule;
+    }
+  }
+  std::cout << "Rule added after the flows are cached: " << (passedWithLaterRule ? "PASSED" : "FAILED") << std::endl;
+
+  Simulator::Destroy ();
+
+  return (passed && passedWithLaterRule) ? 0 : 1;
+}
@@ -19,6 +19,8 @@
  * Author: Xiuchao Wu <xw2@cs.ucc.ie>
  */
 
+#include <cmath>
+
 #include "xgpon-config-db.h"
 
 #include "ns3/xgpon-burst-profile.h"
@@ -37,6 +39,8 @@ XgponConfigDb::XgponConfigDb()
   
   m_onuUsSchedulerTypeIdStr = DEFAULT_XGPON_ONU_US_SCHEDULER_TYPEID_STR;
 
+  m_staticEngines = false;
+
   m_profilePreambleLen = XgponBurstProfile::PSBU_PREAMBLE_DEFAULT_LEN;
   m_profileDelimiterLen = XgponBurstProfile::PSBU_DELIMITER_DEFAULT_LEN;
   m_profileFec = true;
@@ -52,6 +56,9 @@ XgponConfigDb::XgponConfigDb()
 
   m_addressFirstByteXgpon = DEFAULT_IP_ADDRESS_FIRST_BYTE_XGPON;
   m_addressFirstByteOnus = DEFAULT_IP_ADDRESS_FIRST_BYTE_ONUS;
+
+  m_odnSplitterDistances.push_back (0);
+  m_odnDistanceResolution = DEFAULT_ODN_DISTANCE_RESOLUTION;
 }
 
 XgponConfigDb::~XgponConfigDb()
@@ -105,6 +112,12 @@ XgponConfigDb::SetOnuUsSchedulerTypeIdStr (std::string typeId)
   m_onuUsSchedulerTypeIdStr = typeId;
 }
 
+void 
+XgponConfigDb::SetStaticEngines (bool staticEngines)
+{
+  m_staticEngines = staticEngines;
+}
+
 void 
 XgponConfigDb::SetProfilePreambleLen (uint16_t len)
 {
@@ -154,5 +167,54 @@ XgponConfigDb::SetIpAddressFirstByteForOnus (uint8_t firstByte)
   m_addressFirstByteOnus = firstByte;
 }
 
+
+
+
+
+void 
+XgponConfigDb::SetOnuDistance (uint32_t onuIndex, double distance)
+{
+  NS_ASSERT_MSG((distance > 0), "The fibre distance of one ONU must be positive!!!");
+  m_onuDistances[onuIndex] = distance;
+}
+
+uint32_t 
+XgponConfigDb::AddOdnSplitter (uint32_t parent, double fibreLength)
+{
+  NS_ASSERT_MSG((parent < m_odnSplitterDistances.size()), "The parent splitter has not been added yet!!!");
+  NS_ASSERT_MSG((fibreLength >= 0), "The fibre length cannot be negative!!!");
+
+  m_odnSplitterDistances.push_back (m_odnSplitterDistances[parent] + fibreLength);
+  return m_odnSplitterDistances.size() - 1;
+}
+
+void 
+XgponConfigDb::AttachOnuToOdnSplitter (uint32_t onuIndex, uint32_t splitter, double dropLength)
+{
+  NS_ASSERT_MSG((splitter < m_odnSplitterDistances.size()), "The splitter has not been added yet!!!");
+  SetOnuDistance (onuIndex, m_odnSplitterDistances[splitter] + dropLength);
+}
+
+void 
+XgponConfigDb::SetOdnDistanceResolution (double resolution)
+{
+  NS_ASSERT_MSG((resolution > 0), "The distance resolution must be positive!!!");
+  m_odnDistanceResolution = resolution;
+}
+
+double 
+XgponConfigDb::GetOnuDistance (uint32_t onuIndex) const
+{
+  std::map<uint32_t, double>::const_iterator it = m_onuDistances.find (onuIndex);
+  if(it == m_onuDistances.end()) return 0;
+
+  double distance = std::floor (it->second / m_odnDistanceResolution + 0.5) * m_odnDistanceResolution;
+  if(distance < m_odnDistanceResolution) distance = m_odnDistanceResolution;
+  return distance;
+}
+
+
+
+
 }//namespace ns3
 
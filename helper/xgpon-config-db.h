@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <string>
 #include <map>
+#include <vector>
 
 #define DEFAULT_XGPON_OLT_DBA_ENGINE_TYPEID_STR          "ns3::XgponOltDbaEngineRoundRobin"
 #define DEFAULT_XGPON_OLT_DS_SCHEDULER_TYPEID_STR        "ns3::XgponOltDsSchedulerRoundRobin"
@@ -45,6 +46,8 @@
 #define DEFAULT_IP_ADDRESS_FIRST_BYTE_XGPON              10   //"10.0.*.*"
 #define DEFAULT_IP_ADDRESS_FIRST_BYTE_ONUS               172  //"172.onuid.*"
 
+#define DEFAULT_ODN_DISTANCE_RESOLUTION                  1.0  //unit: meter
+
 
 
 
@@ -78,6 +81,12 @@ public:
 
   void SetOnuUsSchedulerTypeIdStr (std::string typeId);
 
+  /**
+   * \brief compose the OLT and ONU devices with their engines at compile time (XgponOltNetDeviceStatic and XgponOnuNetDeviceStatic).
+   *        Only takes effect for the round-robin schedulers; other configurations fall back to the normal devices.
+   */
+  void SetStaticEngines (bool staticEngines);
+
   void SetProfilePreambleLen (uint16_t len);
   void SetProfileDelimiterLen (uint16_t len);
   void SetProfileFec (bool fec);
@@ -99,6 +108,40 @@ public:
   
 
 
+  ////////////////////////////////////Optical distribution network (ODN). All lengths are in meter.
+  //ONUs without distance are placed at the logic one way delay of the channel (the delay used when no ODN is described).
+  //ONU index: the order of the ONU node in the NodeContainer passed to XgponHelper::Install (the first ONU: 0)
+
+  /**
+   * \brief set the fibre distance between the OLT and one ONU directly.
+   */
+  void SetOnuDistance (uint32_t onuIndex, double distance);
+
+  /**
+   * \brief add one passive splitter into the splitter tree. The OLT is the root of the tree (splitter 0).
+   * \param parent the splitter (or 0 for the OLT) that the fibre of this splitter comes from
+   * \param fibreLength the length of the fibre between the parent and this splitter
+   * \return the index of the new splitter
+   */
+  uint32_t AddOdnSplitter (uint32_t parent, double fibreLength);
+
+  /**
+   * \brief connect one ONU to one splitter of the tree through its drop fibre.
+   */
+  void AttachOnuToOdnSplitter (uint32_t onuIndex, uint32_t splitter, double dropLength);
+
+  /**
+   * \brief distances are rounded to this resolution. ONUs with the same rounded distance share one delivery event in downstream.
+   */
+  void SetOdnDistanceResolution (double resolution);
+
+  /**
+   * \return the fibre distance (rounded to the resolution) between the OLT and one ONU; 0: not described.
+   */
+  double GetOnuDistance (uint32_t onuIndex) const;
+
+
+
 
 private:
 
@@ -113,6 +156,8 @@ private:
 
   std::string m_onuUsSchedulerTypeIdStr;              //Type Id string of the per Alloc-ID us scheduler used by the ONU
 
+  bool m_staticEngines;                               //whether the devices are composed with their engines at compile time
+
   uint16_t m_profilePreambleLen;                      //burst profile parameters
   uint16_t m_profileDelimiterLen;
   bool m_profileFec;
@@ -130,6 +175,10 @@ private:
   uint16_t m_addressFirstByteXgpon;                    //First byte of the IP address for Xgpon network (Olt + Onus).
   uint16_t m_addressFirstByteOnus;                     //First byte of the IP address for networks connected to the Internet through ONUs. (FirstByte.onu_id.computer)
 
+  std::vector<double> m_odnSplitterDistances;          //fibre distance between the OLT and each splitter (index 0: the OLT itself)
+  std::map<uint32_t, double> m_onuDistances;           //fibre distance between the OLT and each described ONU (key: ONU index)
+  double m_odnDistanceResolution;
+
 };
 
 
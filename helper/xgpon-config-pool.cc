@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+#include "ns3/assert.h"
+
+#include "xgpon-config-pool.h"
+
+
+namespace ns3 {
+
+XgponConfigPool::XgponConfigPool()
+{
+}
+
+XgponConfigPool::~XgponConfigPool()
+{
+}
+
+
+
+
+const Ptr<XgponPhy>& 
+XgponConfigPool::GetPhy (void)
+{
+  if(m_phy == 0) { m_phy = CreateObject<XgponPhy> (); }
+  return m_phy;
+}
+
+void 
+XgponConfigPool::ResetPhy (void)
+{
+  m_phy = 0;
+}
+
+
+const Ptr<XgponKey>& 
+XgponConfigPool::GetKey (void)
+{
+  if(m_key == 0) { m_key = CreateObject<XgponKey> (); }
+  return m_key;
+}
+
+
+const Ptr<XgponBurstProfile>& 
+XgponConfigPool::GetBurstProfile (uint8_t preambleLen, uint8_t delimiterLen, bool fec)
+{
+  //only a few different profiles are used in one network.
+  for(uint32_t i=0; i<m_profiles.size(); i++)
+  {
+    const Ptr<XgponBurstProfile>& profile = m_profiles[i];
+    if(profile->GetPreambleLen () == preambleLen && profile->GetDelimiterLen () == delimiterLen && profile->GetFec () == fec)
+      return profile;
+  }
+
+  Ptr<XgponBurstProfile> profile = CreateObject<XgponBurstProfile> ();
+  profile->SetPreambleLen (preambleLen);
+  profile->SetDelimiterLen (delimiterLen);
+  profile->SetFec (fec);
+  m_profiles.push_back (profile);
+
+  return m_profiles.back ();
+}
+
+
+const Ptr<XgponQosParameters>& 
+XgponConfigPool::GetQosParameters (const ObjectFactory& factory)
+{
+  //the factory is called every time: the result depends on the factory passed and on the default attributes (Config::SetDefault).
+  Ptr<XgponQosParameters> qosParameters = factory.Create<XgponQosParameters> ();
+  for(uint32_t i=0; i<m_qosParameters.size(); i++)
+  {
+    if(m_qosParameters[i]->GetInstanceTypeId () == qosParameters->GetInstanceTypeId () && m_qosParameters[i]->HasSameValues (qosParameters))
+      return m_qosParameters[i];
+  }
+
+  m_qosParameters.push_back (qosParameters);
+  return m_qosParameters.back ();
+}
+
+uint32_t 
+XgponConfigPool::GetNumberOfBurstProfiles (void) const
+{
+  return m_profiles.size ();
+}
+
+uint32_t 
+XgponConfigPool::GetNumberOfQosParameters (void) const
+{
+  return m_qosParameters.size ();
+}
+
+
+
+
+}//namespace ns3
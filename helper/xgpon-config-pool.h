@@ -0,0 +1,108 @@
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_CONFIG_POOL_H
+#define XGPON_CONFIG_POOL_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ptr.h"
+#include "ns3/object-factory.h"
+
+#include "ns3/xgpon-phy.h"
+#include "ns3/xgpon-key.h"
+#include "ns3/xgpon-burst-profile.h"
+#include "ns3/xgpon-qos-parameters.h"
+
+namespace ns3 {
+
+
+
+/**
+ * \brief the immutable configuration objects (PHY parameters, keys, burst profiles and QoS parameters) shared by the devices
+ *        created by one XgponHelper. Objects with the same values are created once and handed to every ONU (and to the OLT)
+ *        instead of one copy per ONU or per connection.
+ *
+ * The objects returned must not be changed in place. A link switches to another burst profile by taking another pooled
+ * profile (XgponHelper::SetBurstProfileForOnu); QoS parameters are replaced as a whole (SetQosParameters).
+ */
+class XgponConfigPool
+{
+public:
+  /**
+   * \brief constructor
+   */
+  XgponConfigPool ();
+  virtual ~XgponConfigPool ();
+
+
+  /**
+   * \brief the PHY parameters shared by the OLT and all ONUs. Created from the default attributes when first asked for.
+   */
+  const Ptr<XgponPhy>& GetPhy (void);
+
+  /**
+   * \brief forget the PHY parameters so that the devices created later see the new default attributes.
+   */
+  void ResetPhy (void);
+
+
+  /**
+   * \brief the key shared by all links (XgponKey is a stub without key material).
+   */
+  const Ptr<XgponKey>& GetKey (void);
+
+
+  /**
+   * \brief the burst profile with these parameters; created if no such profile is in the pool.
+   */
+  const Ptr<XgponBurstProfile>& GetBurstProfile (uint8_t preambleLen, uint8_t delimiterLen, bool fec);
+
+
+  /**
+   * \brief the QoS parameters produced by the factory (with its attributes and the current default attributes), merged
+   *        with the QoS parameters already in the pool that have the same class and values.
+   */
+  const Ptr<XgponQosParameters>& GetQosParameters (const ObjectFactory& factory);
+
+
+  //the number of distinct objects in the pool (for checking how much is shared)
+  uint32_t GetNumberOfBurstProfiles (void) const;
+  uint32_t GetNumberOfQosParameters (void) const;
+
+
+private:
+  Ptr<XgponPhy> m_phy;
+  Ptr<XgponKey> m_key;
+
+  std::vector< Ptr<XgponBurstProfile> > m_profiles;
+
+  std::vector< Ptr<XgponQosParameters> > m_qosParameters;
+};
+
+
+
+
+
+}//namespace ns3
+
+#endif /* XGPON_CONFIG_POOL_H */
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+#include <stdint.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <set>
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/ipv4-address.h"
+
+#include "ns3/xgpon-channel.h"
+#include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-xgtc-dbru.h"
+#include "ns3/xgpon-xgtc-bw-allocation.h"
+
+#include "xgpon-dba-harness.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponDbaHarness");
+
+namespace ns3 {
+
+XgponDbaHarness::XgponDbaHarness () : m_replayTrace(false), m_load(0.5), m_meanArrival(0),
+  m_slotSize(0), m_rtt(0), m_usFrameSize(0), m_extraInLastBwmap(0)
+{
+  m_arrivalVariable = CreateObject<UniformRandomVariable> ();
+
+  m_result.m_bwmaps = 0;
+  m_result.m_allocations = 0;
+  m_result.m_grantedWords = 0;
+  m_result.m_totalNanoseconds = 0;
+  m_result.m_minNanoseconds = 0;
+  m_result.m_maxNanoseconds = 0;
+  m_result.m_violations = 0;
+}
+XgponDbaHarness::~XgponDbaHarness ()
+{
+}
+
+
+
+
+void 
+XgponDbaHarness::Setup (uint32_t nOnus, uint32_t tcontsPerOnu)
+{
+  NS_LOG_FUNCTION (this << nOnus << tcontsPerOnu);
+  NS_ASSERT_MSG((m_olt == 0), "The harness has already been set up!!!");
+
+  m_helper.InitializeObjectFactories ( );
+  NetDeviceContainer devices = m_helper.InstallWithoutNodes (nOnus);
+
+  m_olt = DynamicCast<XgponOltNetDevice, NetDevice> (devices.Get(0));
+  m_dbaEngine = m_olt->GetDbaEngine ( );
+
+  for(uint32_t i=0; i<nOnus; i++)
+  {
+    Ptr<XgponOnuNetDevice> onu = DynamicCast<XgponOnuNetDevice, NetDevice> (devices.Get(i+1));
+
+    //the address is only used to identify the upstream connections of this ONU.
+    Ipv4Address addr ((10 << 24) + ((i + 1) << 8) + 1);
+    for(uint32_t j=0; j<tcontsPerOnu; j++)
+    {
+      XgponQosParameters::XgponTcontType type = static_cast<XgponQosParameters::XgponTcontType>((j % 4) + 1);
+      uint16_t allocId = m_helper.AddOneTcontForOnu (onu, m_olt, type);
+      m_helper.AddOneUpstreamConnectionForOnu (onu, m_olt, allocId, addr);
+
+      m_tcontIndexes[allocId] = m_allocIds.size();
+      m_allocIds.push_back (allocId);
+      m_onuIds.push_back (onu->GetOnuId());
+      m_backlogs.push_back (0);
+    }
+  }
+
+  const Ptr<XgponPhy>& phy = m_olt->GetXgponPhy ( );
+  m_slotSize = phy->GetDsFrameSlotSize ( );
+  m_usFrameSize = phy->GetUsPhyFrameSizeInWord ( );
+
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel> (m_olt->GetChannel());
+  m_rtt = 2 * channel->GetLogicOneWayDelay ( );
+}
+
+
+void 
+XgponDbaHarness::SetSyntheticLoad (double load)
+{
+  NS_ASSERT_MSG((load >= 0), "The offered load cannot be negative!!!");
+  m_load = load;
+}
+
+
+bool 
+XgponDbaHarness::LoadReportTrace (const std::string& fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  std::ifstream in (fileName.c_str());
+  if(!in.is_open()) return false;
+
+  std::string line;
+  while(std::getline (in, line))
+  {
+    if(line.empty() || line[0] == '#') continue;
+
+    std::replace (line.begin(), line.end(), ',', ' ');
+    std::istringstream fields (line);
+
+    PendingReport report;
+    uint32_t allocId;
+    if(!(fields >> report.m_time >> allocId >> report.m_bufOcc))
+    {
+      NS_LOG_WARN ("Ignore one malformed line of the report trace: " << line);
+      continue;
+    }
+    report.m_allocId = allocId;
+    m_pendingReports.push_back (report);
+  }
+
+  std::stable_sort (m_pendingReports.begin(), m_pendingReports.end(), &XgponDbaHarness::ReportEarlier);
+  m_replayTrace = true;
+  return true;
+}
+
+
+
+
+void 
+XgponDbaHarness::Run (uint32_t frames)
+{
+  NS_LOG_FUNCTION (this << frames);
+  NS_ASSERT_MSG((m_olt != 0), "Setup must be called before running the harness!!!");
+
+  if(frames == 0 || m_allocIds.empty()) return;
+
+  //unit: byte; an upstream frame carries m_usFrameSize words.
+  m_meanArrival = m_load * m_usFrameSize * 4 / m_allocIds.size();
+
+  //the first BWmap is produced one slot later, as the OLT does for its first downstream frame after start-up.
+  Simulator::Schedule (NanoSeconds(m_slotSize), &XgponDbaHarness::ProcessFrame, this, frames);
+  Simulator::Run ( );
+}
+
+
+
+void 
+XgponDbaHarness::ProcessFrame (uint32_t remainingFrames)
+{
+  NS_LOG_FUNCTION (this << remainingFrames);
+
+  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
+
+  DeliverReports (nowNano);
+
+  if(!m_replayTrace)
+  {
+    for(uint32_t i=0; i<m_backlogs.size(); i++)
+    {
+      m_backlogs[i] += (uint64_t) m_arrivalVariable->GetValue (0, 2 * m_meanArrival);
+    }
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const Ptr<XgponXgtcBwmap> bwmap = m_dbaEngine->GenerateBwMap ( );
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  uint64_t cost = std::chrono::duration_cast<std::chrono::nanoseconds> (end - start).count();
+  if(m_result.m_bwmaps == 0 || cost < m_result.m_minNanoseconds) m_result.m_minNanoseconds = cost;
+  if(cost > m_result.m_maxNanoseconds) m_result.m_maxNanoseconds = cost;
+  m_result.m_totalNanoseconds += cost;
+  m_result.m_bwmaps++;
+
+  ValidateBwmap (bwmap);
+  ServeBwmap (bwmap, nowNano);
+
+  m_dbaEngine->RemoveExpiredBwmaps (nowNano);
+
+  if(remainingFrames > 1)
+  {
+    Simulator::Schedule (NanoSeconds(m_slotSize), &XgponDbaHarness::ProcessFrame, this, remainingFrames - 1);
+  }
+}
+
+
+
+void 
+XgponDbaHarness::DeliverReports (uint64_t now)
+{
+  while(!m_pendingReports.empty() && m_pendingReports.front().m_time <= now)
+  {
+    const PendingReport& report = m_pendingReports.front();
+
+    std::map<uint16_t, uint32_t>::const_iterator it = m_tcontIndexes.find (report.m_allocId);
+    if(it != m_tcontIndexes.end())
+    {
+      Ptr<XgponXgtcDbru> dbru = Create<XgponXgtcDbru> (report.m_bufOcc);
+      dbru->CalculateCrc ( );
+      dbru->SetCreateTime (report.m_time);
+      m_dbaEngine->ReceiveStatusReport (dbru, m_onuIds[it->second], report.m_allocId, now);
+    }
+    else
+    {
+      NS_LOG_WARN ("Ignore one status report of an unknown alloc-id: " << report.m_allocId);
+    }
+
+    m_pendingReports.pop_front ();
+  }
+}
+
+
+
+
+void 
+XgponDbaHarness::ValidateBwmap (const Ptr<XgponXgtcBwmap>& bwmap)
+{
+  uint16_t num = bwmap->GetNumberOfBwAllocation ( );
+  m_result.m_allocations += num;
+
+  std::ostringstream prefix;
+  prefix << "BWmap " << m_result.m_bwmaps << ": ";
+
+  if(num > XgponOltDbaEngine::MAX_TCONT_PER_BWMAP) AddViolation (prefix.str() + "too many bandwidth allocations");
+  if(num == 0) 
+  {
+    m_extraInLastBwmap = 0;
+    return;
+  }
+  if(bwmap->GetBwAllocationByIndex(0).GetStartTime() == 0xFFFF) AddViolation (prefix.str() + "the first allocation does not start one burst");
+
+  std::set<uint16_t> allocIds;
+  std::set<uint16_t> burstOnus;
+  uint16_t burstOnu = 0;
+  uint32_t burstEnd = m_extraInLastBwmap;     //the earliest start of the next burst (overheads are not counted). unit: word
+
+  for(uint16_t i=0; i<num; i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex (i);
+    uint16_t allocId = bwAlloc.GetAllocId ( );
+    m_result.m_grantedWords += bwAlloc.GetGrantSize ( );
+
+    std::map<uint16_t, uint32_t>::const_iterator it = m_tcontIndexes.find (allocId);
+    if(it == m_tcontIndexes.end())
+    {
+      AddViolation (prefix.str() + "unknown alloc-id");
+      continue;
+    }
+    if(!allocIds.insert(allocId).second) AddViolation (prefix.str() + "the same alloc-id is granted twice");
+
+    uint16_t onuId = m_onuIds[it->second];
+    uint16_t startTime = bwAlloc.GetStartTime ( );
+    if(startTime != 0xFFFF)
+    {
+      if(startTime >= m_usFrameSize) AddViolation (prefix.str() + "StartTime beyond the upstream frame");
+      if(startTime < burstEnd) AddViolation (prefix.str() + "one burst overlaps the previous one");
+      if(!burstOnus.insert(onuId).second) AddViolation (prefix.str() + "one ONU is granted more than one burst");
+
+      burstOnu = onuId;
+      burstEnd = startTime;
+    }
+    else if(onuId != burstOnu) AddViolation (prefix.str() + "the allocations of one burst belong to different ONUs");
+
+    burstEnd += bwAlloc.GetGrantSize ( );
+  }
+
+  m_extraInLastBwmap = (burstEnd > m_usFrameSize) ? (burstEnd - m_usFrameSize) : 0;
+}
+
+
+
+void 
+XgponDbaHarness::ServeBwmap (const Ptr<XgponXgtcBwmap>& bwmap, uint64_t now)
+{
+  if(m_replayTrace) return;
+
+  uint16_t num = bwmap->GetNumberOfBwAllocation ( );
+  for(uint16_t i=0; i<num; i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex (i);
+    std::map<uint16_t, uint32_t>::const_iterator it = m_tcontIndexes.find (bwAlloc.GetAllocId());
+    if(it == m_tcontIndexes.end()) continue;
+
+    uint64_t& backlog = m_backlogs[it->second];
+    uint64_t granted = bwAlloc.GetGrantSize() * 4;
+    backlog = (backlog > granted) ? (backlog - granted) : 0;
+
+    //the report is carried by the burst and reaches the OLT after one round trip time.
+    if(bwAlloc.GetDbruFlag())
+    {
+      PendingReport report;
+      report.m_time = now + m_rtt;
+      report.m_allocId = bwAlloc.GetAllocId ( );
+      report.m_bufOcc = (uint32_t) std::min (backlog, (uint64_t) 0xFFFFFFFF);
+      m_pendingReports.push_back (report);
+    }
+  }
+}
+
+
+
+bool
+XgponDbaHarness::ReportEarlier (const PendingReport& a, const PendingReport& b)
+{
+  return a.m_time < b.m_time;
+}
+
+
+void 
+XgponDbaHarness::AddViolation (const std::string& message)
+{
+  m_result.m_violations++;
+  if(m_result.m_violationMessages.size() < MAX_VIOLATION_MESSAGES) m_result.m_violationMessages.push_back (message);
+  NS_LOG_WARN (message);
+}
+
+
+
+void 
+XgponDbaHarness::PrintSummary (std::ostream& os) const
+{
+  double mean = (m_result.m_bwmaps > 0) ? ((double) m_result.m_totalNanoseconds / m_result.m_bwmaps) : 0;
+
+  os << "tconts," << m_allocIds.size() 
+     << ",bwmaps," << m_result.m_bwmaps 
+     << ",allocations," << m_result.m_allocations 
+     << ",granted-words," << m_result.m_grantedWords << std::endl;
+  os << "ns-per-bwmap,mean," << mean 
+     << ",min," << m_result.m_minNanoseconds 
+     << ",max," << m_result.m_maxNanoseconds << std::endl;
+  os << "violations," << m_result.m_violations << std::endl;
+  for(uint32_t i=0; i<m_result.m_violationMessages.size(); i++)
+  {
+    os << "\t" << m_result.m_violationMessages[i] << std::endl;
+  }
+}
+
+
+
+}//namespace ns3
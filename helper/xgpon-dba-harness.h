@@ -0,0 +1,180 @@
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_DBA_HARNESS_H
+#define XGPON_DBA_HARNESS_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <ostream>
+
+#include "ns3/random-variable-stream.h"
+
+#include "ns3/xgpon-olt-net-device.h"
+#include "ns3/xgpon-olt-dba-engine.h"
+#include "ns3/xgpon-xgtc-bwmap.h"
+
+#include "xgpon-helper.h"
+
+namespace ns3 {
+
+/**
+ * \brief what the harness measured while driving one DBA engine.
+ */
+class XgponDbaHarnessResult
+{
+public:
+  uint64_t m_bwmaps;                   //the number of BWmaps produced
+  uint64_t m_allocations;              //the number of bandwidth allocations in these BWmaps
+  uint64_t m_grantedWords;             //the sum of the grant sizes. unit: word
+
+  uint64_t m_totalNanoseconds;         //wall-clock time spent in GenerateBwMap. unit: nanosecond
+  uint64_t m_minNanoseconds;
+  uint64_t m_maxNanoseconds;
+
+  uint64_t m_violations;               //the number of checks failed by the BWmaps
+  std::vector<std::string> m_violationMessages;   //the first few failed checks
+};
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief Drives one OLT DBA engine frame by frame without nodes, upper layers or ONU engines.
+ *
+ * The harness builds one XG-PON (through XgponHelper::InstallWithoutNodes) whose devices are never initialized,
+ * thus no downstream frame is sent. Only the T-CONTs (with their XgponQosParameters) of the OLT connection manager
+ * are used. Every downstream frame slot, the status reports that are due are passed to the DBA engine, one BWmap is
+ * generated (its wall-clock cost is measured) and checked for validity.
+ *
+ * The status reports come either from a trace file or from a synthetic load. With the synthetic load, each T-CONT
+ * receives a random amount of data per frame; the grants are drained from its backlog and, when one allocation carries
+ * the DBRu flag, the remaining backlog is reported back one round trip time later.
+ *
+ * The trace file is one CSV line per report: time (ns), alloc-id, buffer occupancy (bytes). Lines starting with '#'
+ * are ignored.
+ */
+class XgponDbaHarness
+{
+  const static uint32_t MAX_VIOLATION_MESSAGES = 16;
+
+public:
+  /**
+   * \brief Constructor
+   */
+  XgponDbaHarness ();
+  virtual ~XgponDbaHarness ();
+
+
+  /**
+   * \brief the helper used to build the XG-PON. The DBA engine (XgponConfigDb) and the QoS parameters of the
+   *        T-CONTs (SetQosParametersAttribute) should be configured through it before Setup.
+   */
+  XgponHelper& GetHelper () { return m_helper; }
+
+  /**
+   * \brief build the XG-PON with nOnus ONUs and tcontsPerOnu T-CONTs per ONU. The T-CONT types cycle through T1...T4.
+   */
+  void Setup (uint32_t nOnus, uint32_t tcontsPerOnu);
+
+  /**
+   * \brief the offered load of the synthetic traffic, as a fraction of the upstream capacity, shared evenly by all T-CONTs.
+   */
+  void SetSyntheticLoad (double load);
+
+  /**
+   * \brief replay the status reports in one trace file instead of producing synthetic traffic.
+   * \return false if the file cannot be read.
+   */
+  bool LoadReportTrace (const std::string& fileName);
+
+
+  /**
+   * \brief generate the given number of BWmaps (one per downstream frame slot). Runs the simulator.
+   */
+  void Run (uint32_t frames);
+
+
+  const XgponDbaHarnessResult& GetResult () const { return m_result; }
+
+  /**
+   * \brief print the measured cost per BWmap and the result of the checks.
+   */
+  void PrintSummary (std::ostream& os) const;
+
+
+private:
+  //one status report waiting to be passed to the DBA engine
+  class PendingReport
+  {
+  public:
+    uint64_t m_time;           //unit: nanosecond
+    uint16_t m_allocId;
+    uint32_t m_bufOcc;         //unit: byte
+  };
+
+  //the event of one downstream frame slot
+  void ProcessFrame (uint32_t remainingFrames);
+
+  //pass the reports that are due to the DBA engine
+  void DeliverReports (uint64_t now);
+
+  //check one BWmap against the T-CONTs and the upstream frame; the failed checks are counted.
+  void ValidateBwmap (const Ptr<XgponXgtcBwmap>& bwmap);
+
+  //drain the grants from the backlogs and produce the reports requested through the DBRu flag
+  void ServeBwmap (const Ptr<XgponXgtcBwmap>& bwmap, uint64_t now);
+
+  void AddViolation (const std::string& message);
+
+  static bool ReportEarlier (const PendingReport& a, const PendingReport& b);
+
+
+  XgponHelper m_helper;
+  Ptr<XgponOltNetDevice> m_olt;
+  Ptr<XgponOltDbaEngine> m_dbaEngine;
+
+  std::map<uint16_t, uint32_t> m_tcontIndexes;     //alloc-id ---> index in the following vectors
+  std::vector<uint16_t> m_allocIds;
+  std::vector<uint16_t> m_onuIds;
+  std::vector<uint64_t> m_backlogs;                //data waiting at the ONU side of each T-CONT. unit: byte
+
+  std::deque<PendingReport> m_pendingReports;      //in the order of their time
+  bool m_replayTrace;
+
+  double m_load;
+  double m_meanArrival;                            //mean synthetic arrival per T-CONT per frame. unit: byte
+  Ptr<UniformRandomVariable> m_arrivalVariable;
+
+  uint64_t m_slotSize;                             //downstream frame slot. unit: nanosecond
+  uint64_t m_rtt;                                  //unit: nanosecond
+  uint32_t m_usFrameSize;                          //unit: word
+  uint32_t m_extraInLastBwmap;                     //the part of the last BWmap beyond its upstream frame. unit: word
+
+  XgponDbaHarnessResult m_result;
+};
+
+
+}; // namespace ns3
+
+#endif // XGPON_DBA_HARNESS_H
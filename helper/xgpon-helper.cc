@@ -27,6 +27,8 @@
 #include "ns3/xgpon-net-device.h"
 #include "ns3/xgpon-olt-net-device.h"
 #include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-olt-net-device-static.h"
+#include "ns3/xgpon-onu-net-device-static.h"
 
 
 #include "ns3/xgpon-olt-xgem-engine.h"
@@ -37,6 +39,13 @@
 #include "ns3/xgpon-olt-conn-manager.h"
 #include "ns3/xgpon-olt-ds-scheduler.h"
 #include "ns3/xgpon-olt-dba-engine.h"
+#include "ns3/xgpon-olt-ds-scheduler-round-robin.h"
+#include "ns3/xgpon-olt-dba-engine-round-robin.h"
+#include "ns3/xgpon-olt-dba-engine-ebu.h"
+#include "ns3/xgpon-olt-dba-engine-giant.h"
+#include "ns3/xgpon-olt-dba-engine-xgiant.h"
+#include "ns3/xgpon-olt-dba-engine-xgiantdeficit.h"
+#include "ns3/xgpon-olt-dba-engine-xgiantprop.h"
 
 #include "ns3/xgpon-onu-xgem-engine.h"
 #include "ns3/xgpon-onu-framing-engine.h"
@@ -46,6 +55,9 @@
 #include "ns3/xgpon-onu-conn-manager.h"
 #include "ns3/xgpon-onu-dba-engine.h"
 #include "ns3/xgpon-onu-us-scheduler.h"
+#include "ns3/xgpon-onu-us-scheduler-round-robin.h"
+#include "ns3/xgpon-onu-conn-manager-speed.h"
+#include "ns3/xgpon-onu-conn-manager-flexible.h"
 
 #include "ns3/xgpon-fifo-queue.h"
 
@@ -118,6 +130,7 @@ XgponHelper::SetPhyAttribute (std::string n1, const AttributeValue &v1)
 {
   //example --- Config::SetDefault ("ns3::XgponPhy::DsLinkRate", UintegerValue(10000));
   Config::SetDefault(n1, v1);
+  m_configPool.ResetPhy ();
 }
 
 void 
@@ -137,6 +150,20 @@ XgponHelper::SetQosParametersAttribute (std::string n1, const AttributeValue &v1
 
 
 NetDeviceContainer XgponHelper::Install (NodeContainer nodes)
+{
+  NetDeviceContainer deviceContainer = InstallWithoutNodes (nodes.GetN() - 1);
+
+  //the first node holds the OLT; the others hold the ONUs.
+  for(uint32_t i=0; i<nodes.GetN(); i++)
+  {
+    nodes.Get(i)->AddDevice(deviceContainer.Get(i));
+  }
+
+  return deviceContainer;
+}
+
+
+NetDeviceContainer XgponHelper::InstallWithoutNodes (uint32_t nOnus)
 {
   NetDeviceContainer deviceContainer;
 
@@ -144,18 +171,16 @@ NetDeviceContainer XgponHelper::Install (NodeContainer nodes)
   Ptr<XgponChannel> xgponChannel = CreateXgponChannel ( );
 
   
-  //Create olt device and add it to the node and channel
+  //Create olt device and attach it to the channel
   Ptr<XgponOltNetDevice> oltDevice = CreateXgponOltNetDeviceAndEngines ( );
-  nodes.Get(0)->AddDevice(oltDevice); 
   AttachOltToPonChannel (xgponChannel, oltDevice);
 
   deviceContainer.Add (oltDevice);
   
-  //Create onu devices and add them to nodes and channel.
-  for(uint32_t i=1; i<nodes.GetN(); i++)
+  //Create onu devices and attach them to the channel.
+  for(uint32_t i=0; i<nOnus; i++)
   {
     Ptr<XgponOnuNetDevice> onuDevice = CreateXgponOnuNetDeviceAndEngines ( );
-    nodes.Get(i)->AddDevice(onuDevice);
 
     AttachOnuToPonChannel (xgponChannel, onuDevice);
     AddOnuToOlt (onuDevice, oltDevice);
@@ -163,6 +188,9 @@ NetDeviceContainer XgponHelper::Install (NodeContainer nodes)
     deviceContainer.Add (onuDevice);
   }
 
+  //all ONUs are attached; fill their equalization delays.
+  oltDevice->GetPloamEngine()->RangeOnus ( );
+
   return deviceContainer;
 }
 
@@ -311,10 +339,42 @@ XgponHelper::AddOneBroadcastDownstreamConnection (Ptr<XgponOltNetDevice> oltDevi
   int num = ch->GetNOnuDevices ( );
 
   uint16_t portId = m_idAllocator->GetOneNewBroadcastDownstreamPortId (addr);
+  DoAddOneBroadcastDownstreamConnection (oltDevice, addr, portId);
+
+  for(int i=0; i<num; i++)
+  {
+    Ptr<XgponOnuNetDevice> onuDevice = DynamicCast<XgponOnuNetDevice, PonNetDevice> (ch->GetOnuByIndex (i));
+    DoAddOneBroadcastReceiverForOnu (onuDevice, addr, portId);
+  }
 
+  return portId;
+}
+
+
+uint16_t 
+XgponHelper::AddOneMulticastDownstreamConnection (Ptr<XgponOltNetDevice> oltDevice, const Address& groupAddr)
+{
+  uint16_t portId = m_idAllocator->GetOneNewBroadcastDownstreamPortId (groupAddr);
+  DoAddOneBroadcastDownstreamConnection (oltDevice, groupAddr, portId);
+  oltDevice->GetConnManager ( )->AddOneMulticastGroup (portId);
+
+  return portId;
+}
+
+void 
+XgponHelper::AddOnuToMulticastGroup (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevice> oltDevice, uint16_t portId, const Address& groupAddr)
+{
+  DoAddOneBroadcastReceiverForOnu (onuDevice, groupAddr, portId);
+  oltDevice->GetConnManager ( )->AddOneMulticastMember (portId, onuDevice->GetOnuId ( ));
+}
+
+
+void 
+XgponHelper::DoAddOneBroadcastDownstreamConnection (const Ptr<XgponOltNetDevice>& oltDevice, const Address& addr, uint16_t portId)
+{
   Ptr<XgponConnectionSender> connSender = CreateObject<XgponConnectionSender> ( );
   Ptr<XgponFifoQueue> txQueue = m_queueFactory.Create<ns3::XgponFifoQueue> ( );
-  Ptr<XgponQosParameters> qosParameters = m_qosParametersFactory.Create<ns3::XgponQosParameters> ( );
+  const Ptr<XgponQosParameters>& qosParameters = m_configPool.GetQosParameters (m_qosParametersFactory);
 
   connSender->SetDirection (XgponConnection::DOWNSTREAM_CONN);
   connSender->SetBroadcast (true);
@@ -323,30 +383,27 @@ XgponHelper::AddOneBroadcastDownstreamConnection (Ptr<XgponOltNetDevice> oltDevi
   connSender->SetXgponQueue (txQueue);
 
   oltDevice->SetQosParameters(qosParameters);
-  Ptr<XgponOltConnManager> connManager = oltDevice->GetConnManager ( );
+  const Ptr<XgponOltConnManager>& connManager = oltDevice->GetConnManager ( );
   connManager->AddOneDsConn (connSender, true, 0);
 
-  Ptr<XgponOltDsScheduler> dsScheduler = oltDevice->GetDsScheduler ( );
+  const Ptr<XgponOltDsScheduler>& dsScheduler = oltDevice->GetDsScheduler ( );
   dsScheduler->AddConnToScheduler (connSender);
+}
 
-  for(int i=0; i<num; i++)
-  {
-    Ptr<XgponOnuNetDevice> onuDevice = DynamicCast<XgponOnuNetDevice, PonNetDevice> (ch->GetOnuByIndex (i));
-    Ptr<XgponQosParameters> qosParameters2 = m_qosParametersFactory.Create<ns3::XgponQosParameters> ( );
-    qosParameters2->DeepCopy(qosParameters);    
-    onuDevice->SetQosParameters(qosParameters2);
-
-    Ptr<XgponConnectionReceiver> connReceiver = CreateObject<XgponConnectionReceiver> ( );
-    connReceiver->SetDirection (XgponConnection::DOWNSTREAM_CONN);
-    connReceiver->SetBroadcast (true);
-    connReceiver->SetXgemPort (portId);
-    connReceiver->SetUpperLayerAddr (addr);
-
-    Ptr<XgponOnuConnManager> onuConnManager = onuDevice->GetConnManager ( );
-    onuConnManager->AddOneDsConn (connReceiver);
-  }
+void 
+XgponHelper::DoAddOneBroadcastReceiverForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Address& addr, uint16_t portId)
+{
+  const Ptr<XgponQosParameters>& qosParameters = m_configPool.GetQosParameters (m_qosParametersFactory);
+  onuDevice->SetQosParameters(qosParameters);
 
-  return portId;
+  Ptr<XgponConnectionReceiver> connReceiver = CreateObject<XgponConnectionReceiver> ( );
+  connReceiver->SetDirection (XgponConnection::DOWNSTREAM_CONN);
+  connReceiver->SetBroadcast (true);
+  connReceiver->SetXgemPort (portId);
+  connReceiver->SetUpperLayerAddr (addr);
+
+  const Ptr<XgponOnuConnManager>& onuConnManager = onuDevice->GetConnManager ( );
+  onuConnManager->AddOneDsConn (connReceiver);
 }
 
 
@@ -494,7 +551,7 @@ XgponHelper::CreateXgponChannel (void)
 Ptr<XgponOltNetDevice> 
 XgponHelper::CreateXgponOltNetDeviceAndEngines (void)
 {
-  Ptr<XgponOltNetDevice> oltDevice = CreateObject<XgponOltNetDevice>();
+  Ptr<XgponOltNetDevice> oltDevice = CreateXgponOltNetDevice ( );
 
 
   Ptr<XgponOltXgemEngine> xgemEngine = CreateObject<XgponOltXgemEngine>();
@@ -512,8 +569,7 @@ XgponHelper::CreateXgponOltNetDeviceAndEngines (void)
   phyAdapter->SetPonid (m_configDb.m_ponId); 
 
 
-  Ptr<XgponPhy> commonPhy = CreateObject<XgponPhy>();
-  oltDevice->SetXgponPhy (commonPhy);
+  oltDevice->SetXgponPhy (m_configPool.GetPhy ());
 
 
   Ptr<XgponOltOmciEngine> omciEngine = CreateObject<XgponOltOmciEngine>();
@@ -547,7 +603,7 @@ XgponHelper::CreateXgponOltNetDeviceAndEngines (void)
 Ptr<XgponOnuNetDevice> 
 XgponHelper::CreateXgponOnuNetDeviceAndEngines (void)
 {
-  Ptr<XgponOnuNetDevice> onuDevice = CreateObject<XgponOnuNetDevice>();
+  Ptr<XgponOnuNetDevice> onuDevice = CreateXgponOnuNetDevice ( );
   uint16_t onuId = m_idAllocator->GetOneNewOnuId ();
   onuDevice->SetOnuId (onuId);
 
@@ -566,8 +622,7 @@ XgponHelper::CreateXgponOnuNetDeviceAndEngines (void)
   phyAdapter->SetXgponOnuNetDevice (onuDevice);
   phyAdapter->SetPonid (m_configDb.m_ponId); 
 
-  Ptr<XgponPhy> commonPhy = CreateObject<XgponPhy>();
-  onuDevice->SetXgponPhy (commonPhy);
+  onuDevice->SetXgponPhy (m_configPool.GetPhy ());
 
 
   Ptr<XgponOnuOmciEngine> omciEngine = CreateObject<XgponOnuOmciEngine>();
@@ -585,19 +640,13 @@ XgponHelper::CreateXgponOnuNetDeviceAndEngines (void)
   ploamEngine->SetLinkInfo (linkInfo);
   linkInfo->SetOnuId (onuId);
 
-  Ptr<XgponKey> key1 = CreateObject<XgponKey>();
-  Ptr<XgponKey> key2 = CreateObject<XgponKey>();
-  linkInfo->AddNewDsKey (key1, 0);
-  linkInfo->AddNewUsKey (key2, 0);  
+  linkInfo->AddNewDsKey (m_configPool.GetKey (), 0);
+  linkInfo->AddNewUsKey (m_configPool.GetKey (), 0);  
   linkInfo->SetCurrentDsKeyIndex (0);
   linkInfo->SetCurrentUsKeyIndex (0);
 
   //In the future, profile may depend on propagation delay (distance)
-  Ptr<XgponBurstProfile> profile = CreateObject<XgponBurstProfile>();
-  profile->SetPreambleLen (m_configDb.m_profilePreambleLen);
-  profile->SetDelimiterLen (m_configDb.m_profileDelimiterLen);
-  profile->SetFec (m_configDb.m_profileFec);
-
+  const Ptr<XgponBurstProfile>& profile = m_configPool.GetBurstProfile (m_configDb.m_profilePreambleLen, m_configDb.m_profileDelimiterLen, m_configDb.m_profileFec);
   linkInfo->AddNewProfile (profile, 0);
   linkInfo->SetCurrentProfileIndex (0);
   //////////////////////////////End of PloamEngine Configuration
@@ -621,6 +670,44 @@ XgponHelper::CreateXgponOnuNetDeviceAndEngines (void)
 
 
 
+Ptr<XgponOltNetDevice> 
+XgponHelper::CreateXgponOltNetDevice (void)
+{
+  if(m_configDb.m_staticEngines && m_oltDsSchedulerEngineFactory.GetTypeId () == XgponOltDsSchedulerRoundRobin::GetTypeId ())
+  {
+    TypeId dba = m_oltDbaEngineFactory.GetTypeId ();
+    if(dba == XgponOltDbaEngineRoundRobin::GetTypeId ())
+      return CreateObject<XgponOltNetDeviceStatic<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineRoundRobin> > ();
+    else if(dba == XgponOltDbaEngineEbu::GetTypeId ())
+      return CreateObject<XgponOltNetDeviceStatic<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineEbu> > ();
+    else if(dba == XgponOltDbaEngineGiant::GetTypeId ())
+      return CreateObject<XgponOltNetDeviceStatic<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineGiant> > ();
+    else if(dba == XgponOltDbaEngineXgiant::GetTypeId ())
+      return CreateObject<XgponOltNetDeviceStatic<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineXgiant> > ();
+    else if(dba == XgponOltDbaEngineXgiantDeficit::GetTypeId ())
+      return CreateObject<XgponOltNetDeviceStatic<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineXgiantDeficit> > ();
+    else if(dba == XgponOltDbaEngineXgiantProp::GetTypeId ())
+      return CreateObject<XgponOltNetDeviceStatic<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineXgiantProp> > ();
+  }
+
+  return CreateObject<XgponOltNetDevice>();
+}
+
+
+Ptr<XgponOnuNetDevice> 
+XgponHelper::CreateXgponOnuNetDevice (void)
+{
+  if(m_configDb.m_staticEngines && m_onuUsSchedulerEngineFactory.GetTypeId () == XgponOnuUsSchedulerRoundRobin::GetTypeId ())
+  {
+    if(m_configDb.m_allocateIds4Speed)
+      return CreateObject<XgponOnuNetDeviceStatic<XgponOnuConnManagerSpeed, XgponOnuUsSchedulerRoundRobin> > ();
+    else
+      return CreateObject<XgponOnuNetDeviceStatic<XgponOnuConnManagerFlexible, XgponOnuUsSchedulerRoundRobin> > ();
+  }
+
+  return CreateObject<XgponOnuNetDevice>();
+}
+
 
 
 
@@ -641,12 +728,21 @@ XgponHelper::AttachOnuToPonChannel (Ptr<XgponChannel> ch, Ptr<XgponOnuNetDevice>
   onuDevice->SetChannelIndex (chIndex);
 
 
-  //////////////////////Currently, we assume that all onus have the same propagation delay.
-  //////////////////////In the future, propagation delay may be generated randomly.
+  //////////////////////The propagation delay comes from the fibre distance described in XgponConfigDb.
+  //////////////////////ONUs without distance are placed at the logic one way delay (the equalization delay is then 0).
   uint32_t propDelay = ch->GetLogicOneWayDelay ();
+  double distance = m_configDb.GetOnuDistance (chIndex);
+  if(distance > 0)
+  {
+    propDelay = (uint32_t) (distance * XgponChannel::PROPAGATION_DELAY_PER_KM / 1000 + 0.5);
+    if(propDelay == 0) propDelay = 1;
+    NS_ASSERT_MSG((propDelay <= ch->GetLogicOneWayDelay ()), "The ONU is beyond the reach of the logic one way delay!!!");
+  }
   ch->SetOnuPropagationDelay (chIndex, propDelay);  
+
+  //set by ranging (XgponOltPloamEngine::RangeOnus) when all ONUs are attached.
   Ptr<XgponLinkInfo> linkInfo = onuDevice->GetPloamEngine()->GetLinkInfo();
-  linkInfo->SetEqualizeDelay (0); //LogicOneWayDelay - OnuPropagationDelay; 
+  linkInfo->SetEqualizeDelay (0);
 }
 
 
@@ -668,6 +764,109 @@ XgponHelper::AddOnuToOlt (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevic
 }
 
 
+void 
+XgponHelper::ProvisionOnus (const NetDeviceContainer& devices, const XgponServiceProfile& profile)
+{
+  std::vector<Address> addrs (devices.GetN () - 1);
+  for(uint32_t i=1; i<devices.GetN (); i++)
+  {
+    addrs[i-1] = devices.Get (i)->GetAddress ();
+  }
+
+  ProvisionOnus (devices, profile, addrs);
+}
+
+
+void 
+XgponHelper::ProvisionOnus (const NetDeviceContainer& devices, const XgponServiceProfile& profile, const std::vector<Address>& addrs)
+{
+  Ptr<XgponOltNetDevice> oltDevice = DynamicCast<XgponOltNetDevice, NetDevice> (devices.Get (0));
+  NS_ASSERT_MSG((oltDevice != 0), "The first device should be the OLT!!!");
+  NS_ASSERT_MSG((addrs.size () == devices.GetN () - 1), "One address is needed for each ONU!!!");
+
+  uint32_t nOnus = devices.GetN () - 1;
+  uint32_t nTconts = profile.GetNTconts ();
+
+  //size the per-PON tables once
+  oltDevice->GetConnManager ( )->GetTcontStateTable ( ).Reserve (nOnus * nTconts);
+  oltDevice->GetDbaEngine ( )->ReserveTcontsInDbaEngine (nOnus * nTconts);
+  oltDevice->GetDsScheduler ( )->ReserveConnsInScheduler (nOnus * profile.GetNDsConns ());
+
+  //the QoS parameters of each T-CONT of the profile, shared by all ONUs
+  std::vector< Ptr<XgponQosParameters> > qosParameters (nTconts);
+  for(uint32_t t=0; t<nTconts; t++)
+  {
+    qosParameters[t] = profile.GetQosParameters (t);
+    if(qosParameters[t] == 0) qosParameters[t] = m_configPool.GetQosParameters (m_qosParametersFactory);
+  }
+  Ptr<XgponQosParameters> dsQosParameters;
+  if(profile.GetNDsConns () > 0) dsQosParameters = m_configPool.GetQosParameters (m_qosParametersFactory);
+
+  //The queues are empty copies of one queue from the factory, which skips the attribute lookups of each construction.
+  //A factory that produces another queue class is called for each xgem-port.
+  Ptr<XgponFifoQueue> queue = m_queueFactory.Create<ns3::XgponFifoQueue> ( );
+  bool copyQueue = (queue->GetInstanceTypeId () == XgponFifoQueue::GetTypeId ());
+
+  std::vector< Ptr<XgponFifoQueue> > queues (nOnus * (profile.GetNUsConns () + profile.GetNDsConns ()));
+  for(uint32_t i=0; i<queues.size(); i++)
+  {
+    queues[i] = copyQueue ? CopyObject<XgponFifoQueue> (queue) : m_queueFactory.Create<ns3::XgponFifoQueue> ( );
+  }
+
+  uint32_t nextQueue = 0;
+  for(uint32_t i=0; i<nOnus; i++)
+  {
+    Ptr<XgponOnuNetDevice> onuDevice = DynamicCast<XgponOnuNetDevice, NetDevice> (devices.Get (i+1));
+    NS_ASSERT_MSG((onuDevice != 0), "All devices except the first one should be ONUs!!!");
+    uint16_t onuId = onuDevice->GetOnuId ( );
+    const Address& addr = addrs[i];
+
+    for(uint32_t t=0; t<nTconts; t++)
+    {
+      uint16_t allocId = m_idAllocator->GetOneNewAllocId (onuId);
+      DoAddOneTcontForOnu (onuDevice, oltDevice, allocId, profile.GetTcontType (t), qosParameters[t]);
+
+      for(uint16_t c=0; c<profile.GetNUsConns (t); c++)
+      {
+        uint16_t portId = m_idAllocator->GetOneNewUpstreamPortId (onuId, addr);
+        DoAddOneUpstreamConnectionForOnu (onuDevice, oltDevice, allocId, addr, portId, qosParameters[t], queues[nextQueue++]);
+      }
+    }
+
+    for(uint16_t c=0; c<profile.GetNDsConns (); c++)
+    {
+      uint16_t portId = m_idAllocator->GetOneNewDownstreamPortId (onuId, addr);
+      DoAddOneDownstreamConnectionForOnu (onuDevice, oltDevice, addr, portId, dsQosParameters, queues[nextQueue++]);
+    }
+  }
+}
+
+
+void 
+XgponHelper::SetBurstProfileForOnu (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevice> oltDevice, uint8_t index, 
+                                    uint8_t preambleLen, uint8_t delimiterLen, bool fec)
+{
+  //the links keep references to the pooled profile; the one used before the switch stays in the pool for the other ONUs.
+  const Ptr<XgponBurstProfile>& profile = m_configPool.GetBurstProfile (preambleLen, delimiterLen, fec);
+
+  Ptr<XgponLinkInfo> onuLinkInfo = onuDevice->GetPloamEngine()->GetLinkInfo();
+  onuLinkInfo->AddNewProfile (profile, index);
+  onuLinkInfo->SetCurrentProfileIndex (index);
+
+  Ptr<XgponLinkInfo> oltLinkInfo = oltDevice->GetPloamEngine()->GetLinkInfo (onuDevice->GetOnuId());
+  oltLinkInfo->AddNewProfile (profile, index);
+  oltLinkInfo->SetCurrentProfileIndex (index);
+}
+
+
+
+void 
+XgponHelper::AddUsClassificationRuleForOnu (Ptr<XgponOnuNetDevice> onuDevice, const XgponUsClassifier::Rule& rule, uint16_t portId)
+{
+  onuDevice->GetConnManager()->AddUsClassificationRule (rule, portId);
+}
+
+
 
 
 
@@ -682,21 +881,27 @@ XgponHelper::AddOnuToOlt (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevic
 
 void 
 XgponHelper::AddOneTcontForOnu (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevice> oltDevice, uint16_t allocId, XgponQosParameters::XgponTcontType tcontType) 
+{
+  DoAddOneTcontForOnu (onuDevice, oltDevice, allocId, tcontType, m_configPool.GetQosParameters (m_qosParametersFactory));
+}
+
+void 
+XgponHelper::DoAddOneTcontForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Ptr<XgponOltNetDevice>& oltDevice, uint16_t allocId, 
+                                  XgponQosParameters::XgponTcontType tcontType, const Ptr<XgponQosParameters>& qosParameters) 
 {
   uint16_t onuId = onuDevice->GetOnuId ( );
 
   Ptr<XgponTcontOlt> tcontOlt = CreateObject<ns3::XgponTcontOlt> ();
-  Ptr<XgponQosParameters> qosParameters = m_qosParametersFactory.Create<ns3::XgponQosParameters> ( );
 
   tcontOlt->SetOnuId (onuId);
   tcontOlt->SetAllocId(allocId);
   tcontOlt->SetTcontType(tcontType);
   tcontOlt->SetQosParameters(qosParameters);      //jerome, for the moment, tcontOlt also has a qosParameters object, attached to it. But this should be the object used from the ONU device instead. TODO: have to find a way to bring that qosParameters object from ONU device to the tcontOlt at the time of CalculateTcontParameters
 
-  Ptr<XgponOltConnManager> connManager = oltDevice->GetConnManager ( );
+  const Ptr<XgponOltConnManager>& connManager = oltDevice->GetConnManager ( );
   connManager->AddOneUsTcont (tcontOlt, onuId);
 
-  Ptr<XgponOltDbaEngine> dbaEngine = oltDevice->GetDbaEngine ( );
+  const Ptr<XgponOltDbaEngine>& dbaEngine = oltDevice->GetDbaEngine ( );
   dbaEngine->AddTcontToDbaEngine (tcontOlt);
 
 
@@ -709,25 +914,30 @@ XgponHelper::AddOneTcontForOnu (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNe
   usScheduler->SetTcontOnu(tcontOnu);
   tcontOnu->SetOnuUsScheduler(usScheduler);
 
-  Ptr<XgponOnuConnManager> onuConnManager = onuDevice->GetConnManager ( );
+  const Ptr<XgponOnuConnManager>& onuConnManager = onuDevice->GetConnManager ( );
   onuConnManager->AddOneUsTcont (tcontOnu);
 }
 
 
 void 
 XgponHelper::AddOneUpstreamConnectionForOnu (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevice> oltDevice, uint16_t allocId, const Address& addr, uint16_t portId)
+{
+  DoAddOneUpstreamConnectionForOnu (onuDevice, oltDevice, allocId, addr, portId, 
+                                    m_configPool.GetQosParameters (m_qosParametersFactory), m_queueFactory.Create<ns3::XgponFifoQueue> ( ));
+}
+
+void 
+XgponHelper::DoAddOneUpstreamConnectionForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Ptr<XgponOltNetDevice>& oltDevice, uint16_t allocId, 
+                                               const Address& addr, uint16_t portId, const Ptr<XgponQosParameters>& qosParameters, 
+                                               const Ptr<XgponFifoQueue>& txQueue)
 {
   uint16_t onuId = onuDevice->GetOnuId ( );
 
   Ptr<XgponConnectionSender> connSender = CreateObject<XgponConnectionSender> ( );
-  Ptr<XgponFifoQueue> txQueue = m_queueFactory.Create<ns3::XgponFifoQueue> ( );
         txQueue->SetAllocId(allocId);
-  Ptr<XgponQosParameters> qosParameters = m_qosParametersFactory.Create<ns3::XgponQosParameters> ( );
 
   onuDevice->SetQosParameters (qosParameters);
-  Ptr<XgponQosParameters> qosParameters2 = m_qosParametersFactory.Create<ns3::XgponQosParameters> ( );
-  qosParameters2->DeepCopy(qosParameters);
-  oltDevice->SetQosParameters (qosParameters2);
+  oltDevice->SetQosParameters (qosParameters);
 
   connSender->SetDirection (XgponConnection::UPSTREAM_CONN);
   connSender->SetBroadcast (false);
@@ -737,7 +947,7 @@ XgponHelper::AddOneUpstreamConnectionForOnu (Ptr<XgponOnuNetDevice> onuDevice, P
   connSender->SetUpperLayerAddr (addr);
   connSender->SetXgponQueue (txQueue);
 
-  Ptr<XgponOnuConnManager> onuConnManager = onuDevice->GetConnManager ( );
+  const Ptr<XgponOnuConnManager>& onuConnManager = onuDevice->GetConnManager ( );
   onuConnManager->AddOneUsConn (connSender, allocId);
 
 
@@ -749,24 +959,28 @@ XgponHelper::AddOneUpstreamConnectionForOnu (Ptr<XgponOnuNetDevice> onuDevice, P
   connReceiver->SetOnuId (onuId);
   connReceiver->SetUpperLayerAddr (addr);
 
-  Ptr<XgponOltConnManager> connManager = oltDevice->GetConnManager ( );
+  const Ptr<XgponOltConnManager>& connManager = oltDevice->GetConnManager ( );
   connManager->AddOneUsConn (connReceiver, allocId);
 }
 
 
 void
 XgponHelper::AddOneDownstreamConnectionForOnu (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevice> oltDevice, const Address& addr, uint16_t portId)
+{
+  DoAddOneDownstreamConnectionForOnu (onuDevice, oltDevice, addr, portId, 
+                                      m_configPool.GetQosParameters (m_qosParametersFactory), m_queueFactory.Create<ns3::XgponFifoQueue> ( ));
+}
+
+void
+XgponHelper::DoAddOneDownstreamConnectionForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Ptr<XgponOltNetDevice>& oltDevice, const Address& addr, 
+                                                 uint16_t portId, const Ptr<XgponQosParameters>& qosParameters, const Ptr<XgponFifoQueue>& txQueue)
 {
   uint16_t onuId = onuDevice->GetOnuId ( );
 
   Ptr<XgponConnectionSender> connSender = CreateObject<XgponConnectionSender> ( );
-  Ptr<XgponFifoQueue> txQueue = m_queueFactory.Create<ns3::XgponFifoQueue> ( );
-  Ptr<XgponQosParameters> qosParameters = m_qosParametersFactory.Create<ns3::XgponQosParameters> ( );
 
 
   onuDevice->SetQosParameters (qosParameters);
-  Ptr<XgponQosParameters> qosParameters2 = m_qosParametersFactory.Create<ns3::XgponQosParameters> ( );
-  qosParameters2->DeepCopy(qosParameters);
   oltDevice->SetQosParameters (qosParameters);
   
   connSender->SetDirection (XgponConnection::DOWNSTREAM_CONN);
@@ -776,10 +990,10 @@ XgponHelper::AddOneDownstreamConnectionForOnu (Ptr<XgponOnuNetDevice> onuDevice,
   connSender->SetUpperLayerAddr (addr);
   connSender->SetXgponQueue (txQueue);
 
-  Ptr<XgponOltConnManager> connManager = oltDevice->GetConnManager ( );
+  const Ptr<XgponOltConnManager>& connManager = oltDevice->GetConnManager ( );
   connManager->AddOneDsConn (connSender, false, onuId);
 
-  Ptr<XgponOltDsScheduler> dsScheduler = oltDevice->GetDsScheduler ( );
+  const Ptr<XgponOltDsScheduler>& dsScheduler = oltDevice->GetDsScheduler ( );
   dsScheduler->AddConnToScheduler (connSender);
 
   Ptr<XgponConnectionReceiver> connReceiver = CreateObject<XgponConnectionReceiver> ( );
@@ -789,7 +1003,7 @@ XgponHelper::AddOneDownstreamConnectionForOnu (Ptr<XgponOnuNetDevice> onuDevice,
   connReceiver->SetOnuId (onuId);
   connReceiver->SetUpperLayerAddr (addr);
 
-  Ptr<XgponOnuConnManager> onuConnManager = onuDevice->GetConnManager ( );
+  const Ptr<XgponOnuConnManager>& onuConnManager = onuDevice->GetConnManager ( );
   onuConnManager->AddOneDsConn (connReceiver);
 }
 
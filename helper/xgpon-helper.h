@@ -21,6 +21,8 @@
 #ifndef XGPON_HELPER_H
 #define XGPON_HELPER_H
 
+#include <vector>
+
 #include "ns3/config.h"
 #include "ns3/packet.h"
 #include "ns3/trace-helper.h"
@@ -29,14 +31,18 @@
 #include "ns3/xgpon-net-device.h"
 #include "ns3/xgpon-olt-net-device.h"
 #include "ns3/xgpon-onu-net-device.h"
+#include "ns3/xgpon-us-classifier.h"
 
 
 #include "xgpon-config-db.h"
+#include "xgpon-config-pool.h"
+#include "xgpon-service-profile.h"
 #include "xgpon-id-allocator.h"
 
 namespace ns3 {
 
 class Node;
+class XgponFifoQueue;
 
 /**
  * \brief Build a set of XgponNetDevice objects
@@ -83,6 +89,14 @@ public:
    */
   NetDeviceContainer Install (NodeContainer nodes);
 
+  /**
+   * \brief create the channel, the OLT and the ONUs without adding them to nodes (no upper layers).
+   *        Used to drive the engines directly, e.g., by XgponDbaHarness.
+   * \return the container that holds the xgpon network devices. The first one is XgponOltNetDevice.
+   * \param nOnus the number of ONUs
+   */
+  NetDeviceContainer InstallWithoutNodes (uint32_t nOnus);
+
 
 
   //produce Ip address netmask based on netmask length.
@@ -154,6 +168,64 @@ public:
   uint16_t AddOneBroadcastDownstreamConnection (Ptr<XgponOltNetDevice> oltDevice, const Address& addr);
 
 
+  /**
+   * \brief Add one multicast group (e.g., one IPTV channel) to the OLT. Its traffic is carried by one xgem-port, once per downstream
+   *        frame, whatever the number of member ONUs. ONUs are added to the group through AddOnuToMulticastGroup.
+   * \return ID of the xgem-port of this group
+   * \param oltDevice the OLT
+   * \param groupAddr IP multicast address of this group
+   */
+  uint16_t AddOneMulticastDownstreamConnection (Ptr<XgponOltNetDevice> oltDevice, const Address& groupAddr);
+
+  /**
+   * \brief Add one ONU to one multicast group, so that this ONU receives the traffic of the group.
+   * \param onuDevice the ONU
+   * \param oltDevice the OLT
+   * \param portId the xgem-port returned by AddOneMulticastDownstreamConnection
+   * \param groupAddr IP multicast address of this group
+   */
+  void AddOnuToMulticastGroup (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevice> oltDevice, uint16_t portId, const Address& groupAddr);
+
+
+  /**
+   * \brief Add one upstream classification rule to one ONU. Once one rule is added, the packets sent by this ONU are classified
+   *        through its rules (in the order they are added); the packets that match no rule are still mapped through their TOS.
+   * \param onuDevice the ONU
+   * \param rule the fields that the packets should match
+   * \param portId the upstream xgem-port (already added to this ONU) that carries the matching packets
+   */
+  void AddUsClassificationRuleForOnu (Ptr<XgponOnuNetDevice> onuDevice, const XgponUsClassifier::Rule& rule, uint16_t portId);
+
+
+  /**
+   * \brief Provision all ONUs of one PON with the same services: the T-CONTs and xgem-ports of the profile are added to every ONU,
+   *        with the IDs from XgponIdAllocator. The tables of the OLT are sized once for the whole PON, the QoS parameters are
+   *        resolved once per T-CONT of the profile and the queues are copied from one queue made by the queue factory.
+   * \param devices the devices returned by Install or InstallWithoutNodes. The first one is XgponOltNetDevice.
+   * \param profile the services of each ONU
+   * \param addrs the address of the computer behind each ONU (in the order of the ONUs in devices), used by all its xgem-ports.
+   */
+  void ProvisionOnus (const NetDeviceContainer& devices, const XgponServiceProfile& profile, const std::vector<Address>& addrs);
+
+  /**
+   * \brief the same as above. The address of each ONU device (set after the IP addresses are assigned) is used for its xgem-ports.
+   */
+  void ProvisionOnus (const NetDeviceContainer& devices, const XgponServiceProfile& profile);
+
+
+  /**
+   * \brief Configure one burst profile of the link between the OLT and one ONU (at both sides) and switch to it.
+   *        The profile is shared with the other links that use the same parameters.
+   * \param onuDevice the ONU
+   * \param oltDevice the OLT
+   * \param index the index of the profile in the link (carried in the burst header)
+   * \param preambleLen the preamble length (unit: byte)
+   * \param delimiterLen the delimiter length (unit: byte)
+   */
+  void SetBurstProfileForOnu (Ptr<XgponOnuNetDevice> onuDevice, Ptr<XgponOltNetDevice> oltDevice, uint8_t index, 
+                              uint8_t preambleLen, uint8_t delimiterLen, bool fec);
+
+
 
 
 
@@ -209,6 +281,25 @@ private:
   //create XgponOnuNetDevice and its engines
   Ptr<XgponOnuNetDevice> CreateXgponOnuNetDeviceAndEngines (void);
 
+  //the bodies of the functions adding one T-CONT or xgem-port; the QoS parameters and the queue are given by the caller.
+  void DoAddOneTcontForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Ptr<XgponOltNetDevice>& oltDevice, uint16_t allocId, 
+                            XgponQosParameters::XgponTcontType type, const Ptr<XgponQosParameters>& qosParameters);
+  void DoAddOneUpstreamConnectionForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Ptr<XgponOltNetDevice>& oltDevice, uint16_t allocId, 
+                                         const Address& addr, uint16_t portId, const Ptr<XgponQosParameters>& qosParameters, 
+                                         const Ptr<XgponFifoQueue>& txQueue);
+  void DoAddOneDownstreamConnectionForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Ptr<XgponOltNetDevice>& oltDevice, const Address& addr, 
+                                           uint16_t portId, const Ptr<XgponQosParameters>& qosParameters, const Ptr<XgponFifoQueue>& txQueue);
+
+  //add the sender of one broadcast (or multicast) xgem-port at the OLT and the receiver at one ONU
+  void DoAddOneBroadcastDownstreamConnection (const Ptr<XgponOltNetDevice>& oltDevice, const Address& addr, uint16_t portId);
+  void DoAddOneBroadcastReceiverForOnu (const Ptr<XgponOnuNetDevice>& onuDevice, const Address& addr, uint16_t portId);
+
+
+  //create the device only. With static engines, the device is composed with the engines configured in XgponConfigDb if
+  //this combination has been instantiated; otherwise, the normal device is returned.
+  Ptr<XgponOltNetDevice> CreateXgponOltNetDevice (void);
+  Ptr<XgponOnuNetDevice> CreateXgponOnuNetDevice (void);
+
 
   //attach XgponOltNetDevice to the channel
   void AttachOltToPonChannel (Ptr<XgponChannel> ch, Ptr<XgponOltNetDevice> oltDevice);
@@ -236,6 +327,7 @@ private:
 
   XgponConfigDb m_configDb;                //hold the configuration-related information
   XgponIdAllocator* m_idAllocator;          //one singleton used to allocate IDs (xgem-port, alloc-id, onu-id, etc.)
+  XgponConfigPool m_configPool;             //the PHY, keys, burst profiles and QoS parameters shared by the devices
 
 
 
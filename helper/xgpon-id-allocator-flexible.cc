@@ -50,7 +50,7 @@ XgponIdAllocatorFlexible::GetOneNewAllocId (uint16_t onuId)
 uint16_t 
 XgponIdAllocatorFlexible::GetOneNewUpstreamPortId (uint16_t onuId, const Address& addr)
 {
-  NS_ASSERT_MSG((m_nextUpstreamPortId<65536), "Too many upstream XGEM-PORTs are added to the network.");
+  NS_ASSERT_MSG((m_nextUpstreamPortId<65535), "Too many upstream XGEM-PORTs are added to the network.");   //0xFFFF: idle xgem frames
   return m_nextUpstreamPortId++;
 }
 
@@ -59,14 +59,14 @@ XgponIdAllocatorFlexible::GetOneNewUpstreamPortId (uint16_t onuId, const Address
 uint16_t 
 XgponIdAllocatorFlexible::GetOneNewDownstreamPortId (uint16_t onuId, const Address& addr)
 {
-  NS_ASSERT_MSG((m_nextDownstreamPortId<65536), "Too many downstream XGEM-PORTs are added to the network.");
+  NS_ASSERT_MSG((m_nextDownstreamPortId<65535), "Too many downstream XGEM-PORTs are added to the network.");
   return m_nextDownstreamPortId++;
 }
 
 uint16_t 
 XgponIdAllocatorFlexible::GetOneNewBroadcastDownstreamPortId (const Address& addr)
 {
-  NS_ASSERT_MSG((m_nextDownstreamPortId<65536), "Too many downstream XGEM-PORTs are added to the network.");
+  NS_ASSERT_MSG((m_nextDownstreamPortId<65535), "Too many downstream XGEM-PORTs are added to the network.");
   return m_nextDownstreamPortId++;
 }
 
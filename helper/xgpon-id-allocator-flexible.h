@@ -27,6 +27,8 @@ namespace ns3 {
 
 /**
  * \brief a database used to hold the configuration of the xgpon network
+ *        Alloc-IDs and XGEM ports are assigned sequentially over the whole PON, without any per-ONU limit.
+ *        Used with the flexible connection managers, which map them to dense indices through XgponIdMap.
  *
  */
 class XgponIdAllocatorFlexible : public XgponIdAllocator
@@ -50,9 +52,9 @@ public:
 
 
 private:
-  uint16_t m_nextAllocId;
-  uint16_t m_nextUpstreamPortId;
-  uint16_t m_nextDownstreamPortId;
+  uint32_t m_nextAllocId;              //wider than the ids so that their limits can be checked
+  uint32_t m_nextUpstreamPortId;
+  uint32_t m_nextDownstreamPortId;
 };
 
 
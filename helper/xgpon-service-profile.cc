@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+#include "ns3/assert.h"
+
+#include "xgpon-service-profile.h"
+
+
+namespace ns3 {
+
+XgponServiceProfile::XgponServiceProfile()
+{
+  m_nDsConns = 0;
+}
+
+XgponServiceProfile::~XgponServiceProfile()
+{
+}
+
+
+
+
+void 
+XgponServiceProfile::AddTcont (XgponQosParameters::XgponTcontType type, uint16_t nUsConns, const Ptr<XgponQosParameters>& qosParameters)
+{
+  Tcont tcont;
+  tcont.m_type = type;
+  tcont.m_nUsConns = nUsConns;
+  tcont.m_qosParameters = qosParameters;
+  m_tconts.push_back (tcont);
+}
+
+
+void 
+XgponServiceProfile::SetNDsConns (uint16_t nDsConns)
+{
+  m_nDsConns = nDsConns;
+}
+
+uint16_t 
+XgponServiceProfile::GetNDsConns () const
+{
+  return m_nDsConns;
+}
+
+
+uint32_t 
+XgponServiceProfile::GetNTconts () const
+{
+  return m_tconts.size ();
+}
+
+XgponQosParameters::XgponTcontType 
+XgponServiceProfile::GetTcontType (uint32_t index) const
+{
+  NS_ASSERT_MSG((index < m_tconts.size ()), "T-CONT index is too large!!!");
+  return m_tconts[index].m_type;
+}
+
+uint16_t 
+XgponServiceProfile::GetNUsConns (uint32_t index) const
+{
+  NS_ASSERT_MSG((index < m_tconts.size ()), "T-CONT index is too large!!!");
+  return m_tconts[index].m_nUsConns;
+}
+
+const Ptr<XgponQosParameters>& 
+XgponServiceProfile::GetQosParameters (uint32_t index) const
+{
+  NS_ASSERT_MSG((index < m_tconts.size ()), "T-CONT index is too large!!!");
+  return m_tconts[index].m_qosParameters;
+}
+
+
+uint32_t 
+XgponServiceProfile::GetNUsConns () const
+{
+  uint32_t nUsConns = 0;
+  for(uint32_t i=0; i<m_tconts.size(); i++)
+  {
+    nUsConns += m_tconts[i].m_nUsConns;
+  }
+  return nUsConns;
+}
+
+
+
+
+}//namespace ns3
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c)  2012 The Provost, Fellows and Scholars of the 
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin. 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_SERVICE_PROFILE_H
+#define XGPON_SERVICE_PROFILE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ptr.h"
+#include "ns3/xgpon-qos-parameters.h"
+
+namespace ns3 {
+
+
+
+/**
+ * \brief the services provisioned for every ONU by XgponHelper::ProvisionOnus: the T-CONTs (type, QoS parameters and the
+ *        number of upstream xgem-ports of each) and the number of downstream xgem-ports.
+ *
+ */
+class XgponServiceProfile
+{
+
+public:
+  /**
+   * \brief constructor
+   */
+  XgponServiceProfile ();
+  virtual ~XgponServiceProfile ();
+
+
+  /**
+   * \brief add one T-CONT to the profile. T-CONTs are added to each ONU in this order.
+   * \param type T-CONT type
+   * \param nUsConns the number of upstream xgem-ports of this T-CONT
+   * \param qosParameters the QoS parameters of this T-CONT and its xgem-ports; 0: the ones set through XgponHelper::SetQosParametersAttribute.
+   *        It is shared by all ONUs and must not be changed afterwards.
+   */
+  void AddTcont (XgponQosParameters::XgponTcontType type, uint16_t nUsConns, const Ptr<XgponQosParameters>& qosParameters = 0);
+
+  //the number of downstream xgem-ports per ONU. They use the QoS parameters set through XgponHelper::SetQosParametersAttribute.
+  void SetNDsConns (uint16_t nDsConns);
+  uint16_t GetNDsConns () const;
+
+
+  uint32_t GetNTconts () const;
+  XgponQosParameters::XgponTcontType GetTcontType (uint32_t index) const;
+  uint16_t GetNUsConns (uint32_t index) const;
+  const Ptr<XgponQosParameters>& GetQosParameters (uint32_t index) const;
+
+  //the number of upstream xgem-ports per ONU (of all T-CONTs)
+  uint32_t GetNUsConns () const;
+
+
+private:
+  class Tcont
+  {
+  public:
+    XgponQosParameters::XgponTcontType m_type;
+    uint16_t m_nUsConns;
+    Ptr<XgponQosParameters> m_qosParameters;
+  };
+
+  std::vector<Tcont> m_tconts;
+  uint16_t m_nDsConns;
+};
+
+
+
+
+
+}//namespace ns3
+
+#endif /* XGPON_SERVICE_PROFILE_H */
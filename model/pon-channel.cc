@@ -19,6 +19,8 @@
  * Author: Pedro Alvarez <pinheirp@tcd.ie>
  */
 
+#include <map>
+
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 
@@ -46,7 +48,7 @@ PonChannel::GetInstanceTypeId (void) const
 }
 
 
-PonChannel::PonChannel () : Channel(),  m_oltDevice(0)
+PonChannel::PonChannel () : Channel(),  m_oltDevice(0), m_delayBucketsValid(false)
 {
 }
 PonChannel::~PonChannel ()
@@ -74,13 +76,67 @@ PonChannel::SendDownstream (const Ptr<PonFrame>& frame)
 {
   NS_LOG_INFO ("Schedule to Send One Downstream Frame to all ONUs");
 
-  for (int i = 0; i < GetNOnuDevices(); i++)
+  if(!m_delayBucketsValid) BuildDelayBuckets ();
+
+  for (uint32_t b = 0; b < m_delayBuckets.size(); b++)
+  {
+    const std::vector<uint16_t>& onus = m_delayBuckets[b];
+
+    //dormant ONUs do not receive the frame; the frame carries nothing that they must react to.
+    //the ONUs awake now are the receivers, even if they fall asleep before the frame arrives.
+    uint32_t nAwake = 0;
+    for (uint32_t i = 0; i < onus.size(); i++)
+    {
+      if(!GetOnuByIndex(onus[i])->IsDormant()) nAwake++;
+    }
+    if(nAwake == 0) continue;
+
+    std::vector<uint16_t> awakeOnus;
+    if(nAwake < onus.size())
+    {
+      awakeOnus.reserve (nAwake);
+      for (uint32_t i = 0; i < onus.size(); i++)
+      {
+        if(!GetOnuByIndex(onus[i])->IsDormant()) awakeOnus.push_back (onus[i]);
+      }
+    }
+
+    const Ptr<PonNetDevice>& firstDevice = GetOnuByIndex(awakeOnus.empty() ? onus[0] : awakeOnus[0]);
+    Simulator::ScheduleWithContext (firstDevice->GetNode ()->GetId (), NanoSeconds (m_bucketDelays[b]), 
+                                    &PonChannel::DeliverDownstreamToBucket, this, frame, b, awakeOnus);
+  }
+}
+
+void
+PonChannel::DeliverDownstreamToBucket (const Ptr<PonFrame>& frame, uint32_t bucket, const std::vector<uint16_t>& awakeOnus)
+{
+  const std::vector<uint16_t>& onus = awakeOnus.empty() ? m_delayBuckets[bucket] : awakeOnus;
+  for (uint32_t i = 0; i < onus.size(); i++)
+  {
+    GetOnuByIndex(onus[i])->ReceivePonFrameFromChannel (frame);
+  }
+}
+
+
+void
+PonChannel::BuildDelayBuckets (void)
+{
+  std::map<uint32_t, std::vector<uint16_t> > buckets;
+  for (uint16_t i = 0; i < GetNOnuDevices(); i++)
   {
-    uint32_t delay = GetOnuPropagationDelay(i);
+    buckets[GetOnuPropagationDelay(i)].push_back (i);
+  }
 
-    const Ptr<PonNetDevice>& onuDevice = GetOnuByIndex(i);   
-    Simulator::ScheduleWithContext (onuDevice->GetNode ()->GetId (), NanoSeconds (delay), &PonNetDevice::ReceivePonFrameFromChannel, onuDevice, frame);
+  m_delayBuckets.clear ();
+  m_bucketDelays.clear ();
+  std::map<uint32_t, std::vector<uint16_t> >::iterator it;
+  for (it = buckets.begin(); it != buckets.end(); it++)
+  {
+    m_bucketDelays.push_back (it->first);
+    m_delayBuckets.push_back (it->second);
   }
+
+  m_delayBucketsValid = true;
 }
 
 
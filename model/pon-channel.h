@@ -21,6 +21,8 @@
 #ifndef PON_CHANNEL_H
 #define PON_CHANNEL_H
 
+#include <vector>
+
 #include <ns3/ptr.h>
 #include "ns3/channel.h"
 
@@ -37,6 +39,10 @@ namespace ns3 {
  * PonChannel is designed as an abstract class. XgponChannel is the subclass implemented for XG-PON. 
  * It is responsible to maintain the network devices (OLT and ONUs) attached to this channel
  * and simulate propagation delay and data transmission between OLT and ONUs.
+ *
+ * In downstream, the ONUs with the same propagation delay form one bucket, and one frame is delivered to one bucket through
+ * one event. This event is scheduled with the context of the first awake ONU of the bucket; the other ONUs of the bucket
+ * receive the frame (and schedule their own events) under that context too.
  */
 
 class PonChannel : public Channel
@@ -62,7 +68,7 @@ public:
   void SendUpstream (const Ptr<PonFrame>& frame, uint16_t index);
 
   /**
-   * \brief send the downstream frame from OLT to all ONUs
+   * \brief send the downstream frame from OLT to all ONUs (dormant ONUs excluded)
    * \param frame the frame to be transfered from the OLT to all ONUs.
    */
   void SendDownstream (const Ptr<PonFrame>& frame);
@@ -139,13 +145,37 @@ public:
 
 
 protected:
+  /**
+   * \brief called by subclasses when one ONU is attached or its propagation delay is changed.
+   *        ONUs should be attached and their delays set before the simulation starts.
+   */
+  void InvalidateDelayBuckets (void);
+
   Ptr<PonNetDevice> m_oltDevice;           //the OLT network device attached to this channel.
 
+
+private:
+  //group the ONUs by propagation delay (ascend order of delay; ascend order of index in one bucket)
+  void BuildDelayBuckets (void);
+
+  //deliver one downstream frame to the ONUs of one bucket that were awake when the frame was sent.
+  //awakeOnus is empty when all ONUs of the bucket were awake.
+  void DeliverDownstreamToBucket (const Ptr<PonFrame>& frame, uint32_t bucket, const std::vector<uint16_t>& awakeOnus);
+
+  std::vector< std::vector<uint16_t> > m_delayBuckets;   //the indexes of the ONUs that have the same propagation delay
+  std::vector< uint32_t > m_bucketDelays;                //the propagation delay of each bucket. unit: nanosecond
+  bool m_delayBucketsValid;
 };
 
 
 
 ///////////////////////////////////////////////INLINE FUNCTIONS
+inline void
+PonChannel::InvalidateDelayBuckets (void)
+{
+  m_delayBucketsValid = false;
+}
+
 inline void
 PonChannel::SetOlt (const Ptr<PonNetDevice>& device)
 {
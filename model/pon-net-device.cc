@@ -48,7 +48,7 @@ PonNetDevice::GetInstanceTypeId (void) const
 
 
 
-PonNetDevice::PonNetDevice() : NetDevice(), m_channel(0), m_node(0)
+PonNetDevice::PonNetDevice() : NetDevice(), m_channel(0), m_dormant(false), m_node(0)
 {
 }
 PonNetDevice::~PonNetDevice()
@@ -83,6 +83,12 @@ public:
    */
   uint16_t GetChannelIndex ( );
 
+  /**
+   * \brief a dormant device is skipped by the channel when a downstream frame is sent. used for ONU only
+   */
+  void SetDormant (bool dormant);
+  bool IsDormant ( ) const;
+
 
 
 
@@ -149,6 +155,7 @@ protected:
   uint16_t m_channelIndex;   //index of this interface on the channel. (used by onu only)
                              //when passing one upstream burst to the channel, 
                              //ONU uses this index to allow the channel to get the corresponding propagation delay quickly.
+  bool m_dormant;            //whether downstream frames are delivered to this interface. (used by onu only)
 
   Address m_addr;            //(IP) address of this interface
 
@@ -180,6 +187,17 @@ PonNetDevice::GetChannelIndex ( )
   return m_channelIndex;
 }
 
+inline void 
+PonNetDevice::SetDormant (bool dormant)
+{
+  m_dormant = dormant;
+}
+inline bool 
+PonNetDevice::IsDormant ( ) const
+{
+  return m_dormant;
+}
+
 
 
 
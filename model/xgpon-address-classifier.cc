@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include <algorithm>
+
+#include "xgpon-address-classifier.h"
+
+
+
+namespace ns3{
+
+XgponAddressClassifier::XgponAddressClassifier () : m_conns(0), m_nHostRoutes(0), m_trie(0), m_nPrefixRoutes(0), m_nullConn(0)
+{
+  Rehash (INITIAL_BUCKETS);
+
+  AddTrieNode (0, 0, NO_CONN);   //the root: the empty prefix
+}
+XgponAddressClassifier::~XgponAddressClassifier ()
+{
+}
+
+
+
+
+void
+XgponAddressClassifier::AddHostRoute (const Address& addr, const Ptr<XgponConnectionSender>& conn)
+{
+  if(!Ipv4Address::IsMatchingType (addr))
+  {
+    m_otherRoutes.insert (std::pair<Address, Ptr<XgponConnectionSender> >(addr, conn));
+    return;
+  }
+
+  uint32_t key = Ipv4Address::ConvertFrom (addr).Get ();
+  if(2 * (m_nHostRoutes + 1) > m_buckets.size ()) Rehash (2 * m_buckets.size ());
+
+  Bucket& bucket = m_buckets[FindBucket (key)];
+  if(bucket.m_conn != NO_CONN) return;
+
+  bucket.m_addr = key;
+  bucket.m_conn = m_conns.size ();
+  m_conns.push_back (conn);
+  m_nHostRoutes++;
+}
+
+
+void
+XgponAddressClassifier::AddPrefixRoute (const Ipv4Address& prefix, uint8_t prefixLen, const Ptr<XgponConnectionSender>& conn)
+{
+  NS_ASSERT_MSG((prefixLen<=32), "Unreasonable length of IPv4 prefix!!!");
+
+  uint32_t key = prefix.Get () & GetPrefixMask (prefixLen);
+  uint32_t node = 0;
+
+  //walk down while the prefix of the child is a prefix of the new one (the prefix of "node" always is)
+  while(m_trie[node].m_len < prefixLen)
+  {
+    uint32_t bit = (key >> (31 - m_trie[node].m_len)) & 1;
+    uint32_t child = m_trie[node].m_child[bit];
+    if(child == 0)
+    {
+      uint32_t leaf = AddTrieNode (key, prefixLen, m_conns.size ());
+      m_trie[node].m_child[bit] = leaf;
+      m_conns.push_back (conn);
+      m_nPrefixRoutes++;
+      return;
+    }
+
+    //the length of the prefix shared by the child and the new route
+    uint32_t common = m_trie[node].m_len + 1;
+    uint32_t limit = std::min ((uint32_t)prefixLen, m_trie[child].m_len);
+    while(common < limit && ((key ^ m_trie[child].m_prefix) & GetPrefixMask (common + 1)) == 0) common++;
+
+    if(common == m_trie[child].m_len)
+    {
+      node = child;
+      continue;
+    }
+
+    //split the edge to the child with one node that holds the shared prefix
+    uint32_t split = AddTrieNode (key & GetPrefixMask (common), common, NO_CONN);
+    m_trie[split].m_child[(m_trie[child].m_prefix >> (31 - common)) & 1] = child;
+    m_trie[node].m_child[bit] = split;
+
+    if(common == prefixLen) m_trie[split].m_conn = m_conns.size ();
+    else m_trie[split].m_child[(key >> (31 - common)) & 1] = AddTrieNode (key, prefixLen, m_conns.size ());
+    m_conns.push_back (conn);
+    m_nPrefixRoutes++;
+    return;
+  }
+
+  if(m_trie[node].m_conn == NO_CONN)
+  {
+    m_trie[node].m_conn = m_conns.size ();
+    m_conns.push_back (conn);
+    m_nPrefixRoutes++;
+  }
+  else m_conns[m_trie[node].m_conn] = conn;
+}
+
+
+uint32_t
+XgponAddressClassifier::AddTrieNode (uint32_t prefix, uint32_t len, uint32_t conn)
+{
+  TrieNode trieNode;
+  trieNode.m_prefix = prefix;
+  trieNode.m_mask = GetPrefixMask (len);
+  trieNode.m_len = len;
+  trieNode.m_child[0] = 0;
+  trieNode.m_child[1] = 0;
+  trieNode.m_conn = conn;
+
+  m_trie.push_back (trieNode);
+  return m_trie.size () - 1;
+}
+
+
+
+
+const Ptr<XgponConnectionSender>&
+XgponAddressClassifier::Classify (const Address& addr) const
+{
+  if(Ipv4Address::IsMatchingType (addr)) return Classify (Ipv4Address::ConvertFrom (addr));
+
+  std::map< Address, Ptr<XgponConnectionSender> >::const_iterator it = m_otherRoutes.find (addr);
+  if(it == m_otherRoutes.end ()) return m_nullConn;
+  return it->second;
+}
+
+
+const Ptr<XgponConnectionSender>&
+XgponAddressClassifier::ClassifyByPrefix (uint32_t addr) const
+{
+  uint32_t node = 0;
+  uint32_t best = m_trie[0].m_conn;
+  while(m_trie[node].m_len < 32)
+  {
+    node = m_trie[node].m_child[(addr >> (31 - m_trie[node].m_len)) & 1];
+    if(node == 0 || ((addr ^ m_trie[node].m_prefix) & m_trie[node].m_mask) != 0) break;
+    if(m_trie[node].m_conn != NO_CONN) best = m_trie[node].m_conn;
+  }
+
+  if(best == NO_CONN) return m_nullConn;
+  return m_conns[best];
+}
+
+
+
+
+void
+XgponAddressClassifier::Rehash (uint32_t nBuckets)
+{
+  std::vector<Bucket> old;
+  old.swap (m_buckets);
+
+  Bucket empty;
+  empty.m_addr = 0;
+  empty.m_conn = NO_CONN;
+  m_buckets.assign (nBuckets, empty);
+
+  m_bucketShift = 32;
+  for(uint32_t n = nBuckets; n > 1; n >>= 1) m_bucketShift--;
+
+  for(uint32_t i=0; i<old.size(); i++)
+  {
+    if(old[i].m_conn != NO_CONN) m_buckets[FindBucket (old[i].m_addr)] = old[i];
+  }
+}
+
+
+}//namespace ns3
@@ -0,0 +1,174 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_ADDRESS_CLASSIFIER_H
+#define XGPON_ADDRESS_CLASSIFIER_H
+
+#include <stdint.h>
+#include <vector>
+#include <map>
+
+#include "ns3/address.h"
+#include "ns3/ipv4-address.h"
+
+#include "xgpon-connection-sender.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief Maps the address of one packet to the connection that carries it, without any constraint on the addressing scheme.
+ *
+ * IPv4 host routes are kept in an open-addressing hash table (linear probing, at most half full), so that one lookup usually
+ * reads one bucket. IPv4 prefix routes are kept in a path-compressed binary trie (each node holds the whole prefix that leads
+ * to it, so chains of single-child nodes collapse into one node) that is only searched, for the longest matching prefix, when no
+ * host route matches. One lookup visits at most one node per route on its path. Addresses of other types are kept in a std::map.
+ */
+class XgponAddressClassifier
+{
+public:
+
+  /**
+   * \brief Constructor
+   */
+  XgponAddressClassifier ();
+  virtual ~XgponAddressClassifier ();
+
+
+  /**
+   * \brief add one route for one address. As with std::map::insert, the first connection added for one address is kept.
+   */
+  void AddHostRoute (const Address& addr, const Ptr<XgponConnectionSender>& conn);
+
+  /**
+   * \brief add one route for all IPv4 addresses within the prefix; the route of the same prefix is replaced.
+   */
+  void AddPrefixRoute (const Ipv4Address& prefix, uint8_t prefixLen, const Ptr<XgponConnectionSender>& conn);
+
+
+  /**
+   * \brief find the connection of the address. 0: no found
+   */
+  const Ptr<XgponConnectionSender>& Classify (const Address& addr) const;
+
+  /**
+   * \brief find the connection of the IPv4 address (inline function). 0: no found
+   */
+  const Ptr<XgponConnectionSender>& Classify (const Ipv4Address& addr) const;
+
+
+  uint32_t GetNumberOfHostRoutes () const;
+  uint32_t GetNumberOfPrefixRoutes () const;
+
+
+private:
+  const static uint32_t NO_CONN = 0xFFFFFFFF;
+  const static uint32_t INITIAL_BUCKETS = 64;     //power of 2
+
+  class Bucket
+  {
+  public:
+    uint32_t m_addr;
+    uint32_t m_conn;                               //index in m_conns; NO_CONN: empty bucket
+  };
+
+  class TrieNode
+  {
+  public:
+    uint32_t m_prefix;                             //the bits of this node's prefix; the other bits are 0
+    uint32_t m_mask;                               //the mask of this node's prefix
+    uint32_t m_len;                                //the length of this node's prefix; the child is chosen by the next bit
+    uint32_t m_child[2];                           //index in m_trie; 0: no child (the root never is)
+    uint32_t m_conn;                               //index in m_conns; NO_CONN: no prefix ends here (branching node)
+  };
+
+
+  //the bucket holding the address, or the empty bucket where it should be inserted
+  uint32_t FindBucket (uint32_t addr) const;
+
+  void Rehash (uint32_t nBuckets);
+
+  const Ptr<XgponConnectionSender>& ClassifyByPrefix (uint32_t addr) const;
+
+  //append one trie node without children; return its index
+  uint32_t AddTrieNode (uint32_t prefix, uint32_t len, uint32_t conn);
+
+  static uint32_t GetPrefixMask (uint32_t len);
+
+
+  std::vector< Ptr<XgponConnectionSender> > m_conns;                  //the connections of all routes
+  std::vector<Bucket> m_buckets;                                      //IPv4 host routes
+  uint32_t m_bucketShift;                                             //32 - log2(number of buckets)
+  uint32_t m_nHostRoutes;
+
+  std::vector<TrieNode> m_trie;                                       //IPv4 prefix routes; m_trie[0] is the root
+  uint32_t m_nPrefixRoutes;
+
+  std::map< Address, Ptr<XgponConnectionSender> > m_otherRoutes;      //addresses other than IPv4
+
+  Ptr<XgponConnectionSender> m_nullConn;
+};
+
+
+
+
+//////////////////////////////////////INLINE Functions
+inline uint32_t
+XgponAddressClassifier::GetPrefixMask (uint32_t len)
+{
+  if(len == 0) return 0;
+  return 0xFFFFFFFF << (32 - len);
+}
+
+inline uint32_t
+XgponAddressClassifier::FindBucket (uint32_t addr) const
+{
+  uint32_t mask = m_buckets.size () - 1;
+  uint32_t i = (addr * 2654435769u) >> m_bucketShift;   //Fibonacci hashing
+  while(m_buckets[i].m_conn != NO_CONN && m_buckets[i].m_addr != addr) i = (i + 1) & mask;
+  return i;
+}
+
+inline const Ptr<XgponConnectionSender>&
+XgponAddressClassifier::Classify (const Ipv4Address& addr) const
+{
+  uint32_t key = addr.Get ();
+  const Bucket& bucket = m_buckets[FindBucket (key)];
+  if(bucket.m_conn != NO_CONN) return m_conns[bucket.m_conn];
+  if(m_nPrefixRoutes > 0) return ClassifyByPrefix (key);
+  return m_nullConn;
+}
+
+inline uint32_t
+XgponAddressClassifier::GetNumberOfHostRoutes () const
+{
+  return m_nHostRoutes + m_otherRoutes.size ();
+}
+inline uint32_t
+XgponAddressClassifier::GetNumberOfPrefixRoutes () const
+{
+  return m_nPrefixRoutes;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_ADDRESS_CLASSIFIER_H
@@ -0,0 +1,261 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fstream>
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+
+#include "xgpon-bwmap-recorder.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponBwmapRecorder");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (XgponBwmapRecorder);
+
+TypeId
+XgponBwmapRecorder::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponBwmapRecorder")
+    .SetParent<Object> ()
+    .AddConstructor<XgponBwmapRecorder> ()
+    .AddAttribute ("FileName",
+                   "The name of the BWmap timeline file.",
+                   StringValue ("xgpon-bwmap.bin"),
+                   MakeStringAccessor (&XgponBwmapRecorder::m_fileName),
+                   MakeStringChecker ())
+    .AddAttribute ("InitialCapacity",
+                   "The number of records mapped when the file is opened; the file is doubled when it is full.",
+                   UintegerValue (1 << 20),
+                   MakeUintegerAccessor (&XgponBwmapRecorder::m_initialCapacity),
+                   MakeUintegerChecker<uint64_t> (1024))
+  ;
+  return tid;
+}
+TypeId
+XgponBwmapRecorder::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+XgponBwmapRecorder::XgponBwmapRecorder ()
+  : m_fileName("xgpon-bwmap.bin"), m_initialCapacity(1 << 20),
+    m_fd(-1), m_mapping(0), m_mappedSize(0), m_header(0), m_records(0), m_capacity(0), m_numRecords(0)
+{
+}
+XgponBwmapRecorder::~XgponBwmapRecorder ()
+{
+  Close ();
+}
+
+void
+XgponBwmapRecorder::DoDispose (void)
+{
+  Close ();
+  Object::DoDispose ();
+}
+
+
+
+
+void
+XgponBwmapRecorder::Open (uint32_t frameSlotSize)
+{
+  NS_LOG_FUNCTION(this);
+  NS_ASSERT_MSG((m_fd < 0), "The BWmap recorder has been opened!!!");
+
+  m_fd = open (m_fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  NS_ASSERT_MSG((m_fd >= 0), "Cannot create the BWmap timeline file " << m_fileName);
+
+  m_numRecords = 0;
+  MapFile (m_initialCapacity);
+
+  m_header->m_magic = FILE_MAGIC;
+  m_header->m_version = FORMAT_VERSION;
+  m_header->m_recordSize = sizeof(XgponBwmapRecord);
+  m_header->m_frameSlotSize = frameSlotSize;
+  m_header->m_reserved = 0;
+  m_header->m_numRecords = 0;
+}
+
+
+void
+XgponBwmapRecorder::MapFile (uint64_t capacity)
+{
+  uint64_t size = sizeof(FileHeader) + capacity * sizeof(XgponBwmapRecord);
+  int ret = ftruncate (m_fd, size);
+  NS_ASSERT_MSG((ret == 0), "Cannot resize the BWmap timeline file " << m_fileName);
+
+  void* p = mmap (0, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  NS_ASSERT_MSG((p != MAP_FAILED), "Cannot map the BWmap timeline file " << m_fileName);
+
+  m_mapping = (char*) p;
+  m_mappedSize = size;
+  m_capacity = capacity;
+  m_header = (FileHeader*) m_mapping;
+  m_records = (XgponBwmapRecord*) (m_mapping + sizeof(FileHeader));
+}
+
+
+void
+XgponBwmapRecorder::Grow ()
+{
+  NS_LOG_FUNCTION(this);
+  NS_ASSERT_MSG((m_mapping != 0), "The BWmap recorder has not been opened!!!");
+
+  //one BWmap carries at most 512 allocations, so doubling is always enough.
+  munmap (m_mapping, m_mappedSize);
+  MapFile (m_capacity * 2);
+}
+
+
+void
+XgponBwmapRecorder::Close ()
+{
+  if(m_fd < 0) return;
+
+  NS_LOG_FUNCTION(this);
+
+  munmap (m_mapping, m_mappedSize);
+  int ret = ftruncate (m_fd, sizeof(FileHeader) + m_numRecords * sizeof(XgponBwmapRecord));
+  if(ret != 0) NS_LOG_WARN ("Cannot truncate the BWmap timeline file " << m_fileName);
+  close (m_fd);
+
+  m_fd = -1;
+  m_mapping = 0;
+  m_mappedSize = 0;
+  m_header = 0;
+  m_records = 0;
+  m_capacity = 0;
+}
+
+
+
+
+
+
+
+
+
+XgponBwmapTimelineReader::XgponBwmapTimelineReader ()
+  : m_mapping(0), m_mappedSize(0), m_header(0), m_records(0)
+{
+}
+XgponBwmapTimelineReader::~XgponBwmapTimelineReader ()
+{
+  Close ();
+}
+
+
+bool
+XgponBwmapTimelineReader::Open (const std::string& fileName)
+{
+  Close ();
+
+  int fd = open (fileName.c_str(), O_RDONLY);
+  if(fd < 0) return false;
+
+  struct stat st;
+  if(fstat (fd, &st) != 0 || (uint64_t) st.st_size < sizeof(XgponBwmapRecorder::FileHeader))
+  {
+    close (fd);
+    return false;
+  }
+
+  void* p = mmap (0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if(p == MAP_FAILED) return false;
+
+  m_mapping = (char*) p;
+  m_mappedSize = st.st_size;
+  m_header = (const XgponBwmapRecorder::FileHeader*) m_mapping;
+  m_records = (const XgponBwmapRecord*) (m_mapping + sizeof(XgponBwmapRecorder::FileHeader));
+
+  if(m_header->m_magic != XgponBwmapRecorder::FILE_MAGIC || m_header->m_version != XgponBwmapRecorder::FORMAT_VERSION
+     || m_header->m_recordSize != sizeof(XgponBwmapRecord)
+     || sizeof(XgponBwmapRecorder::FileHeader) + m_header->m_numRecords * sizeof(XgponBwmapRecord) > m_mappedSize)
+  {
+    Close ();
+    return false;
+  }
+  return true;
+}
+
+
+void
+XgponBwmapTimelineReader::Close ()
+{
+  if(m_mapping == 0) return;
+
+  munmap (m_mapping, m_mappedSize);
+  m_mapping = 0;
+  m_mappedSize = 0;
+  m_header = 0;
+  m_records = 0;
+}
+
+
+uint64_t
+XgponBwmapTimelineReader::FindFirstRecordOfFrame (uint32_t frameNumber) const
+{
+  uint64_t low = 0;
+  uint64_t high = GetNumberOfRecords ();
+  while(low < high)
+  {
+    uint64_t mid = low + (high - low) / 2;
+    if(m_records[mid].m_frameNumber < frameNumber) low = mid + 1;
+    else high = mid;
+  }
+
+  if(low < GetNumberOfRecords () && m_records[low].m_frameNumber == frameNumber) return low;
+  else return GetNumberOfRecords ();
+}
+
+
+bool
+XgponBwmapTimelineReader::ExportCsv (const std::string& binFileName, const std::string& csvFileName)
+{
+  XgponBwmapTimelineReader reader;
+  if(!reader.Open (binFileName)) return false;
+
+  std::ofstream out (csvFileName.c_str());
+  if(!out.is_open()) return false;
+
+  out << "frame,alloc_id,start_time,grant_size,dbru,ploamu,burst_profile" << std::endl;
+  for(uint64_t i=0; i<reader.GetNumberOfRecords (); i++)
+  {
+    const XgponBwmapRecord& record = reader.GetRecord (i);
+    out << record.m_frameNumber << "," << record.m_allocId << "," << record.m_startTime << "," << record.m_grantSize << ","
+        << ((record.m_flags & XgponBwmapRecord::DBRU_FLAG) ? 1 : 0) << "," << ((record.m_flags & XgponBwmapRecord::PLOAMU_FLAG) ? 1 : 0) << ","
+        << (uint32_t) record.m_burstProfileIndex << std::endl;
+  }
+  return true;
+}
+
+
+}//namespace ns3
@@ -0,0 +1,239 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_BWMAP_RECORDER_H
+#define XGPON_BWMAP_RECORDER_H
+
+#include <stdint.h>
+#include <string>
+
+#include "ns3/object.h"
+
+#include "xgpon-xgtc-bwmap.h"
+
+
+namespace ns3 {
+
+/**
+ * \brief one bandwidth allocation of one BWmap, as stored in the timeline file (fixed width, 12 bytes).
+ */
+class XgponBwmapRecord
+{
+public:
+  enum XgponBwmapRecordFlag
+  {
+    DBRU_FLAG = 0x01,
+    PLOAMU_FLAG = 0x02,
+  };
+
+  uint32_t m_frameNumber;          //the downstream frame that carries the BWmap (creation time / frame slot size)
+  uint16_t m_allocId;
+  uint16_t m_startTime;            //0xFFFF if not the first allocation of one burst. unit: word
+  uint16_t m_grantSize;            //unit: word
+  uint8_t m_flags;                 //DBRU_FLAG, PLOAMU_FLAG
+  uint8_t m_burstProfileIndex;
+};
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief Appends every BWmap produced by the OLT DBA engine to a memory-mapped binary file.
+ *
+ * The file starts with one header (magic, version, record size, frame slot size, number of records) and is followed by
+ * one XgponBwmapRecord per bandwidth allocation. Recording one allocation is a handful of stores into the mapped pages;
+ * the file is grown (doubled) when it is full and truncated to the recorded size when the recorder is closed.
+ * Attached through XgponOltDbaEngine::SetBwmapRecorder; the file is read back with XgponBwmapTimelineReader.
+ */
+class XgponBwmapRecorder : public Object
+{
+public:
+  const static uint32_t FILE_MAGIC = 0x544d4258;       //"XBMT"
+  const static uint16_t FORMAT_VERSION = 1;
+
+  class FileHeader
+  {
+  public:
+    uint32_t m_magic;
+    uint16_t m_version;
+    uint16_t m_recordSize;
+    uint32_t m_frameSlotSize;      //unit: nanosecond
+    uint32_t m_reserved;
+    uint64_t m_numRecords;
+  };
+
+
+  /**
+   * \brief Constructor
+   */
+  XgponBwmapRecorder ();
+  virtual ~XgponBwmapRecorder ();
+
+
+  /**
+   * \brief create the file and map its first "InitialCapacity" records.
+   * \param frameSlotSize the downstream frame slot size stored in the header. unit: nanosecond
+   */
+  void Open (uint32_t frameSlotSize);
+
+  /**
+   * \brief unmap the file and truncate it to the recorded size.
+   */
+  void Close ();
+
+  bool IsOpened () const;
+
+
+  /**
+   * \brief append all bandwidth allocations of one BWmap.
+   * \param frameNumber the downstream frame that carries the BWmap
+   */
+  void RecordBwmap (uint32_t frameNumber, const Ptr<XgponXgtcBwmap>& bwmap);
+
+
+
+  ///////////////////////////////////////////Functions required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+
+protected:
+  virtual void DoDispose (void);
+
+
+private:
+  //map the file with the given capacity (number of records)
+  void MapFile (uint64_t capacity);
+
+  //double the capacity of the file
+  void Grow ();
+
+
+  std::string m_fileName;
+  uint64_t m_initialCapacity;        //unit: record
+
+  int m_fd;
+  char* m_mapping;
+  uint64_t m_mappedSize;             //unit: byte
+  FileHeader* m_header;
+  XgponBwmapRecord* m_records;
+  uint64_t m_capacity;               //unit: record
+  uint64_t m_numRecords;
+};
+
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief Read-only access to one timeline file produced by XgponBwmapRecorder (the file is memory-mapped).
+ */
+class XgponBwmapTimelineReader
+{
+public:
+  XgponBwmapTimelineReader ();
+  ~XgponBwmapTimelineReader ();
+
+  /**
+   * \return false if the file cannot be mapped or is not one BWmap timeline.
+   */
+  bool Open (const std::string& fileName);
+  void Close ();
+
+  uint64_t GetNumberOfRecords () const;
+  uint32_t GetFrameSlotSize () const;       //unit: nanosecond
+  const XgponBwmapRecord& GetRecord (uint64_t index) const;
+
+  /**
+   * \brief find the first record of the given frame (binary search; the records are in the order of frames).
+   * \return the number of records if no BWmap of this frame is recorded.
+   */
+  uint64_t FindFirstRecordOfFrame (uint32_t frameNumber) const;
+
+  /**
+   * \brief convert one timeline file into one CSV file.
+   */
+  static bool ExportCsv (const std::string& binFileName, const std::string& csvFileName);
+
+private:
+  char* m_mapping;
+  uint64_t m_mappedSize;
+  const XgponBwmapRecorder::FileHeader* m_header;
+  const XgponBwmapRecord* m_records;
+};
+
+
+
+
+
+
+///////////////////////////////////////////////////////////INLINE Functions
+inline bool
+XgponBwmapRecorder::IsOpened () const
+{
+  return m_mapping != 0;
+}
+
+inline void
+XgponBwmapRecorder::RecordBwmap (uint32_t frameNumber, const Ptr<XgponXgtcBwmap>& bwmap)
+{
+  uint16_t num = bwmap->GetNumberOfBwAllocation ( );
+  if(m_numRecords + num > m_capacity) Grow ();
+
+  XgponBwmapRecord* record = m_records + m_numRecords;
+  for(uint16_t i=0; i<num; i++, record++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex (i);
+    record->m_frameNumber = frameNumber;
+    record->m_allocId = bwAlloc.GetAllocId ( );
+    record->m_startTime = bwAlloc.GetStartTime ( );
+    record->m_grantSize = bwAlloc.GetGrantSize ( );
+    record->m_flags = (bwAlloc.GetDbruFlag ( ) ? XgponBwmapRecord::DBRU_FLAG : 0) | (bwAlloc.GetPloamuFlag ( ) ? XgponBwmapRecord::PLOAMU_FLAG : 0);
+    record->m_burstProfileIndex = bwAlloc.GetBurstProfileIndex ( );
+  }
+  m_numRecords += num;
+  m_header->m_numRecords = m_numRecords;
+}
+
+
+
+inline uint64_t
+XgponBwmapTimelineReader::GetNumberOfRecords () const
+{
+  return (m_header != 0) ? m_header->m_numRecords : 0;
+}
+
+inline uint32_t
+XgponBwmapTimelineReader::GetFrameSlotSize () const
+{
+  return (m_header != 0) ? m_header->m_frameSlotSize : 0;
+}
+
+inline const XgponBwmapRecord&
+XgponBwmapTimelineReader::GetRecord (uint64_t index) const
+{
+  NS_ASSERT_MSG((index < GetNumberOfRecords ()), "Out of the range of the BWmap timeline!!!");
+  return m_records[index];
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_BWMAP_RECORDER_H
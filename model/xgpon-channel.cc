@@ -21,8 +21,10 @@
 
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 
 #include "xgpon-channel.h"
+#include "xgpon-onu-net-device.h"
 
 
 NS_LOG_COMPONENT_DEFINE ("XgponChannel");
@@ -42,7 +44,16 @@ XgponChannel::GetTypeId (void)
                    UintegerValue (XgponChannel::DEFAULT_LOGIC_ONE_WAY_DELAY),
                    MakeUintegerAccessor (&XgponChannel::m_logicOneWayDelay),
                    MakeUintegerChecker<uint32_t> ())
-
+    .AddAttribute ("BatchUpstreamBursts",
+                   "Whether the OLT assembles the upstream bursts scheduled in one BWmap with a few batch events, instead of one event per burst at each ONU.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&XgponChannel::m_batchUpstreamBursts),
+                   MakeBooleanChecker ())
+    .AddAttribute ("IdleFastForward",
+                   "Whether the downstream frames are not delivered to the ONUs that have nothing to send or receive (dormant ONUs).",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&XgponChannel::m_idleFastForward),
+                   MakeBooleanChecker ())
 
   ;
   return tid;
@@ -54,7 +65,7 @@ XgponChannel::GetInstanceTypeId (void) const
 }
 
 
-XgponChannel::XgponChannel () : PonChannel(), m_onuDevices(0), m_onuPropDelays(0)
+XgponChannel::XgponChannel () : PonChannel(), m_onuDevices(0), m_onuPropDelays(0), m_onusById(0), m_numOnusById(0), m_batchUpstreamBursts(false), m_idleFastForward(false)
 {
 }
 XgponChannel::~XgponChannel ()
@@ -64,4 +75,26 @@ XgponChannel::~XgponChannel ()
 
 
 
+const Ptr<XgponOnuNetDevice>& 
+XgponChannel::GetOnuById (uint16_t onuId)
+{
+  if(m_numOnusById != m_onuDevices.size())
+  {
+    m_onusById.assign (MAXIMAL_NODES_PER_XGPON, 0);
+    for(uint32_t i=0; i<m_onuDevices.size(); i++)
+    {
+      Ptr<XgponOnuNetDevice> onu = DynamicCast<XgponOnuNetDevice, PonNetDevice> (m_onuDevices[i]);
+      NS_ASSERT_MSG((onu!=0 && onu->GetOnuId() < MAXIMAL_NODES_PER_XGPON), "Strange ONU attached to the channel!!!");
+      m_onusById[onu->GetOnuId()] = onu;
+    }
+    m_numOnusById = m_onuDevices.size();
+  }
+
+  if(onuId < m_onusById.size()) return m_onusById[onuId];
+  else return m_nullOnu;
+}
+
+
+
+
 } // namespace ns3
@@ -30,6 +30,8 @@
 
 namespace ns3 {
 
+class XgponOnuNetDevice;
+
 /**
  * \ingroup xgpon
  * \brief A simple XG-PON instance of PON channel.
@@ -42,6 +44,7 @@ public:
   const static uint16_t MAXIMAL_NODES_PER_XGPON = 1024;        //The maximal number of onus supported by the channel.
   const static uint32_t DEFAULT_LOGIC_ONE_WAY_DELAY = 400000;  //Unit: nanosecond;   0.4ms
                                                                //the one way propagation delay (light in optical fibre --- 2*10^8) for a distance of 60km + process delay 
+  const static uint32_t PROPAGATION_DELAY_PER_KM = 5000;       //Unit: nanosecond; light in optical fibre --- 2*10^8 m/s
 
 
   /**
@@ -73,6 +76,12 @@ public:
    */
   virtual const Ptr<PonNetDevice>& GetOnuByIndex (uint32_t index) const;
 
+  /**
+   * \brief Get Onu device based on onu-id. 0: not found.
+   *        The table is built when the ONUs have got their ids and rebuilt when more ONUs are attached.
+   */
+  const Ptr<XgponOnuNetDevice>& GetOnuById (uint16_t onuId);
+
 
   /**
    * \brief Set the one-way propagation delay between OLT and one ONU. The unit of the delay is nanosecond.
@@ -102,6 +111,19 @@ public:
   uint32_t GetLogicOneWayDelay (void) const;   
 
 
+  /**
+   * \brief whether the upstream bursts of one BWmap are assembled and delivered in batches by the OLT (XgponOltUsBurstAssembler)
+   *        instead of one transmission event per ONU burst. Configured through the attribute "BatchUpstreamBursts".
+   */
+  bool GetBatchUpstreamBursts (void) const;
+
+  /**
+   * \brief whether the OLT stops delivering downstream frames to idle ONUs (XgponOltDormancyManager).
+   *        Configured through the attribute "IdleFastForward".
+   */
+  bool GetIdleFastForward (void) const;
+
+
 
 
 
@@ -117,11 +139,18 @@ private:
 
   //different channels (passive splitters included) may be implemented in the future and different data structures may be used for ONUs.
   std::vector< Ptr<PonNetDevice> > m_onuDevices;    //NetDevices entities of all ONU network devices attached to this channel. 
-  std::vector< uint32_t > m_onuPropDelays;          //to simulate different distances to OLT in the future. 
+  std::vector< uint32_t > m_onuPropDelays;          //one-way propagation delay of each ONU (from its fibre distance to the OLT). 
+
+  std::vector< Ptr<XgponOnuNetDevice> > m_onusById; //ONU network devices indexed by onu-id; built on demand.
+  uint16_t m_numOnusById;                           //the number of ONUs when m_onusById was built.
+  Ptr<XgponOnuNetDevice> m_nullOnu;
 
 
   uint32_t m_logicOneWayDelay;                      //the logic one way delay agreed/observed by OLT and all ONUs to avoid upstream collision.
                                                     //Unit: nanosecond; Note that EPON has no such concept.
+
+  bool m_batchUpstreamBursts;                       //whether the upstream bursts are assembled per BWmap by the OLT.
+  bool m_idleFastForward;                           //whether the downstream frames skip the dormant ONUs.
 };
 
 
@@ -136,6 +165,7 @@ XgponChannel::AddOnu (const Ptr<PonNetDevice>& device)
 
   //The delay is initialized to 0. It will be set later through "SetOnuPropagationDelay".
   m_onuPropDelays.push_back (0);  
+  InvalidateDelayBuckets ();
 
   return m_onuDevices.size () - 1;
 }
@@ -158,6 +188,7 @@ inline void
 XgponChannel::SetOnuPropagationDelay (uint16_t onuIndex, uint32_t delay)
 {
   m_onuPropDelays[onuIndex] = delay;
+  InvalidateDelayBuckets ();
 }
 inline uint32_t 
 XgponChannel::GetOnuPropagationDelay (uint16_t onuIndex) const
@@ -177,6 +208,18 @@ XgponChannel::GetLogicOneWayDelay (void) const
   return m_logicOneWayDelay;
 }
 
+inline bool
+XgponChannel::GetBatchUpstreamBursts (void) const
+{
+  return m_batchUpstreamBursts;
+}
+
+inline bool
+XgponChannel::GetIdleFastForward (void) const
+{
+  return m_idleFastForward;
+}
+
 
 
 } // namespace ns3
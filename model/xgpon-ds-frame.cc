@@ -20,6 +20,7 @@
 #include "ns3/log.h"
 
 #include "ns3/xgpon-ds-frame.h"
+#include "xgpon-memory-census.h"
 
 
 
@@ -27,25 +28,14 @@ NS_LOG_COMPONENT_DEFINE ("XgponDsFrame");
 
 namespace ns3 {
 
-//uint64_t XgponDsFrame::CREATED_DS_FRAME_NUM4DEBUG = 0;
-//uint64_t XgponDsFrame::DELETED_DS_FRAME_NUM4DEBUG = 0;
-
 std::stack<void*> XgponDsFrame::m_pool;   //initialize as one empty stack;
 bool XgponDsFrame::m_poolEnabled = true;
 
 XgponDsFrame::XgponDsFrame () : PonFrame()
 {
-  /*
-  CREATED_DS_FRAME_NUM4DEBUG++;
-  if((CREATED_DS_FRAME_NUM4DEBUG % 1000) == 0)
-  {
-    std::cout << CREATED_DS_FRAME_NUM4DEBUG << " downstream frames are created;  " << DELETED_DS_FRAME_NUM4DEBUG <<  " downstream frames are deleted." <<std::endl;
-  }
-  */
 }
 XgponDsFrame::~XgponDsFrame ()
 {
-  //DELETED_DS_FRAME_NUM4DEBUG++;
 }
 
 
@@ -66,12 +56,14 @@ XgponDsFrame::operator new(size_t size) noexcept(false) //throw(const char*)
     p = m_pool.top();
     m_pool.pop();  
     NS_LOG_INFO("allocated XgponDsFrame through the pool!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::DS_FRAME, size, XgponMemoryCensus::FROM_POOL);
   }
   else
   {
     p = malloc(size);
     if (!p) throw "cannot allocate more memory from the system!!!";
     NS_LOG_INFO("allocated XgponDsFrame through malloc!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::DS_FRAME, size, XgponMemoryCensus::FROM_MALLOC);
   }
   return p;
 }
@@ -84,6 +76,7 @@ XgponDsFrame::operator delete(void *p)
     m_pool.push(p);
   }
   else free(p);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::DS_FRAME, sizeof(XgponDsFrame), m_pool.size());
 }
 
 void 
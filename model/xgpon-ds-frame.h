@@ -42,9 +42,6 @@ namespace ns3 {
  */
 class XgponDsFrame : public PonFrame
 {
-  //static uint64_t CREATED_DS_FRAME_NUM4DEBUG;
-  //static uint64_t DELETED_DS_FRAME_NUM4DEBUG;
-
   //used to allocate/free this class from a pool to save CPU.
   static bool m_poolEnabled;
   static std::stack<void*> m_pool;
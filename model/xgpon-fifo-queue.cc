@@ -134,6 +134,7 @@ XgponFifoQueue::DoDequeue (void)
       //to make sure that pop happens at the same frequency as push
       {
 				m_allPacket.at(m_popIndex+2) = now; 	// time the packet is deleted from queue (US Tx time)
+        m_queueDelayTrace (m_allocId, (uint32_t) m_allPacket.at(m_popIndex+3), m_allPacket.at(m_popIndex+1), now);
         m_popIndex = m_popIndex + 5;		// 5 elements are added above each time packet is in queue.
         //std::cout << "m_popIndex " << m_popIndex << " AllocId "<< m_allocId << std::endl;
 				/* once 100 packets have been transferred, vector is reset to prevent the memory size from growing
@@ -0,0 +1,200 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include "xgpon-frame-arena.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponFrameArena");
+
+namespace ns3 {
+
+XgponFrameArena* XgponFrameArena::m_activeArena = 0;
+std::stack<XgponFrameArena*> XgponFrameArena::m_freeArenas;   //initialize as one empty stack;
+bool XgponFrameArena::m_recyclingEnabled = true;
+
+
+XgponFrameArena::XgponFrameArena ()
+  : m_blocks(0), m_blockIndex(0), m_offset(0),
+    m_liveObjects(0), m_open(false), m_previous(0)
+{
+}
+XgponFrameArena::~XgponFrameArena ()
+{
+  for(uint32_t i=0; i<m_blocks.size(); i++) { free(m_blocks[i]); }
+  m_blocks.clear();
+}
+
+
+
+
+XgponFrameArena*
+XgponFrameArena::Open ()
+{
+  XgponFrameArena* arena;
+  if(!m_freeArenas.empty())
+  {
+    arena = m_freeArenas.top();
+    m_freeArenas.pop();
+  }
+  else arena = new XgponFrameArena ();
+
+  arena->m_open = true;
+  arena->m_previous = m_activeArena;
+  m_activeArena = arena;
+
+  return arena;
+}
+
+void
+XgponFrameArena::Close (XgponFrameArena* arena)
+{
+  NS_ASSERT_MSG((arena == m_activeArena && arena->m_open), "Frame arenas must be closed in the reverse order of opening!!!");
+
+  arena->m_open = false;
+  m_activeArena = arena->m_previous;
+  arena->m_previous = 0;
+
+  //nothing has been allocated or everything has already been released.
+  if(arena->m_liveObjects == 0) arena->Recycle ();
+}
+
+
+
+
+void*
+XgponFrameArena::Allocate (size_t size)
+{
+  //keep the next chunk aligned as the header does
+  uint32_t chunkSize = HEADER_SIZE + ((size + HEADER_SIZE - 1) / HEADER_SIZE) * HEADER_SIZE;
+  NS_ASSERT_MSG((chunkSize <= BLOCK_SIZE), "The object is too large to be allocated from a frame arena!!!");
+
+  if(m_blocks.empty() || (m_offset + chunkSize) > BLOCK_SIZE)
+  {
+    if(!m_blocks.empty()) { m_blockIndex++; }
+    m_offset = 0;
+
+    if(m_blockIndex == m_blocks.size())
+    {
+      char* block = (char*) malloc(BLOCK_SIZE);
+      if (!block) throw "cannot allocate more memory from the system!!!";
+      m_blocks.push_back(block);
+    }
+  }
+
+  char* chunk = m_blocks[m_blockIndex] + m_offset;
+  m_offset += chunkSize;
+  m_liveObjects++;
+
+  *((XgponFrameArena**) chunk) = this;
+  return chunk + HEADER_SIZE;
+}
+
+void
+XgponFrameArena::Release ()
+{
+  NS_ASSERT_MSG((m_liveObjects > 0), "More objects are released than allocated from this frame arena!!!");
+
+  m_liveObjects--;
+  if(m_liveObjects == 0 && !m_open) Recycle ();
+}
+
+void
+XgponFrameArena::Recycle ()
+{
+  //one pointer reset releases all the per-frame memory
+  m_blockIndex = 0;
+  m_offset = 0;
+
+  if(m_recyclingEnabled) m_freeArenas.push(this);
+  else delete this;
+}
+
+
+
+
+void*
+XgponFrameArena::AllocateObject (size_t size, bool poolEnabled, std::stack<void*>& pool)
+{
+  if(m_activeArena != 0)
+  {
+    NS_LOG_INFO("allocated one per-frame object through the frame arena!!!");
+    return m_activeArena->Allocate (size);
+  }
+
+  void *p;
+  if(poolEnabled == true && (!pool.empty()))
+  {
+    p = pool.top();
+    pool.pop();
+    NS_LOG_INFO("allocated one per-frame object through the pool!!!");
+  }
+  else
+  {
+    char* chunk = (char*) malloc(size + HEADER_SIZE);
+    if (!chunk) throw "cannot allocate more memory from the system!!!";
+    *((XgponFrameArena**) chunk) = 0;
+    p = chunk + HEADER_SIZE;
+    NS_LOG_INFO("allocated one per-frame object through malloc!!!");
+  }
+  return p;
+}
+
+void
+XgponFrameArena::FreeObject (void* p, bool poolEnabled, std::stack<void*>& pool)
+{
+  char* chunk = ((char*) p) - HEADER_SIZE;
+  XgponFrameArena* arena = *((XgponFrameArena**) chunk);
+
+  if(arena != 0) arena->Release ();
+  else if(poolEnabled == true) pool.push(p);
+  else free(chunk);
+}
+
+void
+XgponFrameArena::ClearPool (std::stack<void*>& pool)
+{
+  while (!pool.empty())
+  {
+    free(((char*) pool.top()) - HEADER_SIZE);
+    pool.pop();
+  }
+}
+
+
+
+
+void
+XgponFrameArena::DisableArenaRecycling ()
+{
+  m_recyclingEnabled = false;
+
+  //the arenas still in use will be deleted when their last objects are released.
+  while (!m_freeArenas.empty())
+  {
+    delete m_freeArenas.top();
+    m_freeArenas.pop();
+  }
+}
+
+
+}; // namespace ns3
@@ -0,0 +1,137 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_FRAME_ARENA_H
+#define XGPON_FRAME_ARENA_H
+
+#include <cstdlib>
+#include <stack>
+#include <vector>
+
+#include <stdint.h>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief A bump allocator whose lifetime is tied to one downstream frame or one upstream burst.
+ *
+ * While an arena is open, the per-frame classes (XgponXgemFrame, XgponXgtcUsAllocation) take their memory
+ * from it instead of from their pools. The arena counts the objects carved out of it; once it has been closed
+ * and the last of these objects is deleted (i.e., the last consumer of the frame is done), the whole arena is
+ * reset by rewinding its bump pointer and is recycled for a later frame.
+ *
+ * Every chunk handed out by AllocateObject carries a small header that records the owning arena (0 for chunks
+ * from malloc/pool), so that operator delete of these classes can route the memory back to the right place.
+ */
+class XgponFrameArena
+{
+  const static uint32_t BLOCK_SIZE = 65536;   //size of one memory block of the arena
+
+public:
+  const static uint32_t HEADER_SIZE = 16;     //keep the object aligned as malloc does
+
+
+  /**
+   * \brief open one arena for the frame/burst to be produced.
+   *        The objects created before the matched Close are allocated from it.
+   */
+  static XgponFrameArena* Open ();
+
+  /**
+   * \brief stop allocating from the arena. It will be recycled after all its objects are deleted.
+   */
+  static void Close (XgponFrameArena* arena);
+
+  /**
+   * \brief the arena that is currently open. 0: no arena is open.
+   */
+  static XgponFrameArena* GetActiveArena ();
+
+
+
+  /**
+   * \brief allocate memory for one per-frame object: from the open arena, or from the pool/malloc otherwise.
+   * \param size the size of the object (without the header)
+   * \param poolEnabled whether the pool of the class can be used
+   * \param pool the pool of the class (chunks from this pool contain the header too)
+   */
+  static void* AllocateObject (size_t size, bool poolEnabled, std::stack<void*>& pool);
+
+  /**
+   * \brief release the memory of one object allocated by AllocateObject.
+   */
+  static void FreeObject (void* p, bool poolEnabled, std::stack<void*>& pool);
+
+  /**
+   * \brief free the chunks kept in the pool of one class (called by DisablePoolAllocation of that class).
+   */
+  static void ClearPool (std::stack<void*>& pool);
+
+
+  //called before the end of simulation to avoid memory leakage.
+  static void DisableArenaRecycling ();
+
+
+
+private:
+  XgponFrameArena ();
+  ~XgponFrameArena ();
+
+  //allocate one chunk from the memory blocks of this arena
+  void* Allocate (size_t size);
+
+  //one object allocated from this arena has been deleted.
+  void Release ();
+
+  //rewind the bump pointer and put the arena into the free list (or delete it at the end of the simulation).
+  void Recycle ();
+
+
+  std::vector<char*> m_blocks;          //memory blocks of this arena. They are kept across frames.
+  uint32_t m_blockIndex;                //the block that is being used
+  uint32_t m_offset;                    //bump pointer in the current block
+
+  uint32_t m_liveObjects;               //the number of objects that have not been deleted
+  bool m_open;                          //whether new objects can be allocated from this arena
+  XgponFrameArena* m_previous;          //the arena that was open before this one was opened
+
+
+  static XgponFrameArena* m_activeArena;
+  static std::stack<XgponFrameArena*> m_freeArenas;
+  static bool m_recyclingEnabled;
+};
+
+
+
+
+
+///////////////////////////////////////////////INLINE Functions
+inline XgponFrameArena*
+XgponFrameArena::GetActiveArena ()
+{
+  return m_activeArena;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_FRAME_ARENA_H
@@ -0,0 +1,355 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include <sstream>
+
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+
+#include "xgpon-golden-trace.h"
+#include "xgpon-net-device.h"
+#include "xgpon-xgtc-bw-allocation.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponGoldenTrace");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (XgponGoldenTrace);
+
+static const uint64_t DIGEST_SEED = 0xcbf29ce484222325ULL;   //FNV-1a offset basis
+
+
+TypeId
+XgponGoldenTrace::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponGoldenTrace")
+    .SetParent<Object> ()
+    .AddConstructor<XgponGoldenTrace> ()
+    .AddAttribute ("FileName",
+                   "The name of the golden trace file.",
+                   StringValue ("xgpon-golden.bin"),
+                   MakeStringAccessor (&XgponGoldenTrace::m_fileName),
+                   MakeStringChecker ())
+    .AddAttribute ("Compare",
+                   "Compare this run with the golden trace file instead of recording it.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&XgponGoldenTrace::m_compare),
+                   MakeBooleanChecker ())
+    .AddAttribute ("SkipIdleFrames",
+                   "Leave out the empty DBRus and the frames in which nothing but polling happens.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&XgponGoldenTrace::m_skipIdleFrames),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+TypeId
+XgponGoldenTrace::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+
+XgponGoldenTrace::XgponGoldenTrace () : m_compare(false), m_skipIdleFrames(false), m_file(0), m_numFrames(0), m_reportDigest(DIGEST_SEED),
+  m_diverged(false), m_hasLastMatch(false)
+{
+}
+XgponGoldenTrace::~XgponGoldenTrace ()
+{
+}
+
+void
+XgponGoldenTrace::DoDispose (void)
+{
+  Close ();
+  m_devices.clear ();
+  Object::DoDispose ();
+}
+
+
+
+
+bool
+XgponGoldenTrace::Open ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG((m_file == 0), "The golden trace has already been opened!!!");
+
+  FileHeader header;
+  if(m_compare)
+  {
+    m_file = fopen (m_fileName.c_str(), "rb");
+    if(m_file == 0) return false;
+
+    if(fread (&header, sizeof(FileHeader), 1, m_file) != 1 || header.m_magic != FILE_MAGIC 
+       || header.m_version != FORMAT_VERSION || header.m_recordSize != sizeof(XgponGoldenTraceRecord))
+    {
+      fclose (m_file);
+      m_file = 0;
+      return false;
+    }
+  }
+  else
+  {
+    m_file = fopen (m_fileName.c_str(), "wb");
+    if(m_file == 0) return false;
+
+    header.m_magic = FILE_MAGIC;
+    header.m_version = FORMAT_VERSION;
+    header.m_recordSize = sizeof(XgponGoldenTraceRecord);
+    header.m_reserved = 0;
+    fwrite (&header, sizeof(FileHeader), 1, m_file);
+  }
+
+  return true;
+}
+
+
+void
+XgponGoldenTrace::Close ()
+{
+  NS_LOG_FUNCTION (this);
+  if(m_file == 0) return;
+
+  if(m_compare && !m_diverged)
+  {
+    XgponGoldenTraceRecord reference;
+    if(fread (&reference, sizeof(XgponGoldenTraceRecord), 1, m_file) == 1)
+    {
+      std::ostringstream os;
+      os << "this run stopped after " << m_numFrames << " frames, but the golden trace goes on from frame " << reference.m_frameNumber;
+      m_divergence = os.str();
+      m_diverged = true;
+    }
+  }
+
+  fclose (m_file);
+  m_file = 0;
+}
+
+
+void
+XgponGoldenTrace::AddDevice (const Ptr<XgponNetDevice>& device)
+{
+  m_devices.push_back (device);
+}
+
+
+
+
+void
+XgponGoldenTrace::RecordStatusReport (uint16_t onuId, uint16_t allocId, uint32_t bufOcc)
+{
+  if(m_file == 0 || m_diverged) return;
+  if(m_skipIdleFrames && bufOcc == 0) return;
+
+  m_reportDigest = Fold (Fold (Fold (m_reportDigest, onuId), allocId), bufOcc);
+
+  Report report;
+  report.m_onuId = onuId;
+  report.m_allocId = allocId;
+  report.m_bufOcc = bufOcc;
+  m_reports.push_back (report);
+}
+
+
+void
+XgponGoldenTrace::RecordBwmap (uint64_t frameNumber, const Ptr<XgponXgtcBwmap>& bwmap)
+{
+  if(m_file == 0 || m_diverged) return;
+
+  XgponGoldenTraceRecord record;
+  record.m_frameNumber = frameNumber;
+  record.m_numAllocations = bwmap->GetNumberOfBwAllocation ( );
+  record.m_numReports = m_reports.size();
+  record.m_reportDigest = m_reportDigest;
+  record.m_reserved = 0;
+
+  uint64_t digest = DIGEST_SEED;
+  for(uint16_t i=0; i<record.m_numAllocations; i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex (i);
+    uint64_t flags = (bwAlloc.GetDbruFlag() << 16) | (bwAlloc.GetPloamuFlag() << 8) | bwAlloc.GetBurstProfileIndex();
+    digest = Fold (digest, ((uint64_t) bwAlloc.GetAllocId() << 48) | ((uint64_t) bwAlloc.GetStartTime() << 32) 
+                           | ((uint64_t) bwAlloc.GetGrantSize() << 16));
+    digest = Fold (digest, flags);
+  }
+  record.m_bwmapDigest = digest;
+
+  DigestDeliveredBytes (record);
+
+  if(m_skipIdleFrames && m_reports.empty() && m_delivered == m_lastDelivered)
+  {
+    bool polling = true;
+    for(uint16_t i=0; i<record.m_numAllocations && polling; i++)
+    {
+      const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex (i);
+      polling = (bwAlloc.GetGrantSize() <= bwAlloc.GetDbruFlag());
+    }
+    if(polling) return;
+  }
+
+  if(!m_compare)
+  {
+    fwrite (&record, sizeof(XgponGoldenTraceRecord), 1, m_file);
+  }
+  else
+  {
+    XgponGoldenTraceRecord reference;
+    if(fread (&reference, sizeof(XgponGoldenTraceRecord), 1, m_file) != 1)
+    {
+      ReportDivergence (record, 0, bwmap);
+    }
+    else if(reference.m_frameNumber != record.m_frameNumber || reference.m_bwmapDigest != record.m_bwmapDigest 
+            || reference.m_numAllocations != record.m_numAllocations || reference.m_reportDigest != record.m_reportDigest 
+            || reference.m_numReports != record.m_numReports || reference.m_deliveredDigest != record.m_deliveredDigest 
+            || reference.m_deliveredBytes != record.m_deliveredBytes)
+    {
+      ReportDivergence (record, &reference, bwmap);
+    }
+    else
+    {
+      m_lastMatch = record;
+      m_hasLastMatch = true;
+    }
+  }
+
+  m_numFrames++;
+  m_reportDigest = DIGEST_SEED;
+  m_reports.clear ();
+  m_lastDelivered.swap (m_delivered);
+}
+
+
+void
+XgponGoldenTrace::DigestDeliveredBytes (XgponGoldenTraceRecord& record)
+{
+  uint64_t digest = DIGEST_SEED;
+  uint64_t total = 0;
+
+  //per device: the downstream bytes of one ONU, then the upstream bytes of each ONU (only filled at the OLT).
+  m_delivered.clear ();
+  for(uint32_t i=0; i<m_devices.size(); i++)
+  {
+    const XgponNetDeviceStatistics& stat = m_devices[i]->GetStatistics ( );
+    m_delivered.push_back (stat.m_dsOnuBytes);
+    for(uint32_t j=0; j<stat.m_perOnu.size(); j++) { m_delivered.push_back (stat.m_perOnu[j].m_usBytes); }
+  }
+
+  for(uint32_t k=0; k<m_delivered.size(); k++)
+  {
+    digest = Fold (digest, m_delivered[k]);
+    total += m_delivered[k];
+  }
+
+  record.m_deliveredDigest = digest;
+  record.m_deliveredBytes = total;
+}
+
+
+
+
+void
+XgponGoldenTrace::ReportDivergence (const XgponGoldenTraceRecord& current, const XgponGoldenTraceRecord* reference, const Ptr<XgponXgtcBwmap>& bwmap)
+{
+  std::ostringstream os;
+
+  os << "first divergence at frame " << current.m_frameNumber << ", after " << m_numFrames << " identical frames" << std::endl;
+  if(m_hasLastMatch) os << "  last matching frame: " << m_lastMatch.m_frameNumber << std::endl;
+
+  if(reference == 0)
+  {
+    os << "  the golden trace ends before this frame" << std::endl;
+  }
+  else
+  {
+    if(reference->m_frameNumber != current.m_frameNumber) 
+      os << "  frame number: " << current.m_frameNumber << " (golden: " << reference->m_frameNumber << ")" << std::endl;
+    if(reference->m_bwmapDigest != current.m_bwmapDigest || reference->m_numAllocations != current.m_numAllocations)
+      os << "  BWmap differs: " << current.m_numAllocations << " allocations (golden: " << reference->m_numAllocations << ")" << std::endl;
+    if(reference->m_reportDigest != current.m_reportDigest || reference->m_numReports != current.m_numReports)
+      os << "  DBRus differ: " << current.m_numReports << " reports (golden: " << reference->m_numReports << ")" << std::endl;
+    if(reference->m_deliveredDigest != current.m_deliveredDigest || reference->m_deliveredBytes != current.m_deliveredBytes)
+      os << "  delivered bytes differ: " << current.m_deliveredBytes << " in total (golden: " << reference->m_deliveredBytes << ")" << std::endl;
+  }
+
+  os << "  BWmap of this run (alloc-id, StartTime, GrantSize, DBRu, PLOAMu, profile):" << std::endl;
+  for(uint16_t i=0; i<bwmap->GetNumberOfBwAllocation(); i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex (i);
+    os << "    " << bwAlloc.GetAllocId() << "," << bwAlloc.GetStartTime() << "," << bwAlloc.GetGrantSize() << "," 
+       << (uint32_t) bwAlloc.GetDbruFlag() << "," << (uint32_t) bwAlloc.GetPloamuFlag() << "," 
+       << (uint32_t) bwAlloc.GetBurstProfileIndex() << std::endl;
+  }
+
+  os << "  DBRus received since the previous BWmap (onu-id, alloc-id, buffer occupancy):" << std::endl;
+  for(uint32_t i=0; i<m_reports.size(); i++)
+  {
+    os << "    " << m_reports[i].m_onuId << "," << m_reports[i].m_allocId << "," << m_reports[i].m_bufOcc << std::endl;
+  }
+
+  //walk the devices in the order of DigestDeliveredBytes to label the values.
+  os << "  delivered bytes changed in this frame:" << std::endl;
+  uint32_t k = 0;
+  for(uint32_t i=0; i<m_devices.size(); i++)
+  {
+    const XgponNetDeviceStatistics& stat = m_devices[i]->GetStatistics ( );
+    for(uint32_t j=0; j<=stat.m_perOnu.size(); j++, k++)
+    {
+      uint64_t last = (k < m_lastDelivered.size()) ? m_lastDelivered[k] : 0;
+      if(m_delivered[k] == last) continue;
+
+      os << "    device " << i;
+      if(j == 0) os << " downstream: ";
+      else os << " upstream from onu " << (j - 1) << ": ";
+      os << m_delivered[k] << " (+" << (m_delivered[k] - last) << ")" << std::endl;
+    }
+  }
+
+  m_divergence = os.str();
+  m_diverged = true;
+  NS_LOG_WARN ("The run diverges from the golden trace at frame " << current.m_frameNumber);
+}
+
+
+void
+XgponGoldenTrace::PrintResult (std::ostream& os) const
+{
+  if(!m_compare)
+  {
+    os << "golden trace," << m_fileName << ",recorded frames," << m_numFrames << std::endl;
+  }
+  else if(m_diverged)
+  {
+    os << "golden trace," << m_fileName << ",DIVERGED" << std::endl << m_divergence;
+  }
+  else
+  {
+    os << "golden trace," << m_fileName << ",identical frames," << m_numFrames << std::endl;
+  }
+}
+
+
+
+}//namespace ns3
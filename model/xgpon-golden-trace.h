@@ -0,0 +1,223 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_GOLDEN_TRACE_H
+#define XGPON_GOLDEN_TRACE_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "ns3/object.h"
+
+#include "xgpon-xgtc-bwmap.h"
+
+
+namespace ns3 {
+
+class XgponNetDevice;
+
+/**
+ * \brief the digest of one downstream frame, as stored in the golden trace file (fixed width, 48 bytes).
+ */
+class XgponGoldenTraceRecord
+{
+public:
+  uint64_t m_frameNumber;          //the downstream frame that carries the BWmap (creation time / frame slot size)
+  uint64_t m_bwmapDigest;          //alloc-id, StartTime, GrantSize, flags and profile of every allocation in the BWmap
+  uint64_t m_reportDigest;         //onu-id, alloc-id and buffer occupancy of the DBRus received since the previous BWmap
+  uint64_t m_deliveredDigest;      //bytes delivered so far to the upper layers, per ONU and direction
+  uint64_t m_deliveredBytes;       //the sum of the above
+  uint16_t m_numAllocations;
+  uint16_t m_numReports;
+  uint32_t m_reserved;
+};
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief Records one canonical digest per downstream frame, or compares a run with a recorded (golden) one.
+ *
+ * When the OLT DBA engine produces one BWmap, the frame digest is completed with the BWmap, the DBRus received since
+ * the previous BWmap and the delivered bytes of the devices added through AddDevice (per ONU upstream at the OLT,
+ * downstream at each ONU). In record mode the digest is appended to the file; when "Compare" is set, it is checked
+ * against the next digest of the file and the first divergence is kept with its context: the last matching frame,
+ * the fields that differ, the current BWmap and DBRus, and the delivered bytes that changed in this frame.
+ * Comparison stops at the first divergence. Attached through XgponOltDbaEngine::SetGoldenTrace.
+ *
+ * When "SkipIdleFrames" is set, empty DBRus are not digested, and a frame is not recorded when its BWmap only polls, no DBRu
+ * with data has been received and no byte has been delivered since the previous frame. A run with idle fast-forward
+ * (which neither produces such frames nor receives empty DBRus from dormant ONUs) can then be compared with one without.
+ */
+class XgponGoldenTrace : public Object
+{
+public:
+  const static uint32_t FILE_MAGIC = 0x54444758;       //"XGDT"
+  const static uint32_t FORMAT_VERSION = 1;
+
+
+  /**
+   * \brief Constructor
+   */
+  XgponGoldenTrace ();
+  virtual ~XgponGoldenTrace ();
+
+
+  /**
+   * \brief create the file (record mode) or open the golden one ("Compare" set).
+   * \return false if the file cannot be created, or is not one golden trace.
+   */
+  bool Open ();
+
+  /**
+   * \brief close the file. When comparing, a reference that has more frames than this run is one divergence.
+   */
+  void Close ();
+
+
+  /**
+   * \brief add one device whose delivered bytes are part of the digest. Devices are digested in the order they are added.
+   */
+  void AddDevice (const Ptr<XgponNetDevice>& device);
+
+
+  /**
+   * \brief called by the OLT DBA engine for every status report it receives.
+   */
+  void RecordStatusReport (uint16_t onuId, uint16_t allocId, uint32_t bufOcc);
+
+  /**
+   * \brief called by the OLT DBA engine for every BWmap; completes the digest of the current frame.
+   * \param frameNumber the downstream frame that carries the BWmap
+   */
+  void RecordBwmap (uint64_t frameNumber, const Ptr<XgponXgtcBwmap>& bwmap);
+
+
+  /**
+   * \brief whether one divergence has been found (compare mode).
+   */
+  bool HasDiverged () const;
+
+  /**
+   * \brief the number of frames recorded or compared so far.
+   */
+  uint64_t GetNumberOfFrames () const;
+
+  /**
+   * \brief print the result of the comparison: the first divergence with its context, or the number of identical frames.
+   */
+  void PrintResult (std::ostream& os) const;
+
+
+
+  ///////////////////////////////////////////Functions required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+
+protected:
+  virtual void DoDispose (void);
+
+
+private:
+  class FileHeader
+  {
+  public:
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_recordSize;
+    uint32_t m_reserved;
+  };
+
+  //one DBRu received since the previous BWmap (kept for the context of a divergence)
+  class Report
+  {
+  public:
+    uint16_t m_onuId;
+    uint16_t m_allocId;
+    uint32_t m_bufOcc;
+  };
+
+  //fold one value into one digest (FNV-1a over its eight bytes)
+  static uint64_t Fold (uint64_t digest, uint64_t value);
+
+  //digest the delivered bytes of the devices into the record; the values are kept in m_delivered.
+  void DigestDeliveredBytes (XgponGoldenTraceRecord& record);
+
+  //keep the context of the first divergence
+  void ReportDivergence (const XgponGoldenTraceRecord& current, const XgponGoldenTraceRecord* reference, const Ptr<XgponXgtcBwmap>& bwmap);
+
+
+  std::string m_fileName;
+  bool m_compare;                                  //false: record the digests; true: compare with the file
+  bool m_skipIdleFrames;                           //whether empty DBRus and idle frames are left out
+
+  FILE* m_file;
+  uint64_t m_numFrames;
+
+  std::vector< Ptr<XgponNetDevice> > m_devices;
+
+  uint64_t m_reportDigest;                         //of the reports received since the previous BWmap
+  std::vector<Report> m_reports;
+
+  std::vector<uint64_t> m_delivered;               //delivered bytes per device and ONU at the current frame
+  std::vector<uint64_t> m_lastDelivered;           //... at the previous frame
+
+  bool m_diverged;
+  bool m_hasLastMatch;
+  XgponGoldenTraceRecord m_lastMatch;              //the last frame that matched the reference
+  std::string m_divergence;                        //the description of the first divergence
+};
+
+
+
+
+///////////////////////////////INLINE functions
+inline bool
+XgponGoldenTrace::HasDiverged () const
+{
+  return m_diverged;
+}
+
+inline uint64_t
+XgponGoldenTrace::GetNumberOfFrames () const
+{
+  return m_numFrames;
+}
+
+inline uint64_t
+XgponGoldenTrace::Fold (uint64_t digest, uint64_t value)
+{
+  for(int i=0; i<8; i++)
+  {
+    digest ^= (value >> (8 * i)) & 0xFF;
+    digest *= 0x100000001b3ULL;
+  }
+  return digest;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_GOLDEN_TRACE_H
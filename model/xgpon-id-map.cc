@@ -0,0 +1,54 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include "xgpon-id-map.h"
+
+
+
+namespace ns3{
+
+XgponIdMap::XgponIdMap () : m_pages(), m_nPages(0)
+{
+}
+XgponIdMap::~XgponIdMap ()
+{
+}
+
+
+void
+XgponIdMap::Insert (uint16_t id, uint32_t index)
+{
+  NS_ASSERT_MSG((index!=NOT_FOUND), "Unreasonable index for one identifier!!!");
+
+  uint32_t pageIndex = id >> PAGE_BITS;
+  if(pageIndex >= m_pages.size()) m_pages.resize (pageIndex + 1);
+
+  std::vector<uint32_t>& page = m_pages[pageIndex];
+  if(page.empty())
+  {
+    page.assign ((uint32_t)PAGE_SIZE, (uint32_t)NOT_FOUND);
+    m_nPages++;
+  }
+  page[id & (PAGE_SIZE - 1)] = index;
+}
+
+
+}//namespace ns3
@@ -0,0 +1,102 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_ID_MAP_H
+#define XGPON_ID_MAP_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/assert.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief Maps the identifiers of xgpon (Alloc-ID, XGEM Port-ID; at most 16 bits) to dense indices (0, 1, 2, ...) in O(1) time.
+ *
+ * The identifier space is split into pages of 256 identifiers and one page is only allocated when one of its identifiers
+ * is inserted. The directory of pages is also grown on demand, up to the highest page inserted, so that one empty map costs
+ * nothing beyond the object itself. Hence, any identifier permitted by the standard can be used, while the memory scales with
+ * the pages actually used (identifiers that are assigned sequentially share pages). The objects themselves are kept by the user
+ * of this map in vectors indexed by the dense index.
+ */
+class XgponIdMap
+{
+public:
+  const static uint32_t NOT_FOUND = 0xFFFFFFFF;
+
+  /**
+   * \brief Constructor
+   */
+  XgponIdMap ();
+  virtual ~XgponIdMap ();
+
+
+  /**
+   * \brief map the identifier to the index; the index of an identifier that has been inserted is replaced.
+   */
+  void Insert (uint16_t id, uint32_t index);
+
+  /**
+   * \brief the index of the identifier (inline function). NOT_FOUND: this identifier has not been inserted.
+   */
+  uint32_t Find (uint16_t id) const;
+
+  /**
+   * \brief the number of pages that have been allocated (for memory statistics).
+   */
+  uint32_t GetNumberOfPages () const;
+
+
+private:
+  const static uint16_t PAGE_BITS = 8;
+  const static uint16_t PAGE_SIZE = 256;
+
+  std::vector< std::vector<uint32_t> > m_pages;   //index == (id >> PAGE_BITS); missing or empty: no identifier of this page is inserted
+  uint32_t m_nPages;
+};
+
+
+
+
+//////////////////////////////////////INLINE Functions
+inline uint32_t
+XgponIdMap::Find (uint16_t id) const
+{
+  uint32_t pageIndex = id >> PAGE_BITS;
+  if(pageIndex >= m_pages.size()) return NOT_FOUND;
+
+  const std::vector<uint32_t>& page = m_pages[pageIndex];
+  if(page.empty()) return NOT_FOUND;
+  return page[id & (PAGE_SIZE - 1)];
+}
+
+inline uint32_t
+XgponIdMap::GetNumberOfPages () const
+{
+  return m_nPages;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_ID_MAP_H
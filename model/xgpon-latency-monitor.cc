@@ -0,0 +1,268 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#include <algorithm>
+#include <iomanip>
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include "xgpon-latency-monitor.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponLatencyMonitor");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (XgponLatencyMonitor);
+
+static const char* g_latencyComponentNames[XgponLatencyMonitor::NUM_LATENCY_COMPONENTS] =
+{
+  "queueing", "report-to-grant", "grant-to-transmit", "propagation", "total"
+};
+
+static bool
+CreatedEarlier (const Ptr<XgponXgtcDbru>& report, uint64_t time)
+{
+  return report->GetCreateTime () < time;
+}
+
+
+
+
+void
+XgponLatencyHistogram::Initialize (uint32_t numberOfBins)
+{
+  m_bins.assign (numberOfBins, 0);
+  m_samples = 0;
+  m_sum = 0;
+  m_max = 0;
+}
+
+void
+XgponLatencyHistogram::AddSample (uint64_t delay, uint64_t binWidth)
+{
+  uint64_t bin = delay / binWidth;
+  if(bin >= m_bins.size()) bin = m_bins.size() - 1;
+  m_bins[bin]++;
+
+  m_samples++;
+  m_sum += delay;
+  if(delay > m_max) m_max = delay;
+}
+
+double
+XgponLatencyHistogram::GetMean () const
+{
+  if(m_samples == 0) return 0;
+  return (double) m_sum / m_samples;
+}
+
+uint64_t
+XgponLatencyHistogram::GetPercentile (double percent, uint64_t binWidth) const
+{
+  if(m_samples == 0) return 0;
+
+  uint64_t target = (uint64_t) (m_samples * percent / 100.0);
+  if(target == 0) target = 1;
+
+  uint64_t count = 0;
+  for(uint32_t i=0; i<m_bins.size(); i++)
+  {
+    count += m_bins[i];
+    if(count >= target) return std::min ((i + 1) * binWidth, m_max);
+  }
+  return m_max;
+}
+
+
+
+
+
+
+
+
+
+TypeId
+XgponLatencyMonitor::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponLatencyMonitor")
+    .SetParent<Object> ()
+    .AddConstructor<XgponLatencyMonitor> ()
+    .AddAttribute ("BinWidth",
+                   "The width of the histogram bins. Unit: nanosecond.",
+                   UintegerValue (25000),
+                   MakeUintegerAccessor (&XgponLatencyMonitor::m_binWidth),
+                   MakeUintegerChecker<uint64_t> (1))
+    .AddAttribute ("NumberOfBins",
+                   "The number of bins of each histogram; the last bin holds all larger delays.",
+                   UintegerValue (400),
+                   MakeUintegerAccessor (&XgponLatencyMonitor::m_numberOfBins),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+TypeId
+XgponLatencyMonitor::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+XgponLatencyMonitor::XgponLatencyMonitor ()
+  : m_binWidth(25000), m_numberOfBins(400), m_stamping(true)
+{
+  XgponLatencyTag::EnableStamping ();
+}
+XgponLatencyMonitor::~XgponLatencyMonitor ()
+{
+  StopStamping ();
+}
+
+void
+XgponLatencyMonitor::DoDispose (void)
+{
+  StopStamping ();
+  Object::DoDispose ();
+}
+
+void
+XgponLatencyMonitor::StopStamping ()
+{
+  if(!m_stamping) return;
+  m_stamping = false;
+  XgponLatencyTag::DisableStamping ();
+}
+
+
+
+
+uint64_t
+XgponLatencyMonitor::FindFirstReportTime (const Ptr<XgponTcontOlt>& tcont, uint64_t time)
+{
+  //the reports of one T-CONT are kept in the order they were created (one second of history).
+  const std::deque< Ptr<XgponXgtcDbru> >& reports = tcont->GetAllBufOccupancyReports ();
+  std::deque< Ptr<XgponXgtcDbru> >::const_iterator it = std::lower_bound (reports.begin(), reports.end(), time, CreatedEarlier);
+
+  if(it == reports.end()) return 0;
+  else return (*it)->GetCreateTime ();
+}
+
+
+void
+XgponLatencyMonitor::RecordSdu (const Ptr<Packet>& sdu, const Ptr<XgponTcontOlt>& tcont, uint16_t portId,
+                                uint64_t grantTime, uint64_t arrivalTime, uint64_t propDelay)
+{
+  XgponLatencyTag tag;
+  if(!sdu->RemovePacketTag (tag)) return;
+
+  uint64_t txTime = arrivalTime - propDelay;
+  uint64_t enqueueTime = tag.GetEnqueueTime ();
+  NS_ASSERT_MSG((tag.GetSendTime () <= enqueueTime && enqueueTime <= txTime), "Strange timestamps of one upstream SDU!!!");
+
+  uint64_t reportTime = FindFirstReportTime (tcont, enqueueTime);
+  if(reportTime == 0 || reportTime > txTime) reportTime = txTime;   //not reported before it was transmitted
+
+  uint64_t grantedTime = std::min (std::max (grantTime, reportTime), txTime);
+
+  uint16_t allocId = tcont->GetAllocId ();
+  std::map<uint16_t, TcontLatency>::iterator it = m_tconts.find (allocId);
+  if(it == m_tconts.end())
+  {
+    TcontLatency& latency = m_tconts[allocId];
+    latency.m_onuId = tcont->GetOnuId ();
+    latency.m_tcontType = (uint16_t) tcont->GetTcontType ();
+    for(int i=0; i<NUM_LATENCY_COMPONENTS; i++) { latency.m_histograms[i].Initialize (m_numberOfBins); }
+    it = m_tconts.find (allocId);
+  }
+
+  XgponLatencyHistogram* histograms = it->second.m_histograms;
+  histograms[QUEUEING].AddSample (reportTime - enqueueTime, m_binWidth);
+  histograms[REPORT_TO_GRANT].AddSample (grantedTime - reportTime, m_binWidth);
+  histograms[GRANT_TO_TRANSMIT].AddSample (txTime - grantedTime, m_binWidth);
+  histograms[PROPAGATION].AddSample (propDelay, m_binWidth);
+  histograms[TOTAL].AddSample (arrivalTime - tag.GetSendTime (), m_binWidth);
+
+  std::map<uint16_t, XgponLatencyHistogram>::iterator connIt = m_conns.find (portId);
+  if(connIt == m_conns.end())
+  {
+    m_conns[portId].Initialize (m_numberOfBins);
+    connIt = m_conns.find (portId);
+  }
+  connIt->second.AddSample (arrivalTime - tag.GetSendTime (), m_binWidth);
+}
+
+
+
+
+const XgponLatencyMonitor::TcontLatency*
+XgponLatencyMonitor::GetTcontLatency (uint16_t allocId) const
+{
+  std::map<uint16_t, TcontLatency>::const_iterator it = m_tconts.find (allocId);
+  if(it == m_tconts.end()) return 0;
+  else return &(it->second);
+}
+
+const XgponLatencyHistogram*
+XgponLatencyMonitor::GetConnLatency (uint16_t portId) const
+{
+  std::map<uint16_t, XgponLatencyHistogram>::const_iterator it = m_conns.find (portId);
+  if(it == m_conns.end()) return 0;
+  else return &(it->second);
+}
+
+const char*
+XgponLatencyMonitor::GetComponentName (XgponLatencyComponent component)
+{
+  NS_ASSERT_MSG((component < NUM_LATENCY_COMPONENTS), "Unknown latency component!!!");
+  return g_latencyComponentNames[component];
+}
+
+
+void
+XgponLatencyMonitor::PrintSummary (std::ostream& os) const
+{
+  std::ios::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+
+  os << "alloc-id,onu-id,tcont-type,component,sdus,mean-us,p50-us,p99-us,max-us" << std::endl;
+  os << std::fixed << std::setprecision (1);
+
+  std::map<uint16_t, TcontLatency>::const_iterator it = m_tconts.begin();
+  for(; it != m_tconts.end(); it++)
+  {
+    for(int i=0; i<NUM_LATENCY_COMPONENTS; i++)
+    {
+      const XgponLatencyHistogram& histogram = it->second.m_histograms[i];
+      os << it->first << "," << it->second.m_onuId << "," << it->second.m_tcontType << ","
+         << g_latencyComponentNames[i] << "," << histogram.m_samples << ","
+         << histogram.GetMean () / 1000 << ","
+         << histogram.GetPercentile (50, m_binWidth) / 1000.0 << ","
+         << histogram.GetPercentile (99, m_binWidth) / 1000.0 << ","
+         << histogram.m_max / 1000.0 << std::endl;
+    }
+  }
+
+  os.flags (flags);
+  os.precision (precision);
+}
+
+
+}//namespace ns3
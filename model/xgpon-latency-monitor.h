@@ -0,0 +1,176 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_LATENCY_MONITOR_H
+#define XGPON_LATENCY_MONITOR_H
+
+#include <stdint.h>
+#include <vector>
+#include <map>
+#include <ostream>
+
+#include "ns3/object.h"
+#include "ns3/packet.h"
+
+#include "xgpon-tcont-olt.h"
+#include "xgpon-latency-tag.h"
+
+
+namespace ns3 {
+
+/**
+ * \brief a histogram of delays with fixed-width bins; the last bin also holds all larger delays.
+ */
+class XgponLatencyHistogram
+{
+public:
+  std::vector<uint64_t> m_bins;
+  uint64_t m_samples;
+  uint64_t m_sum;          //unit: nanosecond
+  uint64_t m_max;          //unit: nanosecond
+
+  void Initialize (uint32_t numberOfBins);
+  void AddSample (uint64_t delay, uint64_t binWidth);
+
+  double GetMean () const;                                       //unit: nanosecond
+  uint64_t GetPercentile (double percent, uint64_t binWidth) const;  //upper edge of the bin. unit: nanosecond
+};
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief Decomposes the latency of the upstream SDUs into per-T-CONT histograms at the OLT.
+ *
+ * For one SDU that completes reassembly at the OLT, with the timestamps carried by XgponLatencyTag:
+ *   queueing          = first report created after the SDU was enqueued - enqueue time
+ *   report-to-grant   = max(grant, report) - report, the grant being the creation of the BWmap of the burst
+ *   grant-to-transmit = transmission of the burst - max(grant, report)
+ *   propagation       = arrival of the burst at the OLT - transmission
+ *   total             = arrival - acceptance by the ONU
+ * The report is searched in the report history of the T-CONT at the OLT; if the SDU leaves the ONU before being
+ * reported (e.g., in a burst granted in advance), report-to-grant is zero. For fragmented SDUs, the burst carrying the
+ * last fragment is used. Memory is bounded: one set of histograms per T-CONT and one total histogram per XGEM port.
+ */
+class XgponLatencyMonitor : public Object
+{
+public:
+  enum XgponLatencyComponent
+  {
+    QUEUEING = 0,
+    REPORT_TO_GRANT,
+    GRANT_TO_TRANSMIT,
+    PROPAGATION,
+    TOTAL,
+    NUM_LATENCY_COMPONENTS,
+  };
+
+  /**
+   * \brief the histograms of one T-CONT.
+   */
+  class TcontLatency
+  {
+  public:
+    uint16_t m_onuId;
+    uint16_t m_tcontType;
+    XgponLatencyHistogram m_histograms[NUM_LATENCY_COMPONENTS];
+  };
+
+
+  /**
+   * \brief Constructor
+   */
+  XgponLatencyMonitor ();
+  virtual ~XgponLatencyMonitor ();
+
+
+  /**
+   * \brief process one upstream SDU that has been reassembled at the OLT. The latency tag (if any) is removed.
+   * \param tcont the T-CONT that carried the SDU
+   * \param portId the XGEM port of the SDU
+   * \param grantTime the creation time of the BWmap that granted the burst. unit: nanosecond
+   * \param arrivalTime the arrival time of the burst at the OLT. unit: nanosecond
+   * \param propDelay the propagation delay of the ONU. unit: nanosecond
+   */
+  void RecordSdu (const Ptr<Packet>& sdu, const Ptr<XgponTcontOlt>& tcont, uint16_t portId,
+                  uint64_t grantTime, uint64_t arrivalTime, uint64_t propDelay);
+
+
+  /**
+   * \return the histograms of one T-CONT; 0 if no SDU of this T-CONT has been recorded.
+   */
+  const TcontLatency* GetTcontLatency (uint16_t allocId) const;
+
+  /**
+   * \return the total latency of one XGEM port; 0 if no SDU of this port has been recorded.
+   */
+  const XgponLatencyHistogram* GetConnLatency (uint16_t portId) const;
+
+  uint64_t GetBinWidth () const;
+
+  static const char* GetComponentName (XgponLatencyComponent component);
+
+
+  /**
+   * \brief print mean, median, 99th percentile and maximum of each component per T-CONT. unit: microsecond
+   */
+  void PrintSummary (std::ostream& os) const;
+
+
+
+  ///////////////////////////////////////////Functions required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+
+protected:
+  virtual void DoDispose (void);
+
+
+private:
+  //release the stamping enabled by this monitor; called once from DoDispose or the destructor.
+  void StopStamping ();
+
+  //find the creation time of the first report of this T-CONT created at or after the given time. 0: no such report.
+  static uint64_t FindFirstReportTime (const Ptr<XgponTcontOlt>& tcont, uint64_t time);
+
+
+  uint64_t m_binWidth;                 //unit: nanosecond
+  uint32_t m_numberOfBins;
+  bool m_stamping;                     //whether this monitor still holds latency stamping on
+
+  std::map<uint16_t, TcontLatency> m_tconts;                 //indexed by alloc-id
+  std::map<uint16_t, XgponLatencyHistogram> m_conns;         //indexed by xgem port-id
+};
+
+
+
+
+///////////////////////////////////////////////////////////INLINE Functions
+inline uint64_t
+XgponLatencyMonitor::GetBinWidth () const
+{
+  return m_binWidth;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_LATENCY_MONITOR_H
@@ -0,0 +1,129 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "xgpon-latency-tag.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponLatencyTag");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (XgponLatencyTag);
+
+bool XgponLatencyTag::m_stampingEnabled = false;
+uint32_t XgponLatencyTag::m_numberOfMonitors = 0;
+
+TypeId
+XgponLatencyTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponLatencyTag")
+    .SetParent<Tag> ()
+    .AddConstructor<XgponLatencyTag> ()
+  ;
+  return tid;
+}
+TypeId
+XgponLatencyTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+XgponLatencyTag::XgponLatencyTag ()
+  : m_sendTime(0), m_enqueueTime(0)
+{
+}
+
+
+
+
+uint32_t
+XgponLatencyTag::GetSerializedSize (void) const
+{
+  return 16;
+}
+void
+XgponLatencyTag::Serialize (TagBuffer i) const
+{
+  i.WriteU64 (m_sendTime);
+  i.WriteU64 (m_enqueueTime);
+}
+void
+XgponLatencyTag::Deserialize (TagBuffer i)
+{
+  m_sendTime = i.ReadU64 ();
+  m_enqueueTime = i.ReadU64 ();
+}
+void
+XgponLatencyTag::Print (std::ostream &os) const
+{
+  os << "send=" << m_sendTime << "ns enqueue=" << m_enqueueTime << "ns";
+}
+
+
+
+
+void
+XgponLatencyTag::EnableStamping ()
+{
+  m_numberOfMonitors++;
+  m_stampingEnabled = true;
+}
+
+void
+XgponLatencyTag::DisableStamping ()
+{
+  NS_ASSERT_MSG((m_numberOfMonitors > 0), "Latency stamping has not been enabled!!!");
+  m_numberOfMonitors--;
+  m_stampingEnabled = (m_numberOfMonitors > 0);
+}
+
+void
+XgponLatencyTag::StampSendTime (const Ptr<Packet>& packet)
+{
+  if(!m_stampingEnabled) return;
+
+  XgponLatencyTag tag;
+  packet->RemovePacketTag (tag);   //a packet looped back into the PON starts over
+
+  uint64_t now = Simulator::Now().GetNanoSeconds();
+  tag.SetSendTime (now);
+  tag.SetEnqueueTime (now);
+  packet->AddPacketTag (tag);
+}
+
+void
+XgponLatencyTag::StampEnqueueTime (const Ptr<Packet>& packet)
+{
+  if(!m_stampingEnabled) return;
+
+  XgponLatencyTag tag;
+  if(packet->RemovePacketTag (tag))   //only the upstream SDUs stamped by the ONU carry the tag
+  {
+    tag.SetEnqueueTime (Simulator::Now().GetNanoSeconds());
+    packet->AddPacketTag (tag);
+  }
+}
+
+
+}//namespace ns3
@@ -0,0 +1,116 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_LATENCY_TAG_H
+#define XGPON_LATENCY_TAG_H
+
+#include "ns3/tag.h"
+#include "ns3/packet.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief The packet tag that carries the timestamps of one upstream SDU through the ONU. 
+ *
+ * The tag is added when the ONU accepts the SDU from upper layers and stamped again when the SDU enters its XgponQueue.
+ * The other points of the latency decomposition (report, grant, transmission, reception) are recovered by the OLT
+ * from the T-CONT history and the BWmap of the burst (see XgponLatencyMonitor), where the tag is also removed.
+ * Stamping is on only while at least one XgponLatencyMonitor is alive, so that normal runs do not touch the tag lists.
+ */
+class XgponLatencyTag : public Tag
+{
+public:
+  XgponLatencyTag ();
+
+  void SetSendTime (uint64_t time);
+  uint64_t GetSendTime () const;            //unit: nanosecond
+
+  void SetEnqueueTime (uint64_t time);
+  uint64_t GetEnqueueTime () const;         //unit: nanosecond
+
+
+  /**
+   * \brief the stamping functions used by the ONU and XgponQueue. They do nothing when stamping is disabled.
+   */
+  static void StampSendTime (const Ptr<Packet>& packet);
+  static void StampEnqueueTime (const Ptr<Packet>& packet);
+
+  /**
+   * \brief called by each XgponLatencyMonitor when it is created and disposed. Stamping is on while the count of monitors is non-zero.
+   */
+  static void EnableStamping ();
+  static void DisableStamping ();
+  static bool IsStampingEnabled ();
+
+
+  ///////////////////////////////////////////Functions required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+
+private:
+  static bool m_stampingEnabled;
+  static uint32_t m_numberOfMonitors;
+
+  uint64_t m_sendTime;
+  uint64_t m_enqueueTime;
+};
+
+
+
+
+///////////////////////////////////////////////////////////INLINE Functions
+inline void
+XgponLatencyTag::SetSendTime (uint64_t time)
+{
+  m_sendTime = time;
+}
+inline uint64_t
+XgponLatencyTag::GetSendTime () const
+{
+  return m_sendTime;
+}
+
+inline void
+XgponLatencyTag::SetEnqueueTime (uint64_t time)
+{
+  m_enqueueTime = time;
+}
+inline uint64_t
+XgponLatencyTag::GetEnqueueTime () const
+{
+  return m_enqueueTime;
+}
+
+inline bool
+XgponLatencyTag::IsStampingEnabled ()
+{
+  return m_stampingEnabled;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_LATENCY_TAG_H
@@ -101,42 +101,13 @@ void XgponLinkInfo::DeepCopy(const Ptr<XgponLinkInfo>& linkInfo)
   m_onuId = linkInfo->m_onuId;
 
   m_curDsKeyIndex = linkInfo->m_curDsKeyIndex;
-  int num = linkInfo->m_activeDsKeys.size();
-  for(int i=0; i<num; i++)
-  {
-    if(linkInfo->m_activeDsKeys[i] !=0)
-    {
-      Ptr<XgponKey> key = CreateObject<XgponKey> ();
-      key->DeepCopy(linkInfo->m_activeDsKeys[i]);
-      m_activeDsKeys[i] = key;    
-    }
-  }
-
+  m_activeDsKeys = linkInfo->m_activeDsKeys;
 
   m_curUsKeyIndex = linkInfo->m_curUsKeyIndex;
-  num = linkInfo->m_activeUsKeys.size();
-  for(int i=0; i<num; i++)
-  {
-    if(linkInfo->m_activeUsKeys[i] !=0)
-    {
-      Ptr<XgponKey> key = CreateObject<XgponKey> ();
-      key->DeepCopy(linkInfo->m_activeUsKeys[i]);
-      m_activeUsKeys[i] = key;    
-    }
-  }
-
+  m_activeUsKeys = linkInfo->m_activeUsKeys;
 
   m_curProfileIndex = linkInfo->m_curProfileIndex;
-  num = linkInfo->m_profiles.size();
-  for(int i=0; i<num; i++)
-  {
-    if(linkInfo->m_profiles[i] !=0)
-    {
-      Ptr<XgponBurstProfile> profile = CreateObject<XgponBurstProfile> ();
-      profile->DeepCopy(linkInfo->m_profiles[i]);
-      m_profiles[i] = profile;    
-    }
-  }
+  m_profiles = linkInfo->m_profiles;
 
   m_eqDelay = linkInfo->m_eqDelay;
 
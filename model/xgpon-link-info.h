@@ -122,7 +122,8 @@ public:
 
 
 
-  //Copy all information except PLOAM message queue; used by the helper to construct the same linkinfo for both OLT and ONU
+  //Copy all information except PLOAM message queue; used by the helper to construct the same linkinfo for both OLT and ONU.
+  //Keys and burst profiles are never changed in place (a link switches to another profile object), so they are shared instead of copied.
   void DeepCopy(const Ptr<XgponLinkInfo>& linkInfo);
 
 
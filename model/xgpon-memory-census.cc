@@ -0,0 +1,99 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include <iomanip>
+
+#include "xgpon-memory-census.h"
+
+
+namespace ns3 {
+
+XgponMemoryCensus::Counters XgponMemoryCensus::m_counters[XgponMemoryCensus::NUM_CENSUS_CLASSES] = { };
+
+
+static const char* CENSUS_CLASS_NAMES[XgponMemoryCensus::NUM_CENSUS_CLASSES] = 
+{
+  "XgponDsFrame",
+  "XgponUsBurst",
+  "XgponXgemFrame",
+  "XgponXgtcUsAllocation",
+  "XgponXgtcBwmap",
+  "XgponXgtcDbru",
+  "XgponXgtcPloam",
+  "XgponServiceRecord",
+  "XgponOltDbaPerBurstInfo",
+  "T-CONT DBRu history (entries)",
+  "T-CONT BW allocation history (entries)",
+};
+
+
+
+double
+XgponMemoryCensus::Counters::GetPoolHitRate () const
+{
+  uint64_t total = m_poolHits + m_mallocs;
+  if(total == 0) return 0;
+  return (double) m_poolHits / total;
+}
+
+
+const char*
+XgponMemoryCensus::GetClassName (XgponCensusClass cls)
+{
+  return CENSUS_CLASS_NAMES[cls];
+}
+
+
+uint64_t
+XgponMemoryCensus::GetTotalLiveBytes ()
+{
+  uint64_t total = 0;
+  for(int i=0; i<NUM_CENSUS_CLASSES; i++) total += m_counters[i].m_liveBytes;
+  return total;
+}
+
+
+void
+XgponMemoryCensus::PrintSummary (std::ostream& os)
+{
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+
+  os << "XG-PON memory census: " << GetTotalLiveBytes () << " bytes alive" << std::endl;
+  os << std::setw(40) << std::left << "class" << std::right << std::setw(14) << "created" << std::setw(10) << "live" 
+     << std::setw(10) << "peak" << std::setw(14) << "live bytes" << std::setw(14) << "peak bytes" 
+     << std::setw(10) << "pool hit" << std::setw(12) << "arena" << std::setw(10) << "pool hwm" << std::endl;
+
+  for(int i=0; i<NUM_CENSUS_CLASSES; i++)
+  {
+    const Counters& c = m_counters[i];
+    os << std::setw(40) << std::left << CENSUS_CLASS_NAMES[i] << std::right << std::setw(14) << c.m_created << std::setw(10) << c.m_live 
+       << std::setw(10) << c.m_peakLive << std::setw(14) << c.m_liveBytes << std::setw(14) << c.m_peakBytes 
+       << std::setw(10) << std::fixed << std::setprecision(3) << c.GetPoolHitRate () << std::setw(12) << c.m_arenaAllocs 
+       << std::setw(10) << c.m_poolHighWater << std::endl;
+    os.flags (flags);
+    os.precision (precision);
+  }
+}
+
+
+
+}//namespace ns3
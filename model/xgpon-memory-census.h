@@ -0,0 +1,156 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_MEMORY_CENSUS_H
+#define XGPON_MEMORY_CENSUS_H
+
+#include <cstddef>
+#include <ostream>
+
+#include <stdint.h>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief Counts the live objects and bytes of the classes allocated per frame/burst (and of the T-CONT histories).
+ *
+ * The operator new/delete of the pooled classes report every allocation (with its source: pool, malloc or frame arena)
+ * and every release (with the size of the pool afterwards). For the T-CONT histories, the entries of the deques
+ * of DBRu reports and BW allocations are counted; the objects they point to are counted by their own classes.
+ * The counters can be queried at any time; PrintSummary is meant to be called at the end of a run.
+ */
+class XgponMemoryCensus
+{
+public:
+  //the classes (or containers) that are counted
+  enum XgponCensusClass
+  {
+    DS_FRAME = 0,
+    US_BURST,
+    XGEM_FRAME,
+    XGTC_US_ALLOCATION,
+    XGTC_BWMAP,
+    XGTC_DBRU,
+    XGTC_PLOAM,
+    SERVICE_RECORD,
+    OLT_DBA_PER_BURST_INFO,
+    TCONT_REPORT_HISTORY,
+    TCONT_BW_ALLOCATION_HISTORY,
+    NUM_CENSUS_CLASSES
+  };
+
+  //where the memory of one object comes from
+  enum XgponAllocationSource
+  {
+    FROM_MALLOC = 0,
+    FROM_POOL,
+    FROM_ARENA,
+    IN_CONTAINER,        //one entry of a history container
+  };
+
+  //the counters of one class
+  class Counters
+  {
+  public:
+    uint64_t m_created;          //objects allocated since the beginning
+    uint64_t m_live;             //objects not released yet
+    uint64_t m_peakLive;
+    uint64_t m_liveBytes;
+    uint64_t m_peakBytes;
+
+    uint64_t m_poolHits;         //allocations served by the pool of the class
+    uint64_t m_mallocs;          //allocations that called malloc
+    uint64_t m_arenaAllocs;      //allocations served by a frame arena
+    uint64_t m_poolHighWater;    //the largest number of free chunks kept in the pool
+
+    //pool hits / (pool hits + mallocs); arena allocations are not counted.
+    double GetPoolHitRate () const;
+  };
+
+
+  /**
+   * \brief called when one object is allocated.
+   */
+  static void RecordAllocation (XgponCensusClass cls, size_t size, XgponAllocationSource source);
+
+  /**
+   * \brief called when one object is released.
+   * \param poolSize the number of free chunks in the pool of the class after the release
+   */
+  static void RecordRelease (XgponCensusClass cls, size_t size, size_t poolSize);
+
+
+  static const Counters& GetCounters (XgponCensusClass cls);
+  static const char* GetClassName (XgponCensusClass cls);
+
+  //the bytes of all live objects (and history entries)
+  static uint64_t GetTotalLiveBytes ();
+
+  static void PrintSummary (std::ostream& os);
+
+
+private:
+  static Counters m_counters[NUM_CENSUS_CLASSES];
+};
+
+
+
+
+
+///////////////////////////////////////////////////////////////INLINE Functions
+inline void
+XgponMemoryCensus::RecordAllocation (XgponCensusClass cls, size_t size, XgponAllocationSource source)
+{
+  Counters& c = m_counters[cls];
+
+  c.m_created++;
+  c.m_live++;
+  c.m_liveBytes += size;
+  if(c.m_live > c.m_peakLive) c.m_peakLive = c.m_live;
+  if(c.m_liveBytes > c.m_peakBytes) c.m_peakBytes = c.m_liveBytes;
+
+  if(source == FROM_POOL) c.m_poolHits++;
+  else if(source == FROM_MALLOC) c.m_mallocs++;
+  else if(source == FROM_ARENA) c.m_arenaAllocs++;
+}
+
+inline void
+XgponMemoryCensus::RecordRelease (XgponCensusClass cls, size_t size, size_t poolSize)
+{
+  Counters& c = m_counters[cls];
+
+  c.m_live--;
+  c.m_liveBytes -= size;
+  if(poolSize > c.m_poolHighWater) c.m_poolHighWater = poolSize;
+}
+
+inline const XgponMemoryCensus::Counters&
+XgponMemoryCensus::GetCounters (XgponCensusClass cls)
+{
+  return m_counters[cls];
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_MEMORY_CENSUS_H
@@ -156,17 +156,7 @@ XgponNetDevice::SendSduToUpperLayer (const Ptr<Packet>& sdu, uint16_t tcontType,
   if ( senderId != 1024 )
     NS_ASSERT_MSG( ( (tcontType <=4) && (tcontType >=1) ), "Invalid TCONT type");
 
-  if (tcontType == 1)
-    m_stat.m_usT1oltBytes[senderId] += sduSize;
-  else if (tcontType == 2)
-    m_stat.m_usT2oltBytes[senderId] += sduSize;
-  else if (tcontType == 3)
-    m_stat.m_usT3oltBytes[senderId] += sduSize;
-  else if (tcontType == 4)
-    m_stat.m_usT4oltBytes[senderId] += sduSize;
-
-  m_stat.m_dsOnuBytes += sduSize;
-  m_stat.m_usOltBytes[senderId] += sduSize;
+  m_stat.CountReceivedSdu (tcontType, senderId, sduSize);
 
   //std::cout << "senderId: " << senderId << ", sduSize: " << sduSize << ", tcontType: " << tcontType << ", receiverId: " << receiverId << ", receivedBytesAtOnu: " << m_stat.m_dsOnuBytes << std::endl;
   m_rxCallback (this, sdu, protocol, from);
@@ -251,15 +241,8 @@ XgponNetDeviceStatistics::initialize ()
 
     m_rxFromUpperLayerBytes = 0;
     m_dsOnuBytes = 0;
-    //ja:update:ns-3.35, new/modified parameters
-    for (uint16_t i = 0; i < XgponChannel::MAXIMAL_NODES_PER_XGPON; i++) 
-    {   
-      m_usOltBytes[i] = 0;
-      m_usT1oltBytes[i] = 0;
-      m_usT2oltBytes[i] = 0;
-      m_usT3oltBytes[i] = 0;
-      m_usT4oltBytes[i] = 0;
-    }   
+    for (uint16_t i = 0; i < NUM_TCONT_TYPES; i++) { m_rxTcontTypeBytes[i] = 0; }
+    m_perOnu.clear();
 
     m_passToUpperLayerBytes = 0;
     m_passToXgponBytes = 0;
@@ -268,4 +251,25 @@ XgponNetDeviceStatistics::initialize ()
 }
 
 
+void 
+XgponNetDeviceStatistics::CountReceivedSdu (uint16_t tcontType, uint16_t senderId, uint32_t sduSize)
+{
+  m_dsOnuBytes += sduSize;
+  if((tcontType <= NUM_TCONT_TYPES) && (tcontType >= 1)) { m_rxTcontTypeBytes[tcontType - 1] += sduSize; }
+
+  //the OLT is the sender: no per-ONU counters are needed at the receiving ONU.
+  if(senderId >= XgponChannel::MAXIMAL_NODES_PER_XGPON) return;
+
+  if(senderId >= m_perOnu.size())
+  {
+    XgponPerOnuStatistics zero = { 0, { } };
+    m_perOnu.resize (senderId + 1, zero);
+  }
+
+  XgponPerOnuStatistics& onuStat = m_perOnu[senderId];
+  onuStat.m_usBytes += sduSize;
+  if((tcontType <= NUM_TCONT_TYPES) && (tcontType >= 1)) { onuStat.m_usTcontBytes[tcontType - 1] += sduSize; }
+}
+
+
 }//namespace ns3
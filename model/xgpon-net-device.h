@@ -22,6 +22,8 @@
 #ifndef XGPON_NET_DEVICE_H
 #define XGPON_NET_DEVICE_H
 
+#include <vector>
+
 #include "ns3/traced-callback.h"
 #include "ns3/packet.h"
 
@@ -40,9 +42,13 @@ namespace ns3{
  */
 
 /////////////////////////////////////Xgpon-Interface Statistics
+class XgponPerOnuStatistics;
+
 class XgponNetDeviceStatistics
 {
 public:
+  const static uint16_t NUM_TCONT_TYPES = 4;
+
   uint64_t m_currentTime;  //current simulation time: nanosecond
 
   uint64_t m_rxFromUpperLayerPkts;
@@ -55,12 +61,11 @@ public:
 
 
   uint64_t m_rxFromUpperLayerBytes;
-  uint64_t m_usOltBytes[XgponChannel::MAXIMAL_NODES_PER_XGPON];//ja:update:ns-3.35 1024 replaced by a defined variable name
-        uint64_t m_usT1oltBytes[XgponChannel::MAXIMAL_NODES_PER_XGPON];
-        uint64_t m_usT2oltBytes[XgponChannel::MAXIMAL_NODES_PER_XGPON];
-        uint64_t m_usT3oltBytes[XgponChannel::MAXIMAL_NODES_PER_XGPON];
-        uint64_t m_usT4oltBytes[XgponChannel::MAXIMAL_NODES_PER_XGPON];
   uint64_t m_dsOnuBytes; //ja:update:xgspon adding stats for downstream bytes at the ONU
+  uint64_t m_rxTcontTypeBytes[NUM_TCONT_TYPES];  //bytes passed to upper layers per T-CONT type (T1...T4)
+
+  //per-ONU upstream counters. Only used at the OLT, indexed by onu-id and grown up to the largest onu-id seen.
+  std::vector<XgponPerOnuStatistics> m_perOnu;
 
   uint64_t m_passToUpperLayerBytes;
   uint64_t m_passToXgponBytes;
@@ -68,6 +73,29 @@ public:
   uint64_t m_overallQueueDropBytes;
 
   void initialize ();
+
+  /**
+   * \brief count one SDU passed to upper layers. 
+   * \param senderId onu-id of the sender, or XgponChannel::MAXIMAL_NODES_PER_XGPON when the OLT is the sender
+   */
+  void CountReceivedSdu (uint16_t tcontType, uint16_t senderId, uint32_t sduSize);
+
+  /**
+   * \brief bytes received at the OLT from one ONU (all T-CONTs or one T-CONT type). 0 for unknown ONUs.
+   */
+  uint64_t GetUsOltBytes (uint16_t onuId) const;
+  uint64_t GetUsTcontOltBytes (uint16_t onuId, uint16_t tcontType) const;
+};
+
+
+/**
+ * \brief the upstream counters that the OLT keeps for one ONU.
+ */
+class XgponPerOnuStatistics
+{
+public:
+  uint64_t m_usBytes;                                                       //all bytes received from this ONU
+  uint64_t m_usTcontBytes[XgponNetDeviceStatistics::NUM_TCONT_TYPES];       //bytes received per T-CONT type (T1...T4)
 };
 
 
@@ -190,6 +218,21 @@ private:
 
 
 ///////////////////////////////INLINE functions
+inline uint64_t 
+XgponNetDeviceStatistics::GetUsOltBytes (uint16_t onuId) const
+{
+  if(onuId >= m_perOnu.size()) return 0;
+  return m_perOnu[onuId].m_usBytes;
+}
+
+inline uint64_t 
+XgponNetDeviceStatistics::GetUsTcontOltBytes (uint16_t onuId, uint16_t tcontType) const
+{
+  NS_ASSERT_MSG(((tcontType <= NUM_TCONT_TYPES) && (tcontType >= 1)), "Invalid TCONT type");
+  if(onuId >= m_perOnu.size()) return 0;
+  return m_perOnu[onuId].m_usTcontBytes[tcontType - 1];
+}
+
 inline XgponNetDeviceStatistics& 
 XgponNetDevice::GetStatistics ()
 {
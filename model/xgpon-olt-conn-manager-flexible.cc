@@ -67,8 +67,8 @@ XgponOltConnManagerFlexible::AddOneDsConn (const Ptr<XgponConnectionSender>& con
   if(isBroadcast)
   {
     AddOneBroadcastDsConnection(conn);
-    m_dsConnsPortIndex[conn->GetXgemPort()] = conn;
-    m_dsConnsAddressIndex.insert ( std::pair<Address, Ptr<XgponConnectionSender> >(conn->GetUpperLayerAddr(),conn) );
+    AddDsConnByXgemPort (conn);
+    m_dsConnsAddressIndex.AddHostRoute (conn->GetUpperLayerAddr(), conn);
   }
   else
   {
@@ -76,8 +76,8 @@ XgponOltConnManagerFlexible::AddOneDsConn (const Ptr<XgponConnectionSender>& con
     if(onu != 0) 
     { 
       onu->AddOneDsConn(conn); 
-      m_dsConnsPortIndex[conn->GetXgemPort()] = conn;
-      m_dsConnsAddressIndex.insert ( std::pair<Address, Ptr<XgponConnectionSender> >(conn->GetUpperLayerAddr(),conn) );
+      AddDsConnByXgemPort (conn);
+      m_dsConnsAddressIndex.AddHostRoute (conn->GetUpperLayerAddr(), conn);
     }
   }
   
@@ -89,13 +89,21 @@ XgponOltConnManagerFlexible::AddOneDsConn (const Ptr<XgponConnectionSender>& con
 const Ptr<XgponConnectionSender>& 
 XgponOltConnManagerFlexible::FindDsConnByAddress (const Address& addr)
 {
-  return m_dsConnsAddressIndex[addr];
+  return m_dsConnsAddressIndex.Classify (addr);
 }
 
 const Ptr<XgponConnectionSender>& 
 XgponOltConnManagerFlexible::FindBroadcastConnByAddress (const Address& addr)
 {
-  return m_dsConnsAddressIndex[addr];
+  return m_dsConnsAddressIndex.Classify (addr);
+}
+
+
+void 
+XgponOltConnManagerFlexible::AddDsPrefixRoute (const Ipv4Address& prefix, uint8_t prefixLen, const Ptr<XgponConnectionSender>& conn)
+{
+  NS_LOG_FUNCTION(this);
+  m_dsConnsAddressIndex.AddPrefixRoute (prefix, prefixLen, conn);
 }
 
 
@@ -22,6 +22,7 @@
 #define XGPON_OLT_CONN_MANAGER_FLEXIBLE_H
 
 #include "xgpon-olt-conn-manager.h"
+#include "xgpon-address-classifier.h"
 
 
 namespace ns3 {
@@ -29,6 +30,7 @@ namespace ns3 {
 /**
  * \ingroup xgpon
  * \brief The class instantiates XgponOltConnManager. It does not impose any constraint between address and onuId/XgemPort;
+ *        the destination address of each packet is classified through XgponAddressClassifier.
  */
 class XgponOltConnManagerFlexible : public XgponOltConnManager
 {
@@ -59,6 +61,18 @@ public:
   virtual const Ptr<XgponConnectionSender>& FindBroadcastConnByAddress (const Address& addr);
 
 
+  /**
+   * \brief Send all packets destined to the IPv4 prefix (e.g., the network behind one ONU) through one downstream connection
+   *        that has been added. The connection of the destination address itself, if any, is still used first.
+   */
+  void AddDsPrefixRoute (const Ipv4Address& prefix, uint8_t prefixLen, const Ptr<XgponConnectionSender>& conn);
+
+  /**
+   * \brief the number of distinct prefixes added through AddDsPrefixRoute
+   */
+  uint32_t GetNumberOfDsPrefixRoutes () const;
+
+
 
   ////////////////////////////////////////////Functions required by NS-3
   static TypeId GetTypeId (void);
@@ -67,14 +81,22 @@ public:
 
 private:
   //used when mapping ip address of the upper-layer packet to the corresponding connection (for both broadcast and per-onu ds connections).
-  //key = address, value = Ptr<XgponConnectionSender>; Performance: O(log n);
-  std::map< Address, Ptr<XgponConnectionSender> > m_dsConnsAddressIndex;    
+  //Performance: O(1) for IPv4 addresses of the connections;
+  XgponAddressClassifier m_dsConnsAddressIndex;    
 
 };
 
 
 
 
+//////////////////////////////////////INLINE Functions
+inline uint32_t
+XgponOltConnManagerFlexible::GetNumberOfDsPrefixRoutes () const
+{
+  return m_dsConnsAddressIndex.GetNumberOfPrefixRoutes ();
+}
+
+
 
 
 }; // namespace ns3
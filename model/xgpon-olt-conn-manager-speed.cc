@@ -52,8 +52,7 @@ XgponOltConnManagerSpeed::GetInstanceTypeId (void) const
 
 
 
-XgponOltConnManagerSpeed::XgponOltConnManagerSpeed ():XgponOltConnManager(),
-  m_broadcastConnsAddressIndex()
+XgponOltConnManagerSpeed::XgponOltConnManagerSpeed ():XgponOltConnManager()
 {
 }
 XgponOltConnManagerSpeed::~XgponOltConnManagerSpeed ()
@@ -75,8 +74,8 @@ XgponOltConnManagerSpeed::AddOneDsConn (const Ptr<XgponConnectionSender>& conn,
   if(isBroadcast)
   {
     AddOneBroadcastDsConnection(conn);
-    m_dsConnsPortIndex[conn->GetXgemPort()] = conn;
-    m_broadcastConnsAddressIndex.insert ( std::pair<Address, Ptr<XgponConnectionSender> >(conn->GetUpperLayerAddr(),conn) );
+    AddDsConnByXgemPort (conn);
+    m_broadcastConnsAddressIndex.AddHostRoute (conn->GetUpperLayerAddr(), conn);
   }
   else
   {
@@ -84,18 +83,17 @@ XgponOltConnManagerSpeed::AddOneDsConn (const Ptr<XgponConnectionSender>& conn,
     if(onu != 0) 
     { 
       onu->AddOneDsConn(conn); 
-      m_dsConnsPortIndex[conn->GetXgemPort()] = conn;
+      AddDsConnByXgemPort (conn);
     }
   }
   
 }
 
 
-//Further study may be necessary for CPU efficiency when a lot of broadcast traffics are simulated.
 const Ptr<XgponConnectionSender>& 
 XgponOltConnManagerSpeed::FindBroadcastConnByAddress (const Address& addr)
 {
-  return m_broadcastConnsAddressIndex[addr];
+  return m_broadcastConnsAddressIndex.Classify (addr);
 }
 
 
@@ -105,7 +103,7 @@ const Ptr<XgponConnectionSender>&
 XgponOltConnManagerSpeed::FindDsConnByAddress (const Address& addr)
 {
   uint16_t xgemPort = CalculateXgemPortFromAddress (addr);
-  return m_dsConnsPortIndex[xgemPort];
+  return FindDsConnByXgemPort (xgemPort);
 }
 
 
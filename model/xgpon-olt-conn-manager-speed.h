@@ -22,6 +22,7 @@
 #define XGPON_OLT_CONN_MANAGER_SPEED_H
 
 #include "xgpon-olt-conn-manager.h"
+#include "xgpon-address-classifier.h"
 
 
 namespace ns3 {
@@ -74,8 +75,8 @@ private:
 
   //used when mapping ip address of the upper-layer packet to the corresponding connection (for broadcast connections only).
   //As for uni-cast connection, we calculate XgemPort from IP address directly.
-  //key = address, value = XgponConnectionSender; Performance: O(log n);
-  std::map< Address, Ptr<XgponConnectionSender> > m_broadcastConnsAddressIndex;    
+  //Performance: O(1) for IPv4 addresses;
+  XgponAddressClassifier m_broadcastConnsAddressIndex;    
   
   uint16_t CalculateXgemPortFromAddress (const Address& addr);
 
@@ -18,6 +18,8 @@
  * Author: Xiuchao Wu <xw2@cs.ucc.ie>
  */
 
+#include <algorithm>
+
 #include "ns3/log.h"
 
 #include "xgpon-olt-conn-manager.h"
@@ -47,11 +49,13 @@ XgponOltConnManager::GetInstanceTypeId (void) const
 
 
 
-XgponOltConnManager::XgponOltConnManager (): m_dsConnsPortIndex(65536,(Ptr<XgponConnectionSender>)0),
-  m_broadcastConns(0), 
+XgponOltConnManager::XgponOltConnManager (): m_broadcastConns(0), 
   m_onus(1024,(Ptr<XgponOltConnPerOnu>)0), 
-  m_tconts(16384,(Ptr<XgponTcontOlt>)0), 
-  m_tcontsType(16384,(XgponQosParameters::XgponTcontType)0)
+  m_tconts(0), 
+  m_tcontsType(0),
+  m_dsConns(0),
+  m_nullTcont(0),
+  m_nullConnSender(0)
 {
 }
 XgponOltConnManager::~XgponOltConnManager ()
@@ -96,7 +100,10 @@ XgponOltConnManager::AddOneUsTcont (const Ptr<XgponTcontOlt>& tcont, uint16_t on
     NS_ASSERT_MSG((tcont->GetAllocId()<16384), "Alloc-ID is too large (unlawful)!!!");
 
     onu->AddOneUsTcont(tcont);
-    m_tconts[tcont->GetAllocId()] = tcont;
+    uint32_t row = m_tcontStateTable.AddTcont (tcont->GetAllocId(), onuId, tcont->GetTcontType());
+    NS_ASSERT_MSG((row==m_tconts.size()), "The T-CONTs and the state table are out of step!!!");
+    m_tconts.push_back (tcont);
+    m_tcontsType.push_back ((XgponQosParameters::XgponTcontType)0);   //known when its first connection is added
   }
 }
 
@@ -108,11 +115,56 @@ XgponOltConnManager::AddOneUsConn (const Ptr<XgponConnectionReceiver>& conn, uin
   NS_LOG_FUNCTION(this);
   NS_ASSERT_MSG((allocId<16384), "Alloc-ID is too large (unlawful)!!!");
 
-  const Ptr<XgponTcontOlt>& tcont = GetTcontById (allocId);
-  Ptr<XgponQosParameters> qosParameters = tcont->GetQosParameters();
-  m_tcontsType[allocId] = qosParameters->GetTcontType();
+  uint32_t row = m_tcontStateTable.GetRow (allocId);
+  if(row == XgponTcontStateTable::NO_ROW) return;
+
+  const Ptr<XgponTcontOlt>& tcont = m_tconts[row];
+  m_tcontsType[row] = tcont->GetQosParameters()->GetTcontType();
+  tcont->AddOneConnection(conn);
+}
+
+
+
+void 
+XgponOltConnManager::AddDsConnByXgemPort (const Ptr<XgponConnectionSender>& conn)
+{
+  uint16_t xgemPort = conn->GetXgemPort();
+  uint32_t index = m_dsConnsPortIndex.Find (xgemPort);
+  if(index == XgponIdMap::NOT_FOUND)
+  {
+    m_dsConnsPortIndex.Insert (xgemPort, m_dsConns.size());
+    m_dsConns.push_back (conn);
+  }
+  else m_dsConns[index] = conn;
+}
+
+
+
+
+void 
+XgponOltConnManager::AddOneMulticastGroup (uint16_t xgemPort)
+{
+  NS_LOG_FUNCTION(this);
+
+  const Ptr<XgponConnectionSender>& conn = FindDsConnByXgemPort (xgemPort);
+  NS_ASSERT_MSG((conn!=0 && conn->IsBroadcast()), "One multicast group should be one broadcast downstream connection!!!");
+
+  if(m_multicastGroupsPortIndex.Find (xgemPort) != XgponIdMap::NOT_FOUND) return;
+  m_multicastGroupsPortIndex.Insert (xgemPort, m_multicastMembers.size());
+  m_multicastMembers.push_back (std::vector<uint16_t> ());
+}
+
+void 
+XgponOltConnManager::AddOneMulticastMember (uint16_t xgemPort, uint16_t onuId)
+{
+  NS_LOG_FUNCTION(this);
+  NS_ASSERT_MSG((onuId<1023), "ONU-ID is too large (unlawful)!!!");
+
+  uint32_t index = m_multicastGroupsPortIndex.Find (xgemPort);
+  NS_ASSERT_MSG((index!=XgponIdMap::NOT_FOUND), "The multicast group has not been added!!!");
 
-  if(tcont != 0) tcont->AddOneConnection(conn);
+  std::vector<uint16_t>& members = m_multicastMembers[index];
+  if(std::find (members.begin(), members.end(), onuId) == members.end()) members.push_back (onuId);
 }
 
 
@@ -28,7 +28,9 @@
 #include "xgpon-connection-sender.h"
 #include "xgpon-connection-receiver.h"
 #include "xgpon-tcont-olt.h"
+#include "xgpon-tcont-state-table.h"
 #include "xgpon-qos-parameters.h"
+#include "xgpon-id-map.h"
 
 
 namespace ns3 {
@@ -72,6 +74,11 @@ public:
    */
   const Ptr<XgponTcontOlt>& GetTcontById (uint16_t allocId) const;
 
+  /**
+   * \brief the per-frame state of all upstream T-CONTs, read by the DBA engine. One row is added by AddOneUsTcont.
+   */
+  XgponTcontStateTable& GetTcontStateTable ();
+
   /*
    * \brief Find TcontOltType based on Alloc-ID (inline function). 0: unknown type
    */
@@ -106,6 +113,28 @@ public:
   virtual const Ptr<XgponConnectionSender>& FindBroadcastConnByAddress (const Address& addr) = 0;
 
 
+  /**
+   * \brief Find one downstream connection (uni-cast or broadcast) based on its xgem-port (inline function). 
+   * \return the corresponding XgponConnectionSender; 0: no found
+   */
+  const Ptr<XgponConnectionSender>& FindDsConnByXgemPort (uint16_t xgemPort) const;
+
+  /**
+   * \brief Make one broadcast downstream connection (already added) a multicast group: its XGEM frames are still carried once
+   *        per downstream frame, but only the member ONUs have to receive them.
+   */
+  void AddOneMulticastGroup (uint16_t xgemPort);
+
+  /**
+   * \brief Add one ONU to the multicast group of the xgem-port.
+   */
+  void AddOneMulticastMember (uint16_t xgemPort, uint16_t onuId);
+
+  /**
+   * \brief the member ONUs of the multicast group of the xgem-port (inline function). 0: not a multicast group
+   */
+  const std::vector<uint16_t>* FindMulticastMembers (uint16_t xgemPort) const;
+
   /**
    * \brief Find the downstream omci connection based on onu-id (inline function). 
    * \return the corresponding XgponConnectionSender; 0: no found
@@ -141,10 +170,11 @@ protected:
   //netmask length for the network controlled by ONUs
   uint8_t m_onuNetmaskLen;
 
-  //used when mapping xgem-port of the low-layer xgem-frame to the corresponding connection (for per-onu connections).
-  //In XgponOltConnManagerSpeed, it is also used to map ip address of the upper-layer packet to the corresponding connection (for per-onu connections).
-  std::vector< Ptr<XgponConnectionSender> > m_dsConnsPortIndex;             //index == xgemPort;
-
+  /**
+   * \brief index the downstream connection by its xgem-port, so that FindDsConnByXgemPort can find it.
+   *        In XgponOltConnManagerSpeed, it is also used to map ip address of the upper-layer packet to the corresponding connection (for per-onu connections).
+   */
+  void AddDsConnByXgemPort (const Ptr<XgponConnectionSender>& conn);
 
   void AddOneBroadcastDsConnection (const Ptr<XgponConnectionSender>& conn);
   std::vector< Ptr<XgponConnectionSender> >& GetAllBroadcastDsConnections ();  
@@ -161,10 +191,23 @@ private:
 
 
 
-  ///////used to find T-CONT, and their types quickly. CPU vs memory tradeoff. index == alloc-id
+  ///////used to find T-CONT, and their types quickly. index == the row of the T-CONT in m_tcontStateTable (alloc-id -> row)
   std::vector< Ptr<XgponTcontOlt> > m_tconts;
   std::vector< XgponQosParameters::XgponTcontType > m_tcontsType; 
 
+  XgponTcontStateTable m_tcontStateTable;
+
+  ///////used when mapping xgem-port of the low-layer xgem-frame to the corresponding connection.
+  std::vector< Ptr<XgponConnectionSender> > m_dsConns;
+  XgponIdMap m_dsConnsPortIndex;                                             //xgem-port -> index in m_dsConns
+
+  ///////the member ONUs of the multicast groups.
+  std::vector< std::vector<uint16_t> > m_multicastMembers;
+  XgponIdMap m_multicastGroupsPortIndex;                                     //xgem-port -> index in m_multicastMembers
+
+  Ptr<XgponTcontOlt> m_nullTcont;
+  Ptr<XgponConnectionSender> m_nullConnSender;
+
   /* 
    * For scheduling the upstream connections, these Alloc-IDs should be organized according to their priorities.
    * For downstream connections, the similar state variables are also necessary.
@@ -197,14 +240,24 @@ inline const Ptr<XgponTcontOlt>&
 XgponOltConnManager::GetTcontById (uint16_t allocId) const 
 {
   NS_ASSERT_MSG((allocId<16384), "Alloc-ID is too large (unlawful)!!!");
-  return m_tconts[allocId];
+  uint32_t row = m_tcontStateTable.GetRow (allocId);
+  if(row == XgponTcontStateTable::NO_ROW) return m_nullTcont;
+  return m_tconts[row];
+}
+
+inline XgponTcontStateTable&
+XgponOltConnManager::GetTcontStateTable ()
+{
+  return m_tcontStateTable;
 }
 
 inline const XgponQosParameters::XgponTcontType
 XgponOltConnManager::GetTcontTypeById(uint16_t allocId) const
 {
   NS_ASSERT_MSG((allocId<16384), "Alloc-ID is too large (unlawful)!!!");
-  return m_tcontsType[allocId];
+  uint32_t row = m_tcontStateTable.GetRow (allocId);
+  if(row == XgponTcontStateTable::NO_ROW) return (XgponQosParameters::XgponTcontType)0;
+  return m_tcontsType[row];
 }
 
 
@@ -212,7 +265,23 @@ inline const Ptr<XgponConnectionSender>&
 XgponOltConnManager::FindDsOmciConnByOnuId (const uint16_t onuId) const 
 {
   NS_ASSERT_MSG((onuId<1023), "ONU-ID is too large (unlawful)!!!");
-  return m_dsConnsPortIndex[onuId];
+  return FindDsConnByXgemPort (onuId);
+}
+
+inline const Ptr<XgponConnectionSender>& 
+XgponOltConnManager::FindDsConnByXgemPort (uint16_t xgemPort) const 
+{
+  uint32_t index = m_dsConnsPortIndex.Find (xgemPort);
+  if(index == XgponIdMap::NOT_FOUND) return m_nullConnSender;
+  return m_dsConns[index];
+}
+
+inline const std::vector<uint16_t>* 
+XgponOltConnManager::FindMulticastMembers (uint16_t xgemPort) const 
+{
+  uint32_t index = m_multicastGroupsPortIndex.Find (xgemPort);
+  if(index == XgponIdMap::NOT_FOUND) return 0;
+  return &(m_multicastMembers[index]);
 }
 
 
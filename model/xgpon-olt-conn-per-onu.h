@@ -59,6 +59,9 @@ public:
   uint32_t GetNumberOfTconts ();
   uint32_t GetNumberOfDsConns ();
 
+  //index: 0...GetNumberOfTconts()-1
+  const Ptr<XgponTcontOlt>& GetTcontByIndex (uint32_t index) const;
+
 
   /////////////////////////////////////////////////////////////////Member variable accessor
   void SetOnuId (uint16_t onuId);
@@ -124,6 +127,13 @@ XgponOltConnPerOnu::GetNumberOfDsConns ()
   return m_connections.size();
 }
 
+inline const Ptr<XgponTcontOlt>&
+XgponOltConnPerOnu::GetTcontByIndex (uint32_t index) const
+{
+  NS_ASSERT_MSG((index < m_tconts.size()), "T-CONT index out of range!!!");
+  return m_tconts[index];
+}
+
 
 
 }; // namespace ns3
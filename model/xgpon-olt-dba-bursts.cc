@@ -48,18 +48,16 @@ XgponOltDbaBursts::ClearBurstInfoList( )
 
 
 bool
-XgponOltDbaBursts::IsNewBurstNecessary(const Ptr<XgponTcontOlt>& tcont)
+XgponOltDbaBursts::IsNewBurstNecessary(uint16_t onuId)
 {
   NS_LOG_FUNCTION(this);
 
-  uint16_t onuId = tcont->GetOnuId();
-
-  std::list< Ptr<XgponOltDbaPerBurstInfo> >::iterator it, end;
+  std::list< Ptr<XgponOltDbaPerBurstInfo> >::const_iterator it, end;
   it = m_dbaPerBurstInfos.begin();
   end = m_dbaPerBurstInfos.end();
   while(it!=end)
   {
-    Ptr<XgponOltDbaPerBurstInfo> perBurstInfo = *it;
+    const Ptr<XgponOltDbaPerBurstInfo>& perBurstInfo = *it;
     if(perBurstInfo->GetOnuId()==onuId)
     {
       if(perBurstInfo->GetBwAllocNumber() < XgponOltDbaPerBurstInfo::MAX_TCONT_PER_BURST)
@@ -76,12 +74,11 @@ XgponOltDbaBursts::IsNewBurstNecessary(const Ptr<XgponTcontOlt>& tcont)
 
 
 
-const Ptr<XgponOltDbaPerBurstInfo> 
-XgponOltDbaBursts::GetBurstInfo4TcontOlt(const Ptr<XgponTcontOlt>& tcont)
+const Ptr<XgponOltDbaPerBurstInfo>& 
+XgponOltDbaBursts::GetBurstInfo4TcontOlt(uint16_t onuId)
 {
   NS_LOG_FUNCTION(this);
 
-  uint16_t onuId = tcont->GetOnuId();
   uint32_t num4Onu=0;
 
   std::list< Ptr<XgponOltDbaPerBurstInfo> >::iterator it, end;
@@ -89,14 +86,14 @@ XgponOltDbaBursts::GetBurstInfo4TcontOlt(const Ptr<XgponTcontOlt>& tcont)
   end = m_dbaPerBurstInfos.end();
   while(it!=end)
   {
-    Ptr<XgponOltDbaPerBurstInfo> perBurstInfo = *it;
+    const Ptr<XgponOltDbaPerBurstInfo>& perBurstInfo = *it;
     if(perBurstInfo->GetOnuId()==onuId)
     {
       if(perBurstInfo->GetBwAllocNumber() < XgponOltDbaPerBurstInfo::MAX_TCONT_PER_BURST)
       {
-        m_dbaPerBurstInfos.erase(it);
-        m_dbaPerBurstInfos.push_front(perBurstInfo);
-        return perBurstInfo;
+        //move the node to the front without touching the reference count
+        m_dbaPerBurstInfos.splice(m_dbaPerBurstInfos.begin(), m_dbaPerBurstInfos, it);
+        return m_dbaPerBurstInfos.front();
       }
       else num4Onu += perBurstInfo->GetBwAllocNumber();
     }
@@ -105,9 +102,8 @@ XgponOltDbaBursts::GetBurstInfo4TcontOlt(const Ptr<XgponTcontOlt>& tcont)
 
   if(num4Onu < MAX_TCONT_PER_ONU)
   {
-    Ptr<XgponOltDbaPerBurstInfo> perBurstInfo = Create<XgponOltDbaPerBurstInfo> ();
-    m_dbaPerBurstInfos.push_front(perBurstInfo);
-    return perBurstInfo;
+    m_dbaPerBurstInfos.push_front(Create<XgponOltDbaPerBurstInfo> ());
+    return m_dbaPerBurstInfos.front();
   } else return m_nullPerBurstInfo;  //no more bandwidth allocation for this ONU
 }
 
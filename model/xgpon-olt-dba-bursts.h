@@ -54,14 +54,17 @@ public:
   /**
     * \brief Check if a new burst is needed to serve a T-CONT. This is useful to check how much size is left to assigne in a
     * upstream phy frame.
+    * \param onuId the ONU that owns the T-CONT
     */
-  bool IsNewBurstNecessary(const Ptr<XgponTcontOlt>& tcont);
+  bool IsNewBurstNecessary(uint16_t onuId);
 
   /**
    * \brief return the perOnuInfo in which the tcont will be scheduled. 
    *        0 means that this ONU cannot be scheduled in this bwmap anymore (too many bursts for one onu).
+   *        The returned reference stays valid until the burst list is cleared.
+   * \param onuId the ONU that owns the T-CONT
    */
-  const Ptr<XgponOltDbaPerBurstInfo> GetBurstInfo4TcontOlt(const Ptr<XgponTcontOlt>& tcont);
+  const Ptr<XgponOltDbaPerBurstInfo>& GetBurstInfo4TcontOlt(uint16_t onuId);
 
 
 
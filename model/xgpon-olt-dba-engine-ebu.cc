@@ -472,38 +472,12 @@ XgponOltDbaEngineEbu::FinalizeBwmapProduction ()
 
 }
 
-uint32_t
-XgponOltDbaEngineEbu::GetAllocationBytesFromRateAndServiceInterval(uint32_t rate, uint16_t si)
-{
-  //uint128_t tmp128;
-  uint64_t tmp64;
-  uint32_t tmp32;
-
-
-  tmp64=(uint64_t)rate*(uint64_t)GetFrameSlotSize(); 	//GetFrameSlotSize()=125us=125000ns
-  tmp64=tmp64*(uint64_t)si;  	//rate is in bps and frame slot size is in nanoseconds
-  tmp64=tmp64/1000000000;     	//Get value in bits
-  if ((tmp64%(32))!=0)
-	tmp64 = (tmp64/32)*32;  //Make the value a multiple of 32 (for unit:word)
-  NS_ASSERT_MSG(tmp64%(32)==0, "Cannot assign that rate to the connection since it will not be a multiple of 4 bytes (one word).");
-  tmp32=tmp64/32;        	//Convert bits to words
-
-  return tmp32;			//unit:word
-
-}
-
-
 uint32_t
 XgponOltDbaEngineEbu::CalculateAmountData2Upload (const Ptr<XgponTcontOlt>& tcontOlt, uint32_t allocatedSize, uint64_t nowNano)
 {
   NS_LOG_FUNCTION(this);
   uint32_t size2Assign = 0;
-  uint32_t sizeRemaining = 0;
   int64_t tempVariableWord = tcontOlt->GetVariableWord();
-  
-  Ptr<XgponPhy> phy = m_device->GetXgponPhy();
-  uint32_t usPhyFrameSize = phy->GetUsPhyFrameSizeInWord();
-  Ptr<XgponBurstProfile> burstProfile = m_device->GetPloamEngine()->GetLinkInfo(tcontOlt->GetOnuId())->GetCurrentProfile();
 
 	if((tcontOlt->GetTcontType()) == XgponQosParameters::XGPON_TCONT_TYPE_1)
   {
@@ -619,134 +593,7 @@ XgponOltDbaEngineEbu::CalculateAmountData2Upload (const Ptr<XgponTcontOlt>& tcon
     }
   }
 
-
-
-  bool isNewBurstNecessary=m_bursts.IsNewBurstNecessary(tcontOlt);
-  /**************************************
-   *
-   * Get the remaining size in a frame
-   *
-   **************************************/
-
-  if(isNewBurstNecessary)
-  {
-
-    if(burstProfile->GetFec())
-    {
-      //Get the remaining size available for XGTC data when a new burst is needed and FEC is enabled.
-      uint32_t fecBlocks=(2+size2Assign)/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words; Add two to take XGTC header and trailer into account
-      if((2+size2Assign)%(phy->GetUsFecBlockDataSize()/4)!=0)
-        fecBlocks++;
-      uint32_t codeWords=fecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-      sizeRemaining = usPhyFrameSize-allocatedSize-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4-codeWords-2; //Two words for XGTC headers.
-
-    }
-    else
-    {
-      //Get the remaining size available for XGTC data when a new burst is needed and FEC is disabled.
-      sizeRemaining = usPhyFrameSize-allocatedSize-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4-2;
-    }
-  }
-  else
-  {
-    if(burstProfile->GetFec())
-    {
-      //Get the remaining size available for XGTC data when the ONU has been served before and FEC is enabled.
-      Ptr<XgponOltDbaPerBurstInfo> burstInfo=m_bursts.GetBurstInfo4TcontOlt(tcontOlt);
-      uint32_t oldDataWords=burstInfo->GetHeaderTrailerDataSize()/phy->GetUsFecBlockDataSize()/4;
-      uint32_t oldFecBlocks=oldDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
-      if(oldDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
-        oldFecBlocks++;
-      uint32_t oldCodeWords=oldFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-
-
-      uint32_t newFecBlocks=(2+size2Assign+oldDataWords)/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words; Add two to take XGTC header and trailer into account
-      if((2+size2Assign+oldDataWords)%(phy->GetUsFecBlockDataSize()/4)!=0)
-        newFecBlocks++;
-      uint32_t newCodeWords=newFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-      sizeRemaining = usPhyFrameSize-(allocatedSize-oldCodeWords)-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4-newCodeWords-2; //Two words for XGTC headers.
-
-      /*
-      Ptr<XgponOltDbaPerBurstInfo> burstInfo=m_bursts.GetBurstInfo4TcontOlt(tcontOlt);
-      uint32_t oldDataWords=burstInfo->GetHeaderTrailerDataSize()/phy->GetUsFecBlockDataSize()/4;
-      uint32_t oldFecBlocks=oldDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
-      if(oldDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
-        oldFecBlocks++;
-      uint32_t oldCodeWords=oldFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-
-      uint32_t newDataWords=oldDataWords+size2Assign; //The new burst should fill up the frame completely
-      uint32_t newFecBlocks=newDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
-      uint32_t newCodeWords=newFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-      if(newDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
-      {
-        newFecBlocks++;
-        uint32_t shortenedDataBlockSize=newDataWords%(phy->GetUsFecBlockDataSize()/4);
-        newCodeWords=newCodeWords+shortenedDataBlockSize+(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-      }
-      */
-      sizeRemaining = usPhyFrameSize-(allocatedSize-oldCodeWords);
-    }
-    else
-    {
-      //Get the remaining size available for XGTC data when the ONU has been served before and FEC is disabled.
-      sizeRemaining = usPhyFrameSize-allocatedSize;
-    }
-  }
-
-  /**************************************
-   *
-   * Prevent the bwMap from granting more than
-   * what is allowed by the US PHY frame.
-   *
-   **************************************/
-  if(size2Assign>sizeRemaining)
-  {
-    //There is not enough space to send all that the user requested
-    if(burstProfile->GetFec())
-    {
-      //FEC is enabled. We need to compute what is the maximum amount of words we can transmit,
-      //considering the FEC overhead will be smaller if the transmitted data is smaller.
-      if(isNewBurstNecessary)
-      {
-        //Computing the maximum data transmission possible, bearing in mind that a new burst is necessary to serve the T-CONT.
-        uint32_t sizeRemainingNoFec=usPhyFrameSize-allocatedSize-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4;
-
-        uint32_t fecBlocs=sizeRemainingNoFec/(phy->GetUsFecBlockSize()/4);
-        uint32_t dataRemainder=0;
-        if(sizeRemainingNoFec%(phy->GetUsFecBlockSize()/4)!=0)
-        {
-          dataRemainder=sizeRemainingNoFec-fecBlocs*(phy->GetUsFecBlockSize()/4)-(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-        }
-        sizeRemaining=fecBlocs*phy->GetUsFecBlockDataSize()/4+dataRemainder-2;
-      }
-      else
-      {
-        //Computing the maximum possible data transmission, bearing in mind that the ONU was served before.
-        Ptr<XgponOltDbaPerBurstInfo> burstInfo=m_bursts.GetBurstInfo4TcontOlt(tcontOlt);
-        uint32_t oldDataWords=burstInfo->GetHeaderTrailerDataSize()/phy->GetUsFecBlockDataSize()/4;
-        uint32_t oldFecBlocks=oldDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
-        if(oldDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
-          oldFecBlocks++;
-        uint32_t oldCodeWords=oldFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-
-        uint32_t newCodedBurstSize=usPhyFrameSize-(allocatedSize-oldCodeWords-oldDataWords);
-        uint32_t newFecBlocks = newCodedBurstSize/(phy->GetUsFecBlockSize()/4);
-        uint32_t newDataWords = newFecBlocks*(phy->GetUsFecBlockDataSize()/4);
-        if(newCodedBurstSize%(phy->GetUsFecBlockSize()/4)!=0)
-        {
-          newFecBlocks++;
-          uint32_t shortenedCodedBlockSize=newCodedBurstSize%(phy->GetUsFecBlockSize()/4);
-          newDataWords=newDataWords+shortenedCodedBlockSize-(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
-        }
-        sizeRemaining=newDataWords-oldDataWords;
-      }
-    }
-    return sizeRemaining;
-  }
-  else
-  {
-    return size2Assign;
-  }
+  return FitGrantIntoUsFrame (tcontOlt, size2Assign, allocatedSize);
 
 }
 
@@ -29,8 +29,10 @@
 
 namespace ns3 {
 
-class XgponOltDbaEngineEbu : public XgponOltDbaEngine
+class XgponOltDbaEngineEbu final : public XgponOltDbaEngine
 {
+  friend class XgponOltDbaEngine;   //calls the hooks below directly in GenerateBwMap<XgponOltDbaEngineEbu> ()
+
 public:
   const static uint32_t ALLOC_PER_SERVICE_MAX_SIZE=1000;    //1K words (4Kbytes). TODO: replace with one attribute
   const static uint32_t MAX_POLLING_INTERVAL=10000000;      //10ms. Unit: nanosecond
@@ -101,9 +103,6 @@ private:
 
   //Calculate the amount of data to be sent for the AllocOlt
   virtual uint32_t CalculateAmountData2Upload (const Ptr<XgponTcontOlt>& allocOlt,uint32_t allocatedSize, uint64_t nowNano);
-  
-  //Get the allocation bytes using service rate and SI. return in unit:words
-  uint32_t GetAllocationBytesFromRateAndServiceInterval(uint32_t rate, uint16_t si);
 
   /*
    * To set the minium service Interval in the entire XG-PON 
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c)  2013 The Provost, Fellows and Scholars of the
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Jerome A Arokkiam
+ */
+
+#include <cmath>
+
+#include "ns3/log.h"
+
+#include "xgpon-olt-dba-engine-giant-base.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponOltDbaEngineGiantBase");
+
+namespace ns3 {
+
+XgponGiantCursor::XgponGiantCursor () :
+  m_current(0),
+  m_firstRound(true)
+{
+  for (uint16_t i = 0; i < 4; i++)
+  {
+    m_firstServed[i] = i;
+    m_lastServed[i] = i;
+  }
+}
+
+void
+XgponGiantCursor::AddTcont (const Ptr<XgponTcontOlt>& tcont, uint32_t row)
+{
+  m_tconts.push_back (tcont);
+  m_rows.push_back (row);
+}
+
+void
+XgponGiantCursor::Reserve (uint32_t nTconts)
+{
+  m_tconts.reserve (m_tconts.size () + nTconts);
+  m_rows.reserve (m_rows.size () + nTconts);
+}
+
+void
+XgponGiantCursor::Enter (XgponQosParameters::XgponTcontType type)
+{
+  uint16_t i = (uint16_t)type - 1;
+  m_current = m_lastServed[i];
+  m_firstServed[i] = m_lastServed[i];
+  NS_ASSERT_MSG((m_tconts[m_current]->GetTcontType() == type), "The T-CONTs of each ONU should be added in the order of T1, T2, T3 and T4!!!");
+}
+
+bool
+XgponGiantCursor::Step (XgponQosParameters::XgponTcontType type)
+{
+  uint16_t i = (uint16_t)type - 1;
+  m_lastServed[i] = GetNextIndex (m_lastServed[i]);
+  m_current = m_lastServed[i];
+  return m_firstServed[i] == m_lastServed[i];
+}
+
+uint16_t
+XgponGiantCursor::GetRemainingT4 () const
+{
+  if (m_firstServed[3] <= m_lastServed[3])
+    return (m_tconts.size () - m_lastServed[3] + m_firstServed[3]) / 4;
+  else
+    return (m_firstServed[3] - m_lastServed[3]) / 4;
+}
+
+
+
+
+void
+XgponGiantAlternateRounds::StartT3 (XgponGiantCursor& cursor)
+{
+}
+
+bool
+XgponGiantAlternateRounds::FinishT4 (XgponGiantCursor& cursor)
+{
+  //the next BWmap starts from the first T1, T2 and T3, but from the next T4 so that T4 T-CONTs take turns to be served first.
+  cursor.m_firstRound = !(cursor.m_firstRound);
+  cursor.m_lastServed[0] = 0;
+  cursor.m_lastServed[1] = 1;
+  cursor.m_lastServed[2] = 2;
+  cursor.m_lastServed[3] = cursor.GetNextIndex (cursor.m_lastServed[3]);
+  return true;
+}
+
+void
+XgponGiantAlternateRounds::FastForward (XgponGiantCursor& cursor, uint64_t nFrames)
+{
+  //T1, T2 and T3 start from the first T-CONT in every BWmap; only the round and the first T4 move.
+  uint16_t numT4 = cursor.m_tconts.size () / 4;
+  uint16_t t4 = cursor.m_lastServed[3] / 4;
+  if (nFrames % 2 == 1)
+    cursor.m_firstRound = !(cursor.m_firstRound);
+  cursor.m_firstServed[3] = 3 + ((t4 + nFrames - 1) % numT4) * 4;
+  cursor.m_lastServed[3] = 3 + ((t4 + nFrames) % numT4) * 4;
+  cursor.m_current = cursor.m_firstServed[3];
+}
+
+
+void
+XgponGiantRepeatedT3Round::StartT3 (XgponGiantCursor& cursor)
+{
+  cursor.m_firstRound = true;
+}
+
+bool
+XgponGiantRepeatedT3Round::FinishT4 (XgponGiantCursor& cursor)
+{
+  if (cursor.m_firstRound)
+  {
+    //go back to T3 for the PIR round
+    cursor.m_firstRound = false;
+    cursor.Enter (XgponQosParameters::XGPON_TCONT_TYPE_3);
+    return false;
+  }
+
+  cursor.m_firstRound = true;
+  for (uint16_t i = 0; i < 4; i++)
+    cursor.m_lastServed[i] = i;
+  return true;
+}
+
+void
+XgponGiantRepeatedT3Round::FastForward (XgponGiantCursor& cursor, uint64_t nFrames)
+{
+  //every complete BWmap starts from and returns to the first T-CONT of each type.
+}
+
+
+
+
+void
+XgponGiantServiceIntervalTimers::Tick (const std::vector< Ptr<XgponTcontOlt> >& tconts)
+{
+  std::vector< Ptr<XgponTcontOlt> >::const_iterator it;
+  for (it = tconts.begin(); it != tconts.end(); it++)
+  {
+    if ((*it)->GetPIRtimerValue() > XgponTcontOlt::TIMER_EXPIRE_VALUE)
+      (*it)->UpdatePIRtimer();
+    if ( ((*it)->GetTcontType() == XgponQosParameters::XGPON_TCONT_TYPE_3) || ((*it)->GetTcontType() == XgponQosParameters::XGPON_TCONT_TYPE_4) )
+    {
+      if ((*it)->GetGIRtimerValue() > XgponTcontOlt::TIMER_EXPIRE_VALUE)
+        (*it)->UpdateGIRtimer();
+    }
+  }
+}
+
+void
+XgponGiantServiceIntervalTimers::FastForward (const std::vector< Ptr<XgponTcontOlt> >& tconts, uint64_t nFrames)
+{
+  std::vector< Ptr<XgponTcontOlt> >::const_iterator it;
+  for (it = tconts.begin(); it != tconts.end(); it++)
+  {
+    (*it)->AdvancePIRtimer (nFrames);
+    if ( ((*it)->GetTcontType() == XgponQosParameters::XGPON_TCONT_TYPE_3) || ((*it)->GetTcontType() == XgponQosParameters::XGPON_TCONT_TYPE_4) )
+      (*it)->AdvanceGIRtimer (nFrames);
+  }
+}
+
+
+
+
+XgponGiantDeficitT4::XgponGiantDeficitT4 () :
+  m_totDeficit(0),
+  m_extraAlloc(0)
+{
+}
+
+void
+XgponGiantDeficitT4::AddTcont ()
+{
+  m_deficits.push_back (0);
+}
+
+void
+XgponGiantDeficitT4::StartT4 (const XgponGiantCursor& cursor, const XgponTcontStateTable& table)
+{
+  if (cursor.m_firstRound) //all deficits and extra allocations are reset at the beginning of every cycle
+  {
+    m_totDeficit = 0;
+    m_extraAlloc = 0;
+    m_deficits.assign (m_deficits.size(), 0);
+  }
+}
+
+uint32_t
+XgponGiantDeficitT4::Grant (const XgponGiantCursor& cursor, uint32_t request, uint32_t allocationWords,
+                            uint32_t allocatedSize, uint32_t usPhyFrameSize, bool served)
+{
+  uint32_t size2Assign = request;
+  uint16_t index = cursor.m_lastServed[3] / 4;
+  uint32_t nextT4threshold = (usPhyFrameSize - allocatedSize - 10 + m_extraAlloc) / cursor.GetRemainingT4 ();
+
+  if (cursor.m_firstRound)
+  {
+    if (size2Assign == 0)
+      return 1;
+
+    if (size2Assign > nextT4threshold)
+    {
+      uint32_t deficit = size2Assign - nextT4threshold;
+      m_deficits.at(index) = deficit;
+      m_totDeficit += deficit;
+      size2Assign = nextT4threshold;
+    }
+    else
+      m_extraAlloc += nextT4threshold - size2Assign;
+  }
+  else
+  {
+    size2Assign += m_deficits.at(index);
+    if (size2Assign > 3*nextT4threshold)  //capping for bursty traffic
+      size2Assign = nextT4threshold;
+    if (size2Assign == 0)
+      return 1;
+  }
+
+  if (size2Assign < 4)
+    size2Assign = 4; //smallest allocation for receiving data from ONU
+  if (!served)
+    size2Assign += 1;
+  return size2Assign;
+}
+
+void
+XgponGiantDeficitT4::FastForward (const XgponGiantCursor& cursor, uint64_t nFrames)
+{
+  //nothing is cut from a zero request; only the reset done by StartT4 in the first round remains.
+  if (nFrames > 1 || cursor.m_firstRound)
+  {
+    m_totDeficit = 0;
+    m_extraAlloc = 0;
+    m_deficits.assign (m_deficits.size(), 0);
+  }
+}
+
+
+
+
+XgponGiantProportionalT4::XgponGiantProportionalT4 () :
+  m_t4FirstTcont(false),
+  m_totRequest(0),
+  m_totAlloc(0),
+  m_burstFactor(1)
+{
+}
+
+void
+XgponGiantProportionalT4::AddTcont ()
+{
+  m_requests.push_back (0);
+}
+
+void
+XgponGiantProportionalT4::StartT4 (const XgponGiantCursor& cursor, const XgponTcontStateTable& table)
+{
+  //regardless of which T4 is served first, the requests of all T4 T-CONTs are recorded before the first T4 is serviced in each alloc cycle
+  m_t4FirstTcont = true;
+  m_totRequest = 0;
+  for (uint16_t index = 3; index < cursor.m_tconts.size(); index += 4)
+  {
+    m_requests.at(index/4) = table.GetRemainingData (cursor.m_rows[index]);
+    m_totRequest += m_requests.at(index/4);
+  }
+}
+
+uint32_t
+XgponGiantProportionalT4::Grant (const XgponGiantCursor& cursor, uint32_t request, uint32_t allocationWords,
+                                 uint32_t allocatedSize, uint32_t usPhyFrameSize, bool served)
+{
+  uint32_t size2Assign = 0;
+
+  if (m_t4FirstTcont)
+  {
+    m_t4FirstTcont = false;
+    m_totAlloc = usPhyFrameSize - allocatedSize;
+    if (m_totRequest != 0)
+      m_burstFactor = std::sqrt(m_totRequest/(usPhyFrameSize-allocatedSize));
+    if (m_burstFactor < 1)
+      m_burstFactor = 1;
+  }
+
+  //size2Assign = min{share, request}, to avoid overprovision when the network is underloaded.
+  if (m_totRequest != 0)
+  {
+    uint32_t collected = m_requests.at(cursor.m_lastServed[3]/4);
+    size2Assign = m_burstFactor*m_totAlloc*collected/m_totRequest;
+    if (size2Assign > collected)
+      size2Assign = collected;
+  }
+
+  if ((size2Assign > 0) && (size2Assign < 4))
+    size2Assign = 4; //smallest allocation for receiving data from ONU
+  if (!served)
+    size2Assign += 1; //T4 is polled every time it is visited
+  return size2Assign;
+}
+
+void
+XgponGiantProportionalT4::FastForward (const XgponGiantCursor& cursor, uint64_t nFrames)
+{
+  //the requests collected by StartT4 are all zero, as they already were in the latest BWmap. m_totAlloc is set again before it is used.
+}
+
+
+
+
+void
+XgponGiantCappedT4::AddTcont ()
+{
+}
+
+void
+XgponGiantCappedT4::StartT4 (const XgponGiantCursor& cursor, const XgponTcontStateTable& table)
+{
+}
+
+uint32_t
+XgponGiantCappedT4::Grant (const XgponGiantCursor& cursor, uint32_t request, uint32_t allocationWords,
+                           uint32_t allocatedSize, uint32_t usPhyFrameSize, bool served)
+{
+  //T4 is only polled in the first round
+  if (cursor.m_firstRound)
+    return 0;
+
+  if (request == 0)
+    return 1;
+
+  uint32_t size2Assign = request;
+  if (size2Assign < 4)
+    size2Assign = 4; //smallest allocation for receiving data from ONU
+  if (!served)
+    size2Assign += 1;
+  if (size2Assign > allocationWords)
+    size2Assign = allocationWords;
+  return size2Assign;
+}
+
+void
+XgponGiantCappedT4::FastForward (const XgponGiantCursor& cursor, uint64_t nFrames)
+{
+}
+
+
+}//namespace ns3
@@ -0,0 +1,558 @@
+/*
+ * Copyright (c)  2013 The Provost, Fellows and Scholars of the
+ * College of the Holy and Undivided Trinity of Queen Elizabeth near Dublin.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Jerome A Arokkiam
+ */
+
+#ifndef XGPON_OLT_DBA_ENGINE_GIANT_BASE_H_
+#define XGPON_OLT_DBA_ENGINE_GIANT_BASE_H_
+
+#include <vector>
+
+#include "ns3/assert.h"
+
+#include "xgpon-olt-dba-engine.h"
+#include "xgpon-tcont-olt.h"
+#include "xgpon-qos-parameters.h"
+#include "xgpon-tcont-state-table.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief The per-type cursors shared by the GIANT family of DBA engines.
+ *
+ * T-CONTs are kept in the order they are added: T1, T2, T3 and T4 of the first ONU, then those of the second ONU, and so on.
+ * Thus, the T-CONTs of one type are four entries apart, and each type keeps where its current round started and which
+ * T-CONT was served last, so that the next BWmap continues from there. The row of each T-CONT in XgponTcontStateTable is kept
+ * alongside, so that the per-frame state is read without touching the T-CONT itself.
+ */
+class XgponGiantCursor
+{
+public:
+  XgponGiantCursor ();
+
+  void AddTcont (const Ptr<XgponTcontOlt>& tcont, uint32_t row);
+  void Reserve (uint32_t nTconts);
+
+  /**
+   * \brief start serving one type from its last served T-CONT.
+   */
+  void Enter (XgponQosParameters::XgponTcontType type);
+
+  /**
+   * \brief move to the next T-CONT of this type (wrapping around).
+   * \return true if all T-CONTs of this type have been visited in the current round.
+   */
+  bool Step (XgponQosParameters::XgponTcontType type);
+
+  //the index of the next T-CONT of the same type
+  uint16_t GetNextIndex (uint16_t index) const;
+
+  //the number of T4 T-CONTs that have not been visited in the current round (including the current one).
+  uint16_t GetRemainingT4 () const;
+
+  const Ptr<XgponTcontOlt>& GetCurrent () const;
+  uint32_t GetCurrentRow () const;
+
+
+  std::vector< Ptr<XgponTcontOlt> > m_tconts;
+  std::vector<uint32_t> m_rows;   //the row of each T-CONT in XgponTcontStateTable
+  uint16_t m_firstServed[4];      //indexed by (type - 1): the T-CONT that started the current round of this type
+  uint16_t m_lastServed[4];       //indexed by (type - 1): the T-CONT of this type that is (or was most recently) served
+  uint16_t m_current;             //the T-CONT under the cursor
+  bool m_firstRound;              //true: GIR round of T3; false: PIR round of T3
+};
+
+
+
+/**
+ * \brief Service order of GIANT: one BWmap visits every type once; GIR and PIR rounds of T3 alternate between BWmaps.
+ */
+class XgponGiantAlternateRounds
+{
+public:
+  static constexpr double T3_PIR_SHARE = 0.8;      //the share of allocationWords that T3 gets in its PIR round
+
+  static void StartT3 (XgponGiantCursor& cursor);
+
+  /**
+   * \brief called when all T4 T-CONTs have been visited. return true to end the BWmap.
+   */
+  static bool FinishT4 (XgponGiantCursor& cursor);
+
+  /**
+   * \brief move the cursor over nFrames BWmaps that visit every T-CONT: the rounds alternate and T4 starts one T-CONT later each time.
+   */
+  static void FastForward (XgponGiantCursor& cursor, uint64_t nFrames);
+};
+
+/**
+ * \brief Service order of XGIANT: T3 and T4 are visited twice in one BWmap, first for GIR and then for PIR.
+ */
+class XgponGiantRepeatedT3Round
+{
+public:
+  static constexpr double T3_PIR_SHARE = 0.6;
+
+  static void StartT3 (XgponGiantCursor& cursor);
+  static bool FinishT4 (XgponGiantCursor& cursor);
+  static void FastForward (XgponGiantCursor& cursor, uint64_t nFrames);
+};
+
+
+
+/**
+ * \brief Timer policy without service intervals: every T-CONT can be served whenever it is visited.
+ *
+ * The timers of the T-CONTs are left alone. GIANT used to reset the PIR timer of each T1 that it served; this is not
+ * done here, since it changed nothing: the timer is set to the service interval when the T-CONT is added
+ * (CalculateTcontQosParameters), this policy never counts it down, and nothing else reads it under these engines.
+ */
+class XgponGiantNoTimers
+{
+public:
+  static bool IsExpired (const Ptr<XgponTcontOlt>& tcont, bool gir);
+  static void Rearm (const Ptr<XgponTcontOlt>& tcont, bool gir);
+  static void Tick (const std::vector< Ptr<XgponTcontOlt> >& tconts);
+  static void FastForward (const std::vector< Ptr<XgponTcontOlt> >& tconts, uint64_t nFrames);
+};
+
+/**
+ * \brief Timer policy of XGIANT: a T-CONT is only served when its GIR (first round of T3/T4) or PIR timer has expired.
+ *        The timers are re-armed when the T-CONT is served and count down once per BWmap.
+ */
+class XgponGiantServiceIntervalTimers
+{
+public:
+  static bool IsExpired (const Ptr<XgponTcontOlt>& tcont, bool gir);
+  static void Rearm (const Ptr<XgponTcontOlt>& tcont, bool gir);
+  static void Tick (const std::vector< Ptr<XgponTcontOlt> >& tconts);
+
+  /**
+   * \brief the timers after nFrames BWmaps that visit every T-CONT in both rounds (as XgponGiantRepeatedT3Round does)
+   *        and grant nothing but polls: each timer is re-armed whenever it has expired.
+   */
+  static void FastForward (const std::vector< Ptr<XgponTcontOlt> >& tconts, uint64_t nFrames);
+};
+
+
+
+/**
+ * \brief T4 (surplus) policy of GIANT and XGIANT-DEFICIT: each T4 T-CONT is granted at most an equal share of the space left
+ *        in the frame during the first round; what was cut is remembered as its deficit and added to its request in the second round.
+ */
+class XgponGiantDeficitT4
+{
+public:
+  XgponGiantDeficitT4 ();
+
+  void AddTcont ();
+  void StartT4 (const XgponGiantCursor& cursor, const XgponTcontStateTable& table);
+  uint32_t Grant (const XgponGiantCursor& cursor, uint32_t request, uint32_t allocationWords,
+                  uint32_t allocatedSize, uint32_t usPhyFrameSize, bool served);
+
+  /**
+   * \brief the state after nFrames BWmaps in which no T4 T-CONT requests anything; the cursor is at the first of them.
+   */
+  void FastForward (const XgponGiantCursor& cursor, uint64_t nFrames);
+
+private:
+  std::vector<uint32_t> m_deficits;       //indexed by onu order (index / 4)
+  uint32_t m_totDeficit, m_extraAlloc;
+};
+
+/**
+ * \brief T4 policy of XGIANT-PROP: the requests of all T4 T-CONTs are collected when T4 starts, and the space left in the frame
+ *        (scaled by a burst factor) is granted in proportion to them.
+ */
+class XgponGiantProportionalT4
+{
+public:
+  XgponGiantProportionalT4 ();
+
+  void AddTcont ();
+  void StartT4 (const XgponGiantCursor& cursor, const XgponTcontStateTable& table);
+  uint32_t Grant (const XgponGiantCursor& cursor, uint32_t request, uint32_t allocationWords,
+                  uint32_t allocatedSize, uint32_t usPhyFrameSize, bool served);
+  void FastForward (const XgponGiantCursor& cursor, uint64_t nFrames);
+
+private:
+  std::vector<uint32_t> m_requests;       //indexed by onu order (index / 4)
+  bool m_t4FirstTcont;
+  uint32_t m_totRequest, m_totAlloc;
+  double m_burstFactor;                   //spreads one round of T4 across multiple allocation cycles
+};
+
+/**
+ * \brief T4 policy of XGIANT: T4 is only polled in the first round and gets min(request, allocationWords) in the second round.
+ */
+class XgponGiantCappedT4
+{
+public:
+  void AddTcont ();
+  void StartT4 (const XgponGiantCursor& cursor, const XgponTcontStateTable& table);
+  uint32_t Grant (const XgponGiantCursor& cursor, uint32_t request, uint32_t allocationWords,
+                  uint32_t allocatedSize, uint32_t usPhyFrameSize, bool served);
+  void FastForward (const XgponGiantCursor& cursor, uint64_t nFrames);
+};
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief The common part of the GIANT family of DBA engines (GIANT, XGIANT, XGIANT-DEFICIT and XGIANT-PROP).
+ *
+ * T1 is always granted its allocationWords, T2 gets min(request, allocationWords), and T3 gets min(request, 0.2*allocationWords)
+ * in its GIR round and a larger share in its PIR round. How the rounds are ordered (ServiceOrder), whether service-interval
+ * timers gate the grants (Timers) and how the remaining space is shared among T4 T-CONTs (T4Policy) are the policies that
+ * differ among the engines. They are resolved at compile time; each engine only adds its TypeId.
+ */
+template <class ServiceOrder, class Timers, class T4Policy>
+class XgponOltDbaEngineGiantBase : public XgponOltDbaEngine
+{
+  friend class XgponOltDbaEngine;   //the hooks are called directly when GenerateBwMap is instantiated for one engine of this family
+
+public:
+  const static uint32_t ALLOC_PER_SERVICE_MAX_SIZE=1000;    //1K words (4Kbytes). TODO: replace with one attribute
+  const static uint32_t MAX_POLLING_INTERVAL=10000000;      //10ms. Unit: nanosecond
+  const static uint32_t TIMER_EXPIRE_VALUE=0;               //Value at which the timer expires. Unit: frames.
+
+  XgponOltDbaEngineGiantBase ();
+  virtual ~XgponOltDbaEngineGiantBase ();
+
+  /**
+   * \brief Add Alloc-Id info into the DBA Engine
+   * \param the Alloc-Id to be added to the engine
+   */
+  virtual void AddTcontToDbaEngine (Ptr<XgponTcontOlt>& alloc);
+
+  virtual void ReserveTcontsInDbaEngine (uint32_t nTconts);
+
+  virtual void Prepare2ProduceBwmap ();
+
+  /**
+   * \brief update the service-interval timers (if any) after one BWmap is produced.
+   */
+  virtual void FinalizeBwmapProduction ();
+
+  //checks if all tconts have been served
+  virtual bool CheckAllTcontsServed ();
+
+private:
+  //idle frames can be skipped once the last two BWmaps (one of each round) have visited all T-CONTs, unless a T1 T-CONT
+  //has fixed allocation words: its grants do not depend on the status reports, so an idle frame would still carry them.
+  virtual bool DoCanFastForwardIdleFrames ( );
+  virtual void DoFastForwardIdleFrames (uint64_t nFrames);
+
+  virtual const Ptr<XgponTcontOlt>& GetNextTcontOlt ( );
+  virtual const Ptr<XgponTcontOlt>& GetCurrentTcontOlt ( );
+  virtual const Ptr<XgponTcontOlt>& GetFirstTcontOlt ( );
+
+  //Calculate the amount of data to be sent for the T-CONT
+  virtual uint32_t CalculateAmountData2Upload (const Ptr<XgponTcontOlt>& tcontOlt, uint32_t allocatedSize, uint64_t nowNano);
+
+  //min(request, share*allocationWords), but at least 4 words and one more word for the status report; poll when nothing is requested.
+  static uint32_t ShapeGrant (uint32_t allocationWords, uint32_t request, double share, uint32_t poll, bool served);
+
+  XgponGiantCursor m_cursor;
+  T4Policy m_t4Policy;
+
+  bool m_stop;        //used to break the loop in GenerateBwMap()
+  uint16_t m_completedBwmaps;  //the number of the latest BWmaps (at most 2) that have visited all T-CONTs
+  uint32_t m_fixedAllocationInWords;  //the allocation words of all T1 T-CONTs (fixed bandwidth)
+
+  //TODO: these will be used to prevent BE starvation by reserving a portion of total US transmission opportunity.
+  uint32_t m_nonBestEffortAllocationInWords, m_totalAllocationInWords;
+};
+
+
+
+
+///////////////////////////////////////////INLINE functions
+inline uint16_t
+XgponGiantCursor::GetNextIndex (uint16_t index) const
+{
+  index += 4;
+  if (index >= m_tconts.size ())
+    index = index % 4;
+  return index;
+}
+
+inline const Ptr<XgponTcontOlt>&
+XgponGiantCursor::GetCurrent () const
+{
+  return m_tconts[m_current];
+}
+
+inline uint32_t
+XgponGiantCursor::GetCurrentRow () const
+{
+  return m_rows[m_current];
+}
+
+
+inline bool
+XgponGiantNoTimers::IsExpired (const Ptr<XgponTcontOlt>& tcont, bool gir)
+{
+  return true;
+}
+inline void
+XgponGiantNoTimers::Rearm (const Ptr<XgponTcontOlt>& tcont, bool gir)
+{
+}
+inline void
+XgponGiantNoTimers::Tick (const std::vector< Ptr<XgponTcontOlt> >& tconts)
+{
+}
+inline void
+XgponGiantNoTimers::FastForward (const std::vector< Ptr<XgponTcontOlt> >& tconts, uint64_t nFrames)
+{
+}
+
+
+inline bool
+XgponGiantServiceIntervalTimers::IsExpired (const Ptr<XgponTcontOlt>& tcont, bool gir)
+{
+  if (gir)
+    return tcont->GetGIRtimerValue () == XgponTcontOlt::TIMER_EXPIRE_VALUE;
+  else
+    return tcont->GetPIRtimerValue () == XgponTcontOlt::TIMER_EXPIRE_VALUE;
+}
+inline void
+XgponGiantServiceIntervalTimers::Rearm (const Ptr<XgponTcontOlt>& tcont, bool gir)
+{
+  if (gir)
+    tcont->ResetGIRtimer ();
+  else
+    tcont->ResetPIRtimer ();
+}
+
+
+
+
+template <class ServiceOrder, class Timers, class T4Policy>
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::XgponOltDbaEngineGiantBase () : XgponOltDbaEngine(),
+  m_stop(false),
+  m_completedBwmaps(0),
+  m_fixedAllocationInWords(0),
+  m_nonBestEffortAllocationInWords(0),
+  m_totalAllocationInWords(0)
+{
+}
+
+template <class ServiceOrder, class Timers, class T4Policy>
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::~XgponOltDbaEngineGiantBase ()
+{
+}
+
+
+template <class ServiceOrder, class Timers, class T4Policy>
+void
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::AddTcontToDbaEngine (Ptr<XgponTcontOlt>& alloc)
+{
+  //initially, allocatedRate, sI are calculated; then allocationWords. The SI timers are kept in the T-CONT.
+  XgponQosParameters::XgponTcontType type = alloc->GetTcontType();
+  alloc->CalculateTcontQosParameters(type);
+  alloc->SetAllocationWords (GetAllocationBytesFromRateAndServiceInterval(alloc->GetAllocatedRate(), alloc->GetServiceInterval()));
+
+  XgponTcontStateTable& table = GetTcontStateTable ();
+  uint32_t row = table.GetRow (alloc->GetAllocId());
+  NS_ASSERT_MSG((row != XgponTcontStateTable::NO_ROW), "The T-CONT should be added into XgponOltConnManager before the DBA engine!!!");
+  table.SetAllocationWords (row, alloc->GetAllocationWords());
+
+  if ( type == XgponQosParameters::XGPON_TCONT_TYPE_1 )
+    m_fixedAllocationInWords += alloc->GetAllocationWords();
+  if ( type != XgponQosParameters::XGPON_TCONT_TYPE_4 )
+    m_nonBestEffortAllocationInWords += alloc->GetAllocationWords(); 	//total BW requirement without BE
+  m_totalAllocationInWords += alloc->GetAllocationWords();	//total BW requirement including BE
+
+  m_cursor.AddTcont (alloc, row);
+  if (type == XgponQosParameters::XGPON_TCONT_TYPE_4)
+    m_t4Policy.AddTcont ();
+}
+
+template <class ServiceOrder, class Timers, class T4Policy>
+void
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::ReserveTcontsInDbaEngine (uint32_t nTconts)
+{
+  m_cursor.Reserve (nTconts);
+}
+
+
+template <class ServiceOrder, class Timers, class T4Policy>
+const Ptr<XgponTcontOlt>&
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::GetFirstTcontOlt ( )
+{
+  //T1 is always served first every alloc cycle, starting from the T1 that was served last.
+  m_stop = false;
+  NS_ASSERT_MSG(!m_cursor.m_tconts.empty(), "No tconts available to be served!!!");
+
+  m_cursor.Enter (XgponQosParameters::XGPON_TCONT_TYPE_1);
+  return m_cursor.GetCurrent ();
+}
+
+template <class ServiceOrder, class Timers, class T4Policy>
+const Ptr<XgponTcontOlt>&
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::GetCurrentTcontOlt ( )
+{
+  return m_cursor.GetCurrent ();
+}
+
+template <class ServiceOrder, class Timers, class T4Policy>
+const Ptr<XgponTcontOlt>&
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::GetNextTcontOlt ( )
+{
+  return m_cursor.GetCurrent ();
+}
+
+
+//All Tconts are visited at least once before the cycle of served tconts repeated. When the frame is full, the allocation cycle
+//is broken in the middle and the next BWmap continues from the last served T-CONT of each type.
+template <class ServiceOrder, class Timers, class T4Policy>
+bool
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::CheckAllTcontsServed ()
+{
+  XgponQosParameters::XgponTcontType type = m_cursor.GetCurrent ()->GetTcontType();
+  if (!m_cursor.Step (type))
+    return m_stop;
+
+  switch (type)
+  {
+  case XgponQosParameters::XGPON_TCONT_TYPE_1:
+    m_cursor.Enter (XgponQosParameters::XGPON_TCONT_TYPE_2);
+    break;
+  case XgponQosParameters::XGPON_TCONT_TYPE_2:
+    m_cursor.Enter (XgponQosParameters::XGPON_TCONT_TYPE_3);
+    ServiceOrder::StartT3 (m_cursor);
+    break;
+  case XgponQosParameters::XGPON_TCONT_TYPE_3:
+    m_cursor.Enter (XgponQosParameters::XGPON_TCONT_TYPE_4);
+    m_t4Policy.StartT4 (m_cursor, GetTcontStateTable ());
+    break;
+  default:
+    NS_ASSERT (type == XgponQosParameters::XGPON_TCONT_TYPE_4);
+    m_stop = ServiceOrder::FinishT4 (m_cursor);
+    break;
+  }
+  return m_stop;
+}
+
+
+template <class ServiceOrder, class Timers, class T4Policy>
+void
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::Prepare2ProduceBwmap ( )
+{
+}
+
+template <class ServiceOrder, class Timers, class T4Policy>
+void
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::FinalizeBwmapProduction ()
+{
+  Timers::Tick (m_cursor.m_tconts);
+
+  //the loop of GenerateBwMap is only broken by CheckAllTcontsServed when the cycle is complete; otherwise the frame is full.
+  if (!m_stop)
+    m_completedBwmaps = 0;
+  else if (m_completedBwmaps < 2)
+    m_completedBwmaps++;
+}
+
+
+template <class ServiceOrder, class Timers, class T4Policy>
+bool
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::DoCanFastForwardIdleFrames ( )
+{
+  return m_completedBwmaps == 2 && m_fixedAllocationInWords == 0;
+}
+
+template <class ServiceOrder, class Timers, class T4Policy>
+void
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::DoFastForwardIdleFrames (uint64_t nFrames)
+{
+  //the T4 policy needs the round of the first skipped BWmap, before the cursor is moved.
+  m_t4Policy.FastForward (m_cursor, nFrames);
+  ServiceOrder::FastForward (m_cursor, nFrames);
+  Timers::FastForward (m_cursor.m_tconts, nFrames);
+}
+
+
+template <class ServiceOrder, class Timers, class T4Policy>
+uint32_t
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::ShapeGrant (uint32_t allocationWords, uint32_t request, double share, uint32_t poll, bool served)
+{
+  if (request == 0)
+    return poll;
+
+  uint32_t size2Assign = request;
+  if (size2Assign < 4)
+    size2Assign = 4; //smallest allocation for receiving data from ONU
+  if (size2Assign > share*allocationWords)
+    size2Assign = share*allocationWords;
+  if (!served)
+    size2Assign += 1; //This T-CONT was not served before in this bwMap, add one word for queue status report
+  return size2Assign;
+}
+
+
+template <class ServiceOrder, class Timers, class T4Policy>
+uint32_t
+XgponOltDbaEngineGiantBase<ServiceOrder, Timers, T4Policy>::CalculateAmountData2Upload (const Ptr<XgponTcontOlt>& tcontOlt, uint32_t allocatedSize, uint64_t nowNano)
+{
+  //tcontOlt is the T-CONT under the cursor
+  const XgponTcontStateTable& table = GetTcontStateTable ();
+  uint32_t row = m_cursor.GetCurrentRow ();
+  XgponQosParameters::XgponTcontType type = table.GetTcontType (row);
+  uint32_t request = table.GetRemainingData (row);
+  uint32_t allocationWords = table.GetAllocationWords (row);
+
+  //the first round of T3/T4 is governed by the GIR timer, everything else by the PIR timer.
+  bool gir = m_cursor.m_firstRound
+    && (type == XgponQosParameters::XGPON_TCONT_TYPE_3 || type == XgponQosParameters::XGPON_TCONT_TYPE_4);
+
+  //when the timer has not expired yet, the request is passed on as it is.
+  uint32_t size2Assign = request;
+  if (Timers::IsExpired (tcontOlt, gir))
+  {
+    bool served = CheckServedTcont(tcontOlt->GetAllocId());
+    if (type == XgponQosParameters::XGPON_TCONT_TYPE_1)
+      size2Assign = allocationWords;
+    else if (type == XgponQosParameters::XGPON_TCONT_TYPE_2)
+      size2Assign = ShapeGrant (allocationWords, request, 1, 1, served);
+    else if (type == XgponQosParameters::XGPON_TCONT_TYPE_3)
+    {
+      //no need to poll T3 in the GIR round as it is polled in the PIR round.
+      if (m_cursor.m_firstRound)
+        size2Assign = ShapeGrant (allocationWords, request, 0.2, 0, served);
+      else
+        size2Assign = ShapeGrant (allocationWords, request, ServiceOrder::T3_PIR_SHARE, 1, served);
+    }
+    else
+    {
+      NS_ASSERT_MSG( (type == XgponQosParameters::XGPON_TCONT_TYPE_4), "Invalid Tcont Type detected at allocating grants!!!");
+      size2Assign = m_t4Policy.Grant (m_cursor, request, allocationWords, allocatedSize, GetUsPhyFrameSize(), served);
+    }
+    Timers::Rearm (tcontOlt, gir);
+  }
+
+  return FitGrantIntoUsFrame (tcontOlt, size2Assign, allocatedSize);
+}
+
+
+}; // namespace ns3
+
+#endif /* XGPON_OLT_DBA_ENGINE_GIANT_BASE_H_ */
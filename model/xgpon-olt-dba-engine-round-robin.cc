@@ -62,7 +62,8 @@ XgponOltDbaEngineRoundRobin::GetInstanceTypeId (void) const
 
 XgponOltDbaEngineRoundRobin::XgponOltDbaEngineRoundRobin () : XgponOltDbaEngine(),
   m_lastScheduledTcontIndex(0),
-  m_getNextTcontAtBeginning(false)
+  m_getNextTcontAtBeginning(false),
+  m_allTcontsServed(false)
 {
   m_usAllTconts.clear();
 }
@@ -82,6 +83,12 @@ XgponOltDbaEngineRoundRobin::AddTcontToDbaEngine (Ptr<XgponTcontOlt>& tcont)
   return;
 } 
 
+void 
+XgponOltDbaEngineRoundRobin::ReserveTcontsInDbaEngine (uint32_t nTconts)
+{
+  m_usAllTconts.reserve(m_usAllTconts.size() + nTconts);
+} 
+
 
 
 const Ptr<XgponTcontOlt>& 
@@ -127,6 +134,7 @@ XgponOltDbaEngineRoundRobin::CheckAllTcontsServed ( )
      * one flag should be used to notify OLT that GetNextTcontOlt should not
      * be called at the beginning of the next round.
      *******************************************************************/
+    m_allTcontsServed = true;
     return true; //to break the DBA loop
   }
   else
@@ -137,7 +145,8 @@ XgponOltDbaEngineRoundRobin::CheckAllTcontsServed ( )
 uint32_t 
 XgponOltDbaEngineRoundRobin::CalculateAmountData2Upload (const Ptr<XgponTcontOlt>& tcontOlt,uint32_t allocatedSize, uint64_t nowNano)
 {
-  uint32_t size2Assign = tcontOlt->CalculateRemainingDataToServe(GetRtt(), GetFrameSlotSize()); 
+  const XgponTcontStateTable& table = GetTcontStateTable ();
+  uint32_t size2Assign = table.GetRemainingData (table.GetRow (tcontOlt->GetAllocId()));
   if(size2Assign > 0)
   {
     //always allow the t-cont to piggyback queue status report with its upstream data
@@ -162,6 +171,7 @@ XgponOltDbaEngineRoundRobin::CalculateAmountData2Upload (const Ptr<XgponTcontOlt
 void 
 XgponOltDbaEngineRoundRobin::Prepare2ProduceBwmap ( )
 {
+  m_allTcontsServed = false;
 }
 
 void
@@ -170,4 +180,17 @@ XgponOltDbaEngineRoundRobin::FinalizeBwmapProduction ()
 }
 
 
+bool
+XgponOltDbaEngineRoundRobin::DoCanFastForwardIdleFrames ( )
+{
+  return m_allTcontsServed;
+}
+
+void
+XgponOltDbaEngineRoundRobin::DoFastForwardIdleFrames (uint64_t nFrames)
+{
+  //every idle BWmap polls all T-CONTs from m_lastScheduledTcontIndex and leaves it unchanged.
+}
+
+
 }//namespace ns3
@@ -37,8 +37,10 @@ namespace ns3 {
  *        A simple round-robin scheme is implemented in this sub-class.
  *
  */
-class XgponOltDbaEngineRoundRobin : public XgponOltDbaEngine
+class XgponOltDbaEngineRoundRobin final : public XgponOltDbaEngine
 {
+  friend class XgponOltDbaEngine;   //calls the hooks below directly in GenerateBwMap<XgponOltDbaEngineRoundRobin> ()
+
 public:
   const static uint32_t XGPON1_TCONT_PER_SERVICE_MAX_SIZE=9718;    //9718K words (around 40Kbytes to let one flow to fuly utilize the whole network). 
   const static uint32_t XGPON1_MAX_POLLING_INTERVAL=2000000;       //2ms. Unit: nanosecond
@@ -58,6 +60,8 @@ public:
    */
   virtual void  AddTcontToDbaEngine (Ptr<XgponTcontOlt>& tcont); 
 
+  virtual void  ReserveTcontsInDbaEngine (uint32_t nTconts); 
+
 
 
   ///////////////////////////////////////Functions required by NS-3
@@ -104,6 +108,10 @@ private:
   //For round robin, nothing to be done. In other dba algorithms, olt should first check the T-CONT with the highest priority.
   virtual void FinalizeBwmapProduction ();
 
+  //when all T-CONTs are polled in one BWmap, the cursor is back where it started: idle frames leave the state as it is.
+  virtual bool DoCanFastForwardIdleFrames ( );
+  virtual void DoFastForwardIdleFrames (uint64_t nFrames);
+
 
 
 
@@ -117,6 +125,7 @@ private:
   
   Ptr<XgponTcontOlt> m_firstTcontOlt;
   bool m_getNextTcontAtBeginning;  //whether to get the next T-CONT at the beginning of bwmap generation
+  bool m_allTcontsServed;          //whether all T-CONTs have been considered in the latest BWmap
 
 };
 
@@ -24,8 +24,20 @@
 #include "ns3/simulator.h"
 
 #include "xgpon-olt-dba-engine.h"
+#include "xgpon-profiler.h"
 #include "xgpon-olt-net-device.h"
 #include "xgpon-channel.h"
+#include "xgpon-phy.h"
+#include "xgpon-olt-ploam-engine.h"
+#include "xgpon-link-info.h"
+#include "xgpon-burst-profile.h"
+
+#include "xgpon-olt-dba-engine-round-robin.h"
+#include "xgpon-olt-dba-engine-ebu.h"
+#include "xgpon-olt-dba-engine-giant.h"
+#include "xgpon-olt-dba-engine-xgiant.h"
+#include "xgpon-olt-dba-engine-xgiantdeficit.h"
+#include "xgpon-olt-dba-engine-xgiantprop.h"
 
 
 
@@ -54,7 +66,7 @@ XgponOltDbaEngine::GetInstanceTypeId (void) const
 
 XgponOltDbaEngine::XgponOltDbaEngine (): m_bursts(), 
   m_aggregateAllocatedSize(0),
-  m_servedBwmaps(0), m_nullBwmap(0),
+  m_servedBwmaps(0), m_nullBwmap(0), m_bwmapRecorder(0), m_goldenTrace(0),
   m_extraInLastBwmap(0),
   m_dsFrameSlotSizeInNano (0), m_logicRtt (0), m_usRate(0)
 {
@@ -71,26 +83,47 @@ XgponOltDbaEngine::~XgponOltDbaEngine ()
 
 
 void 
-XgponOltDbaEngine::ReceiveStatusReport (const Ptr<XgponXgtcDbru>& report, uint16_t onuId, uint16_t allocId)
+XgponOltDbaEngine::ReserveTcontsInDbaEngine (uint32_t nTconts)
+{
+}
+
+
+
+void 
+XgponOltDbaEngine::ReceiveStatusReport (const Ptr<XgponXgtcDbru>& report, uint16_t onuId, uint16_t allocId, uint64_t time)
 {
   NS_LOG_FUNCTION(this);
 
   const Ptr<XgponTcontOlt>& tcont = (m_device->GetConnManager( ))->GetTcontById (allocId);
   if(tcont != 0)
   {
-    uint64_t nowNano = Simulator::Now().GetNanoSeconds();
-    tcont->ReceiveStatusReport (report, nowNano);
+    tcont->ReceiveStatusReport (report, time);
+
+    //the grants that this report has not seen are walked once here; later grants are subtracted when BWmaps are produced.
+    XgponTcontStateTable& table = GetTcontStateTable ();
+    table.RecordReport (table.GetRow (allocId), report->GetBufOcc (), time, tcont->CalculateOutstandingData (GetRtt(), GetFrameSlotSize()));
+    if(m_goldenTrace != 0) m_goldenTrace->RecordStatusReport (onuId, allocId, report->GetBufOcc ());
   }
 }
 
 
 
 const Ptr<XgponXgtcBwmap> 
-XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-thread dba is not used.
+XgponOltDbaEngine::GenerateBwMap ()
+{
+  return GenerateBwMap<XgponOltDbaEngine> (Simulator::Now().GetNanoSeconds());
+}
+
+template <class Engine>
+const Ptr<XgponXgtcBwmap> 
+XgponOltDbaEngine::GenerateBwMap (uint64_t nowNano)  //unit: word; we assume that multiple-thread dba is not used.
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (OLT_DBA_GENERATE_BWMAP);
+
+  //the hooks below are virtual for Engine=XgponOltDbaEngine and direct calls for a final sub-class.
+  Engine& engine = static_cast<Engine&> (*this);
 
-  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
   //std::cout << "secondsNano: " << nowNano << std::endl; 
   const Ptr<XgponOltPloamEngine>& ploamEngine = m_device->GetPloamEngine();
 
@@ -103,8 +136,9 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
   //carry out initialization before the loop
   m_bursts.ClearBurstInfoList( );
   uint32_t numScheduledTconts= 0;
-  Prepare2ProduceBwmap ( );
-  Ptr<XgponTcontOlt> tcontOlt = GetFirstTcontOlt ( );
+  engine.Prepare2ProduceBwmap ( );
+  //the engine keeps the T-CONTs alive during the loop; only the slot is tracked so that no reference is counted per T-CONT.
+  const Ptr<XgponTcontOlt>* current = &engine.GetFirstTcontOlt ( );
   
   uint16_t allocatedSize = m_extraInLastBwmap;
   NS_ASSERT_MSG((m_extraInLastBwmap < (usPhyFrameSize - 10)), "the last bwmap over-allocated too much!!!");
@@ -112,7 +146,8 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
 
   do 
   {
-    uint32_t size2Assign = CalculateAmountData2Upload (tcontOlt, allocatedSize, nowNano);
+    const Ptr<XgponTcontOlt>& tcontOlt = *current;
+    uint32_t size2Assign = engine.CalculateAmountData2Upload (tcontOlt, allocatedSize, nowNano);
     //enable the below output to see the details of the serving TCONT, TCONT Type, associated ONU and how much of Bytes requested by the TCONT
     //std::cout << "servingTcont-" << tcontOlt->GetTcontType() << "-" << tcontOlt->GetOnuId() << "-size2Assign-" << size2Assign*4 << "-Bytes"<< std::endl;
     //limit the over-allocation to one half of the upstream frame size.
@@ -124,7 +159,7 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
     {
 			//std::cout << "oltDBA,atMicro," << nowNano/1000 << ",bytesToAssign," << size2Assign*4 << ",allocId," << tcontOlt->GetAllocId() << std::endl;
 			      
-			Ptr<XgponOltDbaPerBurstInfo> perBurstInfo = m_bursts.GetBurstInfo4TcontOlt(tcontOlt);      
+			const Ptr<XgponOltDbaPerBurstInfo>& perBurstInfo = m_bursts.GetBurstInfo4TcontOlt(tcontOlt->GetOnuId());      
       if(perBurstInfo!=0)
       {
         SetServedTcont(tcontOlt->GetAllocId());
@@ -136,17 +171,20 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
                               commonPhy->GetUsFecBlockDataSize(), commonPhy->GetUsFecBlockSize());
 
           //Create the first bwalloc; starttime will be set when producing bwmap from all bursts
-          Ptr<XgponXgtcBwAllocation> bwAlloc = Create<XgponXgtcBwAllocation> (tcontOlt->GetAllocId(), true, linkInfo->GetPloamExistAtOnu4OLT(), 0, size2Assign, 0, linkInfo->GetCurrentProfileIndex());
+          XgponXgtcBwAllocationFields bwAlloc;
+          bwAlloc.Set (tcontOlt->GetAllocId(), true, linkInfo->GetPloamExistAtOnu4OLT(), 0, size2Assign, 0, linkInfo->GetCurrentProfileIndex());
           perBurstInfo->AddOneNewBwAlloc(bwAlloc, tcontOlt);
           allocatedSize += perBurstInfo->GetFinalBurstSize( );
           numScheduledTconts++;
         }
         else
         {
-          if(perBurstInfo->FindBwAlloc(tcontOlt)==0)//bwalloc not already present
+          XgponXgtcBwAllocationFields* existingBwAlloc = perBurstInfo->FindBwAlloc(tcontOlt->GetAllocId());
+          if(existingBwAlloc==0)//bwalloc not already present
           {
             //Create the bwalloc
-            Ptr<XgponXgtcBwAllocation> bwAlloc = Create<XgponXgtcBwAllocation> (tcontOlt->GetAllocId(), true, linkInfo->GetPloamExistAtOnu4OLT(), 0xFFFF, size2Assign, 0, 0);
+            XgponXgtcBwAllocationFields bwAlloc;
+            bwAlloc.Set (tcontOlt->GetAllocId(), true, linkInfo->GetPloamExistAtOnu4OLT(), 0xFFFF, size2Assign, 0, 0);
             uint32_t orgBurstSize = perBurstInfo->GetFinalBurstSize( );
             perBurstInfo->AddOneNewBwAlloc(bwAlloc, tcontOlt);
             allocatedSize += perBurstInfo->GetFinalBurstSize( ) - orgBurstSize;
@@ -155,9 +193,8 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
           else
           {
             //BwAllocation already exists, add extra allocation to the existing bwAlloc
-            Ptr<XgponXgtcBwAllocation> bwAlloc = perBurstInfo->FindBwAlloc(tcontOlt);
             uint32_t orgBurstSize = perBurstInfo->GetFinalBurstSize( );
-            perBurstInfo->AddToExistingBwAlloc( bwAlloc, size2Assign);
+            perBurstInfo->AddToExistingBwAlloc( existingBwAlloc, size2Assign);
             allocatedSize += perBurstInfo->GetFinalBurstSize( ) - orgBurstSize;
             //do not increment numScheduledTconts
           }
@@ -165,10 +202,10 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
       }
     }    
 
-    if(CheckAllTcontsServed()) // all T-CONTs had been considered.
+    if(engine.CheckAllTcontsServed()) // all T-CONTs had been considered.
       break;
 
-    tcontOlt = GetNextTcontOlt ( );
+    current = &engine.GetNextTcontOlt ( );
       
   } while((allocatedSize < (usPhyFrameSize - 10)) && numScheduledTconts<MAX_TCONT_PER_BWMAP);
 
@@ -186,6 +223,14 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
   Ptr<XgponXgtcBwmap> map = m_bursts.ProduceBwmapFromBursts(nowNano, m_extraInLastBwmap, usPhyFrameSize);
   //if(map->GetNumberOfBwAllocation() > 0) map->Print(std::cout);
 
+  XgponTcontStateTable& table = GetTcontStateTable ();
+  uint16_t bwMapSize = map->GetNumberOfBwAllocation ( );
+  for(uint16_t i=0; i<bwMapSize; i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = map->GetBwAllocationByIndex(i);
+    table.RecordGrant (table.GetRow (bwAlloc.GetAllocId()), bwAlloc.GetGrantSize(), bwAlloc.GetDbruFlag());
+  }
+
   if(allocatedSize > usPhyFrameSize)  //update the over-allocation size
   {  
     m_extraInLastBwmap = allocatedSize - usPhyFrameSize;
@@ -194,7 +239,14 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
   map->SetCreationTime(nowNano);
   m_servedBwmaps.push_back(map);  //used for receiving the corresponding bursts
 
-  FinalizeBwmapProduction();
+  engine.FinalizeBwmapProduction();
+
+  if(m_bwmapRecorder != 0)
+  {
+    if(!m_bwmapRecorder->IsOpened ()) m_bwmapRecorder->Open (GetFrameSlotSize ());
+    m_bwmapRecorder->RecordBwmap (nowNano / GetFrameSlotSize (), map);
+  }
+  if(m_goldenTrace != 0) m_goldenTrace->RecordBwmap (nowNano / GetFrameSlotSize (), map);
 
   return map;
 }
@@ -203,6 +255,38 @@ XgponOltDbaEngine::GenerateBwMap ()  //unit: word; we assume that multiple-threa
 
 
 
+bool
+XgponOltDbaEngine::CanFastForwardIdleFrames ()
+{
+  //one BWmap that crosses the frame boundary is not idle.
+  return m_extraInLastBwmap == 0 && DoCanFastForwardIdleFrames ();
+}
+
+void
+XgponOltDbaEngine::FastForwardIdleFrames (uint64_t nFrames)
+{
+  NS_LOG_FUNCTION(this);
+  if(nFrames == 0) return;
+
+  //the polling grants of these BWmaps are not kept in the service histories of the T-CONTs: each of them only carries
+  //the status report, so that they do not change the outstanding data (CalculateOutstandingData) of one T-CONT.
+  DoFastForwardIdleFrames (nFrames);
+}
+
+bool
+XgponOltDbaEngine::DoCanFastForwardIdleFrames ()
+{
+  return false;
+}
+
+void
+XgponOltDbaEngine::DoFastForwardIdleFrames (uint64_t nFrames)
+{
+  NS_ASSERT_MSG(false, "This DBA engine cannot fast-forward idle frames!!!");
+}
+
+
+
 
 
 
@@ -235,6 +319,21 @@ XgponOltDbaEngine::GetBwMap4CurrentBurst (uint64_t time)
 }
 
 
+void 
+XgponOltDbaEngine::RemoveExpiredBwmaps (uint64_t time)
+{
+  NS_LOG_FUNCTION(this);
+
+  uint64_t slotSize = GetFrameSlotSize ( );  //slotSize in nanosecond
+  uint64_t rtt = GetRtt();
+
+  while(m_servedBwmaps.size() > 0 && (m_servedBwmaps.front()->GetCreationTime() + rtt + slotSize) <= time)
+  {
+    m_servedBwmaps.pop_front();
+  }
+}
+
+
 const Ptr<XgponBurstProfile>& 
 XgponOltDbaEngine::GetProfile4BurstFromChannel(uint64_t time)
 {
@@ -246,11 +345,11 @@ XgponOltDbaEngine::GetProfile4BurstFromChannel(uint64_t time)
   uint32_t first = GetIndexOfBurstFirstBwAllocation (map, time);
   NS_ASSERT_MSG((first < map->GetNumberOfBwAllocation()), "strange index of the corresponding bwallocation!!!");
 
-  const Ptr<XgponXgtcBwAllocation>& bwAlloc = map->GetBwAllocationByIndex (first);
+  const XgponXgtcBwAllocationFields& bwAlloc = map->GetBwAllocationByIndex (first);
 
-  uint16_t onuId = ((m_device->GetConnManager( ))->GetTcontById (bwAlloc->GetAllocId() ))->GetOnuId();
+  uint16_t onuId = ((m_device->GetConnManager( ))->GetTcontById (bwAlloc.GetAllocId() ))->GetOnuId();
 
-  return ((m_device->GetPloamEngine())->GetLinkInfo (onuId))->GetProfileByIndex(bwAlloc->GetBurstProfileIndex());  
+  return ((m_device->GetPloamEngine())->GetLinkInfo (onuId))->GetProfileByIndex(bwAlloc.GetBurstProfileIndex());  
 }
 
 
@@ -271,7 +370,7 @@ XgponOltDbaEngine::GetIndexOfBurstFirstBwAllocation (const Ptr<XgponXgtcBwmap>&
   int num = bwmap->GetNumberOfBwAllocation();
   for(int i=0; i<num; i++)
   {
-    uint32_t startTime = (bwmap->GetBwAllocationByIndex(i))->GetStartTime();
+    uint32_t startTime = bwmap->GetBwAllocationByIndex(i).GetStartTime();
 
     //Note that the starttime in BwAlloc starts from the XGTC header (after the preamble and delimiter). Thus, the burst will arrive before the starttime.
     if((startTime!= 0xFFFF) && offsetSize < startTime ) { return i; }
@@ -350,6 +449,18 @@ XgponOltDbaEngine::GetUsLinkRate ()
   return m_usRate;
 }
 
+uint32_t
+XgponOltDbaEngine::GetUsPhyFrameSize ()
+{
+  return (m_device->GetXgponPhy ( ))->GetUsPhyFrameSizeInWord();
+}
+
+XgponTcontStateTable&
+XgponOltDbaEngine::GetTcontStateTable ()
+{
+  return (m_device->GetConnManager ( ))->GetTcontStateTable ();
+}
+
 
 bool
 XgponOltDbaEngine::CheckServedTcont(uint64_t allocId)
@@ -364,5 +475,173 @@ XgponOltDbaEngine::SetServedTcont(uint64_t allocId)
 }
 
 
+uint32_t
+XgponOltDbaEngine::GetAllocationBytesFromRateAndServiceInterval(uint32_t rate, uint16_t si)
+{
+  uint64_t tmp64;
+  uint32_t tmp32;
+
+  tmp64=(uint64_t)rate*(uint64_t)GetFrameSlotSize(); 	//GetFrameSlotSize()=125us=125000ns
+  tmp64=tmp64*(uint64_t)si;  	//rate is in bps and frame slot size is in nanoseconds
+  tmp64=tmp64/1000000000;     	//Get value in bits
+  if ((tmp64%(32))!=0)
+	tmp64 = (tmp64/32)*32;  //Make the value a multiple of 32 (for unit:word)
+  NS_ASSERT_MSG(tmp64%(32)==0, "Cannot assign that rate to the connection since it will not be a multiple of 4 bytes (one word).");
+  tmp32=tmp64/32;        	//Convert bits to words
+
+  return tmp32;			//unit:word
+}
+
+
+uint32_t
+XgponOltDbaEngine::FitGrantIntoUsFrame (const Ptr<XgponTcontOlt>& tcontOlt, uint32_t size2Assign, uint32_t allocatedSize)
+{
+  uint32_t sizeRemaining = 0;
+
+  Ptr<XgponPhy> phy = m_device->GetXgponPhy();
+  uint32_t usPhyFrameSize = phy->GetUsPhyFrameSizeInWord();
+  Ptr<XgponBurstProfile> burstProfile = m_device->GetPloamEngine()->GetLinkInfo(tcontOlt->GetOnuId())->GetCurrentProfile();
+
+  bool isNewBurstNecessary=m_bursts.IsNewBurstNecessary(tcontOlt->GetOnuId());
+
+
+  /**************************************
+   *
+   * Get the remaining size in a frame
+   *
+   **************************************/
+
+  if(isNewBurstNecessary)
+  {
+
+    if(burstProfile->GetFec())
+    {
+      //Get the remaining size available for XGTC data when a new burst is needed and FEC is enabled.
+      uint32_t fecBlocks=(2+size2Assign)/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words; Add two to take XGTC header and trailer into account
+      if((2+size2Assign)%(phy->GetUsFecBlockDataSize()/4)!=0)
+        fecBlocks++;
+      uint32_t codeWords=fecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+      sizeRemaining = usPhyFrameSize-allocatedSize-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4-codeWords-2; //Two words for XGTC headers.
+
+    }
+    else
+    {
+      //Get the remaining size available for XGTC data when a new burst is needed and FEC is disabled.
+      sizeRemaining = usPhyFrameSize-allocatedSize-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4-2;
+    }
+  }
+  else
+  {
+    if(burstProfile->GetFec())
+    {
+      //Get the remaining size available for XGTC data when the ONU has been served before and FEC is enabled.
+      const Ptr<XgponOltDbaPerBurstInfo>& burstInfo=m_bursts.GetBurstInfo4TcontOlt(tcontOlt->GetOnuId());
+      uint32_t oldDataWords=burstInfo->GetHeaderTrailerDataSize()/phy->GetUsFecBlockDataSize()/4;
+      uint32_t oldFecBlocks=oldDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
+      if(oldDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
+        oldFecBlocks++;
+      uint32_t oldCodeWords=oldFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+
+
+      uint32_t newFecBlocks=(2+size2Assign+oldDataWords)/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words; Add two to take XGTC header and trailer into account
+      if((2+size2Assign+oldDataWords)%(phy->GetUsFecBlockDataSize()/4)!=0)
+        newFecBlocks++;
+      uint32_t newCodeWords=newFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+      sizeRemaining = usPhyFrameSize-(allocatedSize-oldCodeWords)-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4-newCodeWords-2; //Two words for XGTC headers.
+
+      /*
+      const Ptr<XgponOltDbaPerBurstInfo>& burstInfo=m_bursts.GetBurstInfo4TcontOlt(tcontOlt->GetOnuId());
+      uint32_t oldDataWords=burstInfo->GetHeaderTrailerDataSize()/phy->GetUsFecBlockDataSize()/4;
+      uint32_t oldFecBlocks=oldDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
+      if(oldDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
+        oldFecBlocks++;
+      uint32_t oldCodeWords=oldFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+
+      uint32_t newDataWords=oldDataWords+size2Assign; //The new burst should fill up the frame completely
+      uint32_t newFecBlocks=newDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
+      uint32_t newCodeWords=newFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+      if(newDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
+      {
+        newFecBlocks++;
+        uint32_t shortenedDataBlockSize=newDataWords%(phy->GetUsFecBlockDataSize()/4);
+        newCodeWords=newCodeWords+shortenedDataBlockSize+(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+      }
+      */
+      sizeRemaining = usPhyFrameSize-(allocatedSize-oldCodeWords);
+    }
+    else
+    {
+      //Get the remaining size available for XGTC data when the ONU has been served before and FEC is disabled.
+      sizeRemaining = usPhyFrameSize-allocatedSize;
+    }
+  }
+
+  /**************************************
+   *
+   * Prevent the bwMap from granting more than
+   * what is allowed by the US PHY frame.
+   *
+   **************************************/
+  if(size2Assign>sizeRemaining)
+  {
+    //There is not enough space to send all that the user requested
+    if(burstProfile->GetFec())
+    {
+      //FEC is enabled. We need to compute what is the maximum amount of words we can transmit,
+      //considering the FEC overhead will be smaller if the transmitted data is smaller.
+      if(isNewBurstNecessary)
+      {
+        //Computing the maximum data transmission possible, bearing in mind that a new burst is necessary to serve the T-CONT.
+        uint32_t sizeRemainingNoFec=usPhyFrameSize-allocatedSize-phy->GetUsMinimumGuardTime()-(burstProfile->GetPreambleLen()+burstProfile->GetDelimiterLen())/4;
+
+        uint32_t fecBlocs=sizeRemainingNoFec/(phy->GetUsFecBlockSize()/4);
+        uint32_t dataRemainder=0;
+        if(sizeRemainingNoFec%(phy->GetUsFecBlockSize()/4)!=0)
+        {
+          dataRemainder=sizeRemainingNoFec-fecBlocs*(phy->GetUsFecBlockSize()/4)-(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+        }
+        sizeRemaining=fecBlocs*phy->GetUsFecBlockDataSize()/4+dataRemainder-2;
+      }
+      else
+      {
+        //Computing the maximum possible data transmission, bearing in mind that the ONU was served before.
+        const Ptr<XgponOltDbaPerBurstInfo>& burstInfo=m_bursts.GetBurstInfo4TcontOlt(tcontOlt->GetOnuId());
+        uint32_t oldDataWords=burstInfo->GetHeaderTrailerDataSize()/phy->GetUsFecBlockDataSize()/4;
+        uint32_t oldFecBlocks=oldDataWords/(phy->GetUsFecBlockDataSize()/4); //Divide by four to convert to words
+        if(oldDataWords%(phy->GetUsFecBlockDataSize()/4)!=0)
+          oldFecBlocks++;
+        uint32_t oldCodeWords=oldFecBlocks*(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+
+        uint32_t newCodedBurstSize=usPhyFrameSize-(allocatedSize-oldCodeWords-oldDataWords);
+        uint32_t newFecBlocks = newCodedBurstSize/(phy->GetUsFecBlockSize()/4);
+        uint32_t newDataWords = newFecBlocks*(phy->GetUsFecBlockDataSize()/4);
+        if(newCodedBurstSize%(phy->GetUsFecBlockSize()/4)!=0)
+        {
+          newFecBlocks++;
+          uint32_t shortenedCodedBlockSize=newCodedBurstSize%(phy->GetUsFecBlockSize()/4);
+          newDataWords=newDataWords+shortenedCodedBlockSize-(phy->GetUsFecBlockSize()-phy->GetUsFecBlockDataSize())/4;
+        }
+        sizeRemaining=newDataWords-oldDataWords;
+      }
+    }
+    return sizeRemaining;
+  }
+  else
+  {
+    return size2Assign;
+  }
+}
+
+
+
+//also called from the other engines (XgponOltFramingEngine), so the instantiations are explicit
+template const Ptr<XgponXgtcBwmap> XgponOltDbaEngine::GenerateBwMap<XgponOltDbaEngine> (uint64_t nowNano);
+template const Ptr<XgponXgtcBwmap> XgponOltDbaEngine::GenerateBwMap<XgponOltDbaEngineRoundRobin> (uint64_t nowNano);
+template const Ptr<XgponXgtcBwmap> XgponOltDbaEngine::GenerateBwMap<XgponOltDbaEngineEbu> (uint64_t nowNano);
+template const Ptr<XgponXgtcBwmap> XgponOltDbaEngine::GenerateBwMap<XgponOltDbaEngineGiant> (uint64_t nowNano);
+template const Ptr<XgponXgtcBwmap> XgponOltDbaEngine::GenerateBwMap<XgponOltDbaEngineXgiant> (uint64_t nowNano);
+template const Ptr<XgponXgtcBwmap> XgponOltDbaEngine::GenerateBwMap<XgponOltDbaEngineXgiantDeficit> (uint64_t nowNano);
+template const Ptr<XgponXgtcBwmap> XgponOltDbaEngine::GenerateBwMap<XgponOltDbaEngineXgiantProp> (uint64_t nowNano);
+
 
 }//namespace ns3
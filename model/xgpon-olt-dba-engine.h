@@ -25,8 +25,11 @@
 
 #include "xgpon-olt-engine.h"
 #include "xgpon-olt-dba-bursts.h"
+#include "xgpon-bwmap-recorder.h"
+#include "xgpon-golden-trace.h"
 
 #include "xgpon-xgtc-dbru.h"
+#include "xgpon-tcont-state-table.h"
 
 
 
@@ -62,7 +65,7 @@ class XgponOltDbaEngine : public XgponOltEngine
 {
 public:
 
-  const static uint32_t MAX_TCONT_PER_BWMAP=512;         //at most, 512 T-CONTs can be scheduled in one bwmap.
+  const static uint32_t MAX_TCONT_PER_BWMAP=XgponXgtcBwmap::MAX_BW_ALLOCATIONS;         //at most, 512 T-CONTs can be scheduled in one bwmap.
 
   /**
    * \brief Constructor
@@ -78,11 +81,41 @@ public:
    */
   virtual void  AddTcontToDbaEngine (Ptr<XgponTcontOlt>& tcont)=0; 
 
+  /**
+   * \brief called before a large number of T-CONTs are added, so that the engine can size its lists once. Nothing by default.
+   * \param nTconts the number of T-CONTs to be added
+   */
+  virtual void  ReserveTcontsInDbaEngine (uint32_t nTconts); 
+
   /**
    * \brief generate BWmap. Effectively, it instantiates the scheduling of upstream connections (more specifically alloc-id) at OLT-side.
    */
   const Ptr<XgponXgtcBwmap> GenerateBwMap ();
 
+  /**
+   * \brief generate BWmap with the hooks of the DBA algorithm called on Engine, the final sub-class of this engine.
+   *        The hooks are then bound at compile time (used by XgponOltNetDeviceStatic).
+   *        Instantiated in xgpon-olt-dba-engine.cc for the DBA engines of this module; Engine must be the dynamic type of this object.
+   * \param nowNano the time that the downstream frame carrying this BWmap is sent. It is earlier than "now" for the frames
+   *        that are produced when the OLT resumes from idle fast-forward. Unit: nanosecond
+   */
+  template <class Engine>
+  const Ptr<XgponXgtcBwmap> GenerateBwMap (uint64_t nowNano);
+
+
+  /**
+   * \brief whether the DBA state can be advanced over idle frames through FastForwardIdleFrames.
+   *        Asked by the OLT after one BWmap that only polls (no T-CONT has anything to send).
+   */
+  bool CanFastForwardIdleFrames ();
+
+  /**
+   * \brief advance the DBA state over nFrames downstream frames in which no T-CONT has anything to send, as if GenerateBwMap were called
+   *        for each of them. These BWmaps only carry polling grants, whose bursts are not transmitted by the dormant ONUs; they are not produced.
+   *        Only called when CanFastForwardIdleFrames returned true and no BWmap or status report with data has been handled since.
+   */
+  void FastForwardIdleFrames (uint64_t nFrames);
+
 
 
   /**
@@ -90,8 +123,9 @@ public:
    * \param report the report to be processed
    * \param onuId the ID of the source ONU
    * \param allocId the T-CONT that this report belongs to
+   * \param time the time that the burst carrying this report arrives at the OLT. Unit: nanosecond
    */
-  void ReceiveStatusReport (const Ptr<XgponXgtcDbru>& report, uint16_t onuId, uint16_t allocId);  
+  void ReceiveStatusReport (const Ptr<XgponXgtcDbru>& report, uint16_t onuId, uint16_t allocId, uint64_t time);  
 
 
 
@@ -124,6 +158,28 @@ public:
   uint32_t GetIndexOfBurstFirstBwAllocation (const Ptr<XgponXgtcBwmap>& bwmap, uint64_t time);
 
 
+  /**
+   * \brief remove the BWmaps whose bursts should all have been received by the given time.
+   *        Needed when no burst arrives for a while (all ONUs are dormant), since the list is otherwise cleaned when bursts arrive.
+   * \param time unit: nanosecond
+   */
+  void RemoveExpiredBwmaps (uint64_t time);
+
+
+  /**
+   * \brief record every BWmap produced from now on into the given recorder (0 to stop recording).
+   *        The recorder is opened when the first BWmap is recorded.
+   */
+  void SetBwmapRecorder (const Ptr<XgponBwmapRecorder>& recorder);
+  const Ptr<XgponBwmapRecorder>& GetBwmapRecorder () const;
+
+  /**
+   * \brief pass every status report and BWmap from now on to the given golden trace (0 to stop). It should have been opened.
+   */
+  void SetGoldenTrace (const Ptr<XgponGoldenTrace>& trace);
+  const Ptr<XgponGoldenTrace>& GetGoldenTrace () const;
+
+
 
 
   //for debugging
@@ -154,6 +210,16 @@ protected:
    */
   uint32_t GetUsLinkRate ();
 
+  /**
+   * \brief return the size of one upstream PHY frame. Unit: word
+   */
+  uint32_t GetUsPhyFrameSize ();
+
+  /**
+   * \brief the per-frame state of all T-CONTs, kept by XgponOltConnManager. Read in the loop of GenerateBwMap instead of the histories of XgponTcontOlt.
+   */
+  XgponTcontStateTable& GetTcontStateTable ();
+
 
   /**
    * \brief return the bytes allocated in the current frame from the last BwMap. Used mainly for error checking. Unit: words
@@ -175,6 +241,24 @@ protected:
   void SetServedTcont(uint64_t allocId);
 
 
+  /**
+   * \brief Get the allocation size of one T-CONT from its service rate and service interval. unit: word
+   * \param rate the service rate. unit: bps
+   * \param si the service interval. unit: upstream frame
+   */
+  uint32_t GetAllocationBytesFromRateAndServiceInterval (uint32_t rate, uint16_t si);
+
+  /**
+   * \brief Limit the grant of one T-CONT to the space left in the upstream PHY frame,
+   *        taking the burst overhead (guard time, preamble, delimiter, XGTC header/trailer and FEC) into account.
+   * \return the grant that fits into the frame. unit: word
+   * \param tcontOlt the T-CONT to be served
+   * \param size2Assign the grant decided by the DBA algorithm. unit: word
+   * \param allocatedSize the space already allocated in this frame. unit: word
+   */
+  uint32_t FitGrantIntoUsFrame (const Ptr<XgponTcontOlt>& tcontOlt, uint32_t size2Assign, uint32_t allocatedSize);
+
+
 private:
 
   /**
@@ -218,6 +302,16 @@ private:
    */
   virtual void FinalizeBwmapProduction () = 0;
 
+  /*
+   * \brief whether the engine knows how its state evolves over idle frames (see FastForwardIdleFrames). False by default.
+   */
+  virtual bool DoCanFastForwardIdleFrames ( );
+
+  /*
+   * \brief advance the round-robin pointers, timers, etc. of the engine by arithmetic over nFrames idle frames.
+   */
+  virtual void DoFastForwardIdleFrames (uint64_t nFrames);
+
 protected:
   XgponOltDbaBursts m_bursts;      //bursts used to produce BWMAP
   uint32_t m_aggregateAllocatedSize;    //Used to maintain the total allocation for the minimum no of cycles. Tcont cycle is reset once this exceeded.
@@ -227,6 +321,9 @@ private:
   std::list< Ptr<XgponXgtcBwmap> > m_servedBwmaps;  
   Ptr<XgponXgtcBwmap> m_nullBwmap;  //used to return a null bwmap.
 
+  Ptr<XgponBwmapRecorder> m_bwmapRecorder;  //0: the BWmaps are not recorded.
+  Ptr<XgponGoldenTrace> m_goldenTrace;      //0: no per-frame digest is recorded or compared.
+
   uint16_t m_extraInLastBwmap;     //BWMAP may cross the boundary of frame and this variable is used to maintail the over-allocation. unit: word;
 
   //calculate once to save CPU.
@@ -238,6 +335,28 @@ private:
   /* more variables may be needed */  
 };
 
+inline void
+XgponOltDbaEngine::SetBwmapRecorder (const Ptr<XgponBwmapRecorder>& recorder)
+{
+  m_bwmapRecorder = recorder;
+}
+inline const Ptr<XgponBwmapRecorder>&
+XgponOltDbaEngine::GetBwmapRecorder () const
+{
+  return m_bwmapRecorder;
+}
+
+inline void
+XgponOltDbaEngine::SetGoldenTrace (const Ptr<XgponGoldenTrace>& trace)
+{
+  m_goldenTrace = trace;
+}
+inline const Ptr<XgponGoldenTrace>&
+XgponOltDbaEngine::GetGoldenTrace () const
+{
+  return m_goldenTrace;
+}
+
 inline uint16_t
 XgponOltDbaEngine::GetExtraInLastBwmap ( ) const
 {
@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 
 #include "xgpon-olt-dba-per-burst-info.h"
+#include "xgpon-memory-census.h"
 #include "xgpon-xgtc-ploam.h"
 
 
@@ -77,14 +78,14 @@ XgponOltDbaPerBurstInfo::Initialize(uint16_t onuId, bool ploam, const Ptr<XgponB
 
 
 void 
-XgponOltDbaPerBurstInfo::AddOneNewBwAlloc(const Ptr<XgponXgtcBwAllocation>& bwAlloc, const Ptr<XgponTcontOlt>& tcontOlt)
+XgponOltDbaPerBurstInfo::AddOneNewBwAlloc(const XgponXgtcBwAllocationFields& bwAlloc, const Ptr<XgponTcontOlt>& tcontOlt)
 {
   NS_LOG_FUNCTION(this);
 
   m_bwAllocs.push_back(bwAlloc);
   m_tcontOlts.push_back(tcontOlt);
 
-  uint32_t grantSize = bwAlloc->GetGrantSize ();
+  uint32_t grantSize = bwAlloc.GetGrantSize ();
   m_headerTrailerDataSize += grantSize;
   
   UpdateFinalBurstSize();
@@ -130,8 +131,8 @@ XgponOltDbaPerBurstInfo::PutAllBwAllocIntoBwmap(const Ptr<XgponXgtcBwmap>& map,
   int num = m_bwAllocs.size();
   for(int i=0; i<num; i++)
   {
-    const Ptr<XgponXgtcBwAllocation>& bwAlloc = m_bwAllocs[i];
-    if(i==0) bwAlloc->SetStartTime(startTime);
+    XgponXgtcBwAllocationFields& bwAlloc = m_bwAllocs[i];
+    if(i==0) bwAlloc.SetStartTime(startTime);
     map->AddOneBwAllocation (bwAlloc);
     m_tcontOlts[i]->AddNewBwAllocation2ServiceHistory(bwAlloc, now);
   }
@@ -139,7 +140,7 @@ XgponOltDbaPerBurstInfo::PutAllBwAllocIntoBwmap(const Ptr<XgponXgtcBwmap>& map,
 
 
 void
-XgponOltDbaPerBurstInfo::AddToExistingBwAlloc(Ptr<XgponXgtcBwAllocation> bwAlloc, uint32_t extraGrantSize)
+XgponOltDbaPerBurstInfo::AddToExistingBwAlloc(XgponXgtcBwAllocationFields* bwAlloc, uint32_t extraGrantSize)
 {
   uint32_t origGrantSize = bwAlloc->GetGrantSize ();
   bwAlloc->SetGrantSize(origGrantSize + extraGrantSize);
@@ -148,15 +149,15 @@ XgponOltDbaPerBurstInfo::AddToExistingBwAlloc(Ptr<XgponXgtcBwAllocation> bwAlloc
   UpdateFinalBurstSize();
 }
 
-Ptr<XgponXgtcBwAllocation>
-XgponOltDbaPerBurstInfo::FindBwAlloc(Ptr<XgponTcontOlt> tcontOlt)
+XgponXgtcBwAllocationFields*
+XgponOltDbaPerBurstInfo::FindBwAlloc(uint16_t allocId)
 {
- std::deque<Ptr<XgponXgtcBwAllocation> >::iterator  it;
+ std::deque<XgponXgtcBwAllocationFields>::iterator  it;
 
  for (it=m_bwAllocs.begin(); it!=m_bwAllocs.end(); it++)
  {
-    if((*it)->GetAllocId() == tcontOlt->GetAllocId())
-      return *it;
+    if(it->GetAllocId() == allocId)
+      return &(*it);
   }
  return 0;
 
@@ -183,12 +184,14 @@ XgponOltDbaPerBurstInfo::operator new(size_t size) noexcept(false) //throw(const
     p = m_pool.top();
     m_pool.pop();  
     NS_LOG_INFO("allocated XgponOltDbaPerBurstInfo through the pool!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::OLT_DBA_PER_BURST_INFO, size, XgponMemoryCensus::FROM_POOL);
   }
   else
   {
     p = malloc(size);
     if (!p) throw "cannot allocate more memory from the system!!!";
     NS_LOG_INFO("allocated XgponOltDbaPerBurstInfo through malloc!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::OLT_DBA_PER_BURST_INFO, size, XgponMemoryCensus::FROM_MALLOC);
   }
   return p;
 }
@@ -201,6 +204,7 @@ XgponOltDbaPerBurstInfo::operator delete(void *p)
     m_pool.push(p);
   }
   else free(p);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::OLT_DBA_PER_BURST_INFO, sizeof(XgponOltDbaPerBurstInfo), m_pool.size());
 }
 
 void 
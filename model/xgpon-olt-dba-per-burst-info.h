@@ -62,23 +62,23 @@ public:
 
 
   /**
-   * \brief Carry out initialization before the first XgponXgtcBwAllocation is scheduled in this burst.
+   * \brief Carry out initialization before the first XgponXgtcBwAllocationFields is scheduled in this burst.
    * \param ploam whether ploam exists in the header of this burst
    * \param profile the burst profile used by this burst
    */
   void Initialize(uint16_t onuId, bool ploam, const Ptr<XgponBurstProfile>& profile, uint16_t guardTime, uint16_t dataBlockSize, uint16_t fecBlockSize);
 
   /**
-   * \brief Add one XgponXgtcBwAllocation into this burst. burst size will be updated
+   * \brief Add one XgponXgtcBwAllocationFields into this burst. burst size will be updated
    * \param bwAlloc the bandwidth allocation to be added
    * \param tcontOlt the T-CONT that this bandwidth allocation belongs to
    */
-  void AddOneNewBwAlloc(const Ptr<XgponXgtcBwAllocation>& bwAlloc, const Ptr<XgponTcontOlt>& tcontOlt);
+  void AddOneNewBwAlloc(const XgponXgtcBwAllocationFields& bwAlloc, const Ptr<XgponTcontOlt>& tcontOlt);
 
 
   /**
-   * \brief Put all XgponXgtcBwAllocation of this burst into BW-MAP. 
-   *         It also puts XgponXgtcBwAllocation into the corresponding XgponTcontOlt for scheduling purpose.
+   * \brief Put all XgponXgtcBwAllocationFields of this burst into BW-MAP. 
+   *         It also puts XgponXgtcBwAllocationFields into the corresponding XgponTcontOlt for scheduling purpose.
    * \param map the bwmap that this burst will be put into
    * \param startTime the start time of this burst
    * \param now current simulation time
@@ -87,17 +87,17 @@ public:
 
   /**
    * \brief Finds if there is a BwAllocation already present in the burst for a particular T-CONT
-   * \param the T-CONT to look for in the bwMap
+   * \param allocId the Alloc-ID of the T-CONT to look for in the bwMap
    * \return The BwAllocation corresponding to the T-CONT if that T-CONT was served before, 0 otherwise.
    */
-  Ptr<XgponXgtcBwAllocation> FindBwAlloc(Ptr<XgponTcontOlt> tcontOlt);
+  XgponXgtcBwAllocationFields* FindBwAlloc(uint16_t allocId);
 
   /**
    * \brief Adds extra bytes in a BwAllocation already present in a burst.
    * \param bwAlloc The BwAlloction that is getting extra bytes
    * \param extraGrantSize The amount of words (4 bytes) to add to the bwAlloc
    */
-  void AddToExistingBwAlloc(Ptr<XgponXgtcBwAllocation> bwAlloc, uint32_t extraGrantSize);
+  void AddToExistingBwAlloc(XgponXgtcBwAllocationFields* bwAlloc, uint32_t extraGrantSize);
 
 
 
@@ -120,7 +120,7 @@ public:
 
 
   /**
-   * \brief Get the number of XgponXgtcBwAllocation in this burst
+   * \brief Get the number of XgponXgtcBwAllocationFields in this burst
    */
   uint32_t GetBwAllocNumber();
 
@@ -142,7 +142,7 @@ public:
 private:
 
   /**
-   * \brief update overall burst size after each XgponXgtcBwAllocation is added
+   * \brief update overall burst size after each XgponXgtcBwAllocationFields is added
    */
   void UpdateFinalBurstSize( );
 
@@ -157,12 +157,12 @@ private:
   uint32_t m_headerTrailerDataSize;//XGTC header (ploam included if exist) + BwAllocations. unit: word
 
 
-  //updated after each XgponXgtcBwAllocation is added
+  //updated after each XgponXgtcBwAllocationFields is added
   uint32_t m_finalBurstSize;       //final size (all stuffs after FEC if FEC is used). unit: word
 
 
 
-  std::deque< Ptr<XgponXgtcBwAllocation> > m_bwAllocs;  //the list of BwAllocations (of this ONU) to be included in this BW_MAP.
+  std::deque< XgponXgtcBwAllocationFields > m_bwAllocs;  //the list of BwAllocations (of this ONU) to be included in this BW_MAP.
 
   std::deque< Ptr<XgponTcontOlt> > m_tcontOlts;         //the corresponding XgponTcontOlt. used in the case that FEC is enabled.
                                                          //header+data must be aligned with FEC code size. 
@@ -0,0 +1,246 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include <algorithm>
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "xgpon-olt-dormancy-manager.h"
+#include "xgpon-olt-net-device.h"
+#include "xgpon-onu-net-device.h"
+#include "xgpon-channel.h"
+#include "xgpon-phy.h"
+
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponOltDormancyManager");
+
+namespace ns3{
+
+NS_OBJECT_ENSURE_REGISTERED (XgponOltDormancyManager);
+
+//flags kept per ONU for the current BWmap
+const static uint8_t GRANTED = 0x01;       //at least one allocation is granted to this ONU
+const static uint8_t BUSY_GRANT = 0x02;    //at least one allocation carries more than the status report
+const static uint8_t MULTICAST = 0x04;     //this ONU is a member of one multicast group carried in this frame
+
+
+TypeId
+XgponOltDormancyManager::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponOltDormancyManager")
+    .SetParent<XgponOltEngine> ()
+    .AddConstructor<XgponOltDormancyManager> ()
+  ;
+  return tid;
+}
+TypeId
+XgponOltDormancyManager::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+
+XgponOltDormancyManager::XgponOltDormancyManager () : m_grantFlags(XgponChannel::MAXIMAL_NODES_PER_XGPON, 0),
+  m_suspended(false), m_nextFrameTime(0)
+{
+}
+XgponOltDormancyManager::~XgponOltDormancyManager ()
+{
+}
+
+
+
+
+void
+XgponOltDormancyManager::SelectDormantOnus (XgponXgtcDsFrame& frame)
+{
+  NS_LOG_FUNCTION(this);
+
+  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
+
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel>(m_device->GetChannel());
+  const Ptr<XgponOltConnManager>& connManager = m_device->GetConnManager ( );
+
+  XgponXgtcDsHeader& header = frame.GetHeader ();
+  const Ptr<XgponXgtcBwmap>& bwmap = header.GetBwmap ();
+  std::vector<uint8_t>& bitmap = frame.GetBitmap ();
+
+  //all ONUs must process PLOAM messages and broadcast XGEM frames; only the members have to receive multicast XGEM frames.
+  bool wakeAll = (header.GetPloamCount () > 0);
+  std::fill (m_grantFlags.begin(), m_grantFlags.end(), 0);
+
+  std::vector<Ptr<XgponXgemFrame> >& broadcastFrames = frame.GetBroadcastXgemFrames ();
+  for(uint32_t i=0; i<broadcastFrames.size() && !wakeAll; i++)
+  {
+    const std::vector<uint16_t>* members = connManager->FindMulticastMembers ((broadcastFrames[i]->GetXgemHeader()).GetXgemPortId());
+    if(members == 0) wakeAll = true;
+    else
+    {
+      for(uint32_t j=0; j<members->size(); j++) m_grantFlags[(*members)[j]] |= MULTICAST;
+    }
+  }
+
+  MarkGrantedOnus (bwmap);
+
+  uint16_t numOnus = channel->GetNOnuDevices ();
+  for(uint16_t i=0; i<numOnus; i++)
+  {
+    const Ptr<XgponOnuNetDevice> onu = DynamicCast<XgponOnuNetDevice, PonNetDevice>(channel->GetOnuByIndex (i));
+    uint16_t onuId = onu->GetOnuId ();
+
+    bool busyFrame = wakeAll || (bitmap[onuId] != 0) || (m_grantFlags[onuId] & (BUSY_GRANT | MULTICAST));
+    bool idle = !busyFrame && onu->IsUpstreamIdle () && IsIdleAtOlt (onuId);
+
+    if(onu->IsDormant ())
+    {
+      if(!idle) onu->LeaveDormancy ();
+    }
+    else if(idle) onu->EnterDormancy ();
+
+    //the frame is not delivered to this ONU; keep its grants for the bursts that it has to transmit when it wakes up.
+    if(onu->IsDormant () && (m_grantFlags[onuId] & GRANTED))
+    {
+      onu->DeferBwMap (bwmap, nowNano + channel->GetOnuPropagationDelay (i));
+    }
+  }
+
+  //no burst may arrive for a while; the served BWmaps are otherwise removed when bursts arrive.
+  (m_device->GetDbaEngine ())->RemoveExpiredBwmaps (nowNano);
+}
+
+
+void
+XgponOltDormancyManager::MarkGrantedOnus (const Ptr<XgponXgtcBwmap>& bwmap)
+{
+  const Ptr<XgponOltConnManager>& connManager = m_device->GetConnManager ( );
+
+  uint16_t bwMapSize = bwmap->GetNumberOfBwAllocation ( );
+  for(uint16_t i=0; i<bwMapSize; i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex(i);
+    const Ptr<XgponTcontOlt>& tcont = connManager->GetTcontById (bwAlloc.GetAllocId());
+    NS_ASSERT_MSG((tcont!=0), "Cannot find the T-CONT of one allocation in the BWmap!!!");
+
+    uint16_t onuId = tcont->GetOnuId ();
+    m_grantFlags[onuId] |= GRANTED;
+    if(bwAlloc.GetGrantSize() > bwAlloc.GetDbruFlag()) m_grantFlags[onuId] |= BUSY_GRANT;
+  }
+}
+
+
+
+
+bool
+XgponOltDormancyManager::SuspendDownstreamFrames (uint64_t nextFrameTime)
+{
+  NS_LOG_FUNCTION(this);
+  NS_ASSERT_MSG(!m_suspended, "The downstream frames have already been suspended!!!");
+
+  //one awake ONU must receive the frames. When all ONUs are dormant, the frame just sent carried no PLOAM message and
+  //no XGEM frame with data: the OLT has nothing to send until new data arrives from upper layers.
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel>(m_device->GetChannel());
+  uint16_t numOnus = channel->GetNOnuDevices ();
+  for(uint16_t i=0; i<numOnus; i++)
+  {
+    if(!(channel->GetOnuByIndex (i))->IsDormant ()) return false;
+  }
+
+  if(!(m_device->GetDsScheduler ())->CanFastForwardIdleFrames () || !(m_device->GetDbaEngine ())->CanFastForwardIdleFrames ()) return false;
+
+  m_suspended = true;
+  m_nextFrameTime = nextFrameTime;
+  return true;
+}
+
+
+uint64_t
+XgponOltDormancyManager::ResumeDownstreamFrames (uint64_t time)
+{
+  NS_LOG_FUNCTION(this);
+  NS_ASSERT_MSG(m_suspended, "The downstream frames are not suspended!!!");
+  m_suspended = false;
+
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel>(m_device->GetChannel());
+  const Ptr<XgponOltDbaEngine>& dbaEngine = m_device->GetDbaEngine ();
+  uint64_t slotSize = (m_device->GetXgponPhy ())->GetDsFrameSlotSize ();
+
+  //the frames before "time" have been skipped; the one at "time" (if any) is produced as usual.
+  uint64_t numSkipped = 0;
+  if(time > m_nextFrameTime) numSkipped = (time - m_nextFrameTime + slotSize - 1) / slotSize;
+
+  //the bursts of one BWmap are received at the OLT within one RTT plus one frame slot. The latest skipped frames may still
+  //have bursts to come; their BWmaps are produced so that the waking ONU transmits them and the OLT can receive them.
+  uint64_t horizon = 2 * channel->GetLogicOneWayDelay () + slotSize;
+  uint64_t firstProduced = 0;
+  if(time > m_nextFrameTime + horizon) firstProduced = (time - horizon - m_nextFrameTime + slotSize - 1) / slotSize;
+  if(firstProduced > numSkipped) firstProduced = numSkipped;
+
+  const Ptr<XgponOltPhyAdapter>& phyAdapter = m_device->GetPhyAdapter ();
+  phyAdapter->SetSfc (phyAdapter->GetSfc () + numSkipped);
+  (m_device->GetDsScheduler ())->FastForwardIdleFrames (numSkipped);
+  dbaEngine->FastForwardIdleFrames (firstProduced);
+
+  uint16_t numOnus = channel->GetNOnuDevices ();
+  for(uint64_t k=firstProduced; k<numSkipped; k++)
+  {
+    uint64_t frameTime = m_nextFrameTime + k * slotSize;
+    const Ptr<XgponXgtcBwmap> bwmap = dbaEngine->GenerateBwMap<XgponOltDbaEngine> (frameTime);
+
+    std::fill (m_grantFlags.begin(), m_grantFlags.end(), 0);
+    MarkGrantedOnus (bwmap);
+    for(uint16_t i=0; i<numOnus; i++)
+    {
+      const Ptr<XgponOnuNetDevice> onu = DynamicCast<XgponOnuNetDevice, PonNetDevice>(channel->GetOnuByIndex (i));
+      uint16_t onuId = onu->GetOnuId ();
+      NS_ASSERT_MSG(((m_grantFlags[onuId] & BUSY_GRANT) == 0), "One skipped frame grants more than the status report!!!");
+      if(m_grantFlags[onuId] & GRANTED) onu->DeferBwMap (bwmap, frameTime + channel->GetOnuPropagationDelay (i));
+    }
+    dbaEngine->RemoveExpiredBwmaps (frameTime);
+  }
+
+  return m_nextFrameTime + numSkipped * slotSize;
+}
+
+
+bool
+XgponOltDormancyManager::IsIdleAtOlt (uint16_t onuId)
+{
+  const Ptr<XgponLinkInfo>& linkInfo = (m_device->GetPloamEngine ())->GetLinkInfo (onuId);
+  if(linkInfo->GetPloamExistAtOnu4OLT () || linkInfo->GetDyingGasp ()) return false;
+
+  const Ptr<XgponOltConnPerOnu>& conns = (m_device->GetConnManager ())->GetOneOnu4ConnsById (onuId);
+  if(conns == 0) return true;
+
+  uint32_t numTconts = conns->GetNumberOfTconts ();
+  for(uint32_t i=0; i<numTconts; i++)
+  {
+    const Ptr<XgponXgtcDbru>& report = (conns->GetTcontByIndex (i))->GetLatestBufOccupancyReport ();
+    if(report != 0 && report->GetBufOcc () > 0) return false;
+  }
+  return true;
+}
+
+
+
+}//namespace ns3
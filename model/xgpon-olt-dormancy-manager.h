@@ -0,0 +1,126 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_OLT_DORMANCY_MANAGER_H
+#define XGPON_OLT_DORMANCY_MANAGER_H
+
+#include <vector>
+
+#include "xgpon-olt-engine.h"
+#include "xgpon-xgtc-ds-frame.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief Decides, for each downstream frame, which ONUs do not need to receive it (dormant ONUs), and stops the production
+ *        of downstream frames while all of them are dormant (idle fast-forward).
+ *
+ * While some ONUs are awake, the OLT produces one downstream frame per slot. What is saved is the delivery of idle frames
+ * to idle ONUs (one event per ONU per frame in PonChannel) and their processing at the ONUs. One ONU becomes dormant when all of the following hold:
+ *   - it has no data, PLOAM message or dying gasp to send, and its latest non-zero status report has reached the OLT;
+ *   - at the OLT, the latest status reports of its T-CONTs are zero (or absent) and no PLOAM is pending at this ONU;
+ *   - the frame carries no PLOAM message, no broadcast XGEM frame and no unicast XGEM frame for this ONU,
+ *     and its allocations in the BWmap are pure polling grants (only the status report).
+ * The BWmaps granting one dormant ONU are handed to it and replayed when it leaves dormancy: when it receives data from
+ * upper layers or when one frame violates the above conditions. Since the ONU would only reply to these polling grants
+ * with zero reports, the OLT DBA produces the same BWmaps as without this mode.
+ *
+ * Once all ONUs are dormant, the frames are only polls and idle XGEM frames. If the DBA engine and the downstream scheduler
+ * know how their state evolves over such frames (CanFastForwardIdleFrames), the OLT stops producing frames. When data arrives
+ * at the OLT or at one ONU, the skipped frames are accounted for at once: the superframe counter, the downstream scheduler and
+ * the DBA state (cursors, service-interval timers) are advanced by arithmetic, and only the latest frames, whose bursts may
+ * still be transmitted, get their BWmaps produced and handed to the ONUs. Production then resumes at the next frame boundary.
+ * Engines without this support (e.g. EBU) keep one frame per slot. Other events that would wake one ONU (PLOAM messages,
+ * dying gasp) are only checked while frames are produced.
+ * Note that dormant ONUs do not fire the per-frame "DeviceStatistics" trace, nor does the OLT for the skipped frames;
+ * XgponStatisticsSampler should be used instead. Used when the "IdleFastForward" attribute of XgponChannel is set.
+ */
+class XgponOltDormancyManager : public XgponOltEngine
+{
+public:
+
+  /**
+   * \brief Constructor
+   */
+  XgponOltDormancyManager ();
+  virtual ~XgponOltDormancyManager ();
+
+
+  /**
+   * \brief put the idle ONUs into dormancy and wake up the ONUs that must receive this frame. Called before the frame is sent.
+   * \param frame the downstream frame to be sent to the channel
+   */
+  void SelectDormantOnus (XgponXgtcDsFrame& frame);
+
+
+  /**
+   * \brief called after one frame is sent: stop producing frames if all ONUs are dormant and the engines can skip idle frames.
+   * \param nextFrameTime the time of the next downstream frame. Unit: nanosecond
+   * \return true if no frame should be scheduled until ResumeDownstreamFrames is called.
+   */
+  bool SuspendDownstreamFrames (uint64_t nextFrameTime);
+
+  /**
+   * \brief whether the production of downstream frames is suspended.
+   */
+  bool IsSuspended ( ) const;
+
+  /**
+   * \brief account for the frames skipped since the production was suspended, before new data is handled at the OLT or one ONU.
+   * \param time the current time. Unit: nanosecond
+   * \return the time of the next downstream frame to be produced (the first frame boundary not earlier than time).
+   */
+  uint64_t ResumeDownstreamFrames (uint64_t time);
+
+
+  /////////////////////////////////////////////////////Required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+
+private:
+  //whether the T-CONTs of this ONU have nothing to be served based on the information at the OLT
+  bool IsIdleAtOlt (uint16_t onuId);
+
+  //walk the BWmap once to flag the ONUs that are granted in this frame.
+  void MarkGrantedOnus (const Ptr<XgponXgtcBwmap>& bwmap);
+
+  std::vector<uint8_t> m_grantFlags;       //indexed by onu-id; built for every frame (grants and multicast membership).
+
+  bool m_suspended;                        //whether the OLT has stopped producing downstream frames
+  uint64_t m_nextFrameTime;                //when suspended, the time of the first skipped frame. unit: nanosecond
+};
+
+
+
+///////////////////////////////INLINE functions
+inline bool
+XgponOltDormancyManager::IsSuspended ( ) const
+{
+  return m_suspended;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_OLT_DORMANCY_MANAGER_H
@@ -67,7 +67,7 @@ XgponOltDsSchedulerRoundRobin::~XgponOltDsSchedulerRoundRobin ()
 
 
 
-const Ptr<XgponConnectionSender>
+const Ptr<XgponConnectionSender>&
 XgponOltDsSchedulerRoundRobin::SelectConnToServe (uint32_t* amountToServe)
 {
   NS_LOG_FUNCTION(this);
@@ -77,7 +77,7 @@ XgponOltDsSchedulerRoundRobin::SelectConnToServe (uint32_t* amountToServe)
   if(m_startFrame)
   {
     m_startFrame = false;
-    const Ptr<XgponConnectionSender> lastConn = GetTheLastServedConnection ();
+    const Ptr<XgponConnectionSender>& lastConn = GetTheLastServedConnection ();
     if(lastConn->IsSegmentationRunning ( ))  //the connection in segmentation has the highest priority.
     {
       *amountToServe = lastConn->GetFragBufOccupancy4Scheduling () * 4;
@@ -87,23 +87,23 @@ XgponOltDsSchedulerRoundRobin::SelectConnToServe (uint32_t* amountToServe)
 
   //get one connection who has data to transmit
   uint16_t numEmpty = 0;
-  Ptr<XgponConnectionSender> conn = GetNextConnection2Serve ();
-  while(conn->GetQueueStatus()==0)
+  const Ptr<XgponConnectionSender>* conn = &GetNextConnection2Serve ();
+  while((*conn)->GetQueueStatus()==0)
   {
     numEmpty++;
     if(numEmpty > m_dsAllConns.size()) //all connections are empty. There is no data in the OLT.
     { 
       *amountToServe = 0; 
       return m_nullConn; 
-    } else { conn = GetNextConnection2Serve (); }
+    } else { conn = &GetNextConnection2Serve (); }
   }
 
   //calculate the amount of data to be served
-  uint32_t dataInQueue = conn->GetBufOccupancy4Scheduling () * 4;
+  uint32_t dataInQueue = (*conn)->GetBufOccupancy4Scheduling () * 4;
   if(dataInQueue < m_maxServiceSize)  *amountToServe = dataInQueue;
   else *amountToServe = m_maxServiceSize;
 
-  return conn;
+  return *conn;
 }
 
 
@@ -119,6 +119,26 @@ XgponOltDsSchedulerRoundRobin::AddConnToScheduler (const Ptr<XgponConnectionSend
   return;
 }
 
+void 
+XgponOltDsSchedulerRoundRobin::ReserveConnsInScheduler (uint32_t nConns)
+{
+  m_dsAllConns.reserve(m_dsAllConns.size() + nConns);
+}
+
+
+bool
+XgponOltDsSchedulerRoundRobin::CanFastForwardIdleFrames ( ) const
+{
+  return m_dsAllConns.size() > 0;
+}
+
+void
+XgponOltDsSchedulerRoundRobin::FastForwardIdleFrames (uint64_t nFrames)
+{
+  m_lastServedConnIndex = (m_lastServedConnIndex + nFrames) % m_dsAllConns.size();
+  m_startFrame = false;
+}
+
 
 
 
@@ -33,7 +33,7 @@ namespace ns3 {
  * \ingroup xgpon
  * \brief The class used to schedule the downstream connections at OLT side in a round-robin manner. 
  */
-class XgponOltDsSchedulerRoundRobin : public XgponOltDsScheduler
+class XgponOltDsSchedulerRoundRobin final : public XgponOltDsScheduler
 {
 public:
 
@@ -53,7 +53,7 @@ public:
    * \return the connection to be served. 0: all connections have no data to send.
    * \param  amountToServe used to return the amount of data to be transmitted for this connection. 
    */  
-  virtual const Ptr<XgponConnectionSender>  SelectConnToServe (uint32_t* amountToServe);
+  virtual const Ptr<XgponConnectionSender>& SelectConnToServe (uint32_t* amountToServe);
   
 
   /**
@@ -63,6 +63,14 @@ public:
    */  
   virtual void AddConnToScheduler (const Ptr<XgponConnectionSender>& conn);   
 
+  virtual void ReserveConnsInScheduler (uint32_t nConns);
+
+  /**
+   * \brief one idle frame visits every connection once more than their number, i.e., the pointer moves by one connection.
+   */
+  virtual bool CanFastForwardIdleFrames ( ) const;
+  virtual void FastForwardIdleFrames (uint64_t nFrames);
+
 
 
 
@@ -74,10 +82,10 @@ public:
 private:
 
   //Get the last connection served in the last downstream connection.
-  Ptr<XgponConnectionSender> GetTheLastServedConnection () const;  
+  const Ptr<XgponConnectionSender>& GetTheLastServedConnection () const;  
 
   //Get the next connection to be considered for serving in this downstream frame.
-  Ptr<XgponConnectionSender> GetNextConnection2Serve ();  
+  const Ptr<XgponConnectionSender>& GetNextConnection2Serve ();  
 
 private:
   uint32_t m_maxServiceSize;       //maximal served size, configured through attribute 
@@ -96,14 +104,14 @@ private:
 
 
 ///////////////////////////////////////////////////////INLINE Functions
-inline Ptr<XgponConnectionSender> 
+inline const Ptr<XgponConnectionSender>& 
 XgponOltDsSchedulerRoundRobin::GetTheLastServedConnection () const
 {
   return m_dsAllConns[m_lastServedConnIndex];
 }
 
 
-inline Ptr<XgponConnectionSender> 
+inline const Ptr<XgponConnectionSender>& 
 XgponOltDsSchedulerRoundRobin::GetNextConnection2Serve ()
 {
   m_lastServedConnIndex++;
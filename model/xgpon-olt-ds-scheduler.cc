@@ -62,6 +62,23 @@ XgponOltDsScheduler::Prepare2ProduceDsFrame ( )
   m_startFrame = true;
 }
 
+void 
+XgponOltDsScheduler::ReserveConnsInScheduler (uint32_t nConns)
+{
+}
+
+bool
+XgponOltDsScheduler::CanFastForwardIdleFrames ( ) const
+{
+  return false;
+}
+
+void
+XgponOltDsScheduler::FastForwardIdleFrames (uint64_t nFrames)
+{
+  NS_ASSERT_MSG((nFrames == 0), "This downstream scheduler cannot fast-forward idle frames!!!");
+}
+
 
 
 
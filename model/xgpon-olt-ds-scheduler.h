@@ -52,7 +52,7 @@ public:
    * \return the connection to be served.   0: all connections have no data to send.
    * \param  amountToServe used to return the amount of data to be transmitted for this connection. must be 4-bytes aligned.
    */  
-  virtual const Ptr<XgponConnectionSender>  SelectConnToServe (uint32_t* amountToServe)=0;
+  virtual const Ptr<XgponConnectionSender>& SelectConnToServe (uint32_t* amountToServe)=0;
   
 
   /**
@@ -62,6 +62,12 @@ public:
    */  
   virtual void  AddConnToScheduler (const Ptr<XgponConnectionSender>& conn)=0;   
 
+  /**
+   * \brief called before a large number of connections are added (bulk provisioning). Nothing by default.
+   * \param nConns the number of connections to be added
+   */
+  virtual void  ReserveConnsInScheduler (uint32_t nConns);
+
 
   /**
    * \brief prepare to start to generate one downstream frame
@@ -69,6 +75,17 @@ public:
   void Prepare2ProduceDsFrame ( );
 
 
+  /**
+   * \brief whether the scheduler can be advanced over idle frames (no connection has data) through FastForwardIdleFrames. False by default.
+   */
+  virtual bool CanFastForwardIdleFrames ( ) const;
+
+  /**
+   * \brief advance the scheduler over nFrames downstream frames that carry no data, as if one frame were produced for each of them.
+   */
+  virtual void FastForwardIdleFrames (uint64_t nFrames);
+
+
 
 
   //////////////////////////////////////////////////////Functions required by NS-3
@@ -22,12 +22,23 @@
 #include "ns3/simulator.h"
 
 #include "xgpon-olt-framing-engine.h"
+#include "xgpon-profiler.h"
 #include "xgpon-olt-net-device.h"
 
 #include "xgpon-olt-conn-manager.h"
 #include "xgpon-olt-ploam-engine.h"
 #include "xgpon-olt-dba-engine.h"
 #include "xgpon-olt-xgem-engine.h"
+#include "xgpon-olt-ds-scheduler-round-robin.h"
+#include "xgpon-olt-dba-engine-round-robin.h"
+#include "xgpon-olt-dba-engine-ebu.h"
+#include "xgpon-olt-dba-engine-giant.h"
+#include "xgpon-olt-dba-engine-xgiant.h"
+#include "xgpon-olt-dba-engine-xgiantdeficit.h"
+#include "xgpon-olt-dba-engine-xgiantprop.h"
+#include "xgpon-onu-net-device.h"
+#include "xgpon-channel.h"
+#include "xgpon-frame-arena.h"
 
 
 
@@ -64,10 +75,18 @@ XgponOltFramingEngine::~XgponOltFramingEngine ()
 
 
 
+void
+XgponOltFramingEngine::ProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame)
+{
+  ProduceXgtcDsFrame<XgponOltDsScheduler, XgponOltDbaEngine> (xgtcDsFrame);
+}
+
+template <class DsScheduler, class DbaEngine>
 void
 XgponOltFramingEngine::ProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (OLT_FRAMING_PRODUCE_DS_FRAME);
 
   XgponXgtcDsHeader& header = xgtcDsFrame.GetHeader ();
 
@@ -82,11 +101,13 @@ XgponOltFramingEngine::ProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame)
   }
 
   //BWmap
-  header.SetBwmap ((m_device->GetDbaEngine( ))->GenerateBwMap ());
+  header.SetBwmap ((m_device->GetDbaEngine( ))->GenerateBwMap<DbaEngine> (Simulator::Now().GetNanoSeconds()));
 
-  //produce a list of xgem frames
+  //produce a list of xgem frames. They are allocated from one arena that is recycled once the frame has been consumed by all ONUs.
   uint32_t payloadLen = (m_device->GetXgponPhy())->GetXgtcDsFrameSize ( )  - header.GetSerializedSize();
-  (m_device->GetXgemEngine( ))->GenerateFramesToTransmit(xgtcDsFrame.GetUnicastXgemFrames(), xgtcDsFrame.GetBroadcastXgemFrames(), xgtcDsFrame.GetBitmap(), payloadLen); 
+  XgponFrameArena* arena = XgponFrameArena::Open ();
+  (m_device->GetXgemEngine( ))->GenerateFramesToTransmit<DsScheduler> (xgtcDsFrame.GetUnicastXgemFrames(), xgtcDsFrame.GetBroadcastXgemFrames(), xgtcDsFrame.GetBitmap(), payloadLen); 
+  XgponFrameArena::Close (arena);
 
   return;
 }
@@ -94,10 +115,12 @@ XgponOltFramingEngine::ProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame)
 
 
 void 
-XgponOltFramingEngine::ParseXgtcUpstreamBurst (XgponXgtcUsBurst& burst)
+XgponOltFramingEngine::ParseXgtcUpstreamBurst (XgponXgtcUsBurst& burst, uint64_t time)
 {
   NS_LOG_FUNCTION(this);
-  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
+  XGPON_PROFILE_SCOPE (OLT_FRAMING_PARSE_US_BURST);
+  //the burst arrival time; it is earlier than "now" when the bursts are delivered in batches.
+  uint64_t nowNano = time;
 
   //get header information
   XgponXgtcUsHeader& header = burst.GetHeader();
@@ -122,8 +145,8 @@ XgponOltFramingEngine::ParseXgtcUpstreamBurst (XgponXgtcUsBurst& burst)
   uint32_t first = dbaEngine->GetIndexOfBurstFirstBwAllocation (bwmap, nowNano);
   NS_ASSERT_MSG((first<bwmap->GetNumberOfBwAllocation ( )), "The index is out of range!!!");
 
-  const Ptr<XgponXgtcBwAllocation>& firstBwAlloc = bwmap->GetBwAllocationByIndex(first);
-  if(firstBwAlloc->GetPloamuFlag())
+  const XgponXgtcBwAllocationFields& firstBwAlloc = bwmap->GetBwAllocationByIndex(first);
+  if(firstBwAlloc.GetPloamuFlag())
   {
     const Ptr<XgponXgtcPloam>& ploam = header.GetPloam ();
     ploamEngine->ReceivePloamMessage (ploam, onuId);  
@@ -135,25 +158,42 @@ XgponOltFramingEngine::ParseXgtcUpstreamBurst (XgponXgtcUsBurst& burst)
   const Ptr<XgponOltConnManager>& connManager = m_device->GetConnManager ( );
   const Ptr<XgponOltXgemEngine>& xgemEngine = m_device->GetXgemEngine ( );
 
+  uint32_t propDelay = 0;
+  if(m_device->GetLatencyMonitor ( ) != 0)
+  {
+    const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel>(m_device->GetChannel());
+    propDelay = channel->GetOnuPropagationDelay ((channel->GetOnuById (onuId))->GetChannelIndex ());
+  }
+
   int num = burst.GetUsAllocationCount ();
   for(int i=first, j=0; j<num; i++, j++)
   {
-    const Ptr<XgponXgtcBwAllocation>& bwAlloc = bwmap->GetBwAllocationByIndex(i);
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex(i);
     const Ptr<XgponXgtcUsAllocation>& alloc = burst.GetUsAllocationByIndex(j);
 
-    uint16_t allocId = bwAlloc->GetAllocId ( );
+    uint16_t allocId = bwAlloc.GetAllocId ( );
     const Ptr<XgponTcontOlt>& tcontOlt = connManager->GetTcontById(allocId);
     NS_ASSERT_MSG(((tcontOlt!=0) && (tcontOlt->GetOnuId()==onuId)), "Cannot find the corresponding Bwmap of this upstream burst.");
 
     //queue status report
-    if(bwAlloc->GetDbruFlag ()) dbaEngine->ReceiveStatusReport(alloc->GetDbru(), onuId, allocId);
+    if(bwAlloc.GetDbruFlag ()) dbaEngine->ReceiveStatusReport(alloc->GetDbru(), onuId, allocId, nowNano);
 
     //xgem frames
-    xgemEngine->ProcessXgemFramesFromLowerLayer (alloc->GetXgemFrames ( ), onuId, allocId);
+    xgemEngine->ProcessXgemFramesFromLowerLayer (alloc->GetXgemFrames ( ), onuId, allocId, bwmap->GetCreationTime ( ), nowNano, propDelay);
   }  
 
   return;
 }
 
 
+
+//the combinations that XgponOltNetDeviceStatic can be composed of
+template void XgponOltFramingEngine::ProduceXgtcDsFrame<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineRoundRobin> (XgponXgtcDsFrame& xgtcDsFrame);
+template void XgponOltFramingEngine::ProduceXgtcDsFrame<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineEbu> (XgponXgtcDsFrame& xgtcDsFrame);
+template void XgponOltFramingEngine::ProduceXgtcDsFrame<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineGiant> (XgponXgtcDsFrame& xgtcDsFrame);
+template void XgponOltFramingEngine::ProduceXgtcDsFrame<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineXgiant> (XgponXgtcDsFrame& xgtcDsFrame);
+template void XgponOltFramingEngine::ProduceXgtcDsFrame<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineXgiantDeficit> (XgponXgtcDsFrame& xgtcDsFrame);
+template void XgponOltFramingEngine::ProduceXgtcDsFrame<XgponOltDsSchedulerRoundRobin, XgponOltDbaEngineXgiantProp> (XgponXgtcDsFrame& xgtcDsFrame);
+
+
 }//namespace ns3
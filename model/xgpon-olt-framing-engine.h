@@ -45,14 +45,24 @@ public:
    */
   void ProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame);
 
+  /**
+   * \brief produce the XgponXgtcDsFrame with the downstream scheduler and the DBA engine of the device bound to their final classes,
+   *        so that the whole downstream path is resolved at compile time. Used by XgponOltNetDeviceStatic;
+   *        the supported combinations are instantiated in xgpon-olt-framing-engine.cc.
+   * \param frame the XgponXgtcDsFrame to be filled
+   */
+  template <class DsScheduler, class DbaEngine>
+  void ProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame);
+
   
   /**
    * \brief Parse the upstream XGTC burst. 
    * Since the burst may contain multiple lists of packets from different T-CONTs, 
    * framing engine will call xgem engine directly (for multiple times) to process these payloads.
    * \param burst the upstream XGTC burst
+   * \param time the time that this burst arrives at the OLT. Unit: nanosecond
    */
-  void ParseXgtcUpstreamBurst (XgponXgtcUsBurst& burst);
+  void ParseXgtcUpstreamBurst (XgponXgtcUsBurst& burst, uint64_t time);
 
 	
 
@@ -0,0 +1,101 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_OLT_NET_DEVICE_STATIC_H
+#define XGPON_OLT_NET_DEVICE_STATIC_H
+
+#include "ns3/fatal-error.h"
+
+#include "xgpon-olt-net-device.h"
+
+
+
+namespace ns3{
+
+/**
+ * \ingroup xgpon
+ * \brief XgponOltNetDevice whose downstream scheduler and DBA engine are fixed at compile time.
+ *
+ * The engines are still created and attached by XgponHelper as for XgponOltNetDevice, but they must be of the classes
+ * DsScheduler and DbaEngine (both final). The downstream frames are then produced by the instantiation of
+ * XgponOltFramingEngine::ProduceXgtcDsFrame for these classes, in which the scheduler and the hooks of the DBA algorithm
+ * are called directly instead of through virtual functions. The combinations supported are those instantiated in
+ * xgpon-olt-framing-engine.cc; the upstream path has no virtual calls and is shared with XgponOltNetDevice.
+ */
+template <class DsScheduler, class DbaEngine>
+class XgponOltNetDeviceStatic : public XgponOltNetDevice
+{
+public:
+
+  /**
+   * \brief Constructor
+   */
+  XgponOltNetDeviceStatic ( );
+  virtual ~XgponOltNetDeviceStatic ( );
+
+
+protected:
+  virtual void DoInitialize (void);
+
+private:
+  virtual void DoProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame);
+};
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////TEMPLATE FUNCTIONS
+
+template <class DsScheduler, class DbaEngine>
+XgponOltNetDeviceStatic<DsScheduler, DbaEngine>::XgponOltNetDeviceStatic () : XgponOltNetDevice ()
+{
+}
+template <class DsScheduler, class DbaEngine>
+XgponOltNetDeviceStatic<DsScheduler, DbaEngine>::~XgponOltNetDeviceStatic ()
+{
+}
+
+template <class DsScheduler, class DbaEngine>
+void
+XgponOltNetDeviceStatic<DsScheduler, DbaEngine>::DoInitialize (void)
+{
+  //the frames are produced through static_cast to these types; a mismatch must stop the simulation in optimized builds too.
+  if(DynamicCast<DsScheduler> (GetDsScheduler ()) == 0) NS_FATAL_ERROR ("The downstream scheduler is not the one that the device is composed of!!!");
+  if(DynamicCast<DbaEngine> (GetDbaEngine ()) == 0) NS_FATAL_ERROR ("The DBA engine is not the one that the device is composed of!!!");
+
+  XgponOltNetDevice::DoInitialize ();
+}
+
+template <class DsScheduler, class DbaEngine>
+void
+XgponOltNetDeviceStatic<DsScheduler, DbaEngine>::DoProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame)
+{
+  GetFramingEngine ()->ProduceXgtcDsFrame<DsScheduler, DbaEngine> (xgtcDsFrame);
+}
+
+
+
+}; //namespace ns3
+#endif /* XGPON_OLT_NET_DEVICE_STATIC_H */
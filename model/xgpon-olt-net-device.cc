@@ -25,11 +25,13 @@
 #include "ns3/ipv4-header.h"
 
 #include "xgpon-olt-net-device.h"
+#include "xgpon-profiler.h"
 #include "pon-channel.h"
 
 
 //to support pool allocation
 #include "xgpon-ds-frame.h"
+#include "xgpon-frame-arena.h"
 #include "xgpon-olt-dba-per-burst-info.h"
 #include "xgpon-service-record.h"
 #include "xgpon-us-burst.h"
@@ -89,11 +91,12 @@ XgponOltNetDevice::~XgponOltNetDevice ()
 
   XgponOltDbaPerBurstInfo::DisablePoolAllocation();
   XgponXgtcBwmap::DisablePoolAllocation();
-  XgponXgtcBwAllocation::DisablePoolAllocation();
   XgponXgtcDbru::DisablePoolAllocation();
 
   XgponXgtcPloam::DisablePoolAllocation();
   XgponServiceRecord::DisablePoolAllocation();
+
+  XgponFrameArena::DisableArenaRecycling();
 }
 
 
@@ -107,12 +110,18 @@ XgponOltNetDevice::ReceivePonFrameFromChannel (const Ptr<PonFrame>& frame)
 {
   NS_LOG_FUNCTION(this);
 
-  Time now = Simulator::Now();
-
   const Ptr<XgponUsBurst>& usBurst = DynamicCast<XgponUsBurst, PonFrame>(frame);
+  ReceiveUsBurst (usBurst, Simulator::Now().GetNanoSeconds());
+}
+
+void 
+XgponOltNetDevice::ReceiveUsBurst (const Ptr<XgponUsBurst>& usBurst, uint64_t time)
+{
+  NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (OLT_EVENT_US_BURST);
 
   //get the burst profile used by this burst based on the bwmap history maintained by dba engine and the time that this burst is received
-  const Ptr<XgponBurstProfile>& profile = m_oltDbaEngine->GetProfile4BurstFromChannel(now.GetNanoSeconds());
+  const Ptr<XgponBurstProfile>& profile = m_oltDbaEngine->GetProfile4BurstFromChannel(time);
 
   //PHY+PHY-Adaptation sub-layer  
   m_oltPhyAdapter->ProcessXgponUsBurstFromChannel(usBurst, profile);
@@ -123,7 +132,7 @@ XgponOltNetDevice::ReceivePonFrameFromChannel (const Ptr<PonFrame>& frame)
   //framing engine will call XGEM engine for Service-Adaptation sub-layer multiple times to process these payloads.
   //Thus, XgponOltNetDevice does not call XGEM engine here. 
   //If we let framing engine put all payloads into a list and return back, we will lose the boundary of T-CONTs.
-  m_oltFramingEngine->ParseXgtcUpstreamBurst(usBurst->GetXgtcUsBurst());
+  m_oltFramingEngine->ParseXgtcUpstreamBurst(usBurst->GetXgtcUsBurst(), time);
 
   return;
 }
@@ -148,10 +157,13 @@ XgponOltNetDevice::DoSend (const Ptr<Packet>& packet, const Address& dest, uint1
   packet->PeekHeader(ipHeader);
   dstAddress=ipHeader.GetDestination();  
 
-  const Ptr<XgponConnectionSender>& conn=m_oltConnManager->FindDsConnByAddress(dstAddress);	
+  //broadcast and multicast destinations are carried by the broadcast connections (one copy per frame for all ONUs of one group)
+  const Ptr<XgponConnectionSender>& conn = (dstAddress.IsMulticast() || dstAddress.IsBroadcast()) ? 
+                                             m_oltConnManager->FindBroadcastConnByAddress(dstAddress) : m_oltConnManager->FindDsConnByAddress(dstAddress);	
   if(conn == 0) return false;
   else
   {
+    WakeUpDownstreamFrames ();
     return conn->ReceiveUpperLayerSdu(packet);
   }	
 }
@@ -176,6 +188,19 @@ void
 XgponOltNetDevice::DoInitialize (void)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_START ();
+
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, PonChannel>(m_channel);
+  if(channel != 0 && channel->GetBatchUpstreamBursts())
+  {
+    m_oltUsBurstAssembler = CreateObject<XgponOltUsBurstAssembler> ();
+    m_oltUsBurstAssembler->SetXgponOltNetDevice (this);
+  }
+  if(channel != 0 && channel->GetIdleFastForward())
+  {
+    m_oltDormancyManager = CreateObject<XgponOltDormancyManager> ();
+    m_oltDormancyManager->SetXgponOltNetDevice (this);
+  }
 
   Simulator::ScheduleNow(&XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically, this );
   return;
@@ -186,6 +211,7 @@ void
 XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically ()
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (OLT_EVENT_DS_FRAME);
 
   Ptr<XgponDsFrame> dsFrame = Create<XgponDsFrame> ();  //create the downstream frame to be processed by various engines
 
@@ -193,18 +219,34 @@ XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically ()
   //Framing sub-layer
   //Note that framing engine will call XGEM engine (for Service-Adaptation sub-layer) directly to fill the payloads.
   //Although we can call XGEM engine and downstream scheduler here, it might be better to keep XgponOltNetDevice short.
-  m_oltFramingEngine->ProduceXgtcDsFrame(dsFrame->GetXgtcDsFrame ());
+  DoProduceXgtcDsFrame (dsFrame->GetXgtcDsFrame ());
 
   //phy and ohy-adaptation layer
   m_oltPhyAdapter->ProcessXgtcDsFrameFromUpperLayer(dsFrame);
 
+  //decide which ONUs can skip this frame
+  if(m_oltDormancyManager != 0)
+  {
+    m_oltDormancyManager->SelectDormantOnus (dsFrame->GetXgtcDsFrame ());
+  }
+
   //send to the channel
   m_channel->SendDownstream (dsFrame);
 
+  //in batch mode, the bursts granted in this BWmap are produced and delivered by the assembler (after the ONUs receive this frame).
+  if(m_oltUsBurstAssembler != 0)
+  {
+    m_oltUsBurstAssembler->ScheduleUsBursts ((dsFrame->GetXgtcDsFrame ()).GetHeader ().GetBwmap ());
+  }
+
   m_phyTxEndTrace(dsFrame, Simulator::Now());
 
-  //schedule for the next downstream frame
-  Simulator::Schedule (NanoSeconds(m_commonPhy->GetDsFrameSlotSize()), &XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically, this); 
+  //schedule for the next downstream frame, unless the whole PON is idle: the frames are then skipped until new data arrives.
+  uint64_t nextFrameTime = Simulator::Now().GetNanoSeconds() + m_commonPhy->GetDsFrameSlotSize();
+  if(m_oltDormancyManager == 0 || !m_oltDormancyManager->SuspendDownstreamFrames (nextFrameTime))
+  {
+    Simulator::Schedule (NanoSeconds(m_commonPhy->GetDsFrameSlotSize()), &XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically, this); 
+  }
 
 
   //tracesource callback for network device statistics
@@ -213,6 +255,27 @@ XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically ()
 }
 
 
+void
+XgponOltNetDevice::WakeUpDownstreamFrames ( )
+{
+  if(m_oltDormancyManager == 0 || !m_oltDormancyManager->IsSuspended ()) return;
+  NS_LOG_FUNCTION(this);
+
+  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
+  uint64_t nextFrameTime = m_oltDormancyManager->ResumeDownstreamFrames (nowNano);
+
+  //may be called from the context of one ONU
+  Simulator::ScheduleWithContext (GetNode()->GetId(), NanoSeconds(nextFrameTime - nowNano), &XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically, this);
+}
+
+
+void
+XgponOltNetDevice::DoProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame)
+{
+  m_oltFramingEngine->ProduceXgtcDsFrame (xgtcDsFrame);
+}
+
+
 
 
 
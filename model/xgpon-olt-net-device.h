@@ -35,6 +35,9 @@
 #include "xgpon-olt-dba-engine.h"
 #include "xgpon-olt-framing-engine.h"
 #include "xgpon-olt-phy-adapter.h"
+#include "xgpon-olt-us-burst-assembler.h"
+#include "xgpon-olt-dormancy-manager.h"
+#include "xgpon-latency-monitor.h"
 
 
 
@@ -63,6 +66,20 @@ public:
    */
   virtual void ReceivePonFrameFromChannel (const Ptr<PonFrame>& frame);
 
+  /**
+   * \brief process one upstream burst that arrived at the given time.
+   *        The time is earlier than "now" when the bursts are delivered in batches by XgponOltUsBurstAssembler.
+   * \param usBurst the upstream burst
+   * \param time the time that this burst arrives at the OLT. Unit: nanosecond
+   */
+  void ReceiveUsBurst (const Ptr<XgponUsBurst>& usBurst, uint64_t time);
+
+  /**
+   * \brief resume the downstream frames if they were suspended while the whole PON is idle (see XgponOltDormancyManager).
+   *        Called before new data is handled at the OLT or at one dormant ONU.
+   */
+  void WakeUpDownstreamFrames ( );
+
 
 
   ///////////////////////////////////////////////////////member variable accessors
@@ -93,6 +110,12 @@ public:
   void SetOmciEngine (const Ptr<XgponOltOmciEngine>& engine);
   const Ptr<XgponOltOmciEngine>& GetOmciEngine ( ) const;
 
+  /**
+   * \brief decompose the latency of the upstream SDUs with the given monitor (0: no decomposition).
+   */
+  void SetLatencyMonitor (const Ptr<XgponLatencyMonitor>& monitor);
+  const Ptr<XgponLatencyMonitor>& GetLatencyMonitor ( ) const;
+
 
 
 
@@ -118,6 +141,12 @@ private:
    * \brief generate one downstream frame per 125 micro-second and send to ONUs. started in DoStart ();
    */
   void SendDownstreamFrameToChannelPeriodically ( );
+
+  /**
+   * \brief fill the XGTC part of one downstream frame through the framing engine.
+   *        XgponOltNetDeviceStatic overrides it to bind the engines at compile time.
+   */
+  virtual void DoProduceXgtcDsFrame (XgponXgtcDsFrame& xgtcDsFrame);
   
 
 private:
@@ -135,6 +164,10 @@ private:
   Ptr<XgponOltXgemEngine> m_oltXgemEngine;
   Ptr<XgponOltOmciEngine> m_oltOmciEngine;
 
+  Ptr<XgponOltUsBurstAssembler> m_oltUsBurstAssembler;   //only created when the upstream bursts are assembled in batches
+  Ptr<XgponOltDormancyManager> m_oltDormancyManager;     //only created when idle ONUs are skipped by the downstream frames
+  Ptr<XgponLatencyMonitor> m_latencyMonitor;             //0: the latency of upstream SDUs is not decomposed
+
 
 
   TracedCallback<Ptr<const XgponDsFrame>, Time > m_phyTxEndTrace;
@@ -249,6 +282,17 @@ XgponOltNetDevice::GetOmciEngine ( ) const
   return m_oltOmciEngine;
 }
 
+inline void
+XgponOltNetDevice::SetLatencyMonitor (const Ptr<XgponLatencyMonitor>& monitor)
+{
+  m_latencyMonitor = monitor;
+}
+inline const Ptr<XgponLatencyMonitor>&
+XgponOltNetDevice::GetLatencyMonitor ( ) const
+{
+  return m_latencyMonitor;
+}
+
 
 
 }; //namespace ns3
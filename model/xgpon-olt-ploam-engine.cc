@@ -21,6 +21,8 @@
 #include "ns3/log.h"
 
 #include "xgpon-olt-ploam-engine.h"
+#include "xgpon-olt-net-device.h"
+#include "xgpon-onu-net-device.h"
 #include "xgpon-channel.h"   //the constant for maximal onus per xgpon
 
 
@@ -99,6 +101,35 @@ XgponOltPloamEngine::GetPloamsForTransmit(void)
 
 
 
+void
+XgponOltPloamEngine::RangeOnus ( )
+{
+  NS_LOG_FUNCTION(this);
+
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel>(m_device->GetChannel());
+  uint64_t logicRtt = 2 * channel->GetLogicOneWayDelay ();
+
+  uint16_t numOnus = channel->GetNOnuDevices ();
+  for(uint16_t i=0; i<numOnus; i++)
+  {
+    const Ptr<XgponOnuNetDevice> onu = DynamicCast<XgponOnuNetDevice, PonNetDevice>(channel->GetOnuByIndex (i));
+    uint16_t onuId = onu->GetOnuId ();
+
+    uint64_t rtt = 2 * channel->GetOnuPropagationDelay (i);
+    NS_ASSERT_MSG((rtt <= logicRtt), "The measured round trip delay is larger than the logic one!!!");
+
+    //the ONU waits two equalization delays before its burst (see XgponOnuDbaEngine::GetUsBurstTxDelay).
+    uint64_t eqDelay = (logicRtt - rtt) / 2;
+
+    const Ptr<XgponLinkInfo>& linkInfo = GetLinkInfo (onuId);
+    NS_ASSERT_MSG((linkInfo!=0), "The ONU has not been added to the OLT yet!!!");
+    linkInfo->SetEqualizeDelay (eqDelay);
+    (onu->GetPloamEngine ())->GetLinkInfo ()->SetEqualizeDelay (eqDelay);
+  }
+}
+
+
+
 
 
 
@@ -67,6 +67,16 @@ public:
   std::list< Ptr<XgponXgtcPloam> >& GetPloamsForTransmit(void);
 
 
+  /**
+   * \brief range all ONUs attached to the channel and fill their equalization delays (at both OLT and ONU).
+   *        The round trip delay of one ONU is measured as with one ranging grant sent to it before its equalization delay is set.
+   *        The equalization delay is chosen so that the bursts of all ONUs arrive as if they were at the logic one way delay.
+   *        The Ranging_Time PLOAM message is not simulated; the delay is set directly at the ONU.
+   *        Called after all ONUs are attached and before the simulation starts.
+   */
+  void RangeOnus ( );
+
+
 
 
   ///////////////////////////////////////////////////////maintain linkinfo for ONUs (inline functions)
@@ -0,0 +1,192 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#include <algorithm>
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "xgpon-olt-us-burst-assembler.h"
+#include "xgpon-olt-net-device.h"
+#include "xgpon-onu-net-device.h"
+#include "xgpon-channel.h"
+
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponOltUsBurstAssembler");
+
+namespace ns3{
+
+NS_OBJECT_ENSURE_REGISTERED (XgponOltUsBurstAssembler);
+
+static bool
+ArriveEarlier (const XgponUsBurstBatch::Entry& a, const XgponUsBurstBatch::Entry& b)
+{
+  return a.m_arrivalTime < b.m_arrivalTime;
+}
+
+
+TypeId
+XgponOltUsBurstAssembler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponOltUsBurstAssembler")
+    .SetParent<XgponOltEngine> ()
+    .AddConstructor<XgponOltUsBurstAssembler> ()
+  ;
+  return tid;
+}
+TypeId
+XgponOltUsBurstAssembler::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+
+XgponOltUsBurstAssembler::XgponOltUsBurstAssembler ()
+{
+}
+XgponOltUsBurstAssembler::~XgponOltUsBurstAssembler ()
+{
+}
+
+
+
+
+void
+XgponOltUsBurstAssembler::ScheduleUsBursts (const Ptr<XgponXgtcBwmap>& bwmap)
+{
+  NS_LOG_FUNCTION(this);
+
+  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
+  uint64_t slotSize = (m_device->GetXgponPhy())->GetDsFrameSlotSize();  //unit: nanosecond
+
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel>(m_device->GetChannel());
+  const Ptr<XgponOltConnManager>& connManager = m_device->GetConnManager ( );
+
+  Ptr<XgponUsBurstBatch> batch = Create<XgponUsBurstBatch> ();
+  batch->m_bwmap = bwmap;
+
+  uint64_t currentSlot = 0;      //the downstream frame (after the current one) during which the bursts of this batch arrive
+  uint64_t firstTxTime = 0;
+  uint64_t lastDsRxTime = 0;
+  uint64_t lastArrivalTime = 0;
+
+  uint16_t bwMapSize = bwmap->GetNumberOfBwAllocation ( );
+  for(uint16_t i=0; i<bwMapSize; i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc = bwmap->GetBwAllocationByIndex(i);
+    if(bwAlloc.GetStartTime() == 0xFFFF) continue;   //not the first allocation of one burst
+
+    const Ptr<XgponTcontOlt>& tcont = connManager->GetTcontById (bwAlloc.GetAllocId());
+    NS_ASSERT_MSG((tcont!=0), "Cannot find the T-CONT of one allocation in the BWmap!!!");
+    const Ptr<XgponOnuNetDevice>& onu = channel->GetOnuById (tcont->GetOnuId());
+    NS_ASSERT_MSG((onu!=0), "Cannot find the ONU that the allocation is granted to!!!");
+    if(onu->IsDormant()) continue;   //its bursts are scheduled by itself when it leaves dormancy
+
+    //the ONU receives the BWmap after one propagation delay and its burst reaches the OLT after another one.
+    uint64_t propDelay = channel->GetOnuPropagationDelay (onu->GetChannelIndex ());
+    uint64_t dsRxTime = nowNano + propDelay;
+    uint64_t txTime = dsRxTime + (onu->GetDbaEngine())->GetUsBurstTxDelay (bwAlloc);
+    uint64_t arrivalTime = txTime + propDelay;
+
+    //split at the boundary of downstream frames so that status reports are seen by the same BWmap as in per-burst mode.
+    uint64_t slot = (arrivalTime - nowNano) / slotSize;
+    if(!batch->m_entries.empty() && slot != currentSlot)
+    {
+      ScheduleBatch (batch, nowNano, std::max(firstTxTime, lastDsRxTime), lastArrivalTime);
+      batch->m_bwmap = bwmap;
+    }
+
+    if(batch->m_entries.empty())
+    {
+      currentSlot = slot;
+      firstTxTime = txTime;
+      lastDsRxTime = dsRxTime;
+      lastArrivalTime = arrivalTime;
+    }
+    else
+    {
+      firstTxTime = std::min(firstTxTime, txTime);
+      lastDsRxTime = std::max(lastDsRxTime, dsRxTime);
+      lastArrivalTime = std::max(lastArrivalTime, arrivalTime);
+    }
+
+    XgponUsBurstBatch::Entry entry;
+    entry.m_onu = onu;
+    entry.m_first = i;
+    entry.m_arrivalTime = arrivalTime;
+    batch->m_entries.push_back (entry);
+  }
+
+  if(!batch->m_entries.empty())
+  {
+    ScheduleBatch (batch, nowNano, std::max(firstTxTime, lastDsRxTime), lastArrivalTime);
+  }
+}
+
+
+void
+XgponOltUsBurstAssembler::ScheduleBatch (Ptr<XgponUsBurstBatch>& batch, uint64_t now, uint64_t assembleTime, uint64_t deliverTime)
+{
+  NS_ASSERT_MSG((now <= assembleTime && assembleTime <= deliverTime), "Strange assembly time of the upstream bursts!!!");
+
+  //the OLT parses the bursts in the order they arrive, as in per-burst mode (equalization delays may differ among ONUs).
+  std::stable_sort (batch->m_entries.begin(), batch->m_entries.end(), ArriveEarlier);
+
+  //When both events have the same time, the batch is still assembled first (insertion order).
+  Simulator::Schedule (NanoSeconds(assembleTime - now), &XgponOltUsBurstAssembler::AssembleBatch, this, batch);
+  Simulator::Schedule (NanoSeconds(deliverTime - now), &XgponOltUsBurstAssembler::DeliverBatch, this, batch);
+
+  batch = Create<XgponUsBurstBatch> ();
+}
+
+
+
+
+void
+XgponOltUsBurstAssembler::AssembleBatch (const Ptr<XgponUsBurstBatch>& batch)
+{
+  NS_LOG_FUNCTION(this);
+
+  std::vector<XgponUsBurstBatch::Entry>& entries = batch->m_entries;
+  for(uint32_t i=0; i<entries.size(); i++)
+  {
+    entries[i].m_burst = entries[i].m_onu->ProduceUsBurst (batch->m_bwmap, entries[i].m_first);
+  }
+}
+
+
+void
+XgponOltUsBurstAssembler::DeliverBatch (const Ptr<XgponUsBurstBatch>& batch)
+{
+  NS_LOG_FUNCTION(this);
+
+  std::vector<XgponUsBurstBatch::Entry>& entries = batch->m_entries;
+  for(uint32_t i=0; i<entries.size(); i++)
+  {
+    m_device->ReceiveUsBurst (entries[i].m_burst, entries[i].m_arrivalTime);
+  }
+  entries.clear ();
+}
+
+
+
+}//namespace ns3
@@ -0,0 +1,106 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_OLT_US_BURST_ASSEMBLER_H
+#define XGPON_OLT_US_BURST_ASSEMBLER_H
+
+#include <vector>
+
+#include "ns3/simple-ref-count.h"
+
+#include "xgpon-olt-engine.h"
+#include "xgpon-xgtc-bwmap.h"
+#include "xgpon-us-burst.h"
+
+
+namespace ns3 {
+
+class XgponOnuNetDevice;
+
+/**
+ * \brief the upstream bursts of one BWmap that arrive at the OLT between two consecutive downstream frames.
+ */
+class XgponUsBurstBatch : public SimpleRefCount<XgponUsBurstBatch>
+{
+public:
+  class Entry
+  {
+  public:
+    Ptr<XgponOnuNetDevice> m_onu;        //the ONU that transmits this burst
+    uint16_t m_first;                    //index of the first allocation of this burst in the BWmap
+    uint64_t m_arrivalTime;              //the time that this burst arrives at the OLT. unit: nanosecond
+    Ptr<XgponUsBurst> m_burst;           //filled when the batch is assembled
+  };
+
+  Ptr<XgponXgtcBwmap> m_bwmap;
+  std::vector<Entry> m_entries;          //in the order of StartTime
+};
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief Assembles the upstream bursts scheduled in one BWmap with a few events, instead of one event per burst at each ONU.
+ *
+ * When the BWmap is sent, the transmission and arrival time of every burst is computed from the propagation delay,
+ * the equalization delay and the StartTime of the burst. The bursts are then split into (at most two) batches at the
+ * boundaries of downstream frames, so that the OLT DBA sees the same status reports when producing the next BWmap.
+ * Each batch is produced by the granted ONUs at the later of its earliest transmission time and the time that its last ONU
+ * receives the BWmap (no ONU fills a burst before having the BWmap), and delivered to the OLT at its latest arrival time;
+ * each burst is parsed with its own arrival time. Used when the "BatchUpstreamBursts" attribute of XgponChannel is set.
+ */
+class XgponOltUsBurstAssembler : public XgponOltEngine
+{
+public:
+
+  /**
+   * \brief Constructor
+   */
+  XgponOltUsBurstAssembler ();
+  virtual ~XgponOltUsBurstAssembler ();
+
+
+  /**
+   * \brief schedule the assembly and delivery of the upstream bursts granted in this BWmap. Called when the BWmap is sent.
+   * \param bwmap the BWmap carried by the downstream frame that has just been sent to the channel
+   */
+  void ScheduleUsBursts (const Ptr<XgponXgtcBwmap>& bwmap);
+
+
+  /////////////////////////////////////////////////////Required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+
+private:
+  //ask the granted ONUs to produce their bursts
+  void AssembleBatch (const Ptr<XgponUsBurstBatch>& batch);
+
+  //hand the bursts to the OLT with their arrival times
+  void DeliverBatch (const Ptr<XgponUsBurstBatch>& batch);
+
+  //schedule the assembly and delivery of one batch; the current batch is replaced by an empty one.
+  void ScheduleBatch (Ptr<XgponUsBurstBatch>& batch, uint64_t now, uint64_t assembleTime, uint64_t deliverTime);
+};
+
+
+}; // namespace ns3
+
+#endif // XGPON_OLT_US_BURST_ASSEMBLER_H
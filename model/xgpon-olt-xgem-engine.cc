@@ -23,9 +23,11 @@
 #include "ns3/log.h"
 
 #include "xgpon-olt-xgem-engine.h"
+#include "xgpon-profiler.h"
 #include "xgpon-xgem-routines.h"
 
 #include "xgpon-olt-net-device.h"
+#include "xgpon-olt-ds-scheduler-round-robin.h"
 
 
 
@@ -61,15 +63,24 @@ XgponOltXgemEngine::~XgponOltXgemEngine ()
 
 
 
+void
+XgponOltXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, std::vector<Ptr<XgponXgemFrame> >& broadcastXgemFrames, std::vector<uint8_t>& bitmap4Onus, uint32_t payloadLength)
+{
+  GenerateFramesToTransmit<XgponOltDsScheduler> (xgemFrames, broadcastXgemFrames, bitmap4Onus, payloadLength);
+}
+
+template <class DsScheduler>
 void
 XgponOltXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, std::vector<Ptr<XgponXgemFrame> >& broadcastXgemFrames, std::vector<uint8_t>& bitmap4Onus, uint32_t payloadLength)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (OLT_XGEM_GENERATE_FRAMES);
 
-  const Ptr<XgponOltDsScheduler>& scheduler = m_device->GetDsScheduler();
+  DsScheduler& scheduler = static_cast<DsScheduler&> (*(m_device->GetDsScheduler()));
   const Ptr<XgponOltPloamEngine>& ploamEngine = m_device->GetPloamEngine ( );
+  const Ptr<XgponNetDevice> device = m_device;
   
-  scheduler->Prepare2ProduceDsFrame ( );
+  scheduler.Prepare2ProduceDsFrame ( );
 
   uint32_t currentPayloadSize = 0;
   while(currentPayloadSize < payloadLength)
@@ -88,7 +99,7 @@ XgponOltXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >&
     else //SDUs (if exist) will be encapsulated.
     {
       uint32_t amountToServe; 
-      const Ptr<XgponConnectionSender>& conn = scheduler->SelectConnToServe (&amountToServe);
+      const Ptr<XgponConnectionSender>& conn = scheduler.SelectConnToServe (&amountToServe);
 
       if(conn==0)  //OLT has no data send. Fill with idle XGEM frames
       {
@@ -127,12 +138,12 @@ XgponOltXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >&
         {
           if(conn->IsBroadcast())
           {
-            frame = XgponXgemRoutines::GenerateXgemFrame (m_device, conn, amountToServe, 0, 0, doSegmentation);
+            frame = XgponXgemRoutines::GenerateXgemFrame (device, conn, amountToServe, 0, 0, doSegmentation);
           }
           else
           {
             const Ptr<XgponLinkInfo>& linkInfo = ploamEngine->GetLinkInfo(conn->GetOnuId());
-            frame = XgponXgemRoutines::GenerateXgemFrame (m_device, conn, amountToServe, 
+            frame = XgponXgemRoutines::GenerateXgemFrame (device, conn, amountToServe, 
                                        linkInfo->GetCurrentUsKey(), linkInfo->GetCurrentUsKeyIndex(), doSegmentation);
           }
 
@@ -163,9 +174,11 @@ XgponOltXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >&
 
 
 void 
-XgponOltXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFrame> >& frames, uint16_t onuId, uint16_t allocId)
+XgponOltXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFrame> >& frames, uint16_t onuId, uint16_t allocId,
+                                                     uint64_t grantTime, uint64_t time, uint32_t propDelay)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (OLT_XGEM_PROCESS_FRAMES);
 
   //Get the engines necessary for processing these Xgem frames
   const Ptr<XgponOltConnManager>& connManager = m_device->GetConnManager ( ); 
@@ -179,6 +192,8 @@ XgponOltXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFr
   const uint16_t tcontOltType = (uint16_t)tcontOlt->GetTcontType();
   NS_ASSERT_MSG((tcontOltType!=0), "Invalid TCONT Type when receiving data at OLT-side!!!");
 
+  const Ptr<XgponLatencyMonitor>& latencyMonitor = m_device->GetLatencyMonitor ( );
+
   std::vector<Ptr<XgponXgemFrame> >::iterator it, end;
   it = frames.begin();
   end = frames.end();
@@ -208,6 +223,7 @@ XgponOltXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFr
         if(portId == onuId) { m_device->GetOmciEngine()->ReceiveOmciPacket(sdu); } //send to OMCI
         else 
           { 
+                if(latencyMonitor != 0) latencyMonitor->RecordSdu (sdu, tcontOlt, portId, grantTime, time, propDelay);
                 m_device->SendSduToUpperLayer (sdu, tcontOltType, onuId, 1024);//ja:update:ns-3.35, 1024 is the OLT ID, which is the receiver ID here
            } //send to upper layers
       } //end for fragmentation state
@@ -219,6 +235,13 @@ XgponOltXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFr
 
 
 
+//also called from the other engines (XgponOltFramingEngine), so the instantiations are explicit
+template void XgponOltXgemEngine::GenerateFramesToTransmit<XgponOltDsScheduler> (std::vector<Ptr<XgponXgemFrame> >& xgemFrames,
+                                                                                   std::vector<Ptr<XgponXgemFrame> >& broadcastXgemFrames,
+                                                                                   std::vector<uint8_t>& bitmap, uint32_t payloadLength);
+template void XgponOltXgemEngine::GenerateFramesToTransmit<XgponOltDsSchedulerRoundRobin> (std::vector<Ptr<XgponXgemFrame> >& xgemFrames,
+                                                                                             std::vector<Ptr<XgponXgemFrame> >& broadcastXgemFrames,
+                                                                                             std::vector<uint8_t>& bitmap, uint32_t payloadLength);
 
 
 }//namespace ns3
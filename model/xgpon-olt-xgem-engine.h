@@ -53,8 +53,12 @@ public:
    * \brief receive a list of XGEM Frames from lower layer (the peer). 
    * \param onuId the ID of the ONU who sends these frames to OLT
    * \param allocId the Alloc-ID that these frames belong to.
+   * \param grantTime the creation time of the BWmap that granted the burst. Unit: nanosecond
+   * \param time the time that the burst arrives at the OLT. Unit: nanosecond
+   * \param propDelay the propagation delay of the ONU; only used for latency decomposition. Unit: nanosecond
    */
-  void ProcessXgemFramesFromLowerLayer(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, uint16_t onuId, uint16_t allocId);
+  void ProcessXgemFramesFromLowerLayer(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, uint16_t onuId, uint16_t allocId,
+                                       uint64_t grantTime, uint64_t time, uint32_t propDelay);
 
 
   /**
@@ -67,6 +71,14 @@ public:
   void GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, std::vector<Ptr<XgponXgemFrame> >& broadcastXgemFrames, 
                                 std::vector<uint8_t>& bitmap, uint32_t payloadLength);
 
+  /**
+   * \brief the same as above, but the downstream scheduler of the device is used as DsScheduler (its final class),
+   *        so that SelectConnToServe is bound at compile time. Instantiated in xgpon-olt-xgem-engine.cc.
+   */
+  template <class DsScheduler>
+  void GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, std::vector<Ptr<XgponXgemFrame> >& broadcastXgemFrames, 
+                                std::vector<uint8_t>& bitmap, uint32_t payloadLength);
+
 
 
 
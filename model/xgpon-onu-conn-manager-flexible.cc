@@ -51,7 +51,7 @@ XgponOnuConnManagerFlexible::GetInstanceTypeId (void) const
 XgponOnuConnManagerFlexible::XgponOnuConnManagerFlexible () 
   :XgponOnuConnManager(),
   m_tconts(0), m_usConnsAddressIndex(),
-  m_dsConns(0), m_broadcastConns(0)
+  m_dsConns(0)
 {
 }
 XgponOnuConnManagerFlexible::~XgponOnuConnManagerFlexible ()
@@ -68,6 +68,7 @@ void
 XgponOnuConnManagerFlexible::AddOneUsTcont (const Ptr<XgponTcontOnu>& tcont)
 {
   NS_LOG_FUNCTION(this);
+  m_tcontsIdIndex.Insert (tcont->GetAllocId(), m_tconts.size());
   m_tconts.push_back(tcont);
 }
 const Ptr<XgponTcontOnu>& 
@@ -75,12 +76,26 @@ XgponOnuConnManagerFlexible::GetTcontById (uint16_t allocId)
 {
   NS_LOG_FUNCTION(this);
 
+  uint32_t index = m_tcontsIdIndex.Find (allocId);
+  if(index == XgponIdMap::NOT_FOUND) return m_nullTcont; 
+  return m_tconts[index];
+}
+
+bool 
+XgponOnuConnManagerFlexible::HasUpstreamData ( )
+{
   uint16_t num = m_tconts.size();
   for(int i=0; i<num; i++)
   {
-    if(m_tconts[i]->GetAllocId() == allocId) return m_tconts[i];
+    if(m_tconts[i]->HasDataToTransmit()) return true;
   }
-  return m_nullTcont; 
+  return false;
+}
+
+void 
+XgponOnuConnManagerFlexible::GetAllTconts (std::vector< Ptr<XgponTcontOnu> >& tconts)
+{
+  tconts.insert (tconts.end (), m_tconts.begin (), m_tconts.end ());
 }
 
 
@@ -95,6 +110,7 @@ XgponOnuConnManagerFlexible::AddOneUsConn (const Ptr<XgponConnectionSender>& con
   {
     tcont->AddOneConnection (conn);    
     m_usConnsAddressIndex.insert ( std::pair<Address, Ptr<XgponConnectionSender> >(conn->GetUpperLayerAddr(),conn) );
+    AddUsConnByXgemPort (conn);
     if(conn->GetOnuId() == conn->GetXgemPort()) m_usOmciConn = conn;
     
   }
@@ -121,26 +137,17 @@ XgponOnuConnManagerFlexible::AddOneDsConn (const Ptr<XgponConnectionReceiver>& c
 {
   NS_LOG_FUNCTION(this);
   
-  if(conn->IsBroadcast()) m_broadcastConns.push_back(conn);
-  else m_dsConns.push_back(conn);
+  m_dsConnsPortIndex.Insert (conn->GetXgemPort(), m_dsConns.size());
+  m_dsConns.push_back(conn);
 }
 const Ptr<XgponConnectionReceiver>& 
 XgponOnuConnManagerFlexible::FindDsConnByXgemPort (uint16_t port)
 {
   NS_LOG_FUNCTION(this);
 
-  uint16_t num = m_dsConns.size();
-  for(int i=0; i<num; i++)
-  {
-    if(m_dsConns[i]->GetXgemPort()==port) return m_dsConns[i];
-  }
-
-  num = m_broadcastConns.size();
-  for(int i=0; i<num; i++)
-  {
-    if(m_broadcastConns[i]->GetXgemPort()==port) return m_broadcastConns[i];
-  }
-  return m_nullConnReceiver; 
+  uint32_t index = m_dsConnsPortIndex.Find (port);
+  if(index == XgponIdMap::NOT_FOUND) return m_nullConnReceiver; 
+  return m_dsConns[index];
 }
 
 
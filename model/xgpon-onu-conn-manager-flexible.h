@@ -22,6 +22,7 @@
 #define XGPON_ONU_CONN_MANAGER_FLEXIBLE_H
 
 #include "xgpon-onu-conn-manager.h"
+#include "xgpon-id-map.h"
 
 
 
@@ -33,7 +34,7 @@ namespace ns3 {
  * \brief The class instantiates XgponOnuConnManager. It does not impose any relationship between alloc-id, xgem-port, onu-id, ipaddress, etc.
  */
 
-class XgponOnuConnManagerFlexible : public XgponOnuConnManager
+class XgponOnuConnManagerFlexible final : public XgponOnuConnManager
 {
 public:
 
@@ -56,6 +57,16 @@ public:
    */
   virtual const Ptr<XgponTcontOnu>& GetTcontById (uint16_t allocId);
 
+  /**
+   * \brief whether any T-CONT of this ONU has data to be transmitted in upstream
+   */
+  virtual bool HasUpstreamData ( );
+
+  /**
+   * \brief append all T-CONTs of this ONU to tconts
+   */
+  virtual void GetAllTconts (std::vector< Ptr<XgponTcontOnu> >& tconts);
+
 
 
   /**
@@ -99,11 +110,12 @@ public:
 
 
 private:
-  std::vector< Ptr<XgponTcontOnu> > m_tconts;                               //T-CONTs; O(n)
+  std::vector< Ptr<XgponTcontOnu> > m_tconts;                               //T-CONTs
+  XgponIdMap m_tcontsIdIndex;                                               //alloc-id -> index in m_tconts; O(1)
   std::map< Address, Ptr<XgponConnectionSender> > m_usConnsAddressIndex;    //key == address; O(log n);
 
-  std::vector< Ptr<XgponConnectionReceiver> > m_dsConns;                    //the downstream connections that belongs to this ONU; O(n)
-  std::vector< Ptr<XgponConnectionReceiver> > m_broadcastConns;             //broadcast downstream connections; O(n)
+  std::vector< Ptr<XgponConnectionReceiver> > m_dsConns;                    //the downstream connections (including broadcast ones) of this ONU
+  XgponIdMap m_dsConnsPortIndex;                                            //xgem-port -> index in m_dsConns; O(1)
 
 
   /* more variables may be needed */
@@ -100,6 +100,25 @@ XgponOnuConnManagerSpeed::GetTcontById (uint16_t allocId)
   return m_tconts[index];
 }
 
+bool 
+XgponOnuConnManagerSpeed::HasUpstreamData ( )
+{
+  for(uint16_t i=0; i<m_tconts.size(); i++)
+  {
+    if(m_tconts[i]!=0 && m_tconts[i]->HasDataToTransmit()) return true;
+  }
+  return false;
+}
+
+void 
+XgponOnuConnManagerSpeed::GetAllTconts (std::vector< Ptr<XgponTcontOnu> >& tconts)
+{
+  for(uint16_t i=0; i<m_tconts.size(); i++)
+  {
+    if(m_tconts[i]!=0) tconts.push_back (m_tconts[i]);
+  }
+}
+
 
 
 void 
@@ -119,6 +138,7 @@ XgponOnuConnManagerSpeed::AddOneUsConn (const Ptr<XgponConnectionSender>& conn,
 		
 		NS_ASSERT_MSG((((xgemPort % 1024)==onuId) && (index<64)), "Unreasonable XgemPort for this ONU!!!");
     m_usConns[allocId/1024 - 1] = conn;    
+    AddUsConnByXgemPort (conn);
 
     if(conn->GetOnuId() == conn->GetXgemPort()) m_usOmciConn = conn;    
   }
@@ -172,7 +192,11 @@ XgponOnuConnManagerSpeed::AddOneDsConn (const Ptr<XgponConnectionReceiver>& conn
 {
   NS_LOG_FUNCTION(this);
 
-  if(conn->IsBroadcast()) m_broadcastConns.push_back(conn);
+  if(conn->IsBroadcast())
+  {
+    m_broadcastConnsPortIndex.Insert (conn->GetXgemPort(), m_broadcastConns.size());
+    m_broadcastConns.push_back(conn);
+  }
   else 
   {
     uint16_t onuId = m_device->GetOnuId();
@@ -200,12 +224,10 @@ XgponOnuConnManagerSpeed::FindDsConnByXgemPort (uint16_t port)
     return m_dsConns[index];
   } else
   {
-    int num = m_broadcastConns.size();
-    for(int i=0; i<num; i++)
-    {
-      if(m_broadcastConns[i]->GetXgemPort()==port) return m_broadcastConns[i];
-    }    
-    return m_nullConnReceiver;
+    //only the broadcast connections and the multicast groups joined by this ONU are found
+    uint32_t index = m_broadcastConnsPortIndex.Find (port);
+    if(index == XgponIdMap::NOT_FOUND) return m_nullConnReceiver;
+    return m_broadcastConns[index];
   }
 }
 
@@ -37,7 +37,7 @@ namespace ns3 {
  * onu-id: 10bits; xgem-port: 16bits; alloc-id: 14bits
  * Hence, for each ONU, the number of supported xgem-ports / t-conts must be less than 64 / 16 (should be enough for many scenarios).
  */
-class XgponOnuConnManagerSpeed : public XgponOnuConnManager
+class XgponOnuConnManagerSpeed final : public XgponOnuConnManager
 {
 public:
 
@@ -59,6 +59,16 @@ public:
    */
   virtual const Ptr<XgponTcontOnu>& GetTcontById (uint16_t allocId);
 
+  /**
+   * \brief whether any T-CONT of this ONU has data to be transmitted in upstream
+   */
+  virtual bool HasUpstreamData ( );
+
+  /**
+   * \brief append all T-CONTs of this ONU to tconts
+   */
+  virtual void GetAllTconts (std::vector< Ptr<XgponTcontOnu> >& tconts);
+
 
 
   /**
@@ -108,7 +118,8 @@ private:
   std::vector< Ptr<XgponConnectionSender> > m_usConns;                      //the downstream connections that belongs to this ONU
 
   std::vector< Ptr<XgponConnectionReceiver> > m_dsConns;                    //the downstream connections that belongs to this ONU
-  std::vector< Ptr<XgponConnectionReceiver> > m_broadcastConns;             //broadcast downstream connections
+  std::vector< Ptr<XgponConnectionReceiver> > m_broadcastConns;             //broadcast and multicast downstream connections received by this ONU
+  XgponIdMap m_broadcastConnsPortIndex;                                     //xgem-port -> index in m_broadcastConns; O(1)
 
 
   /* more variables may be needed */
@@ -58,5 +58,30 @@ XgponOnuConnManager::~XgponOnuConnManager ()
 
 
 
+void 
+XgponOnuConnManager::AddUsConnByXgemPort (const Ptr<XgponConnectionSender>& conn)
+{
+  uint16_t xgemPort = conn->GetXgemPort();
+  uint32_t index = m_usConnsPortIndex.Find (xgemPort);
+  if(index == XgponIdMap::NOT_FOUND)
+  {
+    m_usConnsPortIndex.Insert (xgemPort, m_usPortConns.size());
+    m_usPortConns.push_back (conn);
+  }
+  else m_usPortConns[index] = conn;
+}
+
+void 
+XgponOnuConnManager::AddUsClassificationRule (const XgponUsClassifier::Rule& rule, uint16_t xgemPort)
+{
+  NS_LOG_FUNCTION(this);
+
+  const Ptr<XgponConnectionSender>& conn = FindUsConnByXgemPort (xgemPort);
+  NS_ASSERT_MSG((conn!=0), "The upstream connection of one classification rule has not been added!!!");
+  m_usClassifier.AddRule (rule, conn);
+}
+
+
+
 }; // namespace ns3
 
@@ -28,6 +28,8 @@
 #include "xgpon-tcont-onu.h"
 #include "xgpon-connection-receiver.h"
 #include "xgpon-connection-sender.h"
+#include "xgpon-id-map.h"
+#include "xgpon-us-classifier.h"
 
 
 
@@ -60,6 +62,16 @@ public:
    */
   virtual const Ptr<XgponTcontOnu>& GetTcontById (uint16_t allocId)=0;
 
+  /**
+   * \brief whether any T-CONT of this ONU has data to be transmitted in upstream
+   */
+  virtual bool HasUpstreamData ( )=0;
+
+  /**
+   * \brief append all T-CONTs of this ONU to tconts
+   */
+  virtual void GetAllTconts (std::vector< Ptr<XgponTcontOnu> >& tconts)=0;
+
 
 
   /**
@@ -83,6 +95,24 @@ public:
    */
 	virtual const Ptr<XgponConnectionSender>& FindUsConnByTcontType (const uint16_t& type) = 0;
 
+  /**
+   * \brief find one upstream connection based on its xgem-port (inline function).  0: not found
+   */
+  const Ptr<XgponConnectionSender>& FindUsConnByXgemPort (uint16_t port) const;
+
+
+  /**
+   * \brief send the packets matching the rule through the upstream connection of the xgem-port, which should have been added.
+   *        Once one rule is added, the packets from upper layers are classified through these rules first; the packets
+   *        that match no rule are still mapped through their TOS.
+   */
+  void AddUsClassificationRule (const XgponUsClassifier::Rule& rule, uint16_t xgemPort);
+
+  /**
+   * \brief the upstream classification table of this ONU (inline function).
+   */
+  XgponUsClassifier& GetUsClassifier ();
+
 
 
 
@@ -116,13 +146,20 @@ protected:
 
   Ptr<XgponConnectionSender> m_usOmciConn;                 //the connection for upstream OMCI traffic.
 
+  //index the upstream connection by its xgem-port, so that FindUsConnByXgemPort can find it. Called by AddOneUsConn of subclasses.
+  void AddUsConnByXgemPort (const Ptr<XgponConnectionSender>& conn);
+
   //to return one null conn or tcont
   Ptr<XgponConnectionSender> m_nullConnSender;
   Ptr<XgponConnectionReceiver> m_nullConnReceiver;
   Ptr<XgponTcontOnu> m_nullTcont;
 
 
+private:
+  std::vector< Ptr<XgponConnectionSender> > m_usPortConns;  //the upstream connections in the order they are added
+  XgponIdMap m_usConnsPortIndex;                            //xgem-port -> index in m_usPortConns
 
+  XgponUsClassifier m_usClassifier;
 };
 
 
@@ -136,6 +173,20 @@ XgponOnuConnManager::FindUsOmciConn ()
   return m_usOmciConn;
 }
 
+inline const Ptr<XgponConnectionSender>& 
+XgponOnuConnManager::FindUsConnByXgemPort (uint16_t port) const
+{
+  uint32_t index = m_usConnsPortIndex.Find (port);
+  if(index == XgponIdMap::NOT_FOUND) return m_nullConnSender;
+  return m_usPortConns[index];
+}
+
+inline XgponUsClassifier& 
+XgponOnuConnManager::GetUsClassifier ()
+{
+  return m_usClassifier;
+}
+
 
 }; // namespace ns3
 
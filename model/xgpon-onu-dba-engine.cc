@@ -21,7 +21,9 @@
 #include "ns3/simulator.h"
 
 #include "xgpon-onu-dba-engine.h"
+#include "xgpon-profiler.h"
 #include "xgpon-onu-net-device.h"
+#include "xgpon-channel.h"
 
 
 
@@ -48,7 +50,7 @@ XgponOnuDbaEngine::GetInstanceTypeId (void) const
 
 
 
-XgponOnuDbaEngine::XgponOnuDbaEngine ()
+XgponOnuDbaEngine::XgponOnuDbaEngine () : m_lastNonZeroReportTime(0)
 {
 }
 XgponOnuDbaEngine::~XgponOnuDbaEngine ()
@@ -66,7 +68,10 @@ XgponOnuDbaEngine::GenerateStatusReport (uint16_t allocId)
 {
   NS_LOG_FUNCTION(this);
 
-  return ((m_device->GetConnManager())->GetTcontById(allocId))->PrepareBufOccupancyReport ( );
+  Ptr<XgponXgtcDbru> report = ((m_device->GetConnManager())->GetTcontById(allocId))->PrepareBufOccupancyReport ( );
+  if(report->GetBufOcc () > 0) m_lastNonZeroReportTime = Simulator::Now().GetNanoSeconds();
+
+  return report;
 }
 
 
@@ -78,47 +83,93 @@ void
 XgponOnuDbaEngine::ProcessBwMap (const Ptr<XgponXgtcBwmap>& bwmap)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (ONU_DBA_PROCESS_BWMAP);
   uint64_t nowNano = Simulator::Now().GetNanoSeconds();
 
   const Ptr<XgponOnuConnManager>& connManager = m_device->GetConnManager();
-  const Ptr<XgponPhy>& commonPhy = m_device->GetXgponPhy();
-  const Ptr<XgponLinkInfo>& linkInfo = (m_device->GetPloamEngine())->GetLinkInfo ();
+
+  //when the bursts are assembled in batches by the OLT, no event should be scheduled here.
+  const Ptr<XgponChannel> channel = DynamicCast<XgponChannel, Channel>(m_device->GetChannel());
+  bool batchBursts = (channel != 0 && channel->GetBatchUpstreamBursts());
 	 
   uint16_t bwMapSize=bwmap->GetNumberOfBwAllocation ( );
   for(int i=0; i<bwMapSize; i++)
   {
-    const Ptr<XgponXgtcBwAllocation>& bwAlloc=bwmap->GetBwAllocationByIndex(i);
-    uint32_t startTime = bwAlloc->GetStartTime();
-    uint16_t allocId = bwAlloc->GetAllocId();
+    const XgponXgtcBwAllocationFields& bwAlloc=bwmap->GetBwAllocationByIndex(i);
+    uint32_t startTime = bwAlloc.GetStartTime();
+    uint16_t allocId = bwAlloc.GetAllocId();
 
     const Ptr<XgponTcontOnu>& tcontOnu = connManager->GetTcontById(allocId);
     if(tcontOnu!=0)
     {
       tcontOnu->ReceiveBwAllocation (bwAlloc, nowNano);
 
-      if(startTime!=0xFFFF) //one upstream burst should be scheduled for this ONU now.
+      if(startTime!=0xFFFF && !batchBursts) //one upstream burst should be scheduled for this ONU now.
       {
-        NS_ASSERT_MSG((startTime<commonPhy->GetUsPhyFrameSizeInWord()), "StartTime is unreasonably large!!!");
+        uint64_t txTime = GetUsBurstTxDelay (bwAlloc);
+        Simulator::Schedule (NanoSeconds(txTime), &XgponOnuNetDevice::ProduceAndTransmitUsBurst, m_device, bwmap, i);
+      }
+    }
+  }
+}
 
-        uint16_t burstIndex = bwAlloc->GetBurstProfileIndex ();
-        const Ptr<XgponBurstProfile>& profile = linkInfo->GetProfileByIndex (burstIndex);
-        NS_ASSERT_MSG((profile!=0), "the corresponding burst profile cannot be found!!!");
 
-        //start_time doesn't consider preamble and delimiter, and its unit is word
-        uint64_t tmpLen = profile->GetPreambleLen () + profile->GetDelimiterLen ();
-        tmpLen = startTime * 4 - tmpLen; //starttime is the time of transmitting xgtcusheader
+void 
+XgponOnuDbaEngine::ProcessDeferredBwMap (const Ptr<XgponXgtcBwmap>& bwmap, uint64_t receiveTime)
+{
+  NS_LOG_FUNCTION(this);
+  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
 
-        uint64_t waitTime = 2*linkInfo->GetEqualizeDelay();  //different propagation delay.
-        uint64_t txTime = waitTime + (tmpLen * 1000000000L) / commonPhy->GetUsLinkRate();
-        NS_ASSERT_MSG((txTime<125000), "the scheduled txTime is unreasonably long!!!");
+  const Ptr<XgponOnuConnManager>& connManager = m_device->GetConnManager();
+	 
+  uint16_t bwMapSize=bwmap->GetNumberOfBwAllocation ( );
+  for(int i=0; i<bwMapSize; i++)
+  {
+    const XgponXgtcBwAllocationFields& bwAlloc=bwmap->GetBwAllocationByIndex(i);
+    const Ptr<XgponTcontOnu>& tcontOnu = connManager->GetTcontById(bwAlloc.GetAllocId());
+    if(tcontOnu!=0)
+    {
+      tcontOnu->ReceiveBwAllocation (bwAlloc, receiveTime);
 
-        Simulator::Schedule (NanoSeconds(txTime), &XgponOnuNetDevice::ProduceAndTransmitUsBurst, m_device, bwmap, i);
+      //the bursts transmitted before now only carried empty reports; the OLT needs nothing from them.
+      if(bwAlloc.GetStartTime()!=0xFFFF)
+      {
+        uint64_t txTime = receiveTime + GetUsBurstTxDelay (bwAlloc);
+        if(txTime >= nowNano)
+        {
+          Simulator::Schedule (NanoSeconds(txTime - nowNano), &XgponOnuNetDevice::ProduceAndTransmitUsBurst, m_device, bwmap, i);
+        }
       }
     }
   }
 }
 
 
+uint64_t
+XgponOnuDbaEngine::GetUsBurstTxDelay (const XgponXgtcBwAllocationFields& bwAlloc)
+{
+  const Ptr<XgponPhy>& commonPhy = m_device->GetXgponPhy();
+  const Ptr<XgponLinkInfo>& linkInfo = (m_device->GetPloamEngine())->GetLinkInfo ();
+
+  uint32_t startTime = bwAlloc.GetStartTime();
+  NS_ASSERT_MSG((startTime<commonPhy->GetUsPhyFrameSizeInWord()), "StartTime is unreasonably large!!!");
+
+  uint16_t burstIndex = bwAlloc.GetBurstProfileIndex ();
+  const Ptr<XgponBurstProfile>& profile = linkInfo->GetProfileByIndex (burstIndex);
+  NS_ASSERT_MSG((profile!=0), "the corresponding burst profile cannot be found!!!");
+
+  //start_time doesn't consider preamble and delimiter, and its unit is word
+  uint64_t tmpLen = profile->GetPreambleLen () + profile->GetDelimiterLen ();
+  tmpLen = startTime * 4 - tmpLen; //starttime is the time of transmitting xgtcusheader
+
+  uint64_t waitTime = 2*linkInfo->GetEqualizeDelay();  //different propagation delay.
+  uint64_t txTime = waitTime + (tmpLen * 1000000000L) / commonPhy->GetUsLinkRate();
+  NS_ASSERT_MSG(((txTime - waitTime)<125000), "the scheduled txTime is unreasonably long!!!");
+
+  return txTime;
+}
+
+
 
 
 
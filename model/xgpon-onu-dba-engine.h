@@ -63,6 +63,26 @@ public:
    */ 
   void ProcessBwMap (const Ptr<XgponXgtcBwmap>& bwmap);  
 
+  /**
+   * \brief the time between receiving the BWmap and transmitting the burst that starts with this allocation.
+   *        It considers the equalization delay of this ONU and the preamble/delimiter of the burst profile. Unit: nanosecond
+   * \param bwAlloc the first allocation of the burst (its StartTime should not be 0xFFFF)
+   */
+  uint64_t GetUsBurstTxDelay (const XgponXgtcBwAllocationFields& bwAlloc);
+
+  /**
+   * \brief process one BWmap that was not delivered to this ONU while it was dormant.
+   *        The allocations are recorded with their original receiving time and only the bursts that have not been due yet are scheduled.
+   * \param bwmap the BWmap sent to this ONU while it was dormant
+   * \param receiveTime the time that this ONU would have received the BWmap. Unit: nanosecond
+   */
+  void ProcessDeferredBwMap (const Ptr<XgponXgtcBwmap>& bwmap, uint64_t receiveTime);
+
+  /**
+   * \brief the last time that a non-zero buffer occupancy report was produced by this ONU. Unit: nanosecond
+   */
+  uint64_t GetLastNonZeroReportTime ( ) const;
+
 
 
   //////////////////////////////////////Functions required by NS-3
@@ -71,10 +91,20 @@ public:
 
 
 private:
-  /* more variables may be needed */
+  uint64_t m_lastNonZeroReportTime;     //used to decide whether the OLT has seen the latest non-zero report of this ONU.
 
 };
 
+
+
+
+///////////////////////////////////////////////INLINE Functions
+inline uint64_t 
+XgponOnuDbaEngine::GetLastNonZeroReportTime ( ) const
+{
+  return m_lastNonZeroReportTime;
+}
+
 }; // namespace ns3
 
 #endif // XGPON_ONU_DBA_ENGINE_H
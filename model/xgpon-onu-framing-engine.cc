@@ -22,7 +22,11 @@
 #include "ns3/simulator.h"
 
 #include "xgpon-onu-framing-engine.h"
+#include "xgpon-profiler.h"
 #include "xgpon-onu-net-device.h"
+#include "xgpon-onu-us-scheduler-round-robin.h"
+#include "xgpon-onu-conn-manager-speed.h"
+#include "xgpon-onu-conn-manager-flexible.h"
 
 
 
@@ -60,10 +64,18 @@ XgponOnuFramingEngine::~XgponOnuFramingEngine ()
 
 
 
+void
+XgponOnuFramingEngine::ParseXgtcDownstreamFrame (XgponXgtcDsFrame& frame)
+{
+  ParseXgtcDownstreamFrame<XgponOnuConnManager> (frame);
+}
+
+template <class ConnManager>
 void
 XgponOnuFramingEngine::ParseXgtcDownstreamFrame (XgponXgtcDsFrame& frame)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (ONU_FRAMING_PARSE_DS_FRAME);
 
   XgponXgtcDsHeader& xgtcDsHeader = frame.GetHeader();
 
@@ -84,26 +96,34 @@ XgponOnuFramingEngine::ParseXgtcDownstreamFrame (XgponXgtcDsFrame& frame)
   //broadcast traffics
   if(frame.GetNBroadcastXgemFrames() > 0)
   {
-    xgemEngine->ProcessXgemFramesFromLowerLayer(frame.GetBroadcastXgemFrames());
+    xgemEngine->ProcessXgemFramesFromLowerLayer<ConnManager> (frame.GetBroadcastXgemFrames());
   }
 
   //unicast traffics
   std::vector<uint8_t>& bitmap = frame.GetBitmap ();
   if(bitmap[m_device->GetOnuId()] != 0)
   {
-    xgemEngine->ProcessXgemFramesFromLowerLayer(frame.GetUnicastXgemFrames());
+    xgemEngine->ProcessXgemFramesFromLowerLayer<ConnManager> (frame.GetUnicastXgemFrames());
   }
 }
 
 
 
+void 
+XgponOnuFramingEngine::ProduceXgtcUsBurst (XgponXgtcUsBurst& usBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first)
+{
+  ProduceXgtcUsBurst<XgponOnuConnManager, XgponOnuUsScheduler> (usBurst, map, first);
+}
+
+template <class ConnManager, class UsScheduler>
 void 
 XgponOnuFramingEngine::ProduceXgtcUsBurst (XgponXgtcUsBurst& usBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (ONU_FRAMING_PRODUCE_US_BURST);
 
   const Ptr<XgponLinkInfo>& linkInfo = (m_device->GetPloamEngine())->GetLinkInfo ();
-  Ptr<XgponXgtcBwAllocation> bwAlloc = map->GetBwAllocationByIndex(first);
+  const XgponXgtcBwAllocationFields* bwAlloc = &(map->GetBwAllocationByIndex(first));
 
   //fill XgponXgtcUsHeader
   XgponXgtcUsHeader& xgtcHeader = usBurst.GetHeader();
@@ -140,11 +160,11 @@ XgponOnuFramingEngine::ProduceXgtcUsBurst (XgponXgtcUsBurst& usBurst, const Ptr<
       }
 
       //Generate XGEM Frames to be transmitted and put them into UsAllocation
-      xgemEngine->GenerateFramesToTransmit(allocation->GetXgemFrames(), allocSize*4, allocId);
+      xgemEngine->GenerateFramesToTransmit<ConnManager, UsScheduler> (allocation->GetXgemFrames(), allocSize*4, allocId);
     }
 
     i++;
-    if(i<num) { bwAlloc = map->GetBwAllocationByIndex(i); }
+    if(i<num) { bwAlloc = &(map->GetBwAllocationByIndex(i)); }
   } while(bwAlloc->GetStartTime()==0xFFFF && i<num);
 
 
@@ -154,4 +174,15 @@ XgponOnuFramingEngine::ProduceXgtcUsBurst (XgponXgtcUsBurst& usBurst, const Ptr<
 }
 
 
+
+//the combinations that XgponOnuNetDeviceStatic can be composed of
+template void XgponOnuFramingEngine::ParseXgtcDownstreamFrame<XgponOnuConnManagerSpeed> (XgponXgtcDsFrame& frame);
+template void XgponOnuFramingEngine::ParseXgtcDownstreamFrame<XgponOnuConnManagerFlexible> (XgponXgtcDsFrame& frame);
+
+template void XgponOnuFramingEngine::ProduceXgtcUsBurst<XgponOnuConnManagerSpeed, XgponOnuUsSchedulerRoundRobin> (XgponXgtcUsBurst& usBurst, 
+                                                                                                                  const Ptr<XgponXgtcBwmap>& map, uint16_t first);
+template void XgponOnuFramingEngine::ProduceXgtcUsBurst<XgponOnuConnManagerFlexible, XgponOnuUsSchedulerRoundRobin> (XgponXgtcUsBurst& usBurst, 
+                                                                                                                     const Ptr<XgponXgtcBwmap>& map, uint16_t first);
+
+
 }//namespace ns3
@@ -49,6 +49,12 @@ public:
    */
   void ParseXgtcDownstreamFrame (XgponXgtcDsFrame& frame);
 
+  /**
+   * \brief the same as above, with the connection manager of the device bound to ConnManager (its final class).
+   */
+  template <class ConnManager>
+  void ParseXgtcDownstreamFrame (XgponXgtcDsFrame& frame);
+
 
 
   /**
@@ -59,6 +65,13 @@ public:
    */
   void ProduceXgtcUsBurst (XgponXgtcUsBurst& usBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first);
 
+  /**
+   * \brief the same as above, with the connection manager and the upstream schedulers bound to ConnManager and UsScheduler.
+   *        Both templates are used by XgponOnuNetDeviceStatic; the supported combinations are instantiated in xgpon-onu-framing-engine.cc.
+   */
+  template <class ConnManager, class UsScheduler>
+  void ProduceXgtcUsBurst (XgponXgtcUsBurst& usBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first);
+
 
 
   ///////////////////////////////////////////////////////Required by NS-3
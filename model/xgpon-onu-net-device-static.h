@@ -0,0 +1,116 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_ONU_NET_DEVICE_STATIC_H
+#define XGPON_ONU_NET_DEVICE_STATIC_H
+
+#include "ns3/fatal-error.h"
+
+#include "xgpon-onu-net-device.h"
+
+
+
+namespace ns3{
+
+/**
+ * \ingroup xgpon
+ * \brief XgponOnuNetDevice whose connection manager and upstream schedulers (of all T-CONTs) are fixed at compile time.
+ *
+ * The engines are created by XgponHelper as for XgponOnuNetDevice, but they must be of the classes ConnManager and
+ * UsScheduler (both final). Downstream frames are parsed and upstream bursts are produced by the instantiations of
+ * XgponOnuFramingEngine for these classes, in which the connection lookups and the upstream scheduling are called
+ * directly instead of through virtual functions. The combinations supported are those instantiated in xgpon-onu-framing-engine.cc.
+ */
+template <class ConnManager, class UsScheduler>
+class XgponOnuNetDeviceStatic : public XgponOnuNetDevice
+{
+public:
+
+  /**
+   * \brief Constructor
+   */
+  XgponOnuNetDeviceStatic ( );
+  virtual ~XgponOnuNetDeviceStatic ( );
+
+
+protected:
+  virtual void DoInitialize (void);
+
+private:
+  virtual void DoParseXgtcDownstreamFrame (XgponXgtcDsFrame& xgtcDsFrame);
+  virtual void DoProduceXgtcUsBurst (XgponXgtcUsBurst& xgtcUsBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first);
+};
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////TEMPLATE FUNCTIONS
+
+template <class ConnManager, class UsScheduler>
+XgponOnuNetDeviceStatic<ConnManager, UsScheduler>::XgponOnuNetDeviceStatic () : XgponOnuNetDevice ()
+{
+}
+template <class ConnManager, class UsScheduler>
+XgponOnuNetDeviceStatic<ConnManager, UsScheduler>::~XgponOnuNetDeviceStatic ()
+{
+}
+
+template <class ConnManager, class UsScheduler>
+void
+XgponOnuNetDeviceStatic<ConnManager, UsScheduler>::DoInitialize (void)
+{
+  //the frames are parsed and produced through static_cast to these types; a mismatch must stop the simulation in optimized builds too.
+  //the T-CONTs are provisioned before the simulation starts, so all of them are known here.
+  if(DynamicCast<ConnManager> (GetConnManager ()) == 0) NS_FATAL_ERROR ("The connection manager is not the one that the device is composed of!!!");
+
+  std::vector< Ptr<XgponTcontOnu> > tconts;
+  GetConnManager ()->GetAllTconts (tconts);
+  for(uint32_t i=0; i<tconts.size(); i++)
+  {
+    if(DynamicCast<UsScheduler> (tconts[i]->GetOnuUsScheduler ()) == 0) 
+      NS_FATAL_ERROR ("The upstream scheduler of T-CONT " << tconts[i]->GetAllocId () << " is not the one that the device is composed of!!!");
+  }
+
+  XgponOnuNetDevice::DoInitialize ();
+}
+
+template <class ConnManager, class UsScheduler>
+void
+XgponOnuNetDeviceStatic<ConnManager, UsScheduler>::DoParseXgtcDownstreamFrame (XgponXgtcDsFrame& xgtcDsFrame)
+{
+  GetFramingEngine ()->ParseXgtcDownstreamFrame<ConnManager> (xgtcDsFrame);
+}
+
+template <class ConnManager, class UsScheduler>
+void
+XgponOnuNetDeviceStatic<ConnManager, UsScheduler>::DoProduceXgtcUsBurst (XgponXgtcUsBurst& xgtcUsBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first)
+{
+  GetFramingEngine ()->ProduceXgtcUsBurst<ConnManager, UsScheduler> (xgtcUsBurst, map, first);
+}
+
+
+
+}; //namespace ns3
+#endif /* XGPON_ONU_NET_DEVICE_STATIC_H */
@@ -24,9 +24,13 @@
 #include "ns3/traced-callback.h"
 
 #include "xgpon-onu-net-device.h"
+#include "xgpon-olt-net-device.h"
+#include "xgpon-profiler.h"
+#include "xgpon-latency-tag.h"
 #include "pon-channel.h"
 
 #include "xgpon-ds-frame.h"
+#include "xgpon-frame-arena.h"
 #include "xgpon-xgtc-ds-frame.h"
 
 
@@ -79,6 +83,7 @@ void
 XgponOnuNetDevice::ReceivePonFrameFromChannel (const Ptr<PonFrame>& frame)
 {
   NS_LOG_FUNCTION (this);
+  XGPON_PROFILE_SCOPE (ONU_EVENT_DS_FRAME);
 
   const Ptr<XgponDsFrame>& dsFrame = DynamicCast<XgponDsFrame, PonFrame>(frame);
   
@@ -87,7 +92,7 @@ XgponOnuNetDevice::ReceivePonFrameFromChannel (const Ptr<PonFrame>& frame)
 
 
   //Framing sublayer; It will call XGEM engine to process the XGEM frames.
-  m_onuFramingEngine->ParseXgtcDownstreamFrame(dsFrame->GetXgtcDsFrame ());
+  DoParseXgtcDownstreamFrame (dsFrame->GetXgtcDsFrame ());
 
 
   //tracesource callback for network device statistics
@@ -111,6 +116,14 @@ XgponOnuNetDevice::DoSend (const Ptr<Packet>& packet, const Address& dest, uint1
 
   Ipv4Header ipHeader;
   packet->PeekHeader(ipHeader);
+
+  XgponUsClassifier& classifier = m_onuConnManager->GetUsClassifier ();
+  if(!classifier.IsEmpty ())
+  {
+    const Ptr<XgponConnectionSender>& ruleConn = classifier.Classify (packet, ipHeader);
+    if(ruleConn != 0) return SendThroughUsConn (packet, ruleConn);
+    //no rule matches: fall back to the TOS-based mapping below.
+  }
   
   m_tcontType = ipHeader.GetTos(); //tcont type is derived from the TOS field of the header; if a suitable value is set (0 to 4), the appropriate tcont type is used, ja:update:ns-3.35
   NS_ASSERT_MSG(((m_tcontType <= 4) & (m_tcontType >= 0)), "A suitable TOS value (0-4) is not set for the traffic end points"); //ja:update:ns-3.35
@@ -119,10 +132,23 @@ XgponOnuNetDevice::DoSend (const Ptr<Packet>& packet, const Address& dest, uint1
   const Ptr<XgponConnectionSender>& conn=m_onuConnManager->FindUsConnByTcontType(m_tcontType); //changed from FindUsConnByAddress
   //std::cout << "now at ONU Net Device, allocID: " << conn->GetAllocId() << std::endl;
   
-  
+  return SendThroughUsConn (packet, conn);
+}
+
+bool 
+XgponOnuNetDevice::SendThroughUsConn (const Ptr<Packet>& packet, const Ptr<XgponConnectionSender>& conn)
+{
   if(conn==0) return false;
   else 
   {
+    if(IsDormant())
+    {
+      //the OLT may have stopped producing frames; the BWmaps of the skipped frames are deferred to this ONU first.
+      DynamicCast<XgponOltNetDevice, PonNetDevice>(m_channel->GetOlt ())->WakeUpDownstreamFrames ();
+      LeaveDormancy ();   //the bursts granted by the deferred BWmaps will report this packet
+    }
+    if(XgponLatencyTag::IsStampingEnabled ()) XgponLatencyTag::StampSendTime (packet);
+
     return conn->ReceiveUpperLayerSdu(packet);
   }
 }
@@ -144,6 +170,21 @@ XgponOnuNetDevice::ProduceAndTransmitUsBurst (const Ptr<XgponXgtcBwmap>& map, ui
 {
   NS_LOG_FUNCTION (this);
 
+  Ptr<XgponUsBurst> usBurst = ProduceUsBurst (map, first);
+
+  //send the burst out
+  m_channel->SendUpstream (usBurst, m_channelIndex);
+
+  //m_phyTxEndTrace(usBurst, Simulator::Now());
+}
+
+
+Ptr<XgponUsBurst>
+XgponOnuNetDevice::ProduceUsBurst (const Ptr<XgponXgtcBwmap>& map, uint16_t first)
+{
+  NS_LOG_FUNCTION (this);
+  XGPON_PROFILE_SCOPE (ONU_EVENT_US_BURST);
+
   //create the upstream burst to be processed by various engines
   Ptr<XgponUsBurst> usBurst = Create<XgponUsBurst> ();  
 
@@ -152,21 +193,85 @@ XgponOnuNetDevice::ProduceAndTransmitUsBurst (const Ptr<XgponXgtcBwmap>& map, ui
    *  Framing engine will call XGEM engine (for Service-Adaptation sub-layer) and DBA engine directly to fill the payloads.
    *  Although we can call Framing, XGEM engine, and upstream scheduler here, it might better to keep XgponOnuNetDevice short.
    */
-  m_onuFramingEngine->ProduceXgtcUsBurst(usBurst->GetXgtcUsBurst(), map, first);
+  XgponFrameArena* arena = XgponFrameArena::Open ();   //us-allocations and xgem frames live as long as this burst
+  DoProduceXgtcUsBurst (usBurst->GetXgtcUsBurst(), map, first);
+  XgponFrameArena::Close (arena);
 
   //Get the burst profile that should be used by this burst
-  const Ptr<XgponXgtcBwAllocation>& bwAlloc = map->GetBwAllocationByIndex (first);
-  NS_ASSERT_MSG((bwAlloc!=0), "Cannot find the XgponXgtcBwAllocation used to produce this burst!!!");
-  const Ptr<XgponBurstProfile>& profile = (m_onuPloamEngine->GetLinkInfo ())->GetProfileByIndex (bwAlloc->GetBurstProfileIndex());  
+  const XgponXgtcBwAllocationFields& bwAlloc = map->GetBwAllocationByIndex (first);
+  const Ptr<XgponBurstProfile>& profile = (m_onuPloamEngine->GetLinkInfo ())->GetProfileByIndex (bwAlloc.GetBurstProfileIndex());  
 
   //PHY and PHY_Adapdation sub-layer  
   m_onuPhyAdapter->ProcessXgtcBurstFromUpperLayer(usBurst, profile);
 
+  return usBurst;
+}
 
-  //send the burst out
-  m_channel->SendUpstream (usBurst, m_channelIndex);
 
-  //m_phyTxEndTrace(usBurst, Simulator::Now());
+void
+XgponOnuNetDevice::DoParseXgtcDownstreamFrame (XgponXgtcDsFrame& xgtcDsFrame)
+{
+  m_onuFramingEngine->ParseXgtcDownstreamFrame (xgtcDsFrame);
+}
+
+void
+XgponOnuNetDevice::DoProduceXgtcUsBurst (XgponXgtcUsBurst& xgtcUsBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first)
+{
+  m_onuFramingEngine->ProduceXgtcUsBurst (xgtcUsBurst, map, first);
+}
+
+
+
+
+
+void 
+XgponOnuNetDevice::EnterDormancy ( )
+{
+  NS_LOG_FUNCTION (this);
+  SetDormant (true);
+}
+
+void 
+XgponOnuNetDevice::LeaveDormancy ( )
+{
+  NS_LOG_FUNCTION (this);
+  SetDormant (false);
+
+  while(!m_deferredBwmaps.empty())
+  {
+    m_onuDbaEngine->ProcessDeferredBwMap (m_deferredBwmaps.front().first, m_deferredBwmaps.front().second);
+    m_deferredBwmaps.pop_front();
+  }
+}
+
+void 
+XgponOnuNetDevice::DeferBwMap (const Ptr<XgponXgtcBwmap>& bwmap, uint64_t receiveTime)
+{
+  uint64_t nowNano = Simulator::Now().GetNanoSeconds();
+
+  //all bursts of one BWmap are transmitted within two equalization delays plus one frame slot after it is received.
+  uint64_t window = m_commonPhy->GetDsFrameSlotSize() + 2 * m_onuPloamEngine->GetLinkInfo()->GetEqualizeDelay();
+  while(!m_deferredBwmaps.empty() && (m_deferredBwmaps.front().second + window) < nowNano)
+  {
+    m_deferredBwmaps.pop_front();
+  }
+
+  m_deferredBwmaps.push_back (std::make_pair(bwmap, receiveTime));
+}
+
+bool 
+XgponOnuNetDevice::IsUpstreamIdle ( )
+{
+  if(m_onuConnManager->HasUpstreamData()) return false;
+
+  const Ptr<XgponLinkInfo>& linkInfo = m_onuPloamEngine->GetLinkInfo ();
+  if(linkInfo->HasPloam2Transmit4ONU() || linkInfo->GetDyingGasp()) return false;
+
+  //the burst carrying the latest non-zero report must have arrived at the OLT.
+  uint64_t lastReportTime = m_onuDbaEngine->GetLastNonZeroReportTime ();
+  if(lastReportTime == 0) return true;
+  uint64_t arrivalTime = lastReportTime + m_channel->GetOnuPropagationDelay (m_channelIndex);
+  return arrivalTime < (uint64_t) Simulator::Now().GetNanoSeconds();
 }
 
 
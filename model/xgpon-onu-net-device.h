@@ -21,6 +21,8 @@
 #ifndef XGPON_ONU_NET_DEVICE_H
 #define XGPON_ONU_NET_DEVICE_H
 
+#include <deque>
+
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
 #include "ns3/address.h"
@@ -79,6 +81,42 @@ public:
    */
   void ProduceAndTransmitUsBurst (const Ptr<XgponXgtcBwmap>& map, uint16_t first);
 
+  /**
+   * \brief produce one upstream burst without sending it to the channel.
+   *        Used by ProduceAndTransmitUsBurst and by the OLT when the upstream bursts are assembled in batches.
+   * \param map the BWmap in which this burst is scheduled
+   * \param first the index of the first T-CONT (belonging to this burst) in the BWmap
+   * \return the burst that has been processed by the PHY adaptation sub-layer
+   */
+  Ptr<XgponUsBurst> ProduceUsBurst (const Ptr<XgponXgtcBwmap>& map, uint16_t first);
+
+
+
+
+  ////////////////////////////////////////////////////Dormancy (used by the idle fast-forward mode of the OLT)
+  /**
+   * \brief whether this ONU has nothing to send in upstream and its latest non-zero status report has reached the OLT.
+   */
+  bool IsUpstreamIdle ( );
+
+  /**
+   * \brief stop receiving downstream frames. The BWmaps granting this ONU are handed over through DeferBwMap.
+   */
+  void EnterDormancy ( );
+
+  /**
+   * \brief receive downstream frames again. The deferred BWmaps are processed and the bursts not yet due are scheduled.
+   *        Called when data arrives from upper layers or when the OLT sends something that this ONU must react to.
+   */
+  void LeaveDormancy ( );
+
+  /**
+   * \brief keep one BWmap that grants this ONU while it is dormant.
+   * \param bwmap the BWmap
+   * \param receiveTime the time that this ONU would have received the BWmap. Unit: nanosecond
+   */
+  void DeferBwMap (const Ptr<XgponXgtcBwmap>& bwmap, uint64_t receiveTime);
+
 
 
 
@@ -128,6 +166,14 @@ private:
   virtual bool DoSend (const Ptr<Packet>& packet, const Address& dest, uint16_t protocolNumber);    
   virtual bool DoSendFrom (const Ptr<Packet>& packet, const Address& source, const Address& dest, uint16_t protocolNumber);
 
+  //put the packet into the queue of the upstream connection chosen by DoSend. return false if no connection is found or the queue is full.
+  bool SendThroughUsConn (const Ptr<Packet>& packet, const Ptr<XgponConnectionSender>& conn);
+
+  //pass one downstream frame and one upstream burst through the framing engine.
+  //XgponOnuNetDeviceStatic overrides them to bind the engines at compile time.
+  virtual void DoParseXgtcDownstreamFrame (XgponXgtcDsFrame& xgtcDsFrame);
+  virtual void DoProduceXgtcUsBurst (XgponXgtcUsBurst& xgtcUsBurst, const Ptr<XgponXgtcBwmap>& map, uint16_t first);
+
 
 private:
   Ptr<XgponOnuConnManager> m_onuConnManager;
@@ -147,6 +193,8 @@ private:
   uint16_t m_onuId;             //The ID of this ONU
   uint16_t m_tcontType;         //static tcont type to be used, when the TCONT type is not calculate from upper layers (e.g. DSCP)
 
+  std::deque< std::pair< Ptr<XgponXgtcBwmap>, uint64_t > > m_deferredBwmaps;   //BWmaps (and receiving time) sent while this ONU is dormant
+
 
   TracedCallback<const Ptr<const Packet>&, Time > m_phyRxEndTrace;
   TracedCallback<const Ptr<const Packet>&, Time > m_phyTxEndTrace;
@@ -62,7 +62,7 @@ XgponOnuUsSchedulerRoundRobin::~XgponOnuUsSchedulerRoundRobin ()
 
 
 
-const Ptr<XgponConnectionSender>  
+uint32_t
 XgponOnuUsSchedulerRoundRobin::SelectConnToServe (uint32_t* amountToServe)
 {
   NS_LOG_FUNCTION(this);
@@ -71,11 +71,11 @@ XgponOnuUsSchedulerRoundRobin::SelectConnToServe (uint32_t* amountToServe)
   NS_ASSERT_MSG(((m_lastServedConnIndex >= 0) && (m_lastServedConnIndex < m_tcontOnu->GetConnNumber())), "The index of the last served connection is strange!!!");
 
 
-  const Ptr<XgponConnectionSender> lastConn = m_tcontOnu->GetConnByIndex(m_lastServedConnIndex);
+  const Ptr<XgponConnectionSender>& lastConn = m_tcontOnu->GetConnByIndex(m_lastServedConnIndex);
   if(lastConn->IsSegmentationRunning()) 
   { //segmentation is running for the last connection served in the last burst
     *amountToServe = lastConn->GetFragBufOccupancy4Scheduling() * 4; 
-    return lastConn;
+    return m_lastServedConnIndex;
   }
   else
   {//get one connection that has data to send
@@ -87,20 +87,20 @@ XgponOnuUsSchedulerRoundRobin::SelectConnToServe (uint32_t* amountToServe)
 
     do
     {
-      const Ptr<XgponConnectionSender> conn = m_tcontOnu->GetConnByIndex(m_lastServedConnIndex);
+      const Ptr<XgponConnectionSender>& conn = m_tcontOnu->GetConnByIndex(m_lastServedConnIndex);
       uint32_t dataInQueue = conn->GetBufOccupancy4Scheduling() * 4; 
       if(dataInQueue > 0)
       {
         if(dataInQueue < m_maxServiceSize)  *amountToServe = dataInQueue;
         else *amountToServe = m_maxServiceSize;
-        return conn;
+        return m_lastServedConnIndex;
       }      
       m_lastServedConnIndex++;
       if(m_lastServedConnIndex >= num) m_lastServedConnIndex = 0;
     } while(m_lastServedConnIndex != orgServedIndex);
   }
 
-  return m_nullConn;
+  return NO_CONN;
 }
 
 
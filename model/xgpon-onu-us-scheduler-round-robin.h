@@ -36,7 +36,7 @@ namespace ns3 {
  *        For upstream scheduling, a simple round-robin scheme is implemented. 
  *
  */
-class XgponOnuUsSchedulerRoundRobin : public XgponOnuUsScheduler
+class XgponOnuUsSchedulerRoundRobin final : public XgponOnuUsScheduler
 {
 
 public:
@@ -57,10 +57,10 @@ public:
    * \brief  Get the connection whose packets will be sent in this upstream burst. 
    *         It implements the scheduling for upstream connections that belong to the same T-CONT.
    *         Round-Robin is implemented in this class.
-   * \return the connection to be served. 0: all connections have no data to send.  (unit: byte)
-   * \param  amountToServe used to return the amount of data to be transmitted for this connection. 
+   * \return the index of the connection to be served in the T-CONT. NO_CONN: all connections have no data to send.
+   * \param  amountToServe used to return the amount of data to be transmitted for this connection. (unit: byte)
    */  
-  virtual const Ptr<XgponConnectionSender>  SelectConnToServe (uint32_t* amountToServe);
+  virtual uint32_t SelectConnToServe (uint32_t* amountToServe);
 
 
   
@@ -46,7 +46,7 @@ XgponOnuUsScheduler::GetInstanceTypeId (void) const
 
 
 
-XgponOnuUsScheduler::XgponOnuUsScheduler ():m_tcontOnu(0), m_nullConn(0)
+XgponOnuUsScheduler::XgponOnuUsScheduler ():m_tcontOnu(0)
 {
 }
 XgponOnuUsScheduler::~XgponOnuUsScheduler ()
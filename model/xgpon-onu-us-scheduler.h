@@ -44,6 +44,8 @@ class XgponOnuUsScheduler : public Object
 
 public:
 
+  const static uint32_t NO_CONN = 0xFFFFFFFF;   //returned by SelectConnToServe when no connection has data to send.
+
   /**
    * \brief Constructor
    */
@@ -56,10 +58,10 @@ public:
   /**
    * \brief  Get the connection whose packets will be sent in this upstream burst. 
    *         It implements the scheduling for upstream connections that belong to the same T-CONT.
-   * \return the connection to be served. 0: all connections have no data to send. (unit: byte)
-   * \param  amountToServe used to return the amount of data to be transmitted for this connection. must be 4-bytes aligned.
+   * \return the index of the connection to be served in the T-CONT (XgponTcontOnu::GetConnByIndex). NO_CONN: all connections have no data to send.
+   * \param  amountToServe used to return the amount of data to be transmitted for this connection. must be 4-bytes aligned. (unit: byte)
    */  
-  virtual const Ptr<XgponConnectionSender>  SelectConnToServe (uint32_t* amountToServe)=0;
+  virtual uint32_t SelectConnToServe (uint32_t* amountToServe)=0;
 
 
 
@@ -80,8 +82,6 @@ public:
 protected:
   Ptr<XgponTcontOnu> m_tcontOnu;
 
-  Ptr<XgponConnectionSender> m_nullConn;  //return a null conn
-
 
 };
 
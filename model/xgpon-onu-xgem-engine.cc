@@ -22,9 +22,13 @@
 #include "ns3/log.h"
 
 #include "xgpon-onu-xgem-engine.h"
+#include "xgpon-profiler.h"
 #include "xgpon-onu-net-device.h"
 
 #include "xgpon-onu-us-scheduler.h"
+#include "xgpon-onu-us-scheduler-round-robin.h"
+#include "xgpon-onu-conn-manager-speed.h"
+#include "xgpon-onu-conn-manager-flexible.h"
 #include "xgpon-xgem-routines.h"
 
 
@@ -63,16 +67,23 @@ XgponOnuXgemEngine::~XgponOnuXgemEngine ()
 void
 XgponOnuXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, uint32_t payloadLength, uint16_t allocId)
 {
-  NS_LOG_FUNCTION(this);
+  GenerateFramesToTransmit<XgponOnuConnManager, XgponOnuUsScheduler> (xgemFrames, payloadLength, allocId);
+}
 
-  Ptr<XgponConnectionSender> conn;
+template <class ConnManager, class UsScheduler>
+void
+XgponOnuXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, uint32_t payloadLength, uint16_t allocId)
+{
+  NS_LOG_FUNCTION(this);
 
-  const Ptr<XgponOnuConnManager>& connManager = m_device->GetConnManager ( ); 
-  const Ptr<XgponTcontOnu>& tcontOnu = connManager->GetTcontById (allocId);
+  ConnManager& connManager = static_cast<ConnManager&> (*(m_device->GetConnManager ( ))); 
+  const Ptr<XgponTcontOnu>& tcontOnu = connManager.GetTcontById (allocId);
     const uint16_t tcontOnuType = (uint16_t)tcontOnu->GetTcontType(); 
     NS_ASSERT_MSG((tcontOnuType!=0), "Invalid TCONT Type when sending data from ONU!!!");
-  const Ptr<XgponOnuUsScheduler>& scheduler = tcontOnu->GetOnuUsScheduler();
+  NS_ASSERT_MSG((DynamicCast<UsScheduler> (tcontOnu->GetOnuUsScheduler()) != 0), "The upstream scheduler of this T-CONT is not the one that the device is composed of!!!");
+  UsScheduler& scheduler = static_cast<UsScheduler&> (*(tcontOnu->GetOnuUsScheduler()));
   const Ptr<XgponLinkInfo>& linkInfo = (m_device->GetPloamEngine ( ))->GetLinkInfo();
+  const Ptr<XgponNetDevice> device = m_device;   //converted once, not for every XGEM frame
 
   uint32_t currentPayloadSize, availableSize;
   currentPayloadSize = 0;
@@ -92,8 +103,8 @@ XgponOnuXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >&
     else //SDUs (if exist) will be encapsulated.
     {
       uint32_t amountToServe;
-      conn = scheduler->SelectConnToServe (&amountToServe);
-      if(conn==0)  //this T-CONT has no data send. fill with idle XGEM frames
+      uint32_t connIndex = scheduler.SelectConnToServe (&amountToServe);
+      if(connIndex==XgponOnuUsScheduler::NO_CONN)  //this T-CONT has no data send. fill with idle XGEM frames
       {
         while(availableSize>0)
         {
@@ -117,6 +128,7 @@ XgponOnuXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >&
       }
       else
       {
+        const Ptr<XgponConnectionSender>& conn = tcontOnu->GetConnByIndex (connIndex);
         bool doSegmentation = false;
         if(amountToServe > (payloadLength - currentPayloadSize)) 
         {
@@ -129,7 +141,7 @@ XgponOnuXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >&
         Ptr<XgponXgemFrame> frame;
         do
         {
-          frame = XgponXgemRoutines::GenerateXgemFrame (m_device, conn, amountToServe, 
+          frame = XgponXgemRoutines::GenerateXgemFrame (device, conn, amountToServe, 
                                        linkInfo->GetCurrentUsKey(), linkInfo->GetCurrentUsKeyIndex(), doSegmentation);
           if(frame!=0)
           {
@@ -150,13 +162,21 @@ XgponOnuXgemEngine::GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >&
 
 
 
+void 
+XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFrame> >& frames)
+{
+  ProcessXgemFramesFromLowerLayer<XgponOnuConnManager> (frames);
+}
+
+template <class ConnManager>
 void 
 XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFrame> >& frames)
 {
   NS_LOG_FUNCTION(this);
+  XGPON_PROFILE_SCOPE (ONU_XGEM_PROCESS_FRAMES);
 
 
-  const Ptr<XgponOnuConnManager>& connManager = m_device->GetConnManager ( ); 
+  ConnManager& connManager = static_cast<ConnManager&> (*(m_device->GetConnManager ( ))); 
 
   //const Ptr<XgponTcontOnu>& tcontOnu = connManager->GetTcontById (allocId); 
   //NS_ASSERT_MSG((tcontOnu!=0), "Cannot find the corresponding T-CONT at OLT-side!!!");
@@ -176,7 +196,7 @@ XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFr
     {
       XgponXgemHeader& xgemHeader = (*it)->GetXgemHeader();
       uint16_t portId = xgemHeader.GetXgemPortId ();
-      const Ptr<XgponConnectionReceiver>& conn = connManager->FindDsConnByXgemPort(portId);
+      const Ptr<XgponConnectionReceiver>& conn = connManager.FindDsConnByXgemPort(portId);
 
       if(conn!=0)  //whether this XGEM frame is for this ONU
       {
@@ -207,4 +227,17 @@ XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer (std::vector<Ptr<XgponXgemFr
 
 
 
+//also called from XgponOnuFramingEngine, so the instantiations are explicit
+template void XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer<XgponOnuConnManager> (std::vector<Ptr<XgponXgemFrame> >& frames);
+template void XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer<XgponOnuConnManagerSpeed> (std::vector<Ptr<XgponXgemFrame> >& frames);
+template void XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer<XgponOnuConnManagerFlexible> (std::vector<Ptr<XgponXgemFrame> >& frames);
+
+template void XgponOnuXgemEngine::GenerateFramesToTransmit<XgponOnuConnManager, XgponOnuUsScheduler> (std::vector<Ptr<XgponXgemFrame> >& xgemFrames,
+                                                                                                       uint32_t payloadLength, uint16_t allocId);
+template void XgponOnuXgemEngine::GenerateFramesToTransmit<XgponOnuConnManagerSpeed, XgponOnuUsSchedulerRoundRobin> (std::vector<Ptr<XgponXgemFrame> >& xgemFrames,
+                                                                                                                      uint32_t payloadLength, uint16_t allocId);
+template void XgponOnuXgemEngine::GenerateFramesToTransmit<XgponOnuConnManagerFlexible, XgponOnuUsSchedulerRoundRobin> (std::vector<Ptr<XgponXgemFrame> >& xgemFrames,
+                                                                                                                         uint32_t payloadLength, uint16_t allocId);
+
+
 }//namespace ns3
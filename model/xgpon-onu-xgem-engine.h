@@ -50,6 +50,12 @@ public:
    */
   void ProcessXgemFramesFromLowerLayer(std::vector<Ptr<XgponXgemFrame> >& xgemFrames);
 
+  /**
+   * \brief the same as above, but the connection manager of the device is used as ConnManager (its final class).
+   */
+  template <class ConnManager>
+  void ProcessXgemFramesFromLowerLayer(std::vector<Ptr<XgponXgemFrame> >& xgemFrames);
+
 
   /**
    * \brief generate a list of XGEM Frames to be transmitted in upstream direction (payload of XgponXgtcUsAllocation).
@@ -59,6 +65,14 @@ public:
    */
   void GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, uint32_t payloadLength, uint16_t allocId);
 
+  /**
+   * \brief the same as above, but the connection manager of the device and the scheduler of the T-CONT are used as
+   *        ConnManager and UsScheduler (their final classes), so that they are called without virtual dispatch.
+   *        Both templates are instantiated in xgpon-onu-xgem-engine.cc for the engines of this module.
+   */
+  template <class ConnManager, class UsScheduler>
+  void GenerateFramesToTransmit(std::vector<Ptr<XgponXgemFrame> >& xgemFrames, uint32_t payloadLength, uint16_t allocId);
+
 
 
 
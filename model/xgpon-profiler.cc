@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "ns3/simulator.h"
+
+#include "xgpon-profiler.h"
+
+
+namespace ns3 {
+
+uint64_t XgponProfiler::m_calls[XgponProfiler::NUM_PROFILE_POINTS] = { 0 };
+uint64_t XgponProfiler::m_cycles[XgponProfiler::NUM_PROFILE_POINTS] = { 0 };
+
+bool XgponProfiler::m_started = false;
+double XgponProfiler::m_wallStartTime = 0;
+double XgponProfiler::m_simStartTime = 0;
+
+
+static const char* PROFILE_POINT_NAMES[XgponProfiler::NUM_PROFILE_POINTS] = 
+{
+  "event: OLT downstream frame",
+  "event: OLT upstream burst",
+  "event: ONU downstream frame",
+  "event: ONU upstream burst",
+  "XgponOltFramingEngine::ProduceXgtcDsFrame",
+  "XgponOltDbaEngine::GenerateBwMap",
+  "XgponOltXgemEngine::GenerateFramesToTransmit",
+  "XgponOltFramingEngine::ParseXgtcUpstreamBurst",
+  "XgponOltXgemEngine::ProcessXgemFramesFromLowerLayer",
+  "XgponOnuFramingEngine::ParseXgtcDownstreamFrame",
+  "XgponOnuDbaEngine::ProcessBwMap",
+  "XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer",
+  "XgponOnuFramingEngine::ProduceXgtcUsBurst",
+};
+
+
+static double
+GetWallClockTime ()
+{
+  return std::chrono::duration<double> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+
+
+void
+XgponProfiler::Start ()
+{
+  if(m_started) return;
+  m_started = true;
+
+  m_wallStartTime = GetWallClockTime ();
+  m_simStartTime = Simulator::Now ().GetSeconds ();
+  Simulator::ScheduleDestroy (&XgponProfiler::PrintSummaryAtDestroy);
+}
+
+
+const char*
+XgponProfiler::GetPointName (XgponProfilePoint point)
+{
+  return PROFILE_POINT_NAMES[point];
+}
+
+
+double
+XgponProfiler::GetRealTimeFactor ()
+{
+  if(!m_started) return 0;
+
+  double wall = GetWallClockTime () - m_wallStartTime;
+  if(wall <= 0) return 0;
+  return (Simulator::Now ().GetSeconds () - m_simStartTime) / wall;
+}
+
+
+void
+XgponProfiler::PrintSummary (std::ostream& os)
+{
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+
+  uint64_t eventCycles = 0;
+  for(int i=0; i<NUM_EVENT_POINTS; i++) eventCycles += m_cycles[i];
+
+  os << "XG-PON profiler: simulated " << (Simulator::Now ().GetSeconds () - m_simStartTime) << "s in " 
+     << (m_started ? GetWallClockTime () - m_wallStartTime : 0) << "s of wall-clock time (real-time factor: " << GetRealTimeFactor () << ")" << std::endl;
+  os << std::setw(55) << std::left << "point" << std::right << std::setw(14) << "calls" << std::setw(18) << "cycles" 
+     << std::setw(14) << "cycles/call" << std::setw(10) << "share(%)" << std::endl;
+
+  for(int i=0; i<NUM_PROFILE_POINTS; i++)
+  {
+    uint64_t avg = m_calls[i] > 0 ? m_cycles[i] / m_calls[i] : 0;
+    double share = eventCycles > 0 ? (100.0 * m_cycles[i]) / eventCycles : 0;
+    os << std::setw(55) << std::left << PROFILE_POINT_NAMES[i] << std::right << std::setw(14) << m_calls[i] << std::setw(18) << m_cycles[i] 
+       << std::setw(14) << avg << std::setw(10) << std::fixed << std::setprecision(2) << share << std::endl;
+    os.flags (flags);
+    os.precision (precision);
+  }
+}
+
+
+void
+XgponProfiler::Reset ()
+{
+  for(int i=0; i<NUM_PROFILE_POINTS; i++)
+  {
+    m_calls[i] = 0;
+    m_cycles[i] = 0;
+  }
+  m_wallStartTime = GetWallClockTime ();
+  m_simStartTime = Simulator::Now ().GetSeconds ();
+}
+
+
+void
+XgponProfiler::PrintSummaryAtDestroy ()
+{
+  PrintSummary (std::cout);
+  m_started = false;
+}
+
+
+
+}//namespace ns3
@@ -0,0 +1,186 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_PROFILER_H
+#define XGPON_PROFILER_H
+
+#include <ostream>
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief Counts the calls and the CPU cycles (time stamp counter) spent in the hot paths of the module.
+ *
+ * The probes (XGPON_PROFILE_SCOPE) are only compiled when XGPON_PROFILING is defined
+ * ("./waf configure --enable-xgpon-profiler"); otherwise they cost nothing.
+ * The cycles of one point include those of the points called inside it. The event points are the top-level
+ * handlers of the simulator events, so their sum is the time spent in the module.
+ * A summary, including the real-time factor (simulated seconds per wall-clock second), is printed at Simulator::Destroy.
+ */
+class XgponProfiler
+{
+public:
+  //the probes; the event points are listed first.
+  enum XgponProfilePoint
+  {
+    OLT_EVENT_DS_FRAME = 0,              //XgponOltNetDevice::SendDownstreamFrameToChannelPeriodically
+    OLT_EVENT_US_BURST,                  //XgponOltNetDevice::ReceiveUsBurst (one burst of a batch in batch mode)
+    ONU_EVENT_DS_FRAME,                  //XgponOnuNetDevice::ReceivePonFrameFromChannel
+    ONU_EVENT_US_BURST,                  //XgponOnuNetDevice::ProduceUsBurst (one burst of a batch in batch mode)
+    NUM_EVENT_POINTS,
+
+    OLT_FRAMING_PRODUCE_DS_FRAME = NUM_EVENT_POINTS,   //XgponOltFramingEngine::ProduceXgtcDsFrame
+    OLT_DBA_GENERATE_BWMAP,              //XgponOltDbaEngine::GenerateBwMap
+    OLT_XGEM_GENERATE_FRAMES,            //XgponOltXgemEngine::GenerateFramesToTransmit
+    OLT_FRAMING_PARSE_US_BURST,          //XgponOltFramingEngine::ParseXgtcUpstreamBurst
+    OLT_XGEM_PROCESS_FRAMES,             //XgponOltXgemEngine::ProcessXgemFramesFromLowerLayer (reassembly)
+    ONU_FRAMING_PARSE_DS_FRAME,          //XgponOnuFramingEngine::ParseXgtcDownstreamFrame
+    ONU_DBA_PROCESS_BWMAP,               //XgponOnuDbaEngine::ProcessBwMap
+    ONU_XGEM_PROCESS_FRAMES,             //XgponOnuXgemEngine::ProcessXgemFramesFromLowerLayer (reassembly)
+    ONU_FRAMING_PRODUCE_US_BURST,        //XgponOnuFramingEngine::ProduceXgtcUsBurst
+    NUM_PROFILE_POINTS
+  };
+
+
+  /**
+   * \brief remember the wall-clock and simulated time at which profiling starts and register the summary
+   *        to be printed at Simulator::Destroy. Only the first call has an effect.
+   */
+  static void Start ();
+
+  /**
+   * \brief add the cycles spent by one call of one point.
+   */
+  static void Record (XgponProfilePoint point, uint64_t cycles);
+
+  /**
+   * \brief read the time stamp counter (nanoseconds of a steady clock on other architectures).
+   */
+  static uint64_t ReadCycles ();
+
+
+  //queries at run time
+  static uint64_t GetCalls (XgponProfilePoint point);
+  static uint64_t GetCycles (XgponProfilePoint point);
+  static const char* GetPointName (XgponProfilePoint point);
+  static double GetRealTimeFactor ();
+
+  static void PrintSummary (std::ostream& os);
+  static void Reset ();
+
+
+private:
+  //registered through Simulator::ScheduleDestroy
+  static void PrintSummaryAtDestroy ();
+
+  static uint64_t m_calls[NUM_PROFILE_POINTS];
+  static uint64_t m_cycles[NUM_PROFILE_POINTS];
+
+  static bool m_started;
+  static double m_wallStartTime;         //unit: second
+  static double m_simStartTime;          //unit: second
+};
+
+
+/**
+ * \brief records the cycles between its construction and its destruction into one point of XgponProfiler.
+ */
+class XgponProfileScope
+{
+public:
+  XgponProfileScope (XgponProfiler::XgponProfilePoint point);
+  ~XgponProfileScope ();
+
+private:
+  XgponProfiler::XgponProfilePoint m_point;
+  uint64_t m_start;
+};
+
+
+
+#ifdef XGPON_PROFILING
+#define XGPON_PROFILE_SCOPE(point) XgponProfileScope xgponProfileScope (XgponProfiler::point)
+#define XGPON_PROFILE_START() XgponProfiler::Start ()
+#else
+#define XGPON_PROFILE_SCOPE(point)
+#define XGPON_PROFILE_START()
+#endif
+
+
+
+
+
+///////////////////////////////////////////////////////////////INLINE Functions
+inline uint64_t
+XgponProfiler::ReadCycles ()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc ();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#endif
+}
+
+inline void
+XgponProfiler::Record (XgponProfilePoint point, uint64_t cycles)
+{
+  m_calls[point]++;
+  m_cycles[point] += cycles;
+}
+
+inline uint64_t
+XgponProfiler::GetCalls (XgponProfilePoint point)
+{
+  return m_calls[point];
+}
+
+inline uint64_t
+XgponProfiler::GetCycles (XgponProfilePoint point)
+{
+  return m_cycles[point];
+}
+
+
+
+inline
+XgponProfileScope::XgponProfileScope (XgponProfiler::XgponProfilePoint point) : m_point(point), m_start(XgponProfiler::ReadCycles ())
+{
+}
+inline
+XgponProfileScope::~XgponProfileScope ()
+{
+  XgponProfiler::Record (m_point, XgponProfiler::ReadCycles () - m_start);
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_PROFILER_H
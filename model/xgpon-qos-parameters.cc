@@ -157,6 +157,15 @@ XgponQosParameters::DeepCopy(const Ptr<XgponQosParameters>& qosParameters)
   m_minInterval = qosParameters->GetMinInterval ();
 }
 
+bool
+XgponQosParameters::HasSameValues(const Ptr<XgponQosParameters>& qosParameters) const
+{
+  return m_tcontType == qosParameters->m_tcontType && m_fixedBw == qosParameters->m_fixedBw
+         && m_assuredBw == qosParameters->m_assuredBw && m_nonAssuredBw == qosParameters->m_nonAssuredBw
+         && m_bestEffortBw == qosParameters->m_bestEffortBw && m_totBwPerOnu == qosParameters->m_totBwPerOnu
+         && m_maxInterval == qosParameters->m_maxInterval && m_minInterval == qosParameters->m_minInterval;
+}
+
 
 
 }; // namespace ns3
@@ -67,6 +67,11 @@ public:
    */
   void DeepCopy(const Ptr<XgponQosParameters>& qosParameters);
 
+  /**
+   * \brief whether the qosParameters (the parameter) has the same values as itself. Used to share identical QoS parameters.
+   */
+  bool HasSameValues(const Ptr<XgponQosParameters>& qosParameters) const;
+
 
 
 
@@ -43,6 +43,7 @@
 #include "ns3/uinteger.h"
 
 #include "xgpon-queue.h"
+#include "xgpon-latency-tag.h"
 
 
 
@@ -75,6 +76,10 @@ XgponQueue::GetTypeId (void)
                    MakeUintegerAccessor (&XgponQueue::m_maxBytes),
                    MakeUintegerChecker<uint32_t> ())
 
+    .AddTraceSource ("QueueDelay", "The delay of one packet logged by the queue (alloc-id, size, enqueue time, dequeue time).",
+                     MakeTraceSourceAccessor (&XgponQueue::m_queueDelayTrace),
+                     "ns3::XgponQueue::QueueDelayTracedCallback")
+
     //ja:update:ns-3.35 removed AddTraceSource for now due to missing arguments
     //.AddTraceSource ("Enqueue", "Enqueue a packet in the queue.",
     //                 MakeTraceSourceAccessor (&XgponQueue::m_traceEnqueue))
@@ -120,6 +125,8 @@ XgponQueue::Enqueue (const Ptr<Packet>& p)
 {
   NS_LOG_FUNCTION (this << p);
 
+  if(XgponLatencyTag::IsStampingEnabled ()) XgponLatencyTag::StampEnqueueTime (p);
+
   bool retval = DoEnqueue (p);
   if (retval)
     {
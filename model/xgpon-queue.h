@@ -194,6 +194,11 @@ public:
   void SetAllocId(uint16_t id);
   uint16_t GetAllocId(void) const;
 
+  /**
+   * TracedCallback signature for the delay of one packet in the queue.
+   */
+  typedef void (* QueueDelayTracedCallback) (uint16_t allocId, uint32_t size, double enqueueTime, double dequeueTime);
+
   /////////////////////////////////////////////////Functions required by NS-3
   static TypeId GetTypeId (void);
   virtual TypeId GetInstanceTypeId (void) const;
@@ -231,6 +236,9 @@ protected:
   uint16_t m_popIndex;             
   uint16_t m_allocId;              // to store the alloc Id
 
+  //delay of each logged packet in this queue (alloc-id, size in byte, enqueue time, dequeue time; unit: second)
+  TracedCallback<uint16_t, uint32_t, double, double> m_queueDelayTrace;
+
   //its main function is to maintain the statistics when a packet is dropped and trigger the trace source related with drop event.
   //when DoEnqueue fails, XgponQueue::Drop is called by the subclass.
   void Drop (const Ptr<Packet>& packet); 
@@ -20,6 +20,7 @@
 #include "ns3/log.h"
 
 #include "xgpon-service-record.h"
+#include "xgpon-memory-census.h"
 
 
 
@@ -52,12 +53,14 @@ XgponServiceRecord::operator new(size_t size) noexcept(false) //throw(const char
     p = m_pool.top();
     m_pool.pop();  
     NS_LOG_INFO("allocated XgponServiceRecord through the pool!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::SERVICE_RECORD, size, XgponMemoryCensus::FROM_POOL);
   }
   else
   {
     p = malloc(size);
     if (!p) throw "cannot allocate more memory from the system!!!";
     NS_LOG_INFO("allocated XgponServiceRecord through malloc!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::SERVICE_RECORD, size, XgponMemoryCensus::FROM_MALLOC);
   }
   return p;
 }
@@ -70,6 +73,7 @@ XgponServiceRecord::operator delete(void *p)
     m_pool.push(p);
   }
   else free(p);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::SERVICE_RECORD, sizeof(XgponServiceRecord), m_pool.size());
 }
 
 void 
@@ -0,0 +1,191 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include "xgpon-statistics-sampler.h"
+#include "xgpon-onu-net-device.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponStatisticsSampler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (XgponStatisticsSampler);
+
+TypeId
+XgponStatisticsSampler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponStatisticsSampler")
+    .SetParent<Object> ()
+    .AddConstructor<XgponStatisticsSampler> ()
+    .AddAttribute ("Interval",
+                   "The interval between two samples of the device statistics. Its unit is nanosecond.",
+                   UintegerValue (XgponStatisticsSampler::DEFAULT_SAMPLING_INTERVAL),
+                   MakeUintegerAccessor (&XgponStatisticsSampler::m_interval),
+                   MakeUintegerChecker<uint64_t> (1))
+    .AddTraceSource ("Sample",
+                     "Deltas and rates of the statistics of one device during the last sampling interval",
+                     MakeTraceSourceAccessor (&XgponStatisticsSampler::m_sampleTrace),
+                     "ns3::XgponStatisticsSampler::SampleTracedCallback")
+  ;
+  return tid;
+}
+TypeId
+XgponStatisticsSampler::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+XgponStatisticsSampler::XgponStatisticsSampler ()
+  : m_interval(DEFAULT_SAMPLING_INTERVAL), m_devices(0), m_snapshots(0), m_onuIds(0), m_isOlt(0), m_lastSampleTime(0)
+{
+}
+XgponStatisticsSampler::~XgponStatisticsSampler ()
+{
+}
+
+void
+XgponStatisticsSampler::DoDispose (void)
+{
+  Simulator::Cancel (m_sampleEvent);
+  m_devices.clear ();
+  m_snapshots.clear ();
+  Object::DoDispose ();
+}
+
+
+
+
+void
+XgponStatisticsSampler::AddDevice (const Ptr<XgponNetDevice>& device)
+{
+  NS_LOG_FUNCTION(this);
+
+  Ptr<XgponOnuNetDevice> onuDevice = DynamicCast<XgponOnuNetDevice, XgponNetDevice> (device);
+
+  m_devices.push_back (device);
+  m_snapshots.push_back (device->GetStatistics ());
+  m_onuIds.push_back (onuDevice != 0 ? onuDevice->GetOnuId () : 0);
+  m_isOlt.push_back (onuDevice == 0);
+}
+
+
+void
+XgponStatisticsSampler::Start ()
+{
+  NS_LOG_FUNCTION(this);
+
+  Simulator::Cancel (m_sampleEvent);
+
+  m_lastSampleTime = Simulator::Now().GetNanoSeconds();
+  for(uint32_t i=0; i<m_devices.size(); i++) { m_snapshots[i] = m_devices[i]->GetStatistics (); }
+
+  m_sampleEvent = Simulator::Schedule (NanoSeconds(m_interval), &XgponStatisticsSampler::Sample, this);
+}
+
+void
+XgponStatisticsSampler::Stop ()
+{
+  NS_LOG_FUNCTION(this);
+  Simulator::Cancel (m_sampleEvent);
+}
+
+
+
+
+void
+XgponStatisticsSampler::Sample ()
+{
+  NS_LOG_FUNCTION(this);
+
+  uint64_t now = Simulator::Now().GetNanoSeconds();
+  uint64_t interval = now - m_lastSampleTime;
+
+  if(interval > 0)
+  {
+    double seconds = interval / 1000000000.0;
+
+    for(uint32_t i=0; i<m_devices.size(); i++)
+    {
+      const XgponNetDeviceStatistics& current = m_devices[i]->GetStatistics ();
+
+      m_sample.m_time = now;
+      m_sample.m_interval = interval;
+      m_sample.m_deviceIndex = i;
+      m_sample.m_isOlt = m_isOlt[i];
+      m_sample.m_onuId = m_onuIds[i];
+
+      ProduceSample (m_sample, current, m_snapshots[i], seconds);
+      m_sampleTrace (m_sample);
+
+      m_snapshots[i] = current;
+    }
+  }
+
+  m_lastSampleTime = now;
+  m_sampleEvent = Simulator::Schedule (NanoSeconds(m_interval), &XgponStatisticsSampler::Sample, this);
+}
+
+
+void
+XgponStatisticsSampler::ProduceSample (XgponStatisticsSample& sample, const XgponNetDeviceStatistics& current, const XgponNetDeviceStatistics& last, double seconds)
+{
+  sample.m_rxBytes = current.m_dsOnuBytes - last.m_dsOnuBytes;
+  sample.m_rxRate = sample.m_rxBytes * 8 / seconds;
+
+  sample.m_txBytes = current.m_rxFromUpperLayerBytes - last.m_rxFromUpperLayerBytes;
+  sample.m_txRate = sample.m_txBytes * 8 / seconds;
+
+  sample.m_dropBytes = current.m_overallQueueDropBytes - last.m_overallQueueDropBytes;
+  sample.m_dropRate = sample.m_dropBytes * 8 / seconds;
+
+  for(uint16_t t=0; t<XgponNetDeviceStatistics::NUM_TCONT_TYPES; t++)
+  {
+    sample.m_rxTcontTypeBytes[t] = current.m_rxTcontTypeBytes[t] - last.m_rxTcontTypeBytes[t];
+    sample.m_rxTcontTypeRate[t] = sample.m_rxTcontTypeBytes[t] * 8 / seconds;
+  }
+
+  //per-ONU counters only exist at the OLT; ONUs that appeared after the last snapshot start from zero.
+  uint32_t num = current.m_perOnu.size();
+  sample.m_perOnu.resize (num);
+  for(uint32_t i=0; i<num; i++)
+  {
+    const XgponPerOnuStatistics& cur = current.m_perOnu[i];
+    XgponPerOnuRate& rate = sample.m_perOnu[i];
+
+    uint64_t lastBytes = (i < last.m_perOnu.size()) ? last.m_perOnu[i].m_usBytes : 0;
+    rate.m_usBytes = cur.m_usBytes - lastBytes;
+    rate.m_usRate = rate.m_usBytes * 8 / seconds;
+
+    for(uint16_t t=0; t<XgponNetDeviceStatistics::NUM_TCONT_TYPES; t++)
+    {
+      uint64_t lastTcontBytes = (i < last.m_perOnu.size()) ? last.m_perOnu[i].m_usTcontBytes[t] : 0;
+      rate.m_usTcontBytes[t] = cur.m_usTcontBytes[t] - lastTcontBytes;
+      rate.m_usTcontRate[t] = rate.m_usTcontBytes[t] * 8 / seconds;
+    }
+  }
+}
+
+
+}; // namespace ns3
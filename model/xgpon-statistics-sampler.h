@@ -0,0 +1,151 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_STATISTICS_SAMPLER_H
+#define XGPON_STATISTICS_SAMPLER_H
+
+#include <vector>
+
+#include "ns3/object.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+
+#include "xgpon-net-device.h"
+
+
+namespace ns3 {
+
+/**
+ * \brief the rates that the OLT observed for one ONU during one sampling interval.
+ */
+class XgponPerOnuRate
+{
+public:
+  uint64_t m_usBytes;                                                        //bytes received from this ONU in this interval
+  double m_usRate;                                                           //unit: bps
+  uint64_t m_usTcontBytes[XgponNetDeviceStatistics::NUM_TCONT_TYPES];        //bytes per T-CONT type (T1...T4) in this interval
+  double m_usTcontRate[XgponNetDeviceStatistics::NUM_TCONT_TYPES];           //unit: bps, per T-CONT type (T1...T4)
+};
+
+/**
+ * \brief what one device did during one sampling interval (deltas and rates of XgponNetDeviceStatistics).
+ */
+class XgponStatisticsSample
+{
+public:
+  uint64_t m_time;                 //the end of the interval. unit: nanosecond
+  uint64_t m_interval;             //the length of the interval. unit: nanosecond
+
+  uint32_t m_deviceIndex;          //the order in which the device was added to the sampler
+  bool m_isOlt;
+  uint16_t m_onuId;                //only meaningful for ONUs
+
+  uint64_t m_rxBytes;              //bytes passed to upper layers
+  double m_rxRate;                 //unit: bps
+  uint64_t m_txBytes;              //bytes accepted from upper layers
+  double m_txRate;                 //unit: bps
+  uint64_t m_dropBytes;            //bytes dropped by the queues
+  double m_dropRate;               //unit: bps
+
+  uint64_t m_rxTcontTypeBytes[XgponNetDeviceStatistics::NUM_TCONT_TYPES]; //bytes passed to upper layers per T-CONT type (T1...T4)
+  double m_rxTcontTypeRate[XgponNetDeviceStatistics::NUM_TCONT_TYPES];    //unit: bps, per T-CONT type (T1...T4)
+
+  std::vector<XgponPerOnuRate> m_perOnu;      //indexed by onu-id. Only filled for the OLT.
+};
+
+
+
+
+/**
+ * \ingroup xgpon
+ * \brief Periodically snapshots the statistics of a set of XgponNetDevices and pushes deltas and rates to a sink.
+ *
+ * Unlike the per-frame "DeviceStatistics" trace source of the devices, the cost of this class only depends on
+ * the sampling interval. The samples are reported through the "Sample" trace source, one call per device per interval.
+ */
+class XgponStatisticsSampler : public Object
+{
+  const static uint64_t DEFAULT_SAMPLING_INTERVAL = 100000000;   //unit: nanosecond; 100ms
+
+public:
+
+  /**
+   * \brief Constructor
+   */
+  XgponStatisticsSampler ();
+  virtual ~XgponStatisticsSampler ();
+
+
+  /**
+   * \brief add one device to be sampled. Devices are reported in the order they are added.
+   */
+  void AddDevice (const Ptr<XgponNetDevice>& device);
+
+  /**
+   * \brief start sampling: the first sample is reported one interval after this call.
+   */
+  void Start ();
+  void Stop ();
+
+
+  /**
+   * \brief take a snapshot now and report deltas since the previous one (called periodically).
+   */
+  void Sample ();
+
+  /**
+   * TracedCallback signature for the sample of one device.
+   */
+  typedef void (* SampleTracedCallback) (const XgponStatisticsSample& sample);
+
+
+  ///////////////////////////////////////////Functions required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+
+protected:
+  virtual void DoDispose (void);
+
+
+private:
+  //fill one sample from the current counters of one device and the snapshot taken at the previous sample
+  void ProduceSample (XgponStatisticsSample& sample, const XgponNetDeviceStatistics& current, const XgponNetDeviceStatistics& last, double seconds);
+
+
+  uint64_t m_interval;                                      //sampling interval. unit: nanosecond
+
+  std::vector< Ptr<XgponNetDevice> > m_devices;             //the devices to be sampled
+  std::vector<XgponNetDeviceStatistics> m_snapshots;        //counters of each device at the previous sample
+  std::vector<uint16_t> m_onuIds;
+  std::vector<bool> m_isOlt;
+  uint64_t m_lastSampleTime;                                //unit: nanosecond
+
+  EventId m_sampleEvent;
+
+  XgponStatisticsSample m_sample;                           //reused across samples to avoid re-allocation
+
+  TracedCallback<const XgponStatisticsSample& > m_sampleTrace;
+};
+
+
+}; // namespace ns3
+
+#endif // XGPON_STATISTICS_SAMPLER_H
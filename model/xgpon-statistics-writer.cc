@@ -0,0 +1,427 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#include <cstring>
+#include <fstream>
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+
+#include "xgpon-statistics-writer.h"
+#include "xgpon-channel.h"
+
+
+NS_LOG_COMPONENT_DEFINE ("XgponStatisticsWriter");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (XgponStatisticsWriter);
+
+TypeId
+XgponStatisticsWriter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::XgponStatisticsWriter")
+    .SetParent<Object> ()
+    .AddConstructor<XgponStatisticsWriter> ()
+    .AddAttribute ("FilePrefix",
+                   "The prefix of the binary files (<prefix>-stats.bin and <prefix>-qdelay.bin).",
+                   StringValue ("xgpon"),
+                   MakeStringAccessor (&XgponStatisticsWriter::m_filePrefix),
+                   MakeStringChecker ())
+    .AddAttribute ("RowsPerBlock",
+                   "The number of rows buffered for one table before they are handed to the writer thread.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&XgponStatisticsWriter::m_rowsPerBlock),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("CsvExport",
+                   "Whether the binary files are also exported into CSV files (<prefix>-stats.csv, <prefix>-qdelay.csv) at Close.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&XgponStatisticsWriter::m_csvExport),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+TypeId
+XgponStatisticsWriter::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+
+XgponStatisticsWriter::XgponStatisticsWriter ()
+  : m_filePrefix("xgpon"), m_rowsPerBlock(4096), m_csvExport(false),
+    m_opened(false), m_stopWriter(false)
+{
+  for(int i=0; i<XGPON_STATS_TABLE_NUMBER; i++) { m_files[i] = 0; }
+}
+XgponStatisticsWriter::~XgponStatisticsWriter ()
+{
+  Close ();
+}
+
+void
+XgponStatisticsWriter::DoDispose (void)
+{
+  Close ();
+  Object::DoDispose ();
+}
+
+
+
+
+std::string
+XgponStatisticsWriter::GetFileName (XgponStatisticsTable table, const std::string& suffix) const
+{
+  if(table == XGPON_STATS_TABLE_DEVICE) return m_filePrefix + "-stats." + suffix;
+  else return m_filePrefix + "-qdelay." + suffix;
+}
+
+
+void
+XgponStatisticsWriter::Open ()
+{
+  NS_LOG_FUNCTION(this);
+  NS_ASSERT_MSG((!m_opened), "The statistics writer has been opened!!!");
+
+  for(int i=0; i<XGPON_STATS_TABLE_NUMBER; i++)
+  {
+    std::string name = GetFileName ((XgponStatisticsTable) i, "bin");
+    m_files[i] = fopen (name.c_str(), "wb");
+    NS_ASSERT_MSG((m_files[i] != 0), "Cannot create the statistics file " << name);
+
+    uint32_t header[3] = { FILE_MAGIC, FORMAT_VERSION, (uint32_t) i };
+    fwrite (header, sizeof(uint32_t), 3, m_files[i]);
+  }
+
+  m_stopWriter = false;
+  m_opened = true;
+  m_writerThread = std::thread (&XgponStatisticsWriter::WriterThreadLoop, this);
+}
+
+
+void
+XgponStatisticsWriter::Close ()
+{
+  if(!m_opened) return;
+
+  NS_LOG_FUNCTION(this);
+
+  FlushDeviceBlock ();
+  FlushQueueDelayBlock ();
+
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_stopWriter = true;
+  }
+  m_condition.notify_one ();
+  m_writerThread.join ();
+
+  for(int i=0; i<XGPON_STATS_TABLE_NUMBER; i++)
+  {
+    fclose (m_files[i]);
+    m_files[i] = 0;
+  }
+  m_opened = false;
+
+  if(m_csvExport)
+  {
+    for(int i=0; i<XGPON_STATS_TABLE_NUMBER; i++)
+    {
+      ExportCsv (GetFileName ((XgponStatisticsTable) i, "bin"), GetFileName ((XgponStatisticsTable) i, "csv"));
+    }
+  }
+}
+
+
+
+
+void
+XgponStatisticsWriter::AttachSampler (const Ptr<XgponStatisticsSampler>& sampler)
+{
+  sampler->TraceConnectWithoutContext ("Sample", MakeCallback (&XgponStatisticsWriter::RecordSample, this));
+}
+
+void
+XgponStatisticsWriter::AttachQueue (const Ptr<XgponQueue>& queue)
+{
+  queue->TraceConnectWithoutContext ("QueueDelay", MakeCallback (&XgponStatisticsWriter::RecordQueueDelay, this));
+}
+
+
+
+
+void
+XgponStatisticsWriter::RecordSample (const XgponStatisticsSample& sample)
+{
+  if(!m_opened) return;
+
+  uint16_t onu = sample.m_isOlt ? XgponChannel::MAXIMAL_NODES_PER_XGPON : sample.m_onuId;
+
+  //one row for the whole device and (if non-zero) one row per T-CONT type
+  m_deviceBlock.AddRow (sample.m_time, sample.m_deviceIndex, onu, 0, sample.m_rxBytes, sample.m_txBytes, sample.m_dropBytes);
+  for(uint16_t t=0; t<XgponNetDeviceStatistics::NUM_TCONT_TYPES; t++)
+  {
+    if(sample.m_rxTcontTypeBytes[t] > 0)
+    {
+      m_deviceBlock.AddRow (sample.m_time, sample.m_deviceIndex, onu, t + 1, sample.m_rxTcontTypeBytes[t], 0, 0);
+    }
+  }
+
+  //upstream traffic per ONU observed at the OLT
+  for(uint16_t i=0; i<sample.m_perOnu.size(); i++)
+  {
+    const XgponPerOnuRate& onuRate = sample.m_perOnu[i];
+    if(onuRate.m_usBytes == 0) continue;
+
+    m_deviceBlock.AddRow (sample.m_time, sample.m_deviceIndex, i, 0, onuRate.m_usBytes, 0, 0);
+    for(uint16_t t=0; t<XgponNetDeviceStatistics::NUM_TCONT_TYPES; t++)
+    {
+      if(onuRate.m_usTcontBytes[t] > 0)
+      {
+        m_deviceBlock.AddRow (sample.m_time, sample.m_deviceIndex, i, t + 1, onuRate.m_usTcontBytes[t], 0, 0);
+      }
+    }
+  }
+
+  if(m_deviceBlock.m_time.size() >= m_rowsPerBlock) FlushDeviceBlock ();
+}
+
+void
+XgponStatisticsWriter::RecordQueueDelay (uint16_t allocId, uint32_t size, double enqueueTime, double dequeueTime)
+{
+  if(!m_opened) return;
+
+  m_queueDelayBlock.m_allocId.push_back (allocId);
+  m_queueDelayBlock.m_size.push_back (size);
+  m_queueDelayBlock.m_enqueueTime.push_back (enqueueTime);
+  m_queueDelayBlock.m_dequeueTime.push_back (dequeueTime);
+
+  if(m_queueDelayBlock.m_allocId.size() >= m_rowsPerBlock) FlushQueueDelayBlock ();
+}
+
+
+
+
+//append the content of one column to the buffer
+template <typename T>
+static void
+AppendColumn (std::vector<char>& buffer, const std::vector<T>& column)
+{
+  size_t offset = buffer.size();
+  buffer.resize (offset + column.size() * sizeof(T));
+  if(!column.empty()) memcpy (&buffer[offset], &column[0], column.size() * sizeof(T));
+}
+
+static void
+AppendBlockHeader (std::vector<char>& buffer, uint32_t magic, uint32_t rows)
+{
+  buffer.resize (2 * sizeof(uint32_t));
+  memcpy (&buffer[0], &magic, sizeof(uint32_t));
+  memcpy (&buffer[sizeof(uint32_t)], &rows, sizeof(uint32_t));
+}
+
+
+void
+XgponStatisticsWriter::FlushDeviceBlock ()
+{
+  uint32_t rows = m_deviceBlock.m_time.size();
+  if(rows == 0) return;
+
+  std::vector<char> buffer;
+  buffer.reserve (2 * sizeof(uint32_t) + rows * (8 + 4 + 2 + 1 + 8 * 3));
+  AppendBlockHeader (buffer, BLOCK_MAGIC, rows);
+  AppendColumn (buffer, m_deviceBlock.m_time);
+  AppendColumn (buffer, m_deviceBlock.m_device);
+  AppendColumn (buffer, m_deviceBlock.m_onu);
+  AppendColumn (buffer, m_deviceBlock.m_tcontType);
+  AppendColumn (buffer, m_deviceBlock.m_rxBytes);
+  AppendColumn (buffer, m_deviceBlock.m_txBytes);
+  AppendColumn (buffer, m_deviceBlock.m_dropBytes);
+
+  m_deviceBlock.Clear ();
+  SubmitBuffer (XGPON_STATS_TABLE_DEVICE, buffer);
+}
+
+void
+XgponStatisticsWriter::FlushQueueDelayBlock ()
+{
+  uint32_t rows = m_queueDelayBlock.m_allocId.size();
+  if(rows == 0) return;
+
+  std::vector<char> buffer;
+  buffer.reserve (2 * sizeof(uint32_t) + rows * (2 + 4 + 8 * 2));
+  AppendBlockHeader (buffer, BLOCK_MAGIC, rows);
+  AppendColumn (buffer, m_queueDelayBlock.m_allocId);
+  AppendColumn (buffer, m_queueDelayBlock.m_size);
+  AppendColumn (buffer, m_queueDelayBlock.m_enqueueTime);
+  AppendColumn (buffer, m_queueDelayBlock.m_dequeueTime);
+
+  m_queueDelayBlock.Clear ();
+  SubmitBuffer (XGPON_STATS_TABLE_QUEUE_DELAY, buffer);
+}
+
+void
+XgponStatisticsWriter::SubmitBuffer (XgponStatisticsTable table, std::vector<char>& buffer)
+{
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_pendingBuffers.push_back (std::make_pair (table, std::vector<char> ()));
+    m_pendingBuffers.back().second.swap (buffer);
+  }
+  m_condition.notify_one ();
+}
+
+
+void
+XgponStatisticsWriter::WriterThreadLoop ()
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+  {
+    m_condition.wait (lock, [this] { return m_stopWriter || !m_pendingBuffers.empty(); });
+
+    while (!m_pendingBuffers.empty())
+    {
+      std::pair<XgponStatisticsTable, std::vector<char> > item;
+      item.first = m_pendingBuffers.front().first;
+      item.second.swap (m_pendingBuffers.front().second);
+      m_pendingBuffers.pop_front ();
+
+      //file I/O is done without holding the lock
+      lock.unlock ();
+      fwrite (&item.second[0], 1, item.second.size(), m_files[item.first]);
+      lock.lock ();
+    }
+
+    if(m_stopWriter) break;
+  }
+}
+
+
+
+
+void
+XgponStatisticsWriter::DeviceBlock::AddRow (uint64_t time, uint32_t device, uint16_t onu, uint8_t tcontType, uint64_t rx, uint64_t tx, uint64_t drop)
+{
+  m_time.push_back (time);
+  m_device.push_back (device);
+  m_onu.push_back (onu);
+  m_tcontType.push_back (tcontType);
+  m_rxBytes.push_back (rx);
+  m_txBytes.push_back (tx);
+  m_dropBytes.push_back (drop);
+}
+
+void
+XgponStatisticsWriter::DeviceBlock::Clear ()
+{
+  m_time.clear ();
+  m_device.clear ();
+  m_onu.clear ();
+  m_tcontType.clear ();
+  m_rxBytes.clear ();
+  m_txBytes.clear ();
+  m_dropBytes.clear ();
+}
+
+void
+XgponStatisticsWriter::QueueDelayBlock::Clear ()
+{
+  m_allocId.clear ();
+  m_size.clear ();
+  m_enqueueTime.clear ();
+  m_dequeueTime.clear ();
+}
+
+
+
+
+//read one column of one block from the binary file
+template <typename T>
+static bool
+ReadColumn (std::ifstream& in, std::vector<T>& column, uint32_t rows)
+{
+  column.resize (rows);
+  if(rows == 0) return true;
+  in.read ((char*) &column[0], rows * sizeof(T));
+  return in.good ();
+}
+
+
+bool
+XgponStatisticsWriter::ExportCsv (const std::string& binFileName, const std::string& csvFileName)
+{
+  std::ifstream in (binFileName.c_str(), std::ios::binary);
+  if(!in.is_open()) return false;
+
+  uint32_t header[3];
+  in.read ((char*) header, sizeof(header));
+  if(!in.good() || header[0] != FILE_MAGIC || header[1] != FORMAT_VERSION) return false;
+
+  std::ofstream out (csvFileName.c_str());
+  if(!out.is_open()) return false;
+
+  XgponStatisticsTable table = (XgponStatisticsTable) header[2];
+  if(table == XGPON_STATS_TABLE_DEVICE) out << "time_ns,device,onu,tcont_type,rx_bytes,tx_bytes,drop_bytes" << std::endl;
+  else if(table == XGPON_STATS_TABLE_QUEUE_DELAY) out << "alloc_id,size,enqueue_time_s,dequeue_time_s" << std::endl;
+  else return false;
+
+  out.precision (12);
+
+  uint32_t blockHeader[2];
+  while (in.read ((char*) blockHeader, sizeof(blockHeader)))
+  {
+    if(blockHeader[0] != BLOCK_MAGIC) return false;
+    uint32_t rows = blockHeader[1];
+
+    if(table == XGPON_STATS_TABLE_DEVICE)
+    {
+      DeviceBlock block;
+      if(!(ReadColumn (in, block.m_time, rows) && ReadColumn (in, block.m_device, rows) &&
+           ReadColumn (in, block.m_onu, rows) && ReadColumn (in, block.m_tcontType, rows) &&
+           ReadColumn (in, block.m_rxBytes, rows) && ReadColumn (in, block.m_txBytes, rows) &&
+           ReadColumn (in, block.m_dropBytes, rows))) return false;
+
+      for(uint32_t i=0; i<rows; i++)
+      {
+        out << block.m_time[i] << "," << block.m_device[i] << "," << block.m_onu[i] << "," << (uint16_t) block.m_tcontType[i] << ","
+            << block.m_rxBytes[i] << "," << block.m_txBytes[i] << "," << block.m_dropBytes[i] << "\n";
+      }
+    }
+    else
+    {
+      QueueDelayBlock block;
+      if(!(ReadColumn (in, block.m_allocId, rows) && ReadColumn (in, block.m_size, rows) &&
+           ReadColumn (in, block.m_enqueueTime, rows) && ReadColumn (in, block.m_dequeueTime, rows))) return false;
+
+      for(uint32_t i=0; i<rows; i++)
+      {
+        out << block.m_allocId[i] << "," << block.m_size[i] << "," << block.m_enqueueTime[i] << "," << block.m_dequeueTime[i] << "\n";
+      }
+    }
+  }
+
+  return true;
+}
+
+
+}; // namespace ns3
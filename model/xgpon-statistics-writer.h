@@ -0,0 +1,186 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_STATISTICS_WRITER_H
+#define XGPON_STATISTICS_WRITER_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "ns3/object.h"
+
+#include "xgpon-statistics-sampler.h"
+#include "xgpon-queue.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief Writes the statistics produced by the module into fixed-schema, columnar binary files.
+ *
+ * Two tables are written, each into its own file:
+ *   <FilePrefix>-stats.bin : time (uint64, ns), device (uint32), onu (uint16), tcont type (uint8, 0: all types),
+ *                            rx bytes, tx bytes, drop bytes (uint64). One row per device per sample, plus (at the OLT)
+ *                            one row per ONU and T-CONT type.
+ *   <FilePrefix>-qdelay.bin: alloc-id (uint16), size (uint32), enqueue time and dequeue time (double, second).
+ *
+ * Each file starts with one file header (magic, version, table id) and is a sequence of blocks.
+ * Each block holds a row count followed by the columns stored one after the other.
+ * Blocks are handed to a background thread, so the simulation thread never waits on file I/O.
+ * When "CsvExport" is set, the binary files are converted into CSV files when the writer is closed.
+ */
+class XgponStatisticsWriter : public Object
+{
+  const static uint32_t FILE_MAGIC = 0x54534758;       //"XGST"
+  const static uint32_t BLOCK_MAGIC = 0x4b4c4258;      //"XBLK"
+  const static uint32_t FORMAT_VERSION = 1;
+
+public:
+  //the tables supported by the writer
+  enum XgponStatisticsTable
+  {
+    XGPON_STATS_TABLE_DEVICE = 0,
+    XGPON_STATS_TABLE_QUEUE_DELAY = 1,
+    XGPON_STATS_TABLE_NUMBER = 2,
+  };
+
+
+  /**
+   * \brief Constructor
+   */
+  XgponStatisticsWriter ();
+  virtual ~XgponStatisticsWriter ();
+
+
+  /**
+   * \brief create the files and start the background writer thread.
+   */
+  void Open ();
+
+  /**
+   * \brief flush the pending rows, stop the writer thread and (optionally) export the tables into CSV files.
+   */
+  void Close ();
+
+
+  /**
+   * \brief record the device statistics through the "Sample" trace source of the sampler.
+   */
+  void AttachSampler (const Ptr<XgponStatisticsSampler>& sampler);
+
+  /**
+   * \brief record the per-packet queue delays through the "QueueDelay" trace source of the queue.
+   */
+  void AttachQueue (const Ptr<XgponQueue>& queue);
+
+
+  /**
+   * \brief the trace sinks. They only append rows to the current block.
+   */
+  void RecordSample (const XgponStatisticsSample& sample);
+  void RecordQueueDelay (uint16_t allocId, uint32_t size, double enqueueTime, double dequeueTime);
+
+
+  /**
+   * \brief convert one binary table produced by this class into one CSV file.
+   * \return false if the binary file cannot be read or is not one table of this class.
+   */
+  static bool ExportCsv (const std::string& binFileName, const std::string& csvFileName);
+
+
+
+  ///////////////////////////////////////////Functions required by NS-3
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+
+protected:
+  virtual void DoDispose (void);
+
+
+private:
+  //rows of the device statistics table that have not been flushed yet (one vector per column)
+  class DeviceBlock
+  {
+  public:
+    std::vector<uint64_t> m_time;
+    std::vector<uint32_t> m_device;
+    std::vector<uint16_t> m_onu;
+    std::vector<uint8_t> m_tcontType;
+    std::vector<uint64_t> m_rxBytes;
+    std::vector<uint64_t> m_txBytes;
+    std::vector<uint64_t> m_dropBytes;
+
+    void AddRow (uint64_t time, uint32_t device, uint16_t onu, uint8_t tcontType, uint64_t rx, uint64_t tx, uint64_t drop);
+    void Clear ();
+  };
+
+  //rows of the queue delay table that have not been flushed yet (one vector per column)
+  class QueueDelayBlock
+  {
+  public:
+    std::vector<uint16_t> m_allocId;
+    std::vector<uint32_t> m_size;
+    std::vector<double> m_enqueueTime;
+    std::vector<double> m_dequeueTime;
+
+    void Clear ();
+  };
+
+  //serialize the current block of one table and pass it to the writer thread.
+  void FlushDeviceBlock ();
+  void FlushQueueDelayBlock ();
+  void SubmitBuffer (XgponStatisticsTable table, std::vector<char>& buffer);
+
+  //main loop of the background thread
+  void WriterThreadLoop ();
+
+  std::string GetFileName (XgponStatisticsTable table, const std::string& suffix) const;
+
+
+  std::string m_filePrefix;                 //the files are named <prefix>-stats.bin and <prefix>-qdelay.bin
+  uint32_t m_rowsPerBlock;                  //the number of rows that trigger one flush
+  bool m_csvExport;                         //whether to produce CSV files at Close
+
+  bool m_opened;
+  FILE* m_files[XGPON_STATS_TABLE_NUMBER];
+
+  DeviceBlock m_deviceBlock;
+  QueueDelayBlock m_queueDelayBlock;
+
+  //blocks handed over to the writer thread (shared between the two threads)
+  std::deque< std::pair<XgponStatisticsTable, std::vector<char> > > m_pendingBuffers;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_stopWriter;
+  std::thread m_writerThread;
+};
+
+
+}; // namespace ns3
+
+#endif // XGPON_STATISTICS_WRITER_H
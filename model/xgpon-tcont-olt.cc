@@ -90,6 +90,28 @@ XgponTcontOlt::ResetGIRtimer ()
   m_girTimer = m_pirSI/2; //GirTimer for T3 counts from SiMinValue/2-1 to 0. 
   //std::cout << "At reset, m_girTimer: " << m_girTimer << std::endl;
 }
+
+//the value of one timer after nFrames BWmaps: it counts down to TIMER_EXPIRE_VALUE (0) and restarts from rearm once it has expired.
+static uint16_t
+AdvanceTimer (uint16_t timer, uint16_t rearm, uint64_t nFrames)
+{
+  if (nFrames <= timer)
+    return timer - nFrames;
+  if (rearm == 0)
+    return 0;
+  uint64_t phase = (nFrames - timer) % rearm;
+  return (phase == 0) ? 0 : rearm - phase;
+}
+void
+XgponTcontOlt::AdvancePIRtimer (uint64_t nFrames)
+{
+  m_pirTimer = AdvanceTimer (m_pirTimer, m_pirSI, nFrames);
+}
+void
+XgponTcontOlt::AdvanceGIRtimer (uint64_t nFrames)
+{
+  m_girTimer = AdvanceTimer (m_girTimer, m_pirSI/2, nFrames);
+}
 //only 4 tconts are supported in GIANT
 void
 XgponTcontOlt::CalculateTcontQosParameters(XgponQosParameters::XgponTcontType type)
@@ -139,17 +161,16 @@ XgponTcontOlt::ReceiveStatusReport (const Ptr<XgponXgtcDbru>& report, uint64_t t
 }
 
 void 
-XgponTcontOlt::AddNewBwAllocation2ServiceHistory (const Ptr<XgponXgtcBwAllocation>& allocation, uint64_t time)
+XgponTcontOlt::AddNewBwAllocation2ServiceHistory (const XgponXgtcBwAllocationFields& allocation, uint64_t time)
 {
   NS_LOG_FUNCTION(this);
 
-  allocation->SetCreateTime(time);
-  AddNewBwAllocation (allocation);
+  AddNewBwAllocation (allocation, time);
 
   int64_t timeTh = time - XgponNetDevice::HISTORY_2_MAINTAIN;
   if(timeTh > 0) ClearOldBandwidthAllocations(timeTh);
 
-  if(allocation->GetDbruFlag() != 0) { m_lastPollingTime = time; }
+  if(allocation.GetDbruFlag() != 0) { m_lastPollingTime = time; }
 }
 
 
@@ -163,11 +184,23 @@ XgponTcontOlt::AddOneConnection (const Ptr<XgponConnectionReceiver>& conn)
 
 
 
-uint32_t 
+uint32_t
 XgponTcontOlt::CalculateRemainingDataToServe (uint64_t rtt, uint64_t slotSize)
 {
   NS_LOG_FUNCTION(this);
 
+  int64_t remain = CalculateOutstandingData (rtt, slotSize);
+  //std::cout << "Remaining: " << remain << "\t";
+  if(remain < 0) remain = 0;
+
+  return remain;
+}
+
+int64_t
+XgponTcontOlt::CalculateOutstandingData (uint64_t rtt, uint64_t slotSize)
+{
+  NS_LOG_FUNCTION(this);
+
   const Ptr<XgponXgtcDbru>& dbru = GetLatestBufOccupancyReport ();
   if(dbru==0)    return 0;
 
@@ -178,28 +211,24 @@ XgponTcontOlt::CalculateRemainingDataToServe (uint64_t rtt, uint64_t slotSize)
 
 
   //since m_bwAllocations is maintained according to creation time (ascend order), we should start from the tail to consider the newer bwallocs.
-  std::deque < Ptr<XgponXgtcBwAllocation> >::reverse_iterator rit, rend;
+  std::deque < XgponTcontBwAllocationRecord >::reverse_iterator rit, rend;
   rend = m_bwAllocations.rend();
   rit = m_bwAllocations.rbegin();
   uint32_t assignedSize = 0;
   while(rit!=rend)
   {
     //the status report in one burst includes the data transmitted in that burst. Thus, slotSize / 2 is added to include the corresponding bwalloc.
-    uint64_t timeTh = (*rit)->GetCreateTime() + rtt + slotSize / 2;
+    uint64_t timeTh = rit->GetTime() + rtt + slotSize / 2;
     if(timeTh > lastReportTime)   
     {
-      assignedSize += (*rit)->GetGrantSize();
-      if((*rit)->GetDbruFlag()) assignedSize -= 1;   //ocuupancy report occupies one word;    
+      assignedSize += rit->GetFields().GetGrantSize();
+      if(rit->GetFields().GetDbruFlag()) assignedSize -= 1;   //ocuupancy report occupies one word;    
       
       rit++;  
     } else break;
   } 
   
-  int remain = latestOccupancy - assignedSize;
-  //std::cout << "Remaining: " << remain << "\t";
-  if(remain < 0) remain = 0;
-
-  return remain;
+  return (int64_t)latestOccupancy - (int64_t)assignedSize;
 }
 
 
@@ -212,7 +241,11 @@ XgponTcontOlt::ClearOldBufOccupancyReports (uint64_t time)
   while(m_bufOccupancyReports.size() > 0)
   {
     const Ptr<XgponXgtcDbru>& dbru = m_bufOccupancyReports.front();
-    if(dbru->GetReceiveTime() < time) m_bufOccupancyReports.pop_front();
+    if(dbru->GetReceiveTime() < time)
+    {
+      m_bufOccupancyReports.pop_front();
+      XgponMemoryCensus::RecordRelease (XgponMemoryCensus::TCONT_REPORT_HISTORY, sizeof(Ptr<XgponXgtcDbru>), 0);
+    }
     else break;
   }
 
@@ -227,8 +260,11 @@ XgponTcontOlt::ClearOldBandwidthAllocations (uint64_t time)
 
   while(m_bwAllocations.size() > 0)
   {
-    const Ptr<XgponXgtcBwAllocation>& bwAlloc = m_bwAllocations.front();
-    if(bwAlloc->GetCreateTime () < time) m_bwAllocations.pop_front();
+    if(m_bwAllocations.front().GetTime () < time)
+    {
+      m_bwAllocations.pop_front();
+      XgponMemoryCensus::RecordRelease (XgponMemoryCensus::TCONT_BW_ALLOCATION_HISTORY, sizeof(XgponTcontBwAllocationRecord), 0);
+    }
     else break;
   }
 
@@ -61,7 +61,7 @@ public:
 
 
   //put the just created bandwidth allocation into the service history of this T-CONT.
-  void AddNewBwAllocation2ServiceHistory (const Ptr<XgponXgtcBwAllocation>& allocation, uint64_t time);
+  void AddNewBwAllocation2ServiceHistory (const XgponXgtcBwAllocationFields& allocation, uint64_t time);
 
 
   //Get the time that the latest polling grant is sent to this T-CONT.
@@ -84,6 +84,11 @@ public:
    */
   uint32_t CalculateRemainingDataToServe (uint64_t rtt, uint64_t slotSize);
 
+  /**
+   * \brief the same as CalculateRemainingDataToServe, but not clamped at zero (negative: over-granted). unit: word
+   */
+  int64_t CalculateOutstandingData (uint64_t rtt, uint64_t slotSize);
+
   //////////////////////////////////////////////////////////////Reassemble related functions
   /**
    * \brief put back the received fragments for further reassemble. 
@@ -106,6 +111,9 @@ public:
   void UpdateGIRtimer ();
   void ResetPIRtimer ();
   void ResetGIRtimer ();
+  //the same as calling UpdatePIRtimer (UpdateGIRtimer) after nFrames BWmaps that visit this T-CONT, the timer being reset whenever it has expired.
+  void AdvancePIRtimer (uint64_t nFrames);
+  void AdvanceGIRtimer (uint64_t nFrames);
 
   
   void SetTotalAllocatedRate (uint32_t bw);
@@ -97,12 +97,11 @@ XgponTcontOnu::PrepareBufOccupancyReport ( )
 
 
 void 
-XgponTcontOnu::ReceiveBwAllocation (const Ptr<XgponXgtcBwAllocation>& allocation, uint64_t time)
+XgponTcontOnu::ReceiveBwAllocation (const XgponXgtcBwAllocationFields& fields, uint64_t time)
 {
   NS_LOG_FUNCTION(this);
 
-  allocation->SetReceiveTime(time);
-  AddNewBwAllocation (allocation);
+  AddNewBwAllocation (fields, time);
 
   int64_t timeTh = time - XgponNetDevice::HISTORY_2_MAINTAIN;
   if(timeTh > 0) ClearOldBandwidthAllocations(timeTh);
@@ -113,6 +112,21 @@ XgponTcontOnu::ReceiveBwAllocation (const Ptr<XgponXgtcBwAllocation>& allocation
 
 
 
+bool 
+XgponTcontOnu::HasDataToTransmit ( )
+{
+  int num = GetConnNumber();
+  for(int i=0; i<num; i++)
+  {
+    const Ptr<XgponConnectionSender>& conn = GetConnByIndex(i);
+    if(conn->GetBufOccupancy4Scheduling () > 0 || conn->IsSegmentationRunning ()) return true;
+  }
+  return false;
+}
+
+
+
+
 void 
 XgponTcontOnu::AddOneConnection (const Ptr<XgponConnectionSender>& conn)
 {
@@ -137,7 +151,11 @@ XgponTcontOnu::ClearOldBufOccupancyReports (uint64_t time)
   while(m_bufOccupancyReports.size() > 0)
   {
     const Ptr<XgponXgtcDbru>& dbru = m_bufOccupancyReports.front();
-    if(dbru->GetCreateTime() < time) m_bufOccupancyReports.pop_front();
+    if(dbru->GetCreateTime() < time)
+    {
+      m_bufOccupancyReports.pop_front();
+      XgponMemoryCensus::RecordRelease (XgponMemoryCensus::TCONT_REPORT_HISTORY, sizeof(Ptr<XgponXgtcDbru>), 0);
+    }
     else break;
   }
 
@@ -152,8 +170,11 @@ XgponTcontOnu::ClearOldBandwidthAllocations (uint64_t time)
 
   while(m_bwAllocations.size() > 0)
   {
-    const Ptr<XgponXgtcBwAllocation>& bwAlloc = m_bwAllocations.front();
-    if(bwAlloc->GetReceiveTime () < time) m_bwAllocations.pop_front();
+    if(m_bwAllocations.front().GetTime () < time)
+    {
+      m_bwAllocations.pop_front();
+      XgponMemoryCensus::RecordRelease (XgponMemoryCensus::TCONT_BW_ALLOCATION_HISTORY, sizeof(XgponTcontBwAllocationRecord), 0);
+    }
     else break;
   }
 
@@ -60,7 +60,11 @@ public:
 
 
   //called when one bandwidth allocation is received from OLT. time: receiving time
-  void ReceiveBwAllocation (const Ptr<XgponXgtcBwAllocation>& allocation, uint64_t time);
+  //the fields are copied into the history together with the receiving time.
+  void ReceiveBwAllocation (const XgponXgtcBwAllocationFields& fields, uint64_t time);
+
+  //whether any connection of this alloc-id has data (or the remaining part of a segmented packet) in its queue
+  bool HasDataToTransmit ( );
   
   /**
    * \brief  add one connection into the alloc-id. 
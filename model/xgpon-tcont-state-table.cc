@@ -0,0 +1,70 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include "xgpon-tcont-state-table.h"
+
+
+
+namespace ns3{
+
+XgponTcontStateTable::XgponTcontStateTable ()
+{
+}
+XgponTcontStateTable::~XgponTcontStateTable ()
+{
+}
+
+
+uint32_t
+XgponTcontStateTable::AddTcont (uint16_t allocId, uint16_t onuId, XgponQosParameters::XgponTcontType type)
+{
+  NS_ASSERT_MSG((allocId<MAX_ALLOC_ID), "Alloc-ID is too large (unlawful)!!!");
+  NS_ASSERT_MSG((m_rowOfAllocId.Find (allocId)==XgponIdMap::NOT_FOUND), "The T-CONT has been added into the state table!!!");
+
+  uint32_t row = m_allocId.size ();
+  m_rowOfAllocId.Insert (allocId, row);
+
+  m_allocId.push_back (allocId);
+  m_onuId.push_back (onuId);
+  m_tcontType.push_back ((uint8_t) type);
+  m_allocationWords.push_back (0);
+  m_latestBufOcc.push_back (0);
+  m_latestReportTime.push_back (0);
+  m_outstanding.push_back (0);
+
+  return row;
+}
+
+void
+XgponTcontStateTable::Reserve (uint32_t nTconts)
+{
+  uint32_t nRows = m_allocId.size () + nTconts;
+  m_allocId.reserve (nRows);
+  m_onuId.reserve (nRows);
+  m_tcontType.reserve (nRows);
+  m_allocationWords.reserve (nRows);
+  m_latestBufOcc.reserve (nRows);
+  m_latestReportTime.reserve (nRows);
+  m_outstanding.reserve (nRows);
+}
+
+
+}//namespace ns3
@@ -0,0 +1,199 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#ifndef XGPON_TCONT_STATE_TABLE_H
+#define XGPON_TCONT_STATE_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/assert.h"
+
+#include "xgpon-qos-parameters.h"
+#include "xgpon-id-map.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief The per-frame state of all upstream T-CONTs at the OLT, kept as one array per field (one row per T-CONT).
+ *
+ * The DBA engines read the rows in every frame, instead of walking the report and allocation histories of each XgponTcontOlt.
+ * The remaining data of one T-CONT is computed from its histories only when its status report arrives; the grants issued
+ * afterwards are subtracted when the BWmap is produced. Rows are added by XgponOltConnManager in the order the T-CONTs are added.
+ */
+class XgponTcontStateTable
+{
+public:
+  const static uint32_t NO_ROW = XgponIdMap::NOT_FOUND;
+  const static uint16_t MAX_ALLOC_ID = 16384;
+
+  /**
+   * \brief Constructor
+   */
+  XgponTcontStateTable ();
+  virtual ~XgponTcontStateTable ();
+
+
+  /**
+   * \brief add one row for the T-CONT.
+   * \return the row of this T-CONT
+   */
+  uint32_t AddTcont (uint16_t allocId, uint16_t onuId, XgponQosParameters::XgponTcontType type);
+
+  /**
+   * \brief reserve the rows for the T-CONTs to be added (bulk provisioning).
+   */
+  void Reserve (uint32_t nTconts);
+
+  /**
+   * \brief the row of one T-CONT. NO_ROW: this T-CONT has not been added.
+   */
+  uint32_t GetRow (uint16_t allocId) const;
+
+  uint32_t GetNumberOfRows () const;
+
+
+  /**
+   * \brief record the status report just received from the T-CONT.
+   * \param outstanding XgponTcontOlt::CalculateOutstandingData, computed right after the report is added to the T-CONT. unit: word
+   */
+  void RecordReport (uint32_t row, uint32_t bufOcc, uint64_t time, int64_t outstanding);
+
+  /**
+   * \brief subtract one grant (of the BWmap just produced) from the data that remains to be served. unit: word
+   */
+  void RecordGrant (uint32_t row, uint32_t grantSize, bool dbru);
+
+
+  ////////////////////////////////////////////////per-row fields
+  uint16_t GetAllocId (uint32_t row) const;
+  uint16_t GetOnuId (uint32_t row) const;
+  XgponQosParameters::XgponTcontType GetTcontType (uint32_t row) const;
+
+  void SetAllocationWords (uint32_t row, uint32_t words);
+  uint32_t GetAllocationWords (uint32_t row) const;
+
+  uint32_t GetLatestBufOcc (uint32_t row) const;
+  uint64_t GetLatestReportTime (uint32_t row) const;
+
+  /**
+   * \brief the same value as XgponTcontOlt::CalculateRemainingDataToServe. unit: word
+   */
+  uint32_t GetRemainingData (uint32_t row) const;
+
+
+private:
+  XgponIdMap m_rowOfAllocId;                //alloc-id -> row
+
+  std::vector<uint16_t> m_allocId;
+  std::vector<uint16_t> m_onuId;
+  std::vector<uint8_t> m_tcontType;
+  std::vector<uint32_t> m_allocationWords;
+  std::vector<uint32_t> m_latestBufOcc;      //unit: word
+  std::vector<uint64_t> m_latestReportTime;  //unit: nanosecond; 0: no report yet
+  std::vector<int64_t> m_outstanding;        //the latest report minus the grants that it does not include; may be negative. unit: word
+};
+
+
+
+
+//////////////////////////////////////INLINE Functions
+inline uint32_t
+XgponTcontStateTable::GetRow (uint16_t allocId) const
+{
+  NS_ASSERT_MSG((allocId<MAX_ALLOC_ID), "Alloc-ID is too large (unlawful)!!!");
+  return m_rowOfAllocId.Find (allocId);
+}
+
+inline uint32_t
+XgponTcontStateTable::GetNumberOfRows () const
+{
+  return m_allocId.size ();
+}
+
+inline void
+XgponTcontStateTable::RecordReport (uint32_t row, uint32_t bufOcc, uint64_t time, int64_t outstanding)
+{
+  NS_ASSERT_MSG((row<m_allocId.size()), "The T-CONT has not been added into the state table!!!");
+  m_latestBufOcc[row] = bufOcc;
+  m_latestReportTime[row] = time;
+  m_outstanding[row] = outstanding;
+}
+
+inline void
+XgponTcontStateTable::RecordGrant (uint32_t row, uint32_t grantSize, bool dbru)
+{
+  NS_ASSERT_MSG((row<m_allocId.size()), "The T-CONT has not been added into the state table!!!");
+  m_outstanding[row] -= grantSize;
+  if(dbru) m_outstanding[row] += 1;   //ocuupancy report occupies one word
+}
+
+inline uint16_t
+XgponTcontStateTable::GetAllocId (uint32_t row) const
+{
+  return m_allocId[row];
+}
+inline uint16_t
+XgponTcontStateTable::GetOnuId (uint32_t row) const
+{
+  return m_onuId[row];
+}
+inline XgponQosParameters::XgponTcontType
+XgponTcontStateTable::GetTcontType (uint32_t row) const
+{
+  return (XgponQosParameters::XgponTcontType) m_tcontType[row];
+}
+
+inline void
+XgponTcontStateTable::SetAllocationWords (uint32_t row, uint32_t words)
+{
+  m_allocationWords[row] = words;
+}
+inline uint32_t
+XgponTcontStateTable::GetAllocationWords (uint32_t row) const
+{
+  return m_allocationWords[row];
+}
+
+inline uint32_t
+XgponTcontStateTable::GetLatestBufOcc (uint32_t row) const
+{
+  return m_latestBufOcc[row];
+}
+inline uint64_t
+XgponTcontStateTable::GetLatestReportTime (uint32_t row) const
+{
+  return m_latestReportTime[row];
+}
+
+inline uint32_t
+XgponTcontStateTable::GetRemainingData (uint32_t row) const
+{
+  int64_t remain = m_outstanding[row];
+  return remain > 0 ? remain : 0;
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_TCONT_STATE_TABLE_H
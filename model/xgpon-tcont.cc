@@ -49,13 +49,20 @@ XgponTcont::XgponTcont ():
   m_allocatedRate(0),
   m_pirSI(10), //10*125us of initial timer
   m_bufOccupancyReports(0),
-  m_bwAllocations(0),
-  m_nullDbru(0),
-  m_nullBwAlloc(0)
+  m_bwAllocations(),
+  m_nullDbru(0)
 {
 }
 XgponTcont::~XgponTcont ()
 {
+  for(uint32_t i=0; i<m_bufOccupancyReports.size(); i++)
+  {
+    XgponMemoryCensus::RecordRelease (XgponMemoryCensus::TCONT_REPORT_HISTORY, sizeof(Ptr<XgponXgtcDbru>), 0);
+  }
+  for(uint32_t i=0; i<m_bwAllocations.size(); i++)
+  {
+    XgponMemoryCensus::RecordRelease (XgponMemoryCensus::TCONT_BW_ALLOCATION_HISTORY, sizeof(XgponTcontBwAllocationRecord), 0);
+  }
 }
 
 
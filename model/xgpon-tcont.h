@@ -28,9 +28,30 @@
 #include "xgpon-xgtc-dbru.h"
 #include "xgpon-xgtc-bw-allocation.h"
 #include "xgpon-qos-parameters.h" 
+#include "xgpon-memory-census.h"
 
 namespace ns3 {
 
+/**
+ * \ingroup xgpon
+ * \brief One entry of the bandwidth allocation history of one T-CONT, kept by value.
+ *        The time is the creation time at the OLT and the receiving time at the ONU. unit: nanosecond
+ */
+class XgponTcontBwAllocationRecord
+{
+public:
+  XgponTcontBwAllocationRecord (const XgponXgtcBwAllocationFields& fields, uint64_t time);
+
+  const XgponXgtcBwAllocationFields& GetFields () const;
+  uint64_t GetTime () const;
+
+private:
+  XgponXgtcBwAllocationFields m_fields;
+  uint64_t m_time;
+};
+
+
+
 /**
  * \ingroup xgpon
  * \brief This class is used to represent one T-CONT, i.e., transmission container (specified by one Alloc-ID). 
@@ -55,10 +76,11 @@ public:
 
   /* bandwidth allocation related operations */
   //this is the actual bandwidth allocation for this TCONT, when served by GIANT MAC
-  void AddNewBwAllocation (const Ptr<XgponXgtcBwAllocation>& allocation);
-  const Ptr<XgponXgtcBwAllocation>& GetOldestBwAllocation () const;  
-  const Ptr<XgponXgtcBwAllocation>& GetLatestBwAllocation () const;  
-  const std::deque < Ptr<XgponXgtcBwAllocation> >& GetAllBwAllocations ();
+  //the allocations are copied into the history; the oldest/latest one is 0 when the history is empty.
+  void AddNewBwAllocation (const XgponXgtcBwAllocationFields& fields, uint64_t time);
+  const XgponTcontBwAllocationRecord* GetOldestBwAllocation () const;  
+  const XgponTcontBwAllocationRecord* GetLatestBwAllocation () const;  
+  const std::deque < XgponTcontBwAllocationRecord >& GetAllBwAllocations ();
 
   ////////////////////////////////////////////////Member variable accessors
   void SetAllocId (uint16_t allocId);
@@ -109,11 +131,10 @@ protected:  //to be accessible by sub-classes
    * Sevice records of this Alloc-ID. It is a list of bandwidth allocation for this Alloc-ID (to support multiple thread DBA in the future).
    * It should be maintained at both ONU and OLT side.
    */
-  std::deque < Ptr<XgponXgtcBwAllocation> > m_bwAllocations;
+  std::deque < XgponTcontBwAllocationRecord > m_bwAllocations;
 
-  ////////just used to return one empty dbru or bwalloc
+  ////////just used to return one empty dbru
   Ptr<XgponXgtcDbru> m_nullDbru;
-  Ptr<XgponXgtcBwAllocation> m_nullBwAlloc;
 
 private:  
   //////////////////////////////////////////////////////Clear history: operations are different at ONU and OLT.
@@ -130,6 +151,23 @@ private:
 
 
 ///////////////////////////////////////////////////////////INLINE Functions
+inline
+XgponTcontBwAllocationRecord::XgponTcontBwAllocationRecord (const XgponXgtcBwAllocationFields& fields, uint64_t time)
+  : m_fields(fields), m_time(time)
+{
+}
+inline const XgponXgtcBwAllocationFields& 
+XgponTcontBwAllocationRecord::GetFields () const
+{
+  return m_fields;
+}
+inline uint64_t 
+XgponTcontBwAllocationRecord::GetTime () const
+{
+  return m_time;
+}
+
+
 inline void 
 XgponTcont::SetAllocId (uint16_t allocId)
 {
@@ -199,6 +237,7 @@ inline void
 XgponTcont::AddNewBufOccupancyReport (const Ptr<XgponXgtcDbru>& report)
 {
   m_bufOccupancyReports.push_back(report);
+  XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::TCONT_REPORT_HISTORY, sizeof(Ptr<XgponXgtcDbru>), XgponMemoryCensus::IN_CONTAINER);
 }
 
 inline const Ptr<XgponXgtcDbru>& 
@@ -226,25 +265,26 @@ XgponTcont::GetAllBufOccupancyReports ()
 
 
 inline void 
-XgponTcont::AddNewBwAllocation (const Ptr<XgponXgtcBwAllocation>& allocation)
+XgponTcont::AddNewBwAllocation (const XgponXgtcBwAllocationFields& fields, uint64_t time)
 {
-  m_bwAllocations.push_back(allocation);
+  m_bwAllocations.push_back(XgponTcontBwAllocationRecord (fields, time));
+  XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::TCONT_BW_ALLOCATION_HISTORY, sizeof(XgponTcontBwAllocationRecord), XgponMemoryCensus::IN_CONTAINER);
 }
 
-inline const Ptr<XgponXgtcBwAllocation>& 
+inline const XgponTcontBwAllocationRecord* 
 XgponTcont::GetOldestBwAllocation () const
 {
-  if(m_bwAllocations.size() > 0) return m_bwAllocations.front();
-  else return m_nullBwAlloc;
+  if(m_bwAllocations.size() > 0) return &m_bwAllocations.front();
+  else return 0;
 }
-inline const Ptr<XgponXgtcBwAllocation>& 
+inline const XgponTcontBwAllocationRecord* 
 XgponTcont::GetLatestBwAllocation () const
 {
-  if(m_bwAllocations.size() > 0) return m_bwAllocations.back();
-  else return m_nullBwAlloc;
+  if(m_bwAllocations.size() > 0) return &m_bwAllocations.back();
+  else return 0;
 }
 
-inline const std::deque < Ptr<XgponXgtcBwAllocation> >& 
+inline const std::deque < XgponTcontBwAllocationRecord >& 
 XgponTcont::GetAllBwAllocations ()
 {
   return m_bwAllocations;
@@ -20,6 +20,7 @@
 #include "ns3/log.h"
 
 #include "xgpon-us-burst.h"
+#include "xgpon-memory-census.h"
 
 
 
@@ -27,25 +28,14 @@ NS_LOG_COMPONENT_DEFINE ("XgponUsBurst");
 
 namespace ns3 {
 
-//uint64_t XgponUsBurst::CREATED_US_BURST_NUM4DEBUG = 0;
-//uint64_t XgponUsBurst::DELETED_US_BURST_NUM4DEBUG = 0;
-
 std::stack<void*> XgponUsBurst::m_pool;   //initialize as one empty list;
 bool XgponUsBurst::m_poolEnabled = true;
 
 XgponUsBurst::XgponUsBurst () : PonFrame ()
 {
-  /*
-  CREATED_US_BURST_NUM4DEBUG++;
-  if((CREATED_US_BURST_NUM4DEBUG % 1000) == 0)
-  {
-    std::cout << CREATED_US_BURST_NUM4DEBUG << " upstream bursts are created;  " << DELETED_US_BURST_NUM4DEBUG <<  " upstream bursts are deleted." <<std::endl;
-  }
-  */
 }
 XgponUsBurst::~XgponUsBurst ()
 {
-  //DELETED_US_BURST_NUM4DEBUG++;
 }
 
 
@@ -64,12 +54,14 @@ XgponUsBurst::operator new(size_t size) noexcept(false) //throw(const char*)
     p = m_pool.top();
     m_pool.pop();  
     NS_LOG_INFO("allocated XgponUsBurst through the pool!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::US_BURST, size, XgponMemoryCensus::FROM_POOL);
   }
   else
   {
     p = malloc(size);
     if (!p) throw "cannot allocate more memory from the system!!!";
     NS_LOG_INFO("allocated XgponUsBurst through malloc!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::US_BURST, size, XgponMemoryCensus::FROM_MALLOC);
   }
   return p;
 }
@@ -82,6 +74,7 @@ XgponUsBurst::operator delete(void *p)
     m_pool.push(p);
   }
   else free(p);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::US_BURST, sizeof(XgponUsBurst), m_pool.size());
 }
 
 void 
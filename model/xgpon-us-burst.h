@@ -41,9 +41,6 @@ namespace ns3 {
  */
 class XgponUsBurst : public PonFrame
 {
-  //static uint64_t CREATED_US_BURST_NUM4DEBUG;
-  //static uint64_t DELETED_US_BURST_NUM4DEBUG;
-
   //used to allocate this structure from a pool for saving CPU.
   static bool m_poolEnabled;
   static std::stack<void*> m_pool;
@@ -0,0 +1,167 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+
+#include "xgpon-us-classifier.h"
+
+
+
+namespace ns3{
+
+XgponUsClassifier::Rule::Rule () : m_src(0), m_srcMask(0), m_dst(0), m_dstMask(0),
+  m_srcPort(0), m_srcPortMask(0), m_dstPort(0), m_dstPortMask(0),
+  m_protocol(0), m_protocolMask(0), m_tos(0), m_tosMask(0)
+{
+}
+
+void
+XgponUsClassifier::Rule::MatchTos (uint8_t tos)
+{
+  m_tos = tos;
+  m_tosMask = 0xFF;
+}
+void
+XgponUsClassifier::Rule::MatchDscp (uint8_t dscp)
+{
+  NS_ASSERT_MSG((dscp<64), "DSCP is too large (unlawful)!!!");
+  m_tos = dscp << 2;
+  m_tosMask = 0xFC;
+}
+void
+XgponUsClassifier::Rule::MatchProtocol (uint8_t protocol)
+{
+  m_protocol = protocol;
+  m_protocolMask = 0xFF;
+}
+void
+XgponUsClassifier::Rule::MatchSource (const Ipv4Address& addr, const Ipv4Mask& mask)
+{
+  m_srcMask = mask.Get ();
+  m_src = addr.Get () & m_srcMask;
+}
+void
+XgponUsClassifier::Rule::MatchDestination (const Ipv4Address& addr, const Ipv4Mask& mask)
+{
+  m_dstMask = mask.Get ();
+  m_dst = addr.Get () & m_dstMask;
+}
+void
+XgponUsClassifier::Rule::MatchSourcePort (uint16_t port)
+{
+  m_srcPort = port;
+  m_srcPortMask = 0xFFFF;
+}
+void
+XgponUsClassifier::Rule::MatchDestinationPort (uint16_t port)
+{
+  m_dstPort = port;
+  m_dstPortMask = 0xFFFF;
+}
+
+
+
+
+XgponUsClassifier::XgponUsClassifier () : m_rules(0), m_conns(0), m_needPorts(false), m_cache(0), m_nullConn(0)
+{
+}
+XgponUsClassifier::~XgponUsClassifier ()
+{
+}
+
+
+void
+XgponUsClassifier::AddRule (const Rule& rule, const Ptr<XgponConnectionSender>& conn)
+{
+  NS_ASSERT_MSG((conn!=0), "The connection of one classification rule should have been added!!!");
+
+  m_rules.push_back (rule);
+  m_conns.push_back (conn);
+  if(rule.NeedsPorts ()) m_needPorts = true;
+
+  //the flows cached so far might match the new rule (or need their ports)
+  CacheEntry invalid;
+  invalid.m_rule = NO_RULE;
+  invalid.m_valid = false;
+  m_cache.assign ((uint32_t)1 << CACHE_BITS, invalid);
+}
+
+
+
+
+const Ptr<XgponConnectionSender>&
+XgponUsClassifier::Classify (const Ptr<Packet>& packet, const Ipv4Header& ipHeader)
+{
+  Flow flow;
+  GetFlow (packet, ipHeader, flow);
+
+  uint32_t hash = flow.m_src * 2654435761u;
+  hash ^= flow.m_dst + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+  hash ^= (((uint32_t)flow.m_srcPort << 16) | flow.m_dstPort) + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+  hash ^= (((uint32_t)flow.m_protocol << 8) | flow.m_tos) + 0x9E3779B9u + (hash << 6) + (hash >> 2);
+
+  CacheEntry& entry = m_cache[(hash * 2654435769u) >> (32 - CACHE_BITS)];
+  if(!entry.m_valid || !(entry.m_flow == flow))
+  {
+    entry.m_flow = flow;
+    entry.m_rule = FindRule (flow);
+    entry.m_valid = true;
+  }
+
+  if(entry.m_rule == NO_RULE) return m_nullConn;
+  return m_conns[entry.m_rule];
+}
+
+
+void
+XgponUsClassifier::GetFlow (const Ptr<Packet>& packet, const Ipv4Header& ipHeader, Flow& flow) const
+{
+  flow.m_src = ipHeader.GetSource ().Get ();
+  flow.m_dst = ipHeader.GetDestination ().Get ();
+  flow.m_protocol = ipHeader.GetProtocol ();
+  flow.m_tos = ipHeader.GetTos ();
+  flow.m_srcPort = 0;
+  flow.m_dstPort = 0;
+
+  //TCP (6) and UDP (17) start with the source and destination ports; read them from the bytes after the IPv4 header
+  if(m_needPorts && (flow.m_protocol == 6 || flow.m_protocol == 17) && ipHeader.GetFragmentOffset () == 0)
+  {
+    uint32_t hdrSize = ipHeader.GetSerializedSize ();
+    uint8_t buf[64];
+    if(hdrSize + 4 <= sizeof (buf) && packet->CopyData (buf, hdrSize + 4) == hdrSize + 4)
+    {
+      flow.m_srcPort = (buf[hdrSize] << 8) | buf[hdrSize + 1];
+      flow.m_dstPort = (buf[hdrSize + 2] << 8) | buf[hdrSize + 3];
+    }
+  }
+}
+
+
+uint32_t
+XgponUsClassifier::FindRule (const Flow& flow) const
+{
+  for(uint32_t i=0; i<m_rules.size(); i++)
+  {
+    if(m_rules[i].Matches (flow)) return i;
+  }
+  return NO_RULE;
+}
+
+
+}//namespace ns3
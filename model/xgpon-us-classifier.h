@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University College Cork (UCC), Ireland
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiuchao Wu <xw2@cs.ucc.ie>
+ */
+
+#ifndef XGPON_US_CLASSIFIER_H
+#define XGPON_US_CLASSIFIER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/packet.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-header.h"
+
+#include "xgpon-connection-sender.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup xgpon
+ * \brief The upstream classification table of one ONU: maps the IPv4 packets from upper layers to upstream connections.
+ *
+ * Rules are matched in the order they are added and the first matching rule wins. The result of each flow (TOS, protocol,
+ * addresses and, if any rule needs them, TCP/UDP ports) is kept in a small direct-mapped cache, so that the packets of one
+ * flow usually cost one probe instead of a search through the rules. The cache is cleared whenever one rule is added.
+ */
+class XgponUsClassifier
+{
+public:
+
+  /**
+   * \brief the header fields used to classify one packet.
+   */
+  class Flow
+  {
+  public:
+    uint32_t m_src;
+    uint32_t m_dst;
+    uint16_t m_srcPort;          //0 when ports are not needed or the packet is not the first fragment of TCP/UDP
+    uint16_t m_dstPort;
+    uint8_t m_protocol;
+    uint8_t m_tos;
+
+    bool operator== (const Flow& other) const;
+  };
+
+
+  /**
+   * \brief the values that the fields of one packet should have. The fields that are not set match any packet.
+   */
+  class Rule
+  {
+  public:
+    Rule ();
+
+    void MatchTos (uint8_t tos);
+    void MatchDscp (uint8_t dscp);                                        //the upper 6 bits of TOS
+    void MatchProtocol (uint8_t protocol);
+    void MatchSource (const Ipv4Address& addr, const Ipv4Mask& mask);
+    void MatchDestination (const Ipv4Address& addr, const Ipv4Mask& mask);
+    void MatchSourcePort (uint16_t port);                                 //TCP or UDP
+    void MatchDestinationPort (uint16_t port);                            //TCP or UDP
+
+    bool Matches (const Flow& flow) const;
+    bool NeedsPorts () const;
+
+  private:
+    //one field matches if ((value ^ expected) & mask) == 0; mask == 0: any value
+    uint32_t m_src;
+    uint32_t m_srcMask;
+    uint32_t m_dst;
+    uint32_t m_dstMask;
+    uint16_t m_srcPort;
+    uint16_t m_srcPortMask;
+    uint16_t m_dstPort;
+    uint16_t m_dstPortMask;
+    uint8_t m_protocol;
+    uint8_t m_protocolMask;
+    uint8_t m_tos;
+    uint8_t m_tosMask;
+  };
+
+
+
+  /**
+   * \brief Constructor
+   */
+  XgponUsClassifier ();
+  virtual ~XgponUsClassifier ();
+
+
+  /**
+   * \brief add one rule at the end of the table.
+   */
+  void AddRule (const Rule& rule, const Ptr<XgponConnectionSender>& conn);
+
+  /**
+   * \brief find the connection of one packet. 0: no rule matches (the ONU then falls back to the TOS-based mapping).
+   * \param ipHeader the IPv4 header already peeked from the packet
+   */
+  const Ptr<XgponConnectionSender>& Classify (const Ptr<Packet>& packet, const Ipv4Header& ipHeader);
+
+  bool IsEmpty () const;
+  uint32_t GetNumberOfRules () const;
+
+
+private:
+  const static uint32_t CACHE_BITS = 6;
+  const static uint32_t NO_RULE = 0xFFFFFFFF;
+
+  class CacheEntry
+  {
+  public:
+    Flow m_flow;
+    uint32_t m_rule;             //index of the matching rule; NO_RULE: no rule matches this flow
+    bool m_valid;
+  };
+
+  void GetFlow (const Ptr<Packet>& packet, const Ipv4Header& ipHeader, Flow& flow) const;
+
+  uint32_t FindRule (const Flow& flow) const;
+
+
+  std::vector<Rule> m_rules;
+  std::vector< Ptr<XgponConnectionSender> > m_conns;   //index == the index of the rule
+  bool m_needPorts;                                    //whether any rule matches TCP/UDP ports
+
+  std::vector<CacheEntry> m_cache;                     //allocated when the first rule is added
+
+  Ptr<XgponConnectionSender> m_nullConn;
+};
+
+
+
+
+//////////////////////////////////////INLINE Functions
+inline bool
+XgponUsClassifier::Flow::operator== (const Flow& other) const
+{
+  return m_src == other.m_src && m_dst == other.m_dst && m_srcPort == other.m_srcPort && m_dstPort == other.m_dstPort
+    && m_protocol == other.m_protocol && m_tos == other.m_tos;
+}
+
+inline bool
+XgponUsClassifier::Rule::Matches (const Flow& flow) const
+{
+  return ((flow.m_src ^ m_src) & m_srcMask) == 0 && ((flow.m_dst ^ m_dst) & m_dstMask) == 0
+    && ((flow.m_srcPort ^ m_srcPort) & m_srcPortMask) == 0 && ((flow.m_dstPort ^ m_dstPort) & m_dstPortMask) == 0
+    && ((flow.m_protocol ^ m_protocol) & m_protocolMask) == 0 && ((flow.m_tos ^ m_tos) & m_tosMask) == 0;
+}
+
+inline bool
+XgponUsClassifier::Rule::NeedsPorts () const
+{
+  return m_srcPortMask != 0 || m_dstPortMask != 0;
+}
+
+inline bool
+XgponUsClassifier::IsEmpty () const
+{
+  return m_rules.empty ();
+}
+inline uint32_t
+XgponUsClassifier::GetNumberOfRules () const
+{
+  return m_rules.size ();
+}
+
+
+}; // namespace ns3
+
+#endif // XGPON_US_CLASSIFIER_H
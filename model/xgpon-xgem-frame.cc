@@ -22,6 +22,8 @@
 #include "ns3/log.h"
 
 #include "xgpon-xgem-frame.h"
+#include "xgpon-memory-census.h"
+#include "xgpon-frame-arena.h"
 
 
 
@@ -29,26 +31,15 @@ NS_LOG_COMPONENT_DEFINE ("XgponXgemFrame");
 
 namespace ns3 {
 
-//uint64_t XgponXgemFrame::CREATED_XGEM_FRAME_NUM4DEBUG = 0;
-//uint64_t XgponXgemFrame::DELETED_XGEM_FRAME_NUM4DEBUG = 0;
-
 std::stack<void*> XgponXgemFrame::m_pool;   //initialize as one empty list;
 bool XgponXgemFrame::m_poolEnabled = true;
 
 XgponXgemFrame::XgponXgemFrame () 
   : m_type(XGPON_XGEM_FRAME_SHORT_IDLE), m_data(0)
 {
-  /*
-  CREATED_XGEM_FRAME_NUM4DEBUG++;
-  if((CREATED_XGEM_FRAME_NUM4DEBUG % 1000) == 0)
-  {
-    std::cout << CREATED_XGEM_FRAME_NUM4DEBUG << " xgem frames are created;  " << DELETED_XGEM_FRAME_NUM4DEBUG <<  " xgem frames are deleted." <<std::endl;
-  }
-  */
 }
 XgponXgemFrame::~XgponXgemFrame ()
 {
-  //DELETED_XGEM_FRAME_NUM4DEBUG++;
 }
 
 
@@ -61,45 +52,27 @@ XgponXgemFrame::~XgponXgemFrame ()
 void* 
 XgponXgemFrame::operator new(size_t size) noexcept(false) //throw(const char*)
 {
-  void *p;
-  if(m_poolEnabled == true && (!m_pool.empty()))
-  {
-    p = m_pool.top();
-    m_pool.pop();  
-    NS_LOG_INFO("allocated XgponXgemFrame through the pool!!!");
-  }
-  else
-  {
-    p = malloc(size);
-    if (!p) throw "cannot allocate more memory from the system!!!";
-    NS_LOG_INFO("allocated XgponXgemFrame through malloc!!!");
-  }
-  return p;
+  XgponMemoryCensus::XgponAllocationSource source = XgponMemoryCensus::FROM_MALLOC;
+  if(XgponFrameArena::GetActiveArena () != 0) source = XgponMemoryCensus::FROM_ARENA;
+  else if(m_poolEnabled == true && (!m_pool.empty())) source = XgponMemoryCensus::FROM_POOL;
+  XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGEM_FRAME, size, source);
+
+  //taken from the frame arena when one is open (the object dies with the frame/burst)
+  return XgponFrameArena::AllocateObject (size, m_poolEnabled, m_pool);
 }
 
 void 
 XgponXgemFrame::operator delete(void *p)
 {
-  if(m_poolEnabled == true)
-  {
-    m_pool.push(p);
-  }
-  else free(p);
+  XgponFrameArena::FreeObject (p, m_poolEnabled, m_pool);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::XGEM_FRAME, sizeof(XgponXgemFrame), m_pool.size());
 }
 
 void 
 XgponXgemFrame::DisablePoolAllocation()
 {
-  void *p;
-
   m_poolEnabled = false;
-
-  while (!m_pool.empty())
-  {
-    p = m_pool.top();
-    free(p);
-    m_pool.pop();
-  }
+  XgponFrameArena::ClearPool (m_pool);
 }
 
 
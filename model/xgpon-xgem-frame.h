@@ -40,8 +40,6 @@ namespace ns3 {
  */
 class XgponXgemFrame : public SimpleRefCount<XgponXgemFrame>
 {
-  //static uint64_t CREATED_XGEM_FRAME_NUM4DEBUG;
-  //static uint64_t DELETED_XGEM_FRAME_NUM4DEBUG;
 
   //used to allocate this structure from a pool for saving CPU.
   static bool m_poolEnabled;
@@ -28,36 +28,9 @@ NS_LOG_COMPONENT_DEFINE ("XgponXgtcBwAllocation");
 
 namespace ns3 {
 
-//uint64_t XgponXgtcBwAllocation::CREATED_BWALLOC_NUM4DEBUG = 0;
-//uint64_t XgponXgtcBwAllocation::DELETED_BWALLOC_NUM4DEBUG = 0;
 
-std::stack<void*> XgponXgtcBwAllocation::m_pool;   //initialize one empty stack;
-bool XgponXgtcBwAllocation::m_poolEnabled = true;
-
-
-XgponXgtcBwAllocation::XgponXgtcBwAllocation ()
-  : m_allocId (0x0000),
-    m_dbru (0x00),
-    m_ploamu(0x00),
-    m_startTime(0x0000),
-    m_grantSize (0x0000),
-    m_fwi (0x00),
-    m_burstProfile (0x00),
-    m_hec (0x0000)
-{
-  meta_createTime = 0;
-  meta_receiveTime = 0;
-  /*
-  CREATED_BWALLOC_NUM4DEBUG++;
-  if((CREATED_BWALLOC_NUM4DEBUG % 1000) == 0)
-  {
-    std::cout << CREATED_BWALLOC_NUM4DEBUG << " bw_alloc are created;  " << DELETED_BWALLOC_NUM4DEBUG <<  " bw_alloc are deleted." <<std::endl;
-  }
-  */
-}
-
-
-XgponXgtcBwAllocation::XgponXgtcBwAllocation (uint16_t allocId, bool dbru, bool ploamu, uint16_t startTime, uint16_t grantSize, uint8_t fwi, uint8_t burstProfile)
+void
+XgponXgtcBwAllocationFields::Set (uint16_t allocId, bool dbru, bool ploamu, uint16_t startTime, uint16_t grantSize, uint8_t fwi, uint8_t burstProfile)
 {
   m_allocId = allocId & 0x3fff;          //14bits
   m_dbru = dbru?1:0;                  //1bits
@@ -66,34 +39,13 @@ XgponXgtcBwAllocation::XgponXgtcBwAllocation (uint16_t allocId, bool dbru, bool
   m_grantSize = grantSize;               //16bits
   m_fwi = fwi * 0x01;                    //1bits
   m_burstProfile = burstProfile & 0x03;  //2bits
+  m_hec = 0x0000;
 
   CalculateHec ();
-
-
-  meta_createTime = 0;
-  meta_receiveTime = 0;
-
-  /*
-  CREATED_BWALLOC_NUM4DEBUG++;
-  if((CREATED_BWALLOC_NUM4DEBUG % 1000) == 0)
-  {
-    std::cout << CREATED_BWALLOC_NUM4DEBUG << " bw_alloc are created;  " << DELETED_BWALLOC_NUM4DEBUG <<  " bw_alloc are deleted." <<std::endl;
-  }
-  */
 }
 
-XgponXgtcBwAllocation::~XgponXgtcBwAllocation ()
-{
-  //DELETED_BWALLOC_NUM4DEBUG++;
-}
-
-
-
-
-
-
 uint64_t
-XgponXgtcBwAllocation::GetSerializedAllocation (void)
+XgponXgtcBwAllocationFields::GetSerializedAllocation (void) const
 {
   uint64_t sAlloc=m_allocId;
   sAlloc=(sAlloc<<2)|(m_dbru<<1)|m_ploamu;
@@ -104,10 +56,8 @@ XgponXgtcBwAllocation::GetSerializedAllocation (void)
   return sAlloc;  
 }
 
-
-
 void
-XgponXgtcBwAllocation::DeserializeAllocation (uint64_t sAlloc)
+XgponXgtcBwAllocationFields::DeserializeAllocation (uint64_t sAlloc)
 {
 
   m_allocId=sAlloc>>50 & 0x3fff;
@@ -124,85 +74,9 @@ XgponXgtcBwAllocation::DeserializeAllocation (uint64_t sAlloc)
   return;
 }
 
-
-
-
-
-
-
-
-
-
-
-void* 
-XgponXgtcBwAllocation::operator new(size_t size) noexcept(false) //throw(const char*)
-{
-  void *p;
-  if(m_poolEnabled == true && (!m_pool.empty()))
-  {
-    p = m_pool.top();
-    m_pool.pop();  
-    NS_LOG_INFO("allocated XgponXgtcBwAllocation through the pool!!!");
-  }
-  else
-  {
-    p = malloc(size);
-    if (!p) throw "cannot allocate more memory from the system!!!";
-    NS_LOG_INFO("allocated XgponXgtcBwAllocation through malloc!!!");
-  }
-  return p;
-}
-
-void 
-XgponXgtcBwAllocation::operator delete(void *p)
-{
-  if(m_poolEnabled == true)
-  {
-    m_pool.push(p);
-  }
-  else free(p);
-}
-
-void 
-XgponXgtcBwAllocation::DisablePoolAllocation()
-{
-  void *p;
-
-  m_poolEnabled = false;
-
-  while (!m_pool.empty())
-  {
-    p = m_pool.top();
-    free(p);
-    m_pool.pop();
-  }
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
 void
-XgponXgtcBwAllocation::Print (std::ostream &os)  const
+XgponXgtcBwAllocationFields::Print (std::ostream &os)  const
 {
-  os << " Create-Time=" << meta_createTime;
-  os << " Receive-Time=" << meta_receiveTime << std::endl;  
-  
-
   os << " ALLOC-ID=" << (int)m_allocId;
   os << " DBRU-FLAG=" << (int)m_dbru;
   os << " PLOAMU-FLAG=" << (int)m_ploamu;
@@ -222,35 +96,6 @@ XgponXgtcBwAllocation::Print (std::ostream &os)  const
   return;
 }
 
-uint32_t
-XgponXgtcBwAllocation::GetSerializedSize (void) const
-{
-  return XGPON_XGTC_BW_ALLOCATION_LENGTH;  //8 bytes;
-}
-
-void 
-XgponXgtcBwAllocation::Serialize (Buffer::Iterator start) const
-{
-  uint64_t sAlloc=m_allocId;
-  sAlloc=(sAlloc<<2)|(m_dbru<<1)|m_ploamu;
-  sAlloc=(sAlloc<<16)|m_startTime;
-  sAlloc=(sAlloc<<16)|m_grantSize;
-  sAlloc=(sAlloc<<3)|(m_fwi<<2)|m_burstProfile;
-  sAlloc=(sAlloc<<13)|m_hec;
-
-  start.WriteHtonU64 (sAlloc);
-
-  return;
-}
-
-uint32_t 
-XgponXgtcBwAllocation::Deserialize (Buffer::Iterator start)
-{
-  uint64_t rst = start.ReadNtohU64();
-  DeserializeAllocation(rst);
-
-  return GetSerializedSize ();
-}
 
 
 }; // namespace ns3
@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 
 #include "xgpon-xgtc-bwmap.h"
+#include "xgpon-memory-census.h"
 
 
 
@@ -29,71 +30,23 @@ NS_LOG_COMPONENT_DEFINE ("XgponXgtcBwmap");
 
 namespace ns3 {
 
-//uint64_t XgponXgtcBwmap::CREATED_BWMAP_NUM4DEBUG = 0;
-//uint64_t XgponXgtcBwmap::DELETED_BWMAP_NUM4DEBUG = 0;
-
 std::stack<void*> XgponXgtcBwmap::m_pool;   //initialize as one empty stack;
 bool XgponXgtcBwmap::m_poolEnabled = true;
 
 
 XgponXgtcBwmap::XgponXgtcBwmap ()
-  : meta_allocationNumber (0), meta_creationTime (0)
+  : m_nBwAllocations (0), meta_allocationNumber (0), meta_creationTime (0)
 {
-  //m_bwAllocations.reserve(XgponOltDbaEngine::MAX_ALLOCID_PER_BWMAP+1);  
-  /*
-  CREATED_BWMAP_NUM4DEBUG++;
-  if((CREATED_BWMAP_NUM4DEBUG % 1000) == 0)
-  {
-    std::cout << CREATED_BWMAP_NUM4DEBUG << " bw_map are created;  " << DELETED_BWMAP_NUM4DEBUG <<  " bw_map are deleted." <<std::endl;
-  }
-  */
+  //the allocations are not initialized; only the first m_nBwAllocations of them are used.
 }
 XgponXgtcBwmap::~XgponXgtcBwmap ()
 {
-  //DELETED_BWMAP_NUM4DEBUG++;
 }
 
 
 
 
 
-void 
-XgponXgtcBwmap::AddOneBwAllocation (const Ptr<XgponXgtcBwAllocation>& bwAlloc)
-{
-  m_bwAllocations.push_back(bwAlloc);
-}
-
-void 
-XgponXgtcBwmap::AddOneSerializedBwAllocation (uint64_t sBwAlloc)
-{
-  Ptr<XgponXgtcBwAllocation> bwAlloc = Create<XgponXgtcBwAllocation>(); 
-  bwAlloc->DeserializeAllocation(sBwAlloc);
-
-  m_bwAllocations.push_back(bwAlloc);
-  return;
-}
-
-uint16_t 
-XgponXgtcBwmap::GetNumberOfBwAllocation ( ) const
-{
-  return m_bwAllocations.size();
-}
-
-const Ptr<XgponXgtcBwAllocation>& 
-XgponXgtcBwmap::GetBwAllocationByIndex (uint16_t index) const
-{
-  NS_ASSERT_MSG( (index < m_bwAllocations.size()), "The index is too large for BWmap!!!");
-
-  return m_bwAllocations[index];
-}
-
-
-
-
-
-
-
-
 void* 
 XgponXgtcBwmap::operator new(size_t size) noexcept(false) //throw(const char*)
 {
@@ -103,12 +56,14 @@ XgponXgtcBwmap::operator new(size_t size) noexcept(false) //throw(const char*)
     p = m_pool.top();
     m_pool.pop();  
     NS_LOG_INFO("allocated XgponXgtcBwmap through the pool!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGTC_BWMAP, size, XgponMemoryCensus::FROM_POOL);
   }
   else
   {
     p = malloc(size);
     if (!p) throw "cannot allocate more memory from the system!!!";
     NS_LOG_INFO("allocated XgponXgtcBwmap through malloc!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGTC_BWMAP, size, XgponMemoryCensus::FROM_MALLOC);
   }
   return p;
 }
@@ -121,6 +76,7 @@ XgponXgtcBwmap::operator delete(void *p)
     m_pool.push(p);
   }
   else free(p);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::XGTC_BWMAP, sizeof(XgponXgtcBwmap), m_pool.size());
 }
 
 void 
@@ -149,23 +105,14 @@ XgponXgtcBwmap::DisablePoolAllocation()
 void
 XgponXgtcBwmap::Print (std::ostream &os)  const
 {
-  uint32_t i;
-  std::deque< Ptr<XgponXgtcBwAllocation> >::const_iterator iterator4Print, end;
-
   os << std::endl <<std::endl <<"Creation Time = " << meta_creationTime <<std::endl;
-  os << " BW-ALLOC-NUM=" << m_bwAllocations.size();
+  os << " BW-ALLOC-NUM=" << m_nBwAllocations;
   os << std::endl;
 
-  iterator4Print = m_bwAllocations.begin();
-  end = m_bwAllocations.end();
-  i = 1;
-  while (iterator4Print != end)
+  for(uint16_t i=0; i<m_nBwAllocations; i++)
   {
-    os << " BW-ALLOCATION "<<i<<": ";
-    (*iterator4Print)->Print(os);
-    //os << std::endl;
-    iterator4Print++;
-    i++;
+    os << " BW-ALLOCATION "<<(i+1)<<": ";
+    m_bwAllocations[i].Print(os);
   }
 
   os << std::endl;
@@ -175,34 +122,23 @@ XgponXgtcBwmap::Print (std::ostream &os)  const
 
 uint32_t XgponXgtcBwmap::GetSerializedSize (void) const
 {
-  return XGPON_XGTC_BW_ALLOCATION_LENGTH * m_bwAllocations.size(); 
+  return XGPON_XGTC_BW_ALLOCATION_LENGTH * m_nBwAllocations; 
 }
 
 void XgponXgtcBwmap::Serialize (Buffer::Iterator start) const
 {
-  int i, num;
-  Ptr<XgponXgtcBwAllocation> bwAlloc;
-
-  num = m_bwAllocations.size(); 
-
-  for(i=0; i<num; i++)
+  for(uint16_t i=0; i<m_nBwAllocations; i++)
   {
-    bwAlloc = GetBwAllocationByIndex(i);
-    bwAlloc->Serialize(start);
+    start.WriteHtonU64 (m_bwAllocations[i].GetSerializedAllocation ());
   }
   return;
 }
 
 uint32_t XgponXgtcBwmap::Deserialize (Buffer::Iterator start)
 {
-  int i;
-  Ptr<XgponXgtcBwAllocation> bwAlloc;
-
-  for(i=0; i<meta_allocationNumber; i++)
+  for(uint16_t i=0; i<meta_allocationNumber; i++)
   {
-    bwAlloc = Create<XgponXgtcBwAllocation>();
-    bwAlloc->Deserialize(start);
-    m_bwAllocations.push_back(bwAlloc);
+    AddOneSerializedBwAllocation (start.ReadNtohU64 ());
   }
   
   return GetSerializedSize ();
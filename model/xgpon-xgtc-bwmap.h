@@ -23,10 +23,10 @@
 
 #include <cstdlib>
 #include <stack>
-#include <deque>
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/assert.h"
 
 #include "xgpon-xgtc-bw-allocation.h"
 
@@ -38,16 +38,15 @@ namespace ns3 {
  * \ingroup xgpon
  * \brief The BW-MAP structure used by XG-PON.
  *
- * This class mainly contains a list of XgponXgtcBwAllocation.
- * used by XG-PON's DBA scheme. This class also includes the methods for serialization 
- * to and deserialization from a byte buffer.
+ * This class mainly contains a list of bandwidth allocations used by XG-PON's DBA scheme.
+ * They are kept by value in one inline array (XgponXgtcBwAllocationFields), so that building and scanning one BWmap
+ * touches one block of memory. The T-CONT histories keep the same fields by value (XgponTcontBwAllocationRecord).
+ * This class also includes the methods for serialization to and deserialization from a byte buffer.
  * It follows ITU-T G.987.3 recommendation.
  */
 
-class XgponXgtcBwmap : public SimpleRefCount<XgponXgtcBwAllocation>
+class XgponXgtcBwmap : public SimpleRefCount<XgponXgtcBwmap>
 {
-  //static uint64_t CREATED_BWMAP_NUM4DEBUG;
-  //static uint64_t DELETED_BWMAP_NUM4DEBUG;
 
   //used to allocate this structure from a pool for saving CPU.
   static bool m_poolEnabled;
@@ -55,6 +54,8 @@ class XgponXgtcBwmap : public SimpleRefCount<XgponXgtcBwAllocation>
 
 public:
 
+  const static uint16_t MAX_BW_ALLOCATIONS=512;     //at most, 512 allocations in one BWmap.
+
   /**
    * \brief Constructor
    */
@@ -63,11 +64,12 @@ public:
 
 
   //////////////////////////////////////////////////////////////////Main Functions
-  void AddOneBwAllocation (const Ptr<XgponXgtcBwAllocation>& bwAlloc);
+  //the fields of the allocation are copied into the map
+  void AddOneBwAllocation (const XgponXgtcBwAllocationFields& bwAlloc);
   void AddOneSerializedBwAllocation (uint64_t sBwAlloc);
 
   uint16_t GetNumberOfBwAllocation ( ) const;
-  const Ptr<XgponXgtcBwAllocation>& GetBwAllocationByIndex (uint16_t index) const;
+  const XgponXgtcBwAllocationFields& GetBwAllocationByIndex (uint16_t index) const;
 
 
 
@@ -101,7 +103,11 @@ public:
 
 
 private:
-  std::deque< Ptr<XgponXgtcBwAllocation> > m_bwAllocations;
+  //the allocation that is about to be added
+  XgponXgtcBwAllocationFields& AppendBwAllocation ();
+
+  XgponXgtcBwAllocationFields m_bwAllocations[MAX_BW_ALLOCATIONS];
+  uint16_t m_nBwAllocations;
 
 
   uint16_t meta_allocationNumber;  //META-data: the number of allocations in this map. It is set by a receiver based on one field in the downstream frame header.
@@ -130,6 +136,40 @@ private:
 
 
 ///////////////////////////////////////////////INLINE Functions
+inline XgponXgtcBwAllocationFields&
+XgponXgtcBwmap::AppendBwAllocation ()
+{
+  NS_ASSERT_MSG((m_nBwAllocations < MAX_BW_ALLOCATIONS), "Too many allocations in one BWmap!!!");
+  return m_bwAllocations[m_nBwAllocations++];
+}
+
+inline void 
+XgponXgtcBwmap::AddOneBwAllocation (const XgponXgtcBwAllocationFields& bwAlloc)
+{
+  AppendBwAllocation () = bwAlloc;
+}
+
+inline void 
+XgponXgtcBwmap::AddOneSerializedBwAllocation (uint64_t sBwAlloc)
+{
+  AppendBwAllocation ().DeserializeAllocation (sBwAlloc);
+}
+
+inline uint16_t 
+XgponXgtcBwmap::GetNumberOfBwAllocation ( ) const
+{
+  return m_nBwAllocations;
+}
+
+inline const XgponXgtcBwAllocationFields& 
+XgponXgtcBwmap::GetBwAllocationByIndex (uint16_t index) const
+{
+  NS_ASSERT_MSG( (index < m_nBwAllocations), "The index is too large for BWmap!!!");
+  return m_bwAllocations[index];
+}
+
+
+
 inline void 
 XgponXgtcBwmap::SetCreationTime (uint64_t time)
 {
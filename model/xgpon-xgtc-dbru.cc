@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 
 #include "xgpon-xgtc-dbru.h"
+#include "xgpon-memory-census.h"
 
 
 
@@ -86,12 +87,14 @@ XgponXgtcDbru::operator new(size_t size) noexcept(false) //throw(const char*)
     p = m_pool.top();
     m_pool.pop();  
     NS_LOG_INFO("allocated XgponXgtcDbru through the pool!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGTC_DBRU, size, XgponMemoryCensus::FROM_POOL);
   }
   else
   {
     p = malloc(size);
     if (!p) throw "cannot allocate more memory from the system!!!";
     NS_LOG_INFO("allocated XgponXgtcDbru through malloc!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGTC_DBRU, size, XgponMemoryCensus::FROM_MALLOC);
   }
   return p;
 }
@@ -104,6 +107,7 @@ XgponXgtcDbru::operator delete(void *p)
     m_pool.push(p);
   }
   else free(p);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::XGTC_DBRU, sizeof(XgponXgtcDbru), m_pool.size());
 }
 
 void 
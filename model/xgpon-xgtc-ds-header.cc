@@ -95,7 +95,6 @@ void XgponXgtcDsHeader::Serialize (Buffer::Iterator start) const
 
   uint32_t hlend, i;
 
-  Ptr<XgponXgtcBwAllocation> tmpBwAllocation;
 
 
   uint32_t m_bwmapLen2 = m_bwmap->GetNumberOfBwAllocation();
@@ -106,8 +105,7 @@ void XgponXgtcDsHeader::Serialize (Buffer::Iterator start) const
   start.WriteHtonU32 (hlend);
   for(i=0;i<m_bwmapLen2;i++)
   {
-    tmpBwAllocation=m_bwmap->GetBwAllocationByIndex(i);
-    tmpBwAllocation->Serialize(start);
+    start.WriteHtonU64 (m_bwmap->GetBwAllocationByIndex(i).GetSerializedAllocation ());
   }
   for(i=0;i<m_ploamCount2;i++)
   {
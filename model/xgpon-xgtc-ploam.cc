@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 
 #include "xgpon-xgtc-ploam.h"
+#include "xgpon-memory-census.h"
 
 NS_LOG_COMPONENT_DEFINE ("XgponXgtcPloam");
 
@@ -75,12 +76,14 @@ XgponXgtcPloam::operator new(size_t size) noexcept(false) //throw(const char*)
     p = m_pool.top();
     m_pool.pop();  
     NS_LOG_INFO("allocated XgponXgtcPloam through the pool!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGTC_PLOAM, size, XgponMemoryCensus::FROM_POOL);
   }
   else
   {
     p = malloc(size);
     if (!p) throw "cannot allocate more memory from the system!!!";
     NS_LOG_INFO("allocated XgponXgtcPloam through malloc!!!");
+    XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGTC_PLOAM, size, XgponMemoryCensus::FROM_MALLOC);
   }
   return p;
 }
@@ -93,6 +96,7 @@ XgponXgtcPloam::operator delete(void *p)
     m_pool.push(p);
   }
   else free(p);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::XGTC_PLOAM, sizeof(XgponXgtcPloam), m_pool.size());
 }
 
 void 
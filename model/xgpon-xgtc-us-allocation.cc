@@ -21,6 +21,8 @@
 #include "ns3/log.h"
 
 #include "xgpon-xgtc-us-allocation.h"
+#include "xgpon-memory-census.h"
+#include "xgpon-frame-arena.h"
 
 
 
@@ -28,9 +30,6 @@ NS_LOG_COMPONENT_DEFINE ("XgponXgtcUsAllocation");
 
 namespace ns3 {
 
-//uint64_t XgponXgtcUsAllocation::CREATED_USALLOC_NUM4DEBUG = 0;
-//uint64_t XgponXgtcUsAllocation::DELETED_USALLOC_NUM4DEBUG = 0;
-
 std::stack<void*> XgponXgtcUsAllocation::m_pool;   //initialize as one empty stack;
 bool XgponXgtcUsAllocation::m_poolEnabled = true;
 
@@ -38,20 +37,12 @@ bool XgponXgtcUsAllocation::m_poolEnabled = true;
 XgponXgtcUsAllocation::XgponXgtcUsAllocation ()
   : m_burst(0), m_dbru(0), meta_dbruExist (false)
 {
-  /*
-  CREATED_USALLOC_NUM4DEBUG++;
-  if((CREATED_USALLOC_NUM4DEBUG % 1000) == 0)
-  {
-    std::cout << CREATED_USALLOC_NUM4DEBUG << " us_allocations are created;  " << DELETED_USALLOC_NUM4DEBUG <<  " us_alllocations are deleted." <<std::endl;
-  }
-  */
   m_burst.reserve(XGPON1_MAX_XGEM_FRAMES_PER_US_ALLOCATION);  
 }
 XgponXgtcUsAllocation::~XgponXgtcUsAllocation ()
 {
   m_dbru = 0;
 
-  //DELETED_USALLOC_NUM4DEBUG++;
 }
 
 
@@ -64,45 +55,27 @@ XgponXgtcUsAllocation::~XgponXgtcUsAllocation ()
 void* 
 XgponXgtcUsAllocation::operator new(size_t size) noexcept(false) //throw(const char*)
 {
-  void *p;
-  if(m_poolEnabled == true && (!m_pool.empty()))
-  {
-    p = m_pool.top();
-    m_pool.pop();  
-    NS_LOG_INFO("allocated XgponXgtcUsAllocation through the pool!!!");
-  }
-  else
-  {
-    p = malloc(size);
-    if (!p) throw "cannot allocate more memory from the system!!!";
-    NS_LOG_INFO("allocated XgponXgtcUsAllocation through malloc!!!");
-  }
-  return p;
+  XgponMemoryCensus::XgponAllocationSource source = XgponMemoryCensus::FROM_MALLOC;
+  if(XgponFrameArena::GetActiveArena () != 0) source = XgponMemoryCensus::FROM_ARENA;
+  else if(m_poolEnabled == true && (!m_pool.empty())) source = XgponMemoryCensus::FROM_POOL;
+  XgponMemoryCensus::RecordAllocation (XgponMemoryCensus::XGTC_US_ALLOCATION, size, source);
+
+  //taken from the frame arena when one is open (the object dies with the frame/burst)
+  return XgponFrameArena::AllocateObject (size, m_poolEnabled, m_pool);
 }
 
 void 
 XgponXgtcUsAllocation::operator delete(void *p)
 {
-  if(m_poolEnabled == true)
-  {
-    m_pool.push(p);
-  }
-  else free(p);
+  XgponFrameArena::FreeObject (p, m_poolEnabled, m_pool);
+  XgponMemoryCensus::RecordRelease (XgponMemoryCensus::XGTC_US_ALLOCATION, sizeof(XgponXgtcUsAllocation), m_pool.size());
 }
 
 void 
 XgponXgtcUsAllocation::DisablePoolAllocation()
 {
-  void *p;
-
   m_poolEnabled = false;
-
-  while (!m_pool.empty())
-  {
-    p = m_pool.top();
-    free(p);
-    m_pool.pop();
-  }
+  XgponFrameArena::ClearPool (m_pool);
 }
 
 
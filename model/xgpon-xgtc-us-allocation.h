@@ -47,8 +47,6 @@ class XgponXgtcUsAllocation : public SimpleRefCount<XgponXgtcUsAllocation>
   //the largest burst size in XG-PON1 is 40Kbytes. Thus, 1000 should be enough even when packet size is very small.
   const static uint32_t XGPON1_MAX_XGEM_FRAMES_PER_US_ALLOCATION = 1000; 
 
-  //static uint64_t CREATED_USALLOC_NUM4DEBUG;
-  //static uint64_t DELETED_USALLOC_NUM4DEBUG;
 
   //used to allocate this structure from a pool for saving CPU.
   static bool m_poolEnabled;
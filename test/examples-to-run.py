@@ -8,7 +8,32 @@
 #     (example_name, do_run, do_valgrind_run).
 #
 # See test.py for more information.
-cpp_examples = []
+cpp_examples = [
+    ("xgpon-scaling-benchmark --onus=8 --sim-time=0.1", "True", "False"),
+    ("xgpon-golden-trace-check --dba=RoundRobin --variant=static-engines", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Giant --variant=static-engines", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Xgiant --variant=static-engines", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantDeficit --variant=static-engines", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantProp --variant=static-engines", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Giant --variant=batch-us-bursts", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Xgiant --variant=batch-us-bursts", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantDeficit --variant=batch-us-bursts", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantProp --variant=batch-us-bursts", "True", "False"),
+    ("xgpon-golden-trace-check --dba=RoundRobin --variant=idle-fast-forward", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Giant --variant=idle-fast-forward", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Xgiant --variant=idle-fast-forward", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantDeficit --variant=idle-fast-forward", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantProp --variant=idle-fast-forward", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Giant --variant=idle-fast-forward-fixed", "True", "False"),
+    ("xgpon-golden-trace-check --dba=Xgiant --variant=idle-fast-forward-fixed", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantDeficit --variant=idle-fast-forward-fixed", "True", "False"),
+    ("xgpon-golden-trace-check --dba=XgiantProp --variant=idle-fast-forward-fixed", "True", "False"),
+    ("xgpon-multicast-check --idle-fast-forward=1", "True", "False"),
+    ("xgpon-multicast-check --idle-fast-forward=0", "True", "False"),
+    ("xgpon-config-pool-check", "True", "False"),
+    ("xgpon-address-classifier-check", "True", "False"),
+    ("xgpon-us-classifier-check", "True", "False"),
+]
 #cpp_examples = [("xgpon-test-suit", "True", "True")]
 
 # A list of Python examples to run in order to ensure that they remain